@@ -185,6 +185,33 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including `mmap` allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+typedef void (*MEM_MemoryUsageByNameFn)(const char *name,
+                                        size_t mem_in_use,
+                                        size_t blocks_num,
+                                        void *user_data);
+
+/**
+ * Call \a fn for every allocation name that currently has live memory blocks, in alphabetical
+ * order. Blocks whose names are equal strings are combined.
+ *
+ * The guarded allocator always knows the names of its blocks. The lock-free allocator only counts
+ * blocks that were allocated while #MEM_use_memory_usage_by_name was enabled.
+ */
+extern void (*MEM_foreach_memory_usage_by_name)(MEM_MemoryUsageByNameFn fn, void *user_data);
+
+/**
+ * Make the lock-free allocator keep live memory counts per allocation name. This adds a pointer
+ * sized overhead to every block allocated while enabled, and a small cost for updating the
+ * per-thread counters. As with #MEM_name_ptr_set, names must be static strings, because only a
+ * pointer to them is stored.
+ *
+ * Tracking can be toggled at any time, blocks remember whether they have been counted.
+ */
+void MEM_use_memory_usage_by_name(bool enabled);
+
+/** Print the live memory per allocation name, sorted by the amount of memory in use. */
+void MEM_print_memory_usage_by_name(void);
+
 #ifdef __cplusplus
 #  define MEM_SAFE_FREE(v) \
     do { \
@@ -13,7 +13,10 @@
 /* To ensure strict conversions. */
 #include "../../source/blender/blenlib/BLI_strict_flags.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <vector>
 
 #include "mallocn_intern.h"
 
@@ -56,6 +59,8 @@ size_t (*MEM_get_memory_in_use)(void) = MEM_lockfree_get_memory_in_use;
 uint (*MEM_get_memory_blocks_in_use)(void) = MEM_lockfree_get_memory_blocks_in_use;
 void (*MEM_reset_peak_memory)(void) = MEM_lockfree_reset_peak_memory;
 size_t (*MEM_get_peak_memory)(void) = MEM_lockfree_get_peak_memory;
+void (*MEM_foreach_memory_usage_by_name)(MEM_MemoryUsageByNameFn fn, void *user_data) =
+    MEM_lockfree_foreach_memory_usage_by_name;
 
 void (*mem_clearmemlist)(void) = mem_lockfree_clearmemlist;
 
@@ -95,6 +100,42 @@ void aligned_free(void *ptr)
 #endif
 }
 
+namespace {
+
+struct MemoryUsageByName {
+  const char *name;
+  size_t mem_in_use;
+  size_t blocks_num;
+};
+
+}  // namespace
+
+void MEM_print_memory_usage_by_name()
+{
+  std::vector<MemoryUsageByName> usages;
+  MEM_foreach_memory_usage_by_name(
+      [](const char *name, size_t mem_in_use, size_t blocks_num, void *user_data) {
+        static_cast<std::vector<MemoryUsageByName> *>(user_data)->push_back(
+            {name, mem_in_use, blocks_num});
+      },
+      &usages);
+  std::stable_sort(usages.begin(),
+                   usages.end(),
+                   [](const MemoryUsageByName &a, const MemoryUsageByName &b) {
+                     return a.mem_in_use > b.mem_in_use;
+                   });
+
+  printf("\nmemory usage by name:\n");
+  printf(" ITEMS TOTAL-MiB AVERAGE-KiB TYPE\n");
+  for (const MemoryUsageByName &usage : usages) {
+    printf("%6zu (%8.3f  %8.3f) %s\n",
+           usage.blocks_num,
+           double(usage.mem_in_use) / double(1024 * 1024),
+           double(usage.mem_in_use) / 1024.0 / double(usage.blocks_num),
+           usage.name);
+  }
+}
+
 /**
  * Perform assert checks on allocator type change.
  *
@@ -141,6 +182,7 @@ void MEM_use_lockfree_allocator()
   MEM_get_memory_blocks_in_use = MEM_lockfree_get_memory_blocks_in_use;
   MEM_reset_peak_memory = MEM_lockfree_reset_peak_memory;
   MEM_get_peak_memory = MEM_lockfree_get_peak_memory;
+  MEM_foreach_memory_usage_by_name = MEM_lockfree_foreach_memory_usage_by_name;
 
   mem_clearmemlist = mem_lockfree_clearmemlist;
 
@@ -176,6 +218,7 @@ void MEM_use_guarded_allocator()
   MEM_get_memory_blocks_in_use = MEM_guarded_get_memory_blocks_in_use;
   MEM_reset_peak_memory = MEM_guarded_reset_peak_memory;
   MEM_get_peak_memory = MEM_guarded_get_peak_memory;
+  MEM_foreach_memory_usage_by_name = MEM_guarded_foreach_memory_usage_by_name;
 
   mem_clearmemlist = mem_guarded_clearmemlist;
 
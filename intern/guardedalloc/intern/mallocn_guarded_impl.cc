@@ -782,6 +782,51 @@ void MEM_guarded_printmemlist_stats()
 #endif
 }
 
+void MEM_guarded_foreach_memory_usage_by_name(MEM_MemoryUsageByNameFn fn, void *user_data)
+{
+  MemPrintBlock *printblock = nullptr;
+  uint totpb = 0;
+
+  mem_lock_thread();
+
+  if (totblock != 0) {
+    printblock = static_cast<MemPrintBlock *>(malloc(sizeof(MemPrintBlock) * totblock));
+    if (UNLIKELY(!printblock)) {
+      mem_unlock_thread();
+      print_error("malloc returned null while gathering memory usage by name");
+      return;
+    }
+  }
+
+  for (MemHead *membl = membase->first ? MEMNEXT(membase->first) : nullptr;
+       membl && totpb < totblock;
+       membl = membl->next ? MEMNEXT(membl->next) : nullptr)
+  {
+    printblock[totpb].name = membl->name;
+    printblock[totpb].len = membl->len;
+    printblock[totpb].items = 1;
+    totpb++;
+  }
+
+  /* The callback may allocate memory, so it must not be called while the lock is held. */
+  mem_unlock_thread();
+
+  if (totpb > 1) {
+    qsort(printblock, totpb, sizeof(MemPrintBlock), compare_name);
+  }
+  for (uint a = 0; a < totpb;) {
+    MemPrintBlock pb = printblock[a++];
+    while (a < totpb && strcmp(printblock[a].name, pb.name) == 0) {
+      pb.len += printblock[a].len;
+      pb.items++;
+      a++;
+    }
+    fn(pb.name, size_t(pb.len), size_t(pb.items), user_data);
+  }
+
+  free(printblock);
+}
+
 static const char mem_printmemlist_pydict_script[] =
     "mb_userinfo = {}\n"
     "totmem = 0\n"
@@ -116,6 +116,9 @@ size_t memory_usage_block_num(void);
 size_t memory_usage_current(void);
 size_t memory_usage_peak(void);
 void memory_usage_peak_reset(void);
+void memory_usage_by_name_block_alloc(const char *name, size_t size);
+void memory_usage_by_name_block_free(const char *name, size_t size);
+void memory_usage_by_name_foreach(MEM_MemoryUsageByNameFn fn, void *user_data);
 
 /**
  * Clear the listbase of allocated memory blocks.
@@ -171,6 +174,7 @@ size_t MEM_lockfree_get_memory_in_use(void);
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void);
 void MEM_lockfree_reset_peak_memory(void);
 size_t MEM_lockfree_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
+void MEM_lockfree_foreach_memory_usage_by_name(MEM_MemoryUsageByNameFn fn, void *user_data);
 
 void mem_lockfree_clearmemlist(void);
 
@@ -220,6 +224,7 @@ size_t MEM_guarded_get_memory_in_use(void);
 unsigned int MEM_guarded_get_memory_blocks_in_use(void);
 void MEM_guarded_reset_peak_memory(void);
 size_t MEM_guarded_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
+void MEM_guarded_foreach_memory_usage_by_name(MEM_MemoryUsageByNameFn fn, void *user_data);
 
 void mem_guarded_clearmemlist(void);
 
@@ -8,6 +8,7 @@
  * Memory allocation which keeps track on allocated memory counters
  */
 
+#include <atomic>
 #include <stdarg.h>
 #include <stdio.h> /* printf */
 #include <stdlib.h>
@@ -43,18 +44,27 @@ static_assert(MEM_MIN_CPP_ALIGNMENT <= alignof(MemHeadAligned), "Bad alignment o
 static_assert(MEM_MIN_CPP_ALIGNMENT <= sizeof(MemHeadAligned), "Bad size of MemHeadAligned");
 
 static bool malloc_debug_memset = false;
+/** See #MEM_use_memory_usage_by_name. */
+static std::atomic<bool> use_memory_usage_by_name = false;
 
 static void (*error_callback)(const char *) = nullptr;
 
 enum {
   MEMHEAD_ALIGN_FLAG = 1,
+  /** The block name is stored after the user data and the block is counted per name. */
+  MEMHEAD_NAME_FLAG = 2,
 };
 
 #define MEMHEAD_FROM_PTR(ptr) (((MemHead *)ptr) - 1)
 #define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & size_t(MEMHEAD_ALIGN_FLAG))
-#define MEMHEAD_LEN(memhead) ((memhead)->len & ~size_t(MEMHEAD_ALIGN_FLAG))
+#define MEMHEAD_HAS_NAME(memhead) ((memhead)->len & size_t(MEMHEAD_NAME_FLAG))
+#define MEMHEAD_LEN(memhead) \
+  ((memhead)->len & ~size_t(MEMHEAD_ALIGN_FLAG | MEMHEAD_NAME_FLAG))
+
+/** Extra bytes allocated after the user data to store the block name. */
+#define MEM_NAME_SIZE(use_name) ((use_name) ? sizeof(const char *) : size_t(0))
 
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 2)))
@@ -75,6 +85,28 @@ print_error(const char *str, ...)
   }
 }
 
+/**
+ * Store the name of a block whose length is already set, and count it in the per-name statistics.
+ */
+static void memhead_name_init(MemHead *memh, const char *str)
+{
+  const size_t len = MEMHEAD_LEN(memh);
+  memcpy(reinterpret_cast<char *>(memh + 1) + len, &str, sizeof(str));
+  memh->len |= size_t(MEMHEAD_NAME_FLAG);
+  memory_usage_by_name_block_alloc(str, len);
+}
+
+/** Get the name stored with a block, or \a fallback when the block has no name. */
+static const char *memhead_name_get(const MemHead *memh, const char *fallback)
+{
+  if (LIKELY(!MEMHEAD_HAS_NAME(memh))) {
+    return fallback;
+  }
+  const char *str;
+  memcpy(&str, reinterpret_cast<const char *>(memh + 1) + MEMHEAD_LEN(memh), sizeof(str));
+  return str;
+}
+
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (LIKELY(vmemh)) {
@@ -102,6 +134,9 @@ void MEM_lockfree_freeN(void *vmemh)
   size_t len = MEMHEAD_LEN(memh);
 
   memory_usage_block_free(len);
+  if (UNLIKELY(MEMHEAD_HAS_NAME(memh))) {
+    memory_usage_by_name_block_free(memhead_name_get(memh, nullptr), len);
+  }
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -124,10 +159,10 @@ void *MEM_lockfree_dupallocN(const void *vmemh)
     if (UNLIKELY(MEMHEAD_IS_ALIGNED(memh))) {
       const MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
       newp = MEM_lockfree_mallocN_aligned(
-          prev_size, size_t(memh_aligned->alignment), "dupli_malloc");
+          prev_size, size_t(memh_aligned->alignment), memhead_name_get(memh, "dupli_malloc"));
     }
     else {
-      newp = MEM_lockfree_mallocN(prev_size, "dupli_malloc");
+      newp = MEM_lockfree_mallocN(prev_size, memhead_name_get(memh, "dupli_malloc"));
     }
     memcpy(newp, vmemh, prev_size);
   }
@@ -142,12 +177,15 @@ void *MEM_lockfree_reallocN_id(void *vmemh, size_t len, const char *str)
     const MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
     const size_t old_len = MEM_lockfree_allocN_len(vmemh);
 
+    /* Keep counting the memory for the original name. */
+    const char *name = memhead_name_get(memh, "realloc");
+
     if (LIKELY(!MEMHEAD_IS_ALIGNED(memh))) {
-      newp = MEM_lockfree_mallocN(len, "realloc");
+      newp = MEM_lockfree_mallocN(len, name);
     }
     else {
       const MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
-      newp = MEM_lockfree_mallocN_aligned(len, size_t(memh_aligned->alignment), "realloc");
+      newp = MEM_lockfree_mallocN_aligned(len, size_t(memh_aligned->alignment), name);
     }
 
     if (newp) {
@@ -178,12 +216,15 @@ void *MEM_lockfree_recallocN_id(void *vmemh, size_t len, const char *str)
     const MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
     const size_t old_len = MEM_lockfree_allocN_len(vmemh);
 
+    /* Keep counting the memory for the original name. */
+    const char *name = memhead_name_get(memh, "recalloc");
+
     if (LIKELY(!MEMHEAD_IS_ALIGNED(memh))) {
-      newp = MEM_lockfree_mallocN(len, "recalloc");
+      newp = MEM_lockfree_mallocN(len, name);
     }
     else {
       const MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
-      newp = MEM_lockfree_mallocN_aligned(len, size_t(memh_aligned->alignment), "recalloc");
+      newp = MEM_lockfree_mallocN_aligned(len, size_t(memh_aligned->alignment), name);
     }
 
     if (newp) {
@@ -215,13 +256,17 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
 {
   MemHead *memh;
 
+  const bool use_name = use_memory_usage_by_name.load(std::memory_order_relaxed);
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+  memh = (MemHead *)calloc(1, len + sizeof(MemHead) + MEM_NAME_SIZE(use_name));
 
   if (LIKELY(memh)) {
     memh->len = len;
     memory_usage_block_alloc(len);
+    if (UNLIKELY(use_name)) {
+      memhead_name_init(memh, str);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -257,9 +302,10 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 #ifdef WITH_MEM_VALGRIND
   const size_t len_unaligned = len;
 #endif
+  const bool use_name = use_memory_usage_by_name.load(std::memory_order_relaxed);
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)malloc(len + sizeof(MemHead));
+  memh = (MemHead *)malloc(len + sizeof(MemHead) + MEM_NAME_SIZE(use_name));
 
   if (LIKELY(memh)) {
 
@@ -279,6 +325,9 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 
     memh->len = len;
     memory_usage_block_alloc(len);
+    if (UNLIKELY(use_name)) {
+      memhead_name_init(memh, str);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -328,6 +377,7 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
    * order to save some bits in MemHead structure.
    */
   size_t extra_padding = MEMHEAD_ALIGN_PADDING(alignment);
+  const bool use_name = use_memory_usage_by_name.load(std::memory_order_relaxed);
 
 #ifdef WITH_MEM_VALGRIND
   const size_t len_unaligned = len;
@@ -335,7 +385,7 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
   len = SIZET_ALIGN_4(len);
 
   MemHeadAligned *memh = (MemHeadAligned *)aligned_malloc(
-      len + extra_padding + sizeof(MemHeadAligned), alignment);
+      len + extra_padding + sizeof(MemHeadAligned) + MEM_NAME_SIZE(use_name), alignment);
 
   if (LIKELY(memh)) {
     /* We keep padding in the beginning of MemHead,
@@ -361,8 +411,12 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
     memh->len = len | size_t(MEMHEAD_ALIGN_FLAG);
     memh->alignment = short(alignment);
     memory_usage_block_alloc(len);
+    void *ptr = PTR_FROM_MEMHEAD(memh);
+    if (UNLIKELY(use_name)) {
+      memhead_name_init(MEMHEAD_FROM_PTR(ptr), str);
+    }
 
-    return PTR_FROM_MEMHEAD(memh);
+    return ptr;
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total " SIZET_FORMAT "\n",
               SIZET_ARG(len),
@@ -417,6 +471,9 @@ void MEM_lockfree_printmemlist_stats()
 {
   printf("\ntotal memory len: %.3f MB\n", double(memory_usage_current()) / double(1024 * 1024));
   printf("peak memory len: %.3f MB\n", double(memory_usage_peak()) / double(1024 * 1024));
+  if (use_memory_usage_by_name.load(std::memory_order_relaxed)) {
+    MEM_print_memory_usage_by_name();
+  }
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
@@ -463,11 +520,21 @@ size_t MEM_lockfree_get_peak_memory()
   return memory_usage_peak();
 }
 
+void MEM_lockfree_foreach_memory_usage_by_name(MEM_MemoryUsageByNameFn fn, void *user_data)
+{
+  memory_usage_by_name_foreach(fn, user_data);
+}
+
+void MEM_use_memory_usage_by_name(const bool enabled)
+{
+  use_memory_usage_by_name.store(enabled, std::memory_order_relaxed);
+}
+
 #ifndef NDEBUG
 const char *MEM_lockfree_name_ptr(void *vmemh)
 {
   if (vmemh) {
-    return "unknown block name ptr";
+    return memhead_name_get(MEMHEAD_FROM_PTR(vmemh), "unknown block name ptr");
   }
 
   return "MEM_lockfree_name_ptr(nullptr)";
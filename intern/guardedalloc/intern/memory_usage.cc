@@ -5,9 +5,12 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <vector>
 
 #include "MEM_guardedalloc.h"
@@ -20,6 +23,99 @@ namespace {
 struct Local;
 struct Global;
 
+/**
+ * Memory counts of all blocks allocated with the same name pointer.
+ */
+struct NameCounter {
+  std::atomic<const char *> name = nullptr;
+  std::atomic<int64_t> mem_in_use = 0;
+  std::atomic<int64_t> blocks_num = 0;
+};
+
+/**
+ * Fixed size open addressing hash table that maps allocation name pointers to their counters.
+ * Names are compared by pointer here, blocks with equal names at different addresses are merged
+ * when the statistics are gathered. The table is allocated with `calloc` to avoid recursing into
+ * the allocator that is being tracked.
+ */
+struct NameCounterTable {
+  static constexpr size_t slots_num = 4096;
+  /** Maximum number of slots that are probed before giving up and using #overflow. */
+  static constexpr size_t max_probes = 32;
+
+  NameCounter slots[slots_num];
+  /** Counts all blocks that did not fit into the table anymore. */
+  NameCounter overflow;
+
+  NameCounter &lookup_or_add(const char *name)
+  {
+    const size_t hash = (size_t(uintptr_t(name)) >> 3) * 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < max_probes; i++) {
+      NameCounter &slot = slots[(hash + i) & (slots_num - 1)];
+      const char *slot_name = slot.name.load(std::memory_order_acquire);
+      if (slot_name == name) {
+        return slot;
+      }
+      if (slot_name == nullptr) {
+        /* Multiple threads may insert into the table of #Global, so the slot has to be claimed
+         * atomically. */
+        if (slot.name.compare_exchange_strong(slot_name, name, std::memory_order_acq_rel) ||
+            slot_name == name)
+        {
+          return slot;
+        }
+      }
+    }
+    return overflow;
+  }
+
+  void add(const NameCounterTable &other)
+  {
+    for (const NameCounter &other_slot : other.slots) {
+      if (const char *name = other_slot.name.load(std::memory_order_acquire)) {
+        NameCounter &slot = this->lookup_or_add(name);
+        slot.mem_in_use.fetch_add(other_slot.mem_in_use, std::memory_order_relaxed);
+        slot.blocks_num.fetch_add(other_slot.blocks_num, std::memory_order_relaxed);
+      }
+    }
+    overflow.mem_in_use.fetch_add(other.overflow.mem_in_use, std::memory_order_relaxed);
+    overflow.blocks_num.fetch_add(other.overflow.blocks_num, std::memory_order_relaxed);
+  }
+
+  static NameCounterTable *create()
+  {
+    void *buffer = calloc(1, sizeof(NameCounterTable));
+    if (buffer == nullptr) {
+      return nullptr;
+    }
+    return new (buffer) NameCounterTable();
+  }
+
+  static void destroy(NameCounterTable *table)
+  {
+    if (table) {
+      table->~NameCounterTable();
+      free(table);
+    }
+  }
+
+  /** Create the table referenced by \a table_ptr if it does not exist yet. */
+  static NameCounterTable *ensure(std::atomic<NameCounterTable *> &table_ptr)
+  {
+    NameCounterTable *table = table_ptr.load(std::memory_order_acquire);
+    if (LIKELY(table)) {
+      return table;
+    }
+    NameCounterTable *new_table = create();
+    if (table_ptr.compare_exchange_strong(table, new_table, std::memory_order_acq_rel)) {
+      return new_table;
+    }
+    /* Another thread was faster. */
+    destroy(new_table);
+    return table;
+  }
+};
+
 /**
  * This is stored per thread. Align to cache line size to avoid false sharing.
  */
@@ -54,6 +150,12 @@ struct alignas(128) Local {
    * accurate, but it's still good enough for practical purposes.
    */
   std::atomic<int64_t> mem_in_use_during_peak_update = 0;
+  /**
+   * Memory counts per allocation name. Only created when the allocator tracks names, see
+   * #memory_usage_by_name_block_alloc. Other threads only read it while #Global::locals_mutex is
+   * locked.
+   */
+  std::atomic<NameCounterTable *> by_name = nullptr;
 
   Local();
   ~Local();
@@ -94,6 +196,15 @@ struct Global {
    * Peak memory usage since the last reset.
    */
   std::atomic<size_t> peak = 0;
+  /**
+   * Per-name memory counts that are not tracked by #Local, for the same reason as above.
+   */
+  std::atomic<NameCounterTable *> by_name_outside_locals = nullptr;
+
+  ~Global()
+  {
+    NameCounterTable::destroy(by_name_outside_locals);
+  }
 };
 
 }  // namespace
@@ -152,6 +263,14 @@ Local::~Local()
   /* Don't forget the memory counts stored locally. */
   this->global->blocks_num_outside_locals.fetch_add(this->blocks_num, std::memory_order_relaxed);
   this->global->mem_in_use_outside_locals.fetch_add(this->mem_in_use, std::memory_order_relaxed);
+  if (NameCounterTable *local_by_name = this->by_name.exchange(nullptr)) {
+    if (NameCounterTable *global_by_name = NameCounterTable::ensure(
+            this->global->by_name_outside_locals))
+    {
+      global_by_name->add(*local_by_name);
+    }
+    NameCounterTable::destroy(local_by_name);
+  }
 
   if (this->is_main) {
     /* The main thread started shutting down. Use global counters from now on to avoid accessing
@@ -273,3 +392,112 @@ void memory_usage_peak_reset()
   Global &global = get_global();
   global.peak = memory_usage_current();
 }
+
+/** Get the per-name counters that should be modified by the current thread. */
+static NameCounter *get_name_counter(const char *name)
+{
+  if (name == nullptr) {
+    /* A null pointer marks unused slots in #NameCounterTable. */
+    name = "(unnamed)";
+  }
+  NameCounterTable *table;
+  if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
+    table = NameCounterTable::ensure(get_local_data().by_name);
+  }
+  else {
+    table = NameCounterTable::ensure(get_global().by_name_outside_locals);
+  }
+  return table ? &table->lookup_or_add(name) : nullptr;
+}
+
+void memory_usage_by_name_block_alloc(const char *name, const size_t size)
+{
+  if (NameCounter *counter = get_name_counter(name)) {
+    counter->blocks_num.fetch_add(1, std::memory_order_relaxed);
+    counter->mem_in_use.fetch_add(int64_t(size), std::memory_order_relaxed);
+  }
+}
+
+void memory_usage_by_name_block_free(const char *name, const size_t size)
+{
+  if (NameCounter *counter = get_name_counter(name)) {
+    counter->mem_in_use.fetch_sub(int64_t(size), std::memory_order_relaxed);
+    counter->blocks_num.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+namespace {
+
+struct NameUsage {
+  const char *name;
+  int64_t mem_in_use;
+  int64_t blocks_num;
+};
+
+}  // namespace
+
+static int compare_name_usage(const void *a, const void *b)
+{
+  return strcmp(static_cast<const NameUsage *>(a)->name, static_cast<const NameUsage *>(b)->name);
+}
+
+void memory_usage_by_name_foreach(MEM_MemoryUsageByNameFn fn, void *user_data)
+{
+  /* Merge the counters of all threads. The callback is only called after the mutex is unlocked
+   * again, because it may allocate memory. */
+  NameCounterTable *merged = NameCounterTable::create();
+  if (merged == nullptr) {
+    return;
+  }
+  {
+    Global &global = get_global();
+    std::lock_guard lock{global.locals_mutex};
+    if (const NameCounterTable *table = global.by_name_outside_locals.load()) {
+      merged->add(*table);
+    }
+    for (const Local *local : global.locals) {
+      if (const NameCounterTable *table = local->by_name.load()) {
+        merged->add(*table);
+      }
+    }
+  }
+
+  NameUsage *usages = static_cast<NameUsage *>(
+      malloc(sizeof(NameUsage) * (NameCounterTable::slots_num + 1)));
+  if (usages == nullptr) {
+    NameCounterTable::destroy(merged);
+    return;
+  }
+  size_t usages_num = 0;
+  for (const NameCounter &slot : merged->slots) {
+    if (const char *name = slot.name.load(std::memory_order_relaxed)) {
+      usages[usages_num++] = {name, slot.mem_in_use, slot.blocks_num};
+    }
+  }
+  if (merged->overflow.blocks_num != 0) {
+    usages[usages_num++] = {
+        "(other names)", merged->overflow.mem_in_use, merged->overflow.blocks_num};
+  }
+  NameCounterTable::destroy(merged);
+
+  /* Different name pointers may refer to equal strings, e.g. when the same literal is used in
+   * different translation units. Sort by name to combine them. */
+  qsort(usages, usages_num, sizeof(NameUsage), compare_name_usage);
+  for (size_t i = 0; i < usages_num;) {
+    NameUsage usage = usages[i++];
+    while (i < usages_num && strcmp(usages[i].name, usage.name) == 0) {
+      usage.mem_in_use += usages[i].mem_in_use;
+      usage.blocks_num += usages[i].blocks_num;
+      i++;
+    }
+    /* Blocks may have been allocated and freed with different names while tracking was toggled,
+     * don't report bogus negative or empty entries. */
+    if (usage.blocks_num > 0) {
+      fn(usage.name,
+         size_t(std::max<int64_t>(usage.mem_in_use, 0)),
+         size_t(usage.blocks_num),
+         user_data);
+    }
+  }
+  free(usages);
+}
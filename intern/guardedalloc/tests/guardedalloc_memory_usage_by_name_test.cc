@@ -0,0 +1,134 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+struct NameUsage {
+  size_t mem_in_use = 0;
+  size_t blocks_num = 0;
+};
+
+/** Get the memory counted for the given name, names are compared by content. */
+NameUsage get_usage(const char *name)
+{
+  struct Data {
+    const char *name;
+    NameUsage usage;
+  } data{name, {}};
+  MEM_foreach_memory_usage_by_name(
+      [](const char *name, size_t mem_in_use, size_t blocks_num, void *user_data) {
+        Data &data = *static_cast<Data *>(user_data);
+        if (strcmp(name, data.name) == 0) {
+          data.usage.mem_in_use += mem_in_use;
+          data.usage.blocks_num += blocks_num;
+        }
+      },
+      &data);
+  return data.usage;
+}
+
+void DoBasicUsageByNameChecks()
+{
+  void *a = MEM_mallocN(100, "usage_by_name_a");
+  void *b = MEM_callocN(28, "usage_by_name_a");
+  void *c = MEM_mallocN_aligned(64, 64, "usage_by_name_b");
+
+  EXPECT_EQ(get_usage("usage_by_name_a").blocks_num, 2);
+  EXPECT_EQ(get_usage("usage_by_name_a").mem_in_use, 128);
+  EXPECT_EQ(get_usage("usage_by_name_b").blocks_num, 1);
+  EXPECT_EQ(get_usage("usage_by_name_b").mem_in_use, 64);
+
+  /* Names are compared by content, not by pointer. */
+  const std::string name_copy = "usage_by_name_b";
+  EXPECT_EQ(get_usage(name_copy.c_str()).blocks_num, 1);
+
+  /* Reallocated blocks keep their name. */
+  a = MEM_reallocN(a, 200);
+  c = MEM_recallocN(c, 128);
+  EXPECT_EQ(get_usage("usage_by_name_a").blocks_num, 2);
+  EXPECT_EQ(get_usage("usage_by_name_a").mem_in_use, 228);
+  EXPECT_EQ(get_usage("usage_by_name_b").mem_in_use, 128);
+
+  MEM_freeN(a);
+  MEM_freeN(b);
+  MEM_freeN(c);
+  EXPECT_EQ(get_usage("usage_by_name_a").blocks_num, 0);
+  EXPECT_EQ(get_usage("usage_by_name_b").blocks_num, 0);
+}
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, MEM_foreach_memory_usage_by_name)
+{
+  MEM_use_memory_usage_by_name(true);
+  DoBasicUsageByNameChecks();
+
+  /* Unlike the guarded allocator, duplicated blocks keep the name of the original. */
+  void *a = MEM_mallocN(16, "usage_by_name_dup");
+  void *b = MEM_dupallocN(a);
+  EXPECT_EQ(get_usage("usage_by_name_dup").blocks_num, 2);
+  MEM_freeN(a);
+  MEM_freeN(b);
+
+  MEM_use_memory_usage_by_name(false);
+}
+
+TEST_F(GuardedAllocatorTest, MEM_foreach_memory_usage_by_name)
+{
+  DoBasicUsageByNameChecks();
+}
+
+TEST_F(LockFreeAllocatorTest, MEM_foreach_memory_usage_by_name_toggle)
+{
+  /* Blocks allocated before tracking is enabled are not counted, also not when they are freed. */
+  void *untracked = MEM_mallocN(16, "usage_by_name_toggle");
+  MEM_use_memory_usage_by_name(true);
+  void *tracked = MEM_mallocN(32, "usage_by_name_toggle");
+  MEM_freeN(untracked);
+  EXPECT_EQ(get_usage("usage_by_name_toggle").blocks_num, 1);
+  EXPECT_EQ(get_usage("usage_by_name_toggle").mem_in_use, 32);
+
+  /* Blocks allocated while tracking was enabled are still uncounted after disabling it. */
+  MEM_use_memory_usage_by_name(false);
+  MEM_freeN(tracked);
+  EXPECT_EQ(get_usage("usage_by_name_toggle").blocks_num, 0);
+}
+
+TEST_F(LockFreeAllocatorTest, MEM_foreach_memory_usage_by_name_threads)
+{
+  MEM_use_memory_usage_by_name(true);
+
+  /* Blocks are allocated on one thread and freed on another, and threads exit while they still
+   * have counts stored locally. */
+  constexpr int blocks_num = 1000;
+  std::vector<void *> blocks(blocks_num);
+  std::thread alloc_thread([&]() {
+    for (void *&block : blocks) {
+      block = MEM_mallocN(8, "usage_by_name_threads");
+    }
+  });
+  alloc_thread.join();
+  EXPECT_EQ(get_usage("usage_by_name_threads").blocks_num, blocks_num);
+  EXPECT_EQ(get_usage("usage_by_name_threads").mem_in_use, blocks_num * 8);
+
+  std::thread free_thread([&]() {
+    for (void *block : blocks) {
+      MEM_freeN(block);
+    }
+  });
+  free_thread.join();
+  EXPECT_EQ(get_usage("usage_by_name_threads").blocks_num, 0);
+
+  MEM_use_memory_usage_by_name(false);
+}
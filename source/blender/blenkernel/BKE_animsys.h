@@ -359,6 +359,9 @@ void BKE_animsys_eval_driver(struct Depsgraph *depsgraph,
 
 void BKE_animsys_update_driver_array(struct ID *id);
 
+/** Free the cached evaluation plan of the active action, it is rebuilt when needed. */
+void BKE_animsys_free_eval_plan(struct AnimData *adt);
+
 /* ************************************* */
 
 #ifdef __cplusplus
@@ -643,6 +643,17 @@ void BKE_pose_eval_cleanup(Depsgraph *depsgraph, Scene *scene, Object *object);
 /* Note that we could have a 'BKE_armature_deform_coords' that doesn't take object data
  * currently there are no callers for this though. */
 
+namespace blender::bke {
+/**
+ * Vertex group weights of a mesh stored in a way that is faster to iterate over during
+ * deformation. It is kept between evaluations (e.g. by the armature modifier) and only rebuilt
+ * when the vertex group data of the mesh changes.
+ */
+struct ArmatureDeformWeightsCache;
+ArmatureDeformWeightsCache *armature_deform_weights_cache_new();
+void armature_deform_weights_cache_free(ArmatureDeformWeightsCache *cache);
+}  // namespace blender::bke
+
 void BKE_armature_deform_coords_with_gpencil_stroke(const Object *ob_arm,
                                                     const Object *ob_target,
                                                     float (*vert_coords)[3],
@@ -671,7 +682,9 @@ void BKE_armature_deform_coords_with_mesh(const Object *ob_arm,
                                           int deformflag,
                                           float (*vert_coords_prev)[3],
                                           const char *defgrp_name,
-                                          const Mesh *me_target);
+                                          const Mesh *me_target,
+                                          blender::bke::ArmatureDeformWeightsCache *weights_cache =
+                                              nullptr);
 
 void BKE_armature_deform_coords_with_editmesh(const Object *ob_arm,
                                               const Object *ob_target,
@@ -182,6 +182,16 @@ void free_bvhtree_from_pointcloud(BVHTreeFromPointCloud *data);
 bool bvhcache_has_tree(const BVHCache *bvh_cache, const BVHTree *tree);
 BVHCache *bvhcache_init();
 /**
- * Frees a BVH-cache.
+ * Create a cache for a copy of the mesh that shares the trees which only depend on the positions
+ * and topology. Returns null when there are no such trees.
+ */
+BVHCache *bvhcache_copy_shared(BVHCache *bvh_cache);
+/**
+ * Frees a BVH-cache. Trees that were built from implicitly shared mesh data are kept when they are
+ * not used anymore, so that they can be reused or refit for another mesh with the same data.
  */
 void bvhcache_free(BVHCache *bvh_cache);
+/**
+ * Free the trees of freed caches that were kept for reuse.
+ */
+void bvhcache_free_unused_trees();
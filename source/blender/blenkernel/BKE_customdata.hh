@@ -401,6 +401,24 @@ void CustomData_bmesh_copy_block(CustomData &dst_data,
                                  const void *src_block,
                                  void **dst_block);
 
+/**
+ * Copy the values of a single layer from a contiguous array into the blocks of many elements, or
+ * set them to the layer type's default value when \a src_data is null. Null blocks are skipped.
+ * Copying a layer at a time avoids the per-value type lookup of #CustomData_data_copy_value.
+ */
+void CustomData_bmesh_layer_copy_from_array(eCustomDataType type,
+                                            const void *src_data,
+                                            blender::Span<void *> dst_blocks,
+                                            int dst_offset);
+
+/**
+ * Copy the values of a single layer from the blocks of many elements into a contiguous array.
+ */
+void CustomData_bmesh_layer_copy_to_array(eCustomDataType type,
+                                          blender::Span<const void *> src_blocks,
+                                          int src_offset,
+                                          void *dst_data);
+
 /**
  * Copies data of a single layer of a given type.
  */
@@ -14,7 +14,9 @@
 extern "C" {
 #endif
 
+struct DataTransferRemapCache;
 struct Depsgraph;
+struct MeshPairRemap;
 struct Object;
 struct ReportList;
 struct SpaceTransform;
@@ -167,6 +169,24 @@ bool BKE_object_data_transfer_mesh(struct Depsgraph *depsgraph,
                                    const char *vgroup_name,
                                    bool invert_vgroup,
                                    struct ReportList *reports);
+
+/**
+ * Storage for the geometry mappings computed by #BKE_object_data_transfer_ex, so that they can be
+ * reused by later evaluations as long as none of their inputs changed.
+ */
+struct DataTransferRemapCache *BKE_data_transfer_remap_cache_new(void);
+void BKE_data_transfer_remap_cache_free(struct DataTransferRemapCache *cache);
+/**
+ * The cached mapping of vertices, edges, corners or faces (\a index 0 to 3), empty when it has not
+ * been computed yet.
+ */
+const struct MeshPairRemap *BKE_data_transfer_remap_cache_get_map(
+    const struct DataTransferRemapCache *cache, int index);
+
+/**
+ * \param remap_cache: Optional, when given the geometry mappings are stored there and only
+ * recomputed when the meshes, their positions or the mapping settings changed.
+ */
 bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
                                  struct Object *ob_src,
                                  struct Object *ob_dst,
@@ -188,6 +208,7 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
                                  float mix_factor,
                                  const char *vgroup_name,
                                  bool invert_vgroup,
+                                 struct DataTransferRemapCache *remap_cache,
                                  struct ReportList *reports);
 
 #ifdef __cplusplus
@@ -8,9 +8,14 @@
  * \ingroup bke
  */
 
+#include "BLI_array.hh"
+#include "BLI_index_range.hh"
+#include "BLI_math_bits.h"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
 struct Depsgraph;
 struct ID;
-struct ListBase;
 struct Object;
 struct ParticleSystem;
 struct Scene;
@@ -23,21 +28,7 @@ struct GeometrySet;
 /* ---------------------------------------------------- */
 /* Dupli-Geometry */
 
-/**
- * \return a #ListBase of #DupliObject.
- */
-ListBase *object_duplilist(Depsgraph *depsgraph, Scene *sce, Object *ob);
-/**
- * \return a #ListBase of #DupliObject for the preview geometry referenced by the #ViewerPath.
- */
-ListBase *object_duplilist_preview(Depsgraph *depsgraph,
-                                   Scene *scene,
-                                   Object *ob,
-                                   const ViewerPath *viewer_path);
-void free_object_duplilist(ListBase *lb);
-
 struct DupliObject {
-  DupliObject *next, *prev;
   /* Object whose geometry is instanced. */
   Object *ob;
   /* Data owned by the object above that is instanced. This might not be the same as `ob->data`. */
@@ -74,6 +65,138 @@ struct DupliObject {
   unsigned int random_id;
 };
 
+namespace blender::bke {
+
+/**
+ * The #DupliObject generated for an object. Duplis are stored in chunks of growing size, so adding
+ * duplis never moves the existing ones and growing the list to millions of instances doesn't
+ * require copying it. Duplis can be accessed by index in constant time, which allows filling and
+ * reading them in parallel.
+ */
+class DupliList : NonCopyable, NonMovable {
+ private:
+  /** The first chunk has 2^first_chunk_size_log2 duplis, every following chunk twice as many. */
+  static constexpr int first_chunk_size_log2 = 4;
+
+  Vector<Array<DupliObject, 0>> chunks_;
+  int64_t size_ = 0;
+
+ public:
+  int64_t size() const
+  {
+    return size_;
+  }
+
+  bool is_empty() const
+  {
+    return size_ == 0;
+  }
+
+  IndexRange index_range() const
+  {
+    return IndexRange(size_);
+  }
+
+  DupliObject &operator[](const int64_t index)
+  {
+    BLI_assert(index >= 0 && index < size_);
+    /* Chunk `c` contains the indices [(2^c - 1) * first_size, (2^(c+1) - 1) * first_size). */
+    const uint64_t chunk_key = uint64_t(index >> first_chunk_size_log2) + 1;
+    BLI_assert(chunk_key <= UINT32_MAX);
+    const int chunk = 31 - int(bitscan_reverse_uint(uint(chunk_key)));
+    const int64_t chunk_start = ((int64_t(1) << chunk) - 1) << first_chunk_size_log2;
+    return chunks_[chunk][index - chunk_start];
+  }
+
+  const DupliObject &operator[](const int64_t index) const
+  {
+    return const_cast<DupliList &>(*this)[index];
+  }
+
+  /** Add a zero initialized dupli. */
+  DupliObject &append()
+  {
+    DupliObject &dob = (*this)[this->append_uninitialized(1).first()];
+    dob = {};
+    return dob;
+  }
+
+  /**
+   * Add \a n duplis without initializing them, which allows filling them in parallel.
+   * \return The indices of the new duplis.
+   */
+  IndexRange append_uninitialized(const int64_t n)
+  {
+    const IndexRange range(size_, n);
+    size_ += n;
+    while ((((int64_t(1) << chunks_.size()) - 1) << first_chunk_size_log2) < size_) {
+      const int64_t chunk_size = int64_t(1) << (chunks_.size() + first_chunk_size_log2);
+      chunks_.append(Array<DupliObject, 0>(chunk_size, NoInitialization()));
+    }
+    return range;
+  }
+
+  template<typename ListT, typename DupliT> class BaseIterator {
+   private:
+    ListT *list_;
+    int64_t index_;
+
+   public:
+    BaseIterator(ListT &list, const int64_t index) : list_(&list), index_(index) {}
+
+    BaseIterator &operator++()
+    {
+      index_++;
+      return *this;
+    }
+
+    DupliT &operator*() const
+    {
+      return (*list_)[index_];
+    }
+
+    friend bool operator!=(const BaseIterator &a, const BaseIterator &b)
+    {
+      return a.index_ != b.index_;
+    }
+  };
+
+  using Iterator = BaseIterator<DupliList, DupliObject>;
+  using ConstIterator = BaseIterator<const DupliList, const DupliObject>;
+
+  Iterator begin()
+  {
+    return Iterator(*this, 0);
+  }
+  Iterator end()
+  {
+    return Iterator(*this, size_);
+  }
+  ConstIterator begin() const
+  {
+    return ConstIterator(*this, 0);
+  }
+  ConstIterator end() const
+  {
+    return ConstIterator(*this, size_);
+  }
+};
+
+}  // namespace blender::bke
+
+/**
+ * \return the duplis of the object. Has to be freed with #free_object_duplilist.
+ */
+blender::bke::DupliList *object_duplilist(Depsgraph *depsgraph, Scene *sce, Object *ob);
+/**
+ * \return the duplis for the preview geometry referenced by the #ViewerPath.
+ */
+blender::bke::DupliList *object_duplilist_preview(Depsgraph *depsgraph,
+                                                 Scene *scene,
+                                                 Object *ob,
+                                                 const ViewerPath *viewer_path);
+void free_object_duplilist(blender::bke::DupliList *duplilist);
+
 /**
  * Look up the RGBA value of a uniform shader attribute.
  * \return true if the attribute was found; if not, r_value is also set to zero.
@@ -9,6 +9,7 @@
  */
 
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 #include "BLI_string_ref.hh"
 #include "DNA_curve_types.h"
 
@@ -601,6 +602,23 @@ void BKE_fcurve_correct_bezpart(const float v1[2], float v2[2], float v3[2], con
 /* evaluate fcurve */
 float evaluate_fcurve(FCurve *fcu, float evaltime);
 float evaluate_fcurve_only_curve(FCurve *fcu, float evaltime);
+/**
+ * Evaluate the F-Curve at all the given times, with the same result as calling
+ * #evaluate_fcurve_only_curve for every time. This is faster when many consecutive times are
+ * evaluated, e.g. one per frame, because the keyframe segment and the Bezier control points of
+ * the previous time are reused.
+ */
+void evaluate_fcurve_batch(FCurve *fcu,
+                           blender::Span<float> times,
+                           blender::MutableSpan<float> r_values);
+/**
+ * Same as #evaluate_fcurve_batch for multiple F-Curves, which are evaluated in parallel.
+ * \param r_values: The values of each curve are stored after each other, so its size has to be
+ * the number of curves times the number of times.
+ */
+void evaluate_fcurves_batch(blender::Span<FCurve *> fcurves,
+                            blender::Span<float> times,
+                            blender::MutableSpan<float> r_values);
 float evaluate_fcurve_driver(PathResolvedRNA *anim_rna,
                              FCurve *fcu,
                              ChannelDriver *driver_orig,
@@ -90,6 +90,17 @@ void BKE_lattice_deform_coords(const Object *ob_lattice,
                                const char *defgrp_name,
                                float fac);
 
+namespace blender::bke {
+/**
+ * The lattice cells of the vertices of a mesh, kept between evaluations (e.g. by the lattice
+ * modifier). Cells are only recomputed for vertices that moved, or when the lattice resolution or
+ * the transform between the lattice and the mesh changed.
+ */
+struct LatticeDeformBinding;
+LatticeDeformBinding *lattice_deform_binding_new();
+void lattice_deform_binding_free(LatticeDeformBinding *binding);
+}  // namespace blender::bke
+
 void BKE_lattice_deform_coords_with_mesh(const Object *ob_lattice,
                                          const Object *ob_target,
                                          float (*vert_coords)[3],
@@ -97,7 +108,8 @@ void BKE_lattice_deform_coords_with_mesh(const Object *ob_lattice,
                                          short flag,
                                          const char *defgrp_name,
                                          float fac,
-                                         const Mesh *me_target);
+                                         const Mesh *me_target,
+                                         blender::bke::LatticeDeformBinding *binding = nullptr);
 
 void BKE_lattice_deform_coords_with_editmesh(const Object *ob_lattice,
                                              const Object *ob_target,
@@ -392,6 +392,12 @@ size_t BKE_id_multi_delete(Main *bmain, blender::Set<ID *> &ids_to_delete);
  * Add a 'NO_MAIN' data-block to given main (also sets user-counts of its IDs if needed).
  */
 void BKE_libblock_management_main_add(Main *bmain, void *idv);
+/**
+ * Same as #BKE_libblock_management_main_add for many data-blocks at once, using faster batch
+ * unique naming. This allows e.g. importers to create 'NO_MAIN' data-blocks from multiple threads,
+ * and then add them all to Main at once.
+ */
+void BKE_libblock_management_main_add_multiple(Main *bmain, blender::Span<ID *> ids);
 /** Remove a data-block from given main (set it to 'NO_MAIN' status). */
 void BKE_libblock_management_main_remove(Main *bmain, void *idv);
 
@@ -606,6 +612,14 @@ bool BKE_id_new_name_validate(Main *bmain,
                               ID *id,
                               const char *name,
                               bool do_linked_data) ATTR_NONNULL(1, 2, 3);
+/**
+ * Same as #BKE_id_new_name_validate (using the current names of the IDs), for many IDs of the
+ * same type at once. See #BKE_main_namemap_get_names.
+ */
+void BKE_id_new_names_validate(Main *bmain,
+                               ListBase *lb,
+                               blender::Span<ID *> ids,
+                               bool do_linked_data) ATTR_NONNULL(1, 2);
 
 /**
  * Pull an ID out of a library (make it local). Only call this for IDs that
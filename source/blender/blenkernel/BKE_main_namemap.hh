@@ -19,6 +19,7 @@
  */
 
 #include "BLI_compiler_attrs.h"
+#include "BLI_span.hh"
 
 struct ID;
 struct Main;
@@ -49,6 +50,19 @@ void BKE_main_namemap_clear(Main *bmain) ATTR_NONNULL();
 bool BKE_main_namemap_get_name(Main *bmain, ID *id, char *name, const bool do_unique_in_bmain)
     ATTR_NONNULL();
 
+/**
+ * Ensures unique names for a batch of IDs, the names are adjusted directly in the IDs.
+ *
+ * The result is the same as calling #BKE_main_namemap_get_name on each ID in order (with
+ * `do_unique_in_bmain` set to `false`), except for names that have to be truncated. IDs with
+ * different base names are processed in parallel. This is intended for operations creating many
+ * IDs at once, like duplicating or importing data.
+ *
+ * All IDs must have the same type and library, and their current names must not be registered in
+ * the name map yet (e.g. newly added IDs).
+ */
+void BKE_main_namemap_get_names(Main *bmain, blender::Span<ID *> ids) ATTR_NONNULL(1);
+
 /**
  * Remove a given name from usage.
  *
@@ -44,6 +44,16 @@ void corner_tris_calc_with_normals(Span<float3> vert_positions,
                                    Span<int> corner_verts,
                                    Span<float3> face_normals,
                                    MutableSpan<int3> corner_tris);
+/**
+ * Only recalculate the triangles of the faces in \a face_mask, for example after some vertices
+ * were moved. The face normals may be empty, then they are calculated for n-gons as necessary.
+ */
+void corner_tris_calc_with_normals(Span<float3> vert_positions,
+                                   OffsetIndices<int> faces,
+                                   Span<int> corner_verts,
+                                   Span<float3> face_normals,
+                                   const IndexMask &face_mask,
+                                   MutableSpan<int3> corner_tris);
 
 void corner_tris_calc_face_indices(OffsetIndices<int> faces, MutableSpan<int> tri_faces);
 
@@ -87,6 +97,12 @@ void normals_calc_faces(Span<float3> vert_positions,
                         OffsetIndices<int> faces,
                         Span<int> corner_verts,
                         MutableSpan<float3> face_normals);
+/** Only recalculate the normals of the faces in \a face_mask. */
+void normals_calc_faces(Span<float3> vert_positions,
+                        OffsetIndices<int> faces,
+                        Span<int> corner_verts,
+                        const IndexMask &face_mask,
+                        MutableSpan<float3> face_normals);
 
 /**
  * Calculate vertex normals directly into the result array.
@@ -103,6 +119,17 @@ void normals_calc_verts(Span<float3> vert_positions,
                         GroupedSpan<int> vert_to_face_map,
                         Span<float3> face_normals,
                         MutableSpan<float3> vert_normals);
+/**
+ * Only recalculate the normals of the vertices in \a vert_mask. The normals of all faces using
+ * these vertices must be up to date.
+ */
+void normals_calc_verts(Span<float3> vert_positions,
+                        OffsetIndices<int> faces,
+                        Span<int> corner_verts,
+                        GroupedSpan<int> vert_to_face_map,
+                        Span<float3> face_normals,
+                        const IndexMask &vert_mask,
+                        MutableSpan<float3> vert_normals);
 
 /** \} */
 
@@ -183,6 +210,33 @@ void normals_calc_corners(Span<float3> vert_positions,
                           CornerNormalSpaceArray *r_lnors_spacearr,
                           MutableSpan<float3> r_corner_normals);
 
+/**
+ * Find the fans of face corners that share a normal. This is the part of #normals_calc_corners
+ * that doesn't depend on positions, so the result can be reused while a mesh deforms.
+ */
+void corner_normal_fans_calc(OffsetIndices<int> faces,
+                             Span<int> corner_verts,
+                             Span<int> corner_edges,
+                             Span<int> corner_to_face_map,
+                             Span<bool> sharp_edges,
+                             Span<bool> sharp_faces,
+                             int edges_num,
+                             CornerNormalFans &r_fans);
+
+/** Same as above, using fans calculated with #corner_normal_fans_calc. */
+void normals_calc_corners(Span<float3> vert_positions,
+                          Span<int2> edges,
+                          OffsetIndices<int> faces,
+                          Span<int> corner_verts,
+                          Span<int> corner_edges,
+                          Span<int> corner_to_face_map,
+                          Span<float3> vert_normals,
+                          Span<float3> face_normals,
+                          const CornerNormalFans &fans,
+                          const short2 *clnors_data,
+                          CornerNormalSpaceArray *r_lnors_spacearr,
+                          MutableSpan<float3> r_corner_normals);
+
 /**
  * \param sharp_faces: Optional array used to mark specific faces for sharp shading.
  */
@@ -94,6 +94,20 @@ struct LooseEdgeCache : public LooseGeomCache {};
  */
 struct LooseVertCache : public LooseGeomCache {};
 
+/**
+ * The fans of face corners that share a normal, used to calculate #Mesh::corner_normals().
+ * They only depend on the topology and the sharp edge and face attributes, so unlike the corner
+ * normals themselves they stay valid when positions change.
+ */
+struct CornerNormalFans {
+  /** The (up to) two corners using each edge, see #mesh::corner_normal_fans_calc. */
+  Array<int2> edge_to_corners;
+  /** Corners with sharp edges on both sides, their normal is the face normal. */
+  Array<int> single_corners;
+  /** The first corner of every smooth fan. */
+  Array<int> fan_corners;
+};
+
 struct MeshRuntime {
   /**
    * "Evaluated" mesh owned by this mesh. Used for objects which don't have effective modifiers, so
@@ -185,6 +199,8 @@ struct MeshRuntime {
   SharedCache<Vector<float3>> face_normals_cache;
   /** Lazily computed face corner normals (#Mesh::corner_normals()). */
   SharedCache<Vector<float3>> corner_normals_cache;
+  /** Smooth fans used to calculate corner normals, independent of positions. */
+  SharedCache<CornerNormalFans> corner_normal_fans_cache;
 
   /**
    * Cache of offsets for vert to face/corner maps. The same offsets array is used to group
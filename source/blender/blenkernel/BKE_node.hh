@@ -499,6 +499,10 @@ void ntreeFreeLocalTree(bNodeTree *ntree);
 bool ntreeContainsTree(const bNodeTree *tree_to_search_in, const bNodeTree *tree_to_search_for);
 
 void ntreeUpdateAllUsers(Main *main, ID *id);
+/**
+ * Same as above for many IDs at once, only iterating over all node trees a single time.
+ */
+void ntreeUpdateAllUsers(Main *main, blender::Span<ID *> ids);
 
 /**
  * XXX: old trees handle output flags automatically based on special output
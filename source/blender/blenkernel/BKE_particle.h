@@ -160,6 +160,11 @@ typedef struct ParticleThreadContext {
   float *vg_effector;
   float *vg_twist;
 
+  /* Data of parent particles shared by all of their children, indexed like `psys->particles`. */
+  float (*parent_hairmats)[4][4];
+  float (*parent_orcos)[3];
+  float (*parent_modifier_orcos)[3];
+
   struct CurveMapping *clumpcurve;
   struct CurveMapping *roughcurve;
   struct CurveMapping *twistcurve;
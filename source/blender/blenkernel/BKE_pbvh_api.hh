@@ -32,7 +32,6 @@
 
 struct BMLog;
 struct BMesh;
-struct CCGElem;
 struct CCGKey;
 struct CustomData;
 struct IsectRayPrecalc;
@@ -395,8 +394,9 @@ struct PBVHVertexIter {
 
   /* grid */
   CCGKey key;
-  CCGElem *const *grids;
-  CCGElem *grid;
+  blender::MutableSpan<blender::float3> grid_positions;
+  blender::Span<blender::float3> grid_normals;
+  blender::MutableSpan<float> grid_masks;
   const blender::BitGroupVector<> *grid_hidden;
   std::optional<blender::BoundedBitSpan> gh;
   const int *grid_indices;
@@ -436,11 +436,10 @@ void pbvh_vertex_iter_init(PBVH &pbvh, PBVHNode *node, PBVHVertexIter *vi, int m
   pbvh_vertex_iter_init(pbvh, node, &vi, mode); \
 \
   for (vi.i = 0, vi.g = 0; vi.g < vi.totgrid; vi.g++) { \
-    if (vi.grids) { \
+    if (!vi.grid_positions.is_empty()) { \
       vi.width = vi.gridsize; \
       vi.height = vi.gridsize; \
       vi.index = vi.vertex.i = vi.grid_indices[vi.g] * vi.key.grid_area - 1; \
-      vi.grid = CCG_elem_offset(&vi.key, vi.grids[vi.grid_indices[vi.g]], -1); \
       if (mode == PBVH_ITER_UNIQUE) { \
         if (vi.grid_hidden) { \
           vi.gh.emplace((*vi.grid_hidden)[vi.grid_indices[vi.g]]); \
@@ -457,13 +456,12 @@ void pbvh_vertex_iter_init(PBVH &pbvh, PBVHNode *node, PBVHVertexIter *vi, int m
 \
     for (vi.gy = 0; vi.gy < vi.height; vi.gy++) { \
       for (vi.gx = 0; vi.gx < vi.width; vi.gx++, vi.i++) { \
-        if (vi.grid) { \
-          vi.grid = CCG_elem_next(&vi.key, vi.grid); \
-          vi.co = CCG_elem_co(&vi.key, vi.grid); \
-          vi.fno = CCG_elem_no(&vi.key, vi.grid); \
-          vi.mask = vi.key.has_mask ? *CCG_elem_mask(&vi.key, vi.grid) : 0.0f; \
+        if (!vi.grid_positions.is_empty()) { \
           vi.index++; \
           vi.vertex.i++; \
+          vi.co = vi.grid_positions[vi.index]; \
+          vi.fno = vi.grid_normals[vi.index]; \
+          vi.mask = vi.key.has_mask ? vi.grid_masks[vi.index] : 0.0f; \
           vi.visible = true; \
           if (vi.gh) { \
             if ((*vi.gh)[vi.gy * vi.gridsize + vi.gx]) { \
@@ -573,7 +571,7 @@ Vector<PBVHNode *> search_gather(PBVH &pbvh,
 Vector<PBVHNode *> gather_proxies(PBVH &pbvh);
 
 void node_update_mask_mesh(Span<float> mask, PBVHNode &node);
-void node_update_mask_grids(const CCGKey &key, Span<CCGElem *> grids, PBVHNode &node);
+void node_update_mask_grids(const CCGKey &key, Span<float> masks, PBVHNode &node);
 void node_update_mask_bmesh(int mask_offset, PBVHNode &node);
 
 void node_update_visibility_mesh(Span<bool> hide_vert, PBVHNode &node);
@@ -581,7 +579,7 @@ void node_update_visibility_grids(const BitGroupVector<> &grid_hidden, PBVHNode
 void node_update_visibility_bmesh(PBVHNode &node);
 
 void update_node_bounds_mesh(Span<float3> positions, PBVHNode &node);
-void update_node_bounds_grids(const CCGKey &key, Span<CCGElem *> grids, PBVHNode &node);
+void update_node_bounds_grids(const CCGKey &key, Span<float3> positions, PBVHNode &node);
 void update_node_bounds_bmesh(PBVHNode &node);
 
 }  // namespace blender::bke::pbvh
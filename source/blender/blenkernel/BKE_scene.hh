@@ -12,10 +12,8 @@
 struct Base;
 struct Collection;
 struct Depsgraph;
-struct DupliObject;
 struct GHash;
 struct Main;
-struct ListBase;
 struct Object;
 struct RenderData;
 struct Scene;
@@ -26,6 +24,9 @@ struct TransformOrientationSlot;
 struct UnitSettings;
 struct View3DCursor;
 struct ViewLayer;
+namespace blender::bke {
+class DupliList;
+}
 
 enum eSceneCopyMethod {
   SCE_COPY_NEW = 0,
@@ -74,8 +75,9 @@ Object *BKE_scene_object_find_by_name(const Scene *scene, const char *name);
  * Define struct here, so no need to bother with alloc/free it.
  */
 struct SceneBaseIter {
-  ListBase *duplilist;
-  DupliObject *dupob;
+  blender::bke::DupliList *duplilist;
+  /** Index of the next dupli in #duplilist. */
+  int64_t dupob_index;
   float omat[4][4];
   Object *dupli_refob;
   int phase;
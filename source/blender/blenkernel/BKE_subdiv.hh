@@ -160,6 +160,9 @@ struct Subdiv {
    * topology to OpenSubdiv. It can be shared by both evaluator and GL mesh
    * drawer. */
   OpenSubdiv_TopologyRefiner *topology_refiner;
+  /* Hash of the mesh data the topology refiner was created from, used to skip the comparison of
+   * the topology when updating from a mesh. Zero when unknown. */
+  uint64_t topology_hash;
   /* CPU side evaluator. */
   OpenSubdiv_Evaluator *evaluator;
   /* Optional displacement evaluator. */
@@ -13,13 +13,14 @@
 #include "BLI_array.hh"
 #include "BLI_bit_group_vector.hh"
 #include "BLI_index_mask_fwd.hh"
+#include "BLI_math_vector_types.hh"
 #include "BLI_offset_indices.hh"
 #include "BLI_sys_types.h"
 
 #include "BKE_DerivedMesh.hh"
+#include "BKE_ccg.h"
 
 struct CCGElem;
-struct CCGKey;
 struct Mesh;
 namespace blender::bke::subdiv {
 struct Subdiv;
@@ -97,18 +98,18 @@ struct SubdivCCG {
   /* Resolution of grid. All grids have matching resolution, and resolution
    * is same as ptex created for non-quad faces. */
   int grid_size = -1;
-  /* Size of a single element of a grid (including coordinate and all the other layers).
-   * Measured in bytes. */
-  int grid_element_size = -1;
-  /* Grids represent limit surface, with displacement applied. Grids are
-   * corresponding to face-corners of coarse mesh, each grid has
-   * grid_size^2 elements.
+  /* Number of grids, which correspond to face-corners of the coarse mesh. */
+  int grids_num = -1;
+  /* Grids represent limit surface, with displacement applied. Each grid has
+   * grid_size^2 elements. Every layer of the elements is stored in its own array, with the
+   * elements of one grid stored contiguously, see #CCG_grid_range and #CCG_elem_index.
    */
-  /* Indexed by a grid index, points to a grid data which is stored in
-   * grids_storage. */
-  blender::Array<CCGElem *> grids;
-  /* Flat array of all grids' data. */
-  blender::Array<uchar> grids_storage;
+  /* Element positions. */
+  blender::Array<blender::float3> positions;
+  /* Element normals, only allocated if #has_normal is true. */
+  blender::Array<blender::float3> normals;
+  /* Element paint mask values, only allocated if #has_mask is true. */
+  blender::Array<float> masks;
   /* Loose edges, each array element contains grid_size elements
    * corresponding to vertices created by subdividing coarse edges. */
   CCGElem **edges = nullptr;
@@ -125,9 +126,6 @@ struct SubdivCCG {
    */
   bool has_normal = false;
   bool has_mask = false;
-  /* Offsets of corresponding data layers in the elements. */
-  int normal_offset = -1;
-  int mask_offset = -1;
 
   /* Faces from which grids are emitted. Owned by base mesh. */
   blender::OffsetIndices<int> faces;
@@ -201,6 +199,24 @@ Mesh *BKE_subdiv_to_ccg_mesh(blender::bke::subdiv::Subdiv &subdiv,
 CCGKey BKE_subdiv_ccg_key(const SubdivCCG &subdiv_ccg, int level);
 CCGKey BKE_subdiv_ccg_key_top_level(const SubdivCCG &subdiv_ccg);
 
+/* Range of the elements of a grid in the #SubdivCCG element arrays, for a top level key. */
+inline blender::IndexRange CCG_grid_range(const CCGKey &key, const int grid_index)
+{
+  return blender::IndexRange(grid_index * key.grid_area, key.grid_area);
+}
+
+/* Index of the element at the given coordinate within a grid. */
+inline int CCG_grid_xy_to_index(const int grid_size, const int x, const int y)
+{
+  return y * grid_size + x;
+}
+
+/* Index of the element in the #SubdivCCG element arrays, for a top level key. */
+inline int CCG_elem_index(const CCGKey &key, const SubdivCCGCoord &coord)
+{
+  return coord.grid_index * key.grid_area + CCG_grid_xy_to_index(key.grid_size, coord.x, coord.y);
+}
+
 /* Recalculate all normals based on grid element coordinates. */
 void BKE_subdiv_ccg_recalc_normals(SubdivCCG &subdiv_ccg);
 
@@ -26,6 +26,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector_types.hh"
+#include "BLI_profile.hh"
 #include "BLI_span.hh"
 #include "BLI_task.h"
 #include "BLI_task.hh"
@@ -552,6 +553,7 @@ static void mesh_calc_modifiers(Depsgraph *depsgraph,
                                 GeometrySet **r_geometry_set)
 {
   using namespace blender::bke;
+  PROFILE_SCOPE_DETAIL("Mesh Modifier Stack", ob->id.name + 2);
   /* Input mesh shouldn't be modified. */
   Mesh *mesh_input = (Mesh *)ob->data;
   /* The final mesh is the result of calculating all enabled modifiers. */
@@ -1015,6 +1017,7 @@ static void editbmesh_calc_modifiers(Depsgraph *depsgraph,
                                      Mesh **r_final,
                                      GeometrySet **r_geometry_set)
 {
+  PROFILE_SCOPE_DETAIL("Edit Mesh Modifier Stack", ob->id.name + 2);
   Mesh *mesh_input = (Mesh *)ob->data;
   BMEditMesh *em_input = mesh_input->runtime->edit_mesh.get();
 
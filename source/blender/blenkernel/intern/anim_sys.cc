@@ -23,6 +23,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -885,6 +886,128 @@ void animsys_blend_in_action(PointerRNA *ptr,
   animsys_blend_in_fcurves(ptr, &act->curves, anim_eval_context, blend_factor);
 }
 
+/* ----------------------------------------- */
+
+/**
+ * An F-Curve of the active action, with its resolved RNA path.
+ */
+struct AnimDataEvalPlanChannel {
+  FCurve *fcu;
+  /** Paths that failed to resolve are not cached, they are resolved again on every evaluation. */
+  bool is_resolved = false;
+  bool is_orig_resolved = false;
+  PathResolvedRNA anim_rna;
+  PathResolvedRNA orig_anim_rna;
+};
+
+/**
+ * Resolving RNA paths is the most expensive part of evaluating an action with many F-Curves,
+ * so the resolved paths of the active action are stored in the evaluated #AnimData.
+ *
+ * The plan is only used for evaluated copies of IDs, and must not outlive any data its resolved
+ * pointers point to:
+ * - A copy-on-evaluation update of the ID re-creates the evaluated copy together with its
+ *   #AnimData, which frees the plan. The plan is also rebuilt when the evaluated ID is tagged
+ *   for such an update.
+ * - A relations update of the dependency graph frees the plans of all its IDs, since the
+ *   original data (pose channels, modifiers, ...) might have been re-allocated.
+ * - A change of the action is detected through its recalc flags, which are set while the
+ *   updated action is evaluated.
+ */
+struct AnimDataEvalPlan {
+  /** The plan is only valid for the ID and action it was built for. */
+  const ID *id = nullptr;
+  const bAction *action = nullptr;
+  /** Whether #ptr_orig is set, for flushing values back to the original ID. */
+  bool has_orig_ptr = false;
+  PointerRNA ptr_orig;
+  blender::Vector<AnimDataEvalPlanChannel> channels;
+};
+
+void BKE_animsys_free_eval_plan(AnimData *adt)
+{
+  MEM_delete(adt->eval_plan);
+  adt->eval_plan = nullptr;
+}
+
+static bool animsys_eval_plan_is_valid(const ID *id,
+                                       const AnimData *adt,
+                                       const bool flush_to_original)
+{
+  const AnimDataEvalPlan *plan = adt->eval_plan;
+  if (plan == nullptr || plan->id != id || plan->action != adt->action) {
+    return false;
+  }
+  if (adt->action->id.recalc != 0 || (id->recalc & ID_RECALC_SYNC_TO_EVAL)) {
+    return false;
+  }
+  return plan->has_orig_ptr || !flush_to_original;
+}
+
+static void animsys_eval_plan_build(PointerRNA *id_ptr,
+                                    AnimData *adt,
+                                    const bool flush_to_original)
+{
+  BKE_animsys_free_eval_plan(adt);
+  AnimDataEvalPlan *plan = MEM_new<AnimDataEvalPlan>(__func__);
+  plan->id = id_ptr->owner_id;
+  plan->action = adt->action;
+  plan->has_orig_ptr = flush_to_original &&
+                       animsys_construct_orig_pointer_rna(id_ptr, &plan->ptr_orig);
+
+  LISTBASE_FOREACH (FCurve *, fcu, &adt->action->curves) {
+    if (!is_fcurve_evaluatable(fcu)) {
+      continue;
+    }
+    AnimDataEvalPlanChannel channel;
+    channel.fcu = fcu;
+    plan->channels.append(channel);
+  }
+  adt->eval_plan = plan;
+}
+
+/**
+ * Same as #animsys_evaluate_action for the active action of an evaluated ID, but using the
+ * cached #AnimDataEvalPlan instead of resolving the RNA path of every F-Curve.
+ */
+static void animsys_evaluate_action_with_plan(PointerRNA *id_ptr,
+                                              AnimData *adt,
+                                              const AnimationEvalContext *anim_eval_context,
+                                              const bool flush_to_original)
+{
+  ID *id = id_ptr->owner_id;
+  action_idcode_patch_check(id, adt->action);
+
+  if (!animsys_eval_plan_is_valid(id, adt, flush_to_original)) {
+    animsys_eval_plan_build(id_ptr, adt, flush_to_original);
+  }
+
+  AnimDataEvalPlan *plan = adt->eval_plan;
+  for (AnimDataEvalPlanChannel &channel : plan->channels) {
+    FCurve *fcu = channel.fcu;
+    if (!channel.is_resolved) {
+      channel.is_resolved = BKE_animsys_rna_path_resolve(
+          id_ptr, fcu->rna_path, fcu->array_index, &channel.anim_rna);
+      if (!channel.is_resolved) {
+        continue;
+      }
+    }
+    const float curval = calculate_fcurve(&channel.anim_rna, fcu, anim_eval_context);
+    BKE_animsys_write_to_rna_path(&channel.anim_rna, curval);
+    if (!flush_to_original || !plan->has_orig_ptr) {
+      continue;
+    }
+    if (!channel.is_orig_resolved) {
+      channel.is_orig_resolved = BKE_animsys_rna_path_resolve(
+          &plan->ptr_orig, fcu->rna_path, fcu->array_index, &channel.orig_anim_rna);
+      if (!channel.is_orig_resolved) {
+        continue;
+      }
+    }
+    BKE_animsys_write_to_rna_path(&channel.orig_anim_rna, curval);
+  }
+}
+
 /* ***************************************** */
 /* NLA System - Evaluation */
 
@@ -3945,7 +4068,12 @@ void BKE_animsys_evaluate_animdata(ID *id,
       }
       /* evaluate Active Action only */
       else if (adt->action) {
-        animsys_evaluate_action(&id_ptr, adt->action, anim_eval_context, flush_to_original);
+        if ((id->tag & LIB_TAG_COPIED_ON_EVAL) && BKE_animdata_from_id(id) == adt) {
+          animsys_evaluate_action_with_plan(&id_ptr, adt, anim_eval_context, flush_to_original);
+        }
+        else {
+          animsys_evaluate_action(&id_ptr, adt->action, anim_eval_context, flush_to_original);
+        }
       }
     }
   }
@@ -0,0 +1,176 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "CLG_log.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_anim_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BLI_listbase.h"
+#include "BLI_string.h"
+
+#include "BKE_action.h"
+#include "BKE_anim_data.hh"
+#include "BKE_fcurve.hh"
+#include "BKE_idprop.hh"
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_main.hh"
+#include "BKE_object.hh"
+#include "BKE_scene.hh"
+
+#include "ANIM_fcurve.hh"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_query.hh"
+
+namespace blender::bke::tests {
+
+class AnimSysEvalPlanTest : public testing::Test {
+ public:
+  Main *bmain = nullptr;
+  Scene *scene = nullptr;
+  ViewLayer *view_layer = nullptr;
+  Depsgraph *depsgraph = nullptr;
+  Object *ob = nullptr;
+  bAction *action = nullptr;
+
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+    DEG_register_node_types();
+  }
+
+  static void TearDownTestSuite()
+  {
+    DEG_free_node_types();
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+    scene = BKE_scene_add(bmain, "Scene");
+    view_layer = static_cast<ViewLayer *>(scene->view_layers.first);
+    ob = BKE_object_add(bmain, scene, view_layer, OB_EMPTY, "Empty");
+    action = BKE_action_add(bmain, "Action");
+    AnimData *adt = BKE_animdata_ensure_id(&ob->id);
+    adt->action = action;
+    id_us_plus(&action->id);
+  }
+
+  void TearDown() override
+  {
+    if (depsgraph) {
+      DEG_graph_free(depsgraph);
+    }
+    BKE_main_free(bmain);
+  }
+
+  /** Add an F-Curve going linearly from 0 at frame 1 to 10 at frame 11. */
+  FCurve *add_fcurve(const char *rna_path, const int array_index)
+  {
+    FCurve *fcu = BKE_fcurve_create();
+    fcu->rna_path = BLI_strdup(rna_path);
+    fcu->array_index = array_index;
+    const animrig::KeyframeSettings settings = animrig::get_keyframe_settings(false);
+    animrig::insert_vert_fcurve(fcu, {1.0f, 0.0f}, settings, INSERTKEY_NOFLAGS);
+    animrig::insert_vert_fcurve(fcu, {11.0f, 10.0f}, settings, INSERTKEY_NOFLAGS);
+    fcu->bezt[0].ipo = BEZT_IPO_LIN;
+    fcu->bezt[1].ipo = BEZT_IPO_LIN;
+    BLI_addtail(&action->curves, fcu);
+    return fcu;
+  }
+
+  void evaluate_frame(const int frame)
+  {
+    scene->r.cfra = frame;
+    if (depsgraph == nullptr) {
+      depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
+      DEG_graph_build_from_view_layer(depsgraph);
+      BKE_scene_graph_update_tagged(depsgraph, bmain);
+    }
+    BKE_scene_graph_update_for_newframe(depsgraph);
+  }
+
+  Object *ob_eval()
+  {
+    return DEG_get_evaluated_object(depsgraph, ob);
+  }
+
+  const AnimDataEvalPlan *eval_plan()
+  {
+    return BKE_animdata_from_id(&ob_eval()->id)->eval_plan;
+  }
+};
+
+TEST_F(AnimSysEvalPlanTest, PlanIsReused)
+{
+  add_fcurve("location", 0);
+
+  evaluate_frame(6);
+  EXPECT_FLOAT_EQ(ob_eval()->loc[0], 5.0f);
+  const AnimDataEvalPlan *plan = eval_plan();
+  EXPECT_NE(plan, nullptr);
+
+  evaluate_frame(8);
+  EXPECT_FLOAT_EQ(ob_eval()->loc[0], 7.0f);
+  EXPECT_EQ(eval_plan(), plan);
+}
+
+TEST_F(AnimSysEvalPlanTest, RelationsUpdateFreesPlan)
+{
+  add_fcurve("location", 0);
+
+  evaluate_frame(6);
+  EXPECT_NE(eval_plan(), nullptr);
+
+  /* The original data the plan points to might be re-allocated by a relations update. */
+  DEG_relations_tag_update(bmain);
+  DEG_graph_relations_update(depsgraph);
+  EXPECT_EQ(eval_plan(), nullptr);
+
+  evaluate_frame(8);
+  EXPECT_FLOAT_EQ(ob_eval()->loc[0], 7.0f);
+}
+
+TEST_F(AnimSysEvalPlanTest, ActionUpdateRebuildsPlan)
+{
+  FCurve *fcu = add_fcurve("location", 0);
+
+  evaluate_frame(6);
+  EXPECT_FLOAT_EQ(ob_eval()->loc[0], 5.0f);
+
+  MEM_freeN(fcu->rna_path);
+  fcu->rna_path = BLI_strdup("scale");
+  DEG_id_tag_update(&action->id, ID_RECALC_ANIMATION);
+
+  evaluate_frame(8);
+  EXPECT_FLOAT_EQ(ob_eval()->scale[0], 7.0f);
+}
+
+TEST_F(AnimSysEvalPlanTest, UnresolvedPathIsRetried)
+{
+  add_fcurve("[\"prop\"]", 0);
+
+  evaluate_frame(6);
+  EXPECT_NE(eval_plan(), nullptr);
+
+  /* The property did not exist when the plan was built, it must still be animated once it
+   * exists without the plan being rebuilt. */
+  IDProperty *prop = bke::idprop::create("prop", 0.0f).release();
+  IDP_AddToGroup(IDP_EnsureProperties(&ob_eval()->id), prop);
+
+  evaluate_frame(8);
+  EXPECT_FLOAT_EQ(IDP_Float(prop), 7.0f);
+}
+
+}  // namespace blender::bke::tests
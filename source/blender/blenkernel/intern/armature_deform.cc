@@ -14,14 +14,19 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_offset_indices.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_armature_types.h"
@@ -229,6 +234,115 @@ static void pchan_bone_deform(const bPoseChannel *pchan,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Armature Deform Weights Cache
+ *
+ * The weights of every vertex are stored in a separate allocation in #MDeformVert, which makes
+ * iterating over them slow for large meshes. The cache stores the same weights contiguously, in
+ * the same order, and is reused as long as the vertex group data of the mesh is not changed.
+ * \{ */
+
+namespace blender::bke {
+
+struct ArmatureDeformWeightsCache {
+  /** Used when the same modifier is evaluated from multiple threads, e.g. for crazy-space. */
+  std::mutex mutex;
+
+  /** The vertex group layer the weights were built from, with a weak user. */
+  const ImplicitSharingInfo *sharing_info = nullptr;
+  int64_t sharing_info_version = 0;
+  const MDeformVert *dverts = nullptr;
+
+  /** Range of every vertex in the arrays below. */
+  Array<int> offsets;
+  /** #MDeformWeight::def_nr. */
+  Array<int> groups;
+  Array<float> weights;
+
+  ~ArmatureDeformWeightsCache()
+  {
+    this->clear();
+  }
+
+  void clear()
+  {
+    if (sharing_info) {
+      sharing_info->remove_weak_user_and_delete_if_last();
+      sharing_info = nullptr;
+    }
+    dverts = nullptr;
+    offsets = {};
+    groups = {};
+    weights = {};
+  }
+};
+
+ArmatureDeformWeightsCache *armature_deform_weights_cache_new()
+{
+  return MEM_new<ArmatureDeformWeightsCache>(__func__);
+}
+
+void armature_deform_weights_cache_free(ArmatureDeformWeightsCache *cache)
+{
+  MEM_delete(cache);
+}
+
+/**
+ * Make sure the cache contains the weights of the mesh.
+ * \return False when the weights can't be cached because their changes can't be detected.
+ */
+static bool armature_deform_weights_cache_ensure(ArmatureDeformWeightsCache &cache,
+                                                 const Mesh &mesh)
+{
+  const int layer_index = CustomData_get_layer_index(&mesh.vert_data, CD_MDEFORMVERT);
+  if (layer_index == -1) {
+    return false;
+  }
+  const CustomDataLayer &layer = mesh.vert_data.layers[layer_index];
+  const ImplicitSharingInfo *sharing_info = layer.sharing_info;
+  if (sharing_info == nullptr) {
+    return false;
+  }
+  const Span<MDeformVert> dverts(static_cast<const MDeformVert *>(layer.data), mesh.verts_num);
+
+  if (cache.sharing_info == sharing_info &&
+      cache.sharing_info_version == sharing_info->version() && cache.dverts == dverts.data() &&
+      cache.offsets.size() == dverts.size() + 1)
+  {
+    return true;
+  }
+
+  cache.clear();
+  cache.sharing_info = sharing_info;
+  cache.sharing_info_version = sharing_info->version();
+  sharing_info->add_weak_user();
+  cache.dverts = dverts.data();
+
+  cache.offsets.reinitialize(dverts.size() + 1);
+  for (const int i : dverts.index_range()) {
+    cache.offsets[i] = dverts[i].totweight;
+  }
+  const OffsetIndices<int> offsets = offset_indices::accumulate_counts_to_offsets(cache.offsets);
+
+  cache.groups.reinitialize(offsets.total_size());
+  cache.weights.reinitialize(offsets.total_size());
+  threading::parallel_for(dverts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const Span<MDeformWeight> dws(dverts[i].dw, dverts[i].totweight);
+      const IndexRange dst = offsets[i];
+      for (const int j : dws.index_range()) {
+        cache.groups[dst[j]] = dws[j].def_nr;
+        cache.weights[dst[j]] = dws[j].weight;
+      }
+    }
+  });
+  return true;
+}
+
+}  // namespace blender::bke
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Armature Deform #BKE_armature_deform_coords API
  *
@@ -252,6 +366,11 @@ struct ArmatureUserdata {
   const MDeformVert *dverts;
   int dverts_len;
 
+  /** Optional contiguous copy of the weights in #dverts, see #ArmatureDeformWeightsCache. */
+  const int *weight_offsets;
+  const int *weight_groups;
+  const float *weights;
+
   bPoseChannel **pchan_from_defbase;
   int defbase_len;
 
@@ -339,13 +458,9 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   mul_m4_v3(data->premat, co);
 
   if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
-    const MDeformWeight *dw = dvert->dw;
     int deformed = 0;
-    uint j;
-    for (j = dvert->totweight; j != 0; j--, dw++) {
-      const uint index = dw->def_nr;
+    auto deform_by_group = [&](const uint index, float weight) {
       if (index < data->defbase_len && (pchan = data->pchan_from_defbase[index])) {
-        float weight = dw->weight;
         const Bone *bone = pchan->bone;
 
         deformed = 1;
@@ -357,6 +472,17 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
 
         pchan_bone_deform(pchan, weight, vec, dq, smat, co, full_deform, &contrib);
       }
+    };
+    if (data->weight_offsets) {
+      for (int j = data->weight_offsets[i]; j < data->weight_offsets[i + 1]; j++) {
+        deform_by_group(uint(data->weight_groups[j]), data->weights[j]);
+      }
+    }
+    else {
+      const MDeformWeight *dw = dvert->dw;
+      for (uint j = dvert->totweight; j != 0; j--, dw++) {
+        deform_by_group(dw->def_nr, dw->weight);
+      }
     }
     /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
     if (deformed == 0 && use_envelope) {
@@ -490,7 +616,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
                                         blender::Span<MDeformVert> dverts,
                                         const Mesh *me_target,
                                         BMEditMesh *em_target,
-                                        bGPDstroke *gps_target)
+                                        bGPDstroke *gps_target,
+                                        blender::bke::ArmatureDeformWeightsCache *weights_cache)
 {
   const bArmature *arm = static_cast<const bArmature *>(ob_arm->data);
   bPoseChannel **pchan_from_defbase = nullptr;
@@ -594,6 +721,16 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   data.defbase_len = defbase_len;
   data.bmesh.cd_dvert_offset = cd_dvert_offset;
 
+  std::unique_lock<std::mutex> weights_cache_lock;
+  if (weights_cache && use_dverts && me_target && em_target == nullptr) {
+    weights_cache_lock = std::unique_lock(weights_cache->mutex);
+    if (blender::bke::armature_deform_weights_cache_ensure(*weights_cache, *me_target)) {
+      data.weight_offsets = weights_cache->offsets.data();
+      data.weight_groups = weights_cache->groups.data();
+      data.weights = weights_cache->weights.data();
+    }
+  }
+
   float obinv[4][4];
   invert_m4_m4(obinv, ob_target->object_to_world().ptr());
 
@@ -650,7 +787,8 @@ void BKE_armature_deform_coords_with_gpencil_stroke(const Object *ob_arm,
                               {},
                               nullptr,
                               nullptr,
-                              gps_target);
+                              gps_target,
+                              nullptr);
 }
 
 void BKE_armature_deform_coords_with_curves(
@@ -675,6 +813,7 @@ void BKE_armature_deform_coords_with_curves(
       dverts,
       nullptr,
       nullptr,
+      nullptr,
       nullptr);
 }
 
@@ -686,7 +825,8 @@ void BKE_armature_deform_coords_with_mesh(const Object *ob_arm,
                                           int deformflag,
                                           float (*vert_coords_prev)[3],
                                           const char *defgrp_name,
-                                          const Mesh *me_target)
+                                          const Mesh *me_target,
+                                          blender::bke::ArmatureDeformWeightsCache *weights_cache)
 {
   armature_deform_coords_impl(ob_arm,
                               ob_target,
@@ -699,7 +839,8 @@ void BKE_armature_deform_coords_with_mesh(const Object *ob_arm,
                               {},
                               me_target,
                               nullptr,
-                              nullptr);
+                              nullptr,
+                              weights_cache);
 }
 
 void BKE_armature_deform_coords_with_editmesh(const Object *ob_arm,
@@ -723,6 +864,7 @@ void BKE_armature_deform_coords_with_editmesh(const Object *ob_arm,
                               {},
                               nullptr,
                               em_target,
+                              nullptr,
                               nullptr);
 }
 
@@ -27,6 +27,7 @@
 #include "BKE_blender_user_menu.hh" /* own include */
 #include "BKE_blender_version.h"    /* own include */
 #include "BKE_brush.hh"
+#include "BKE_bvhutils.hh"
 #include "BKE_cachefile.hh"
 #include "BKE_callbacks.hh"
 #include "BKE_global.hh"
@@ -60,6 +61,9 @@ void BKE_blender_free()
 
   BKE_blender_globals_clear();
 
+  /* After freeing main, freed meshes may have kept their BVH trees for reuse. */
+  bvhcache_free_unused_trees();
+
   if (G.log.file != nullptr) {
     fclose(static_cast<FILE *>(G.log.file));
   }
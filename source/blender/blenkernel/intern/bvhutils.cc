@@ -6,20 +6,32 @@
  * \ingroup bke
  */
 
+#include <array>
+#include <memory>
+#include <mutex>
+#include <optional>
+
 #include "DNA_meshdata_types.h"
 #include "DNA_pointcloud_types.h"
 
+#include "BLI_implicit_sharing.hh"
 #include "BLI_math_geom.h"
+#include "BLI_struct_equality_utils.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_bvhutils.hh"
+#include "BKE_customdata.hh"
 #include "BKE_editmesh.hh"
 #include "BKE_mesh.hh"
+#include "BKE_mesh_types.hh"
 
 using blender::BitSpan;
 using blender::BitVector;
 using blender::float3;
+using blender::ImplicitSharingInfo;
 using blender::IndexRange;
 using blender::int3;
 using blender::Span;
@@ -29,11 +41,244 @@ using blender::VArray;
 /** \name BVHCache
  * \{ */
 
-struct BVHCacheItem {
-  bool is_filled;
+/**
+ * Identifies an array of mesh data by its implicit sharing info. The sharing info is kept alive
+ * with a weak user while the key is stored, so that its address is not reused for other data.
+ */
+struct BVHCacheDataKey {
+  const ImplicitSharingInfo *sharing_info = nullptr;
+  int64_t version = 0;
+  int64_t size = 0;
+
+  BLI_STRUCT_EQUALITY_OPERATORS_3(BVHCacheDataKey, sharing_info, version, size)
+};
+
+/**
+ * The mesh data a tree was built from. Trees whose mesh was freed are kept in a small global
+ * cache, so that a mesh with the same data can reuse them. That is the case for evaluated meshes
+ * that are recreated every frame or in multiple dependency graphs: they usually reference the
+ * topology arrays of the original mesh. When only the positions differ, the tree is refit instead
+ * of built from scratch.
+ */
+struct BVHCacheKey {
+  BVHCacheType type;
+  int tree_type;
+  BVHCacheDataKey positions;
+  BVHCacheDataKey edges;
+  BVHCacheDataKey corner_verts;
+  BVHCacheDataKey face_offsets;
+};
+
+static std::array<const BVHCacheDataKey *, 4> bvhcache_key_data(const BVHCacheKey &key)
+{
+  return {&key.positions, &key.edges, &key.corner_verts, &key.face_offsets};
+}
+
+static void bvhcache_key_add_weak_users(const BVHCacheKey &key)
+{
+  for (const BVHCacheDataKey *data : bvhcache_key_data(key)) {
+    if (data->sharing_info) {
+      data->sharing_info->add_weak_user();
+    }
+  }
+}
+
+static void bvhcache_key_remove_weak_users(const BVHCacheKey &key)
+{
+  for (const BVHCacheDataKey *data : bvhcache_key_data(key)) {
+    if (data->sharing_info) {
+      data->sharing_info->remove_weak_user_and_delete_if_last();
+    }
+  }
+}
+
+/** The tree can only be reused for a mesh with the same topology when the topology is known. */
+static bool bvhcache_key_has_topology(const BVHCacheKey &key)
+{
+  return key.edges.sharing_info || key.corner_verts.sharing_info || key.face_offsets.sharing_info;
+}
+
+static bool bvhcache_key_topology_equal(const BVHCacheKey &a, const BVHCacheKey &b)
+{
+  return a.type == b.type && a.tree_type == b.tree_type && a.positions.size == b.positions.size &&
+         a.edges == b.edges && a.corner_verts == b.corner_verts &&
+         a.face_offsets == b.face_offsets;
+}
+
+/** No mesh can have the same topology anymore once all of the topology arrays were freed. */
+static bool bvhcache_key_is_expired(const BVHCacheKey &key)
+{
+  for (const BVHCacheDataKey *data : {&key.edges, &key.corner_verts, &key.face_offsets}) {
+    if (data->sharing_info && !data->sharing_info->is_expired()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static BVHCacheDataKey layer_data_key(const CustomData &data,
+                                      const eCustomDataType type,
+                                      const char *name,
+                                      const int size)
+{
+  const int layer_index = CustomData_get_named_layer_index(&data, type, name);
+  if (layer_index == -1) {
+    return {nullptr, 0, size};
+  }
+  const ImplicitSharingInfo *sharing_info = data.layers[layer_index].sharing_info;
+  return {sharing_info, sharing_info ? sharing_info->version() : 0, size};
+}
+
+/**
+ * \return The key for the given tree, or nothing when trees of that type depend on more data
+ * than the positions and topology, or when the data is not implicitly shared.
+ */
+static std::optional<BVHCacheKey> bvhcache_key_from_mesh(const Mesh &mesh,
+                                                         const BVHCacheType type,
+                                                         const int tree_type)
+{
+  if (!ELEM(type,
+            BVHTREE_FROM_VERTS,
+            BVHTREE_FROM_EDGES,
+            BVHTREE_FROM_CORNER_TRIS,
+            BVHTREE_FROM_LOOSEVERTS,
+            BVHTREE_FROM_LOOSEEDGES))
+  {
+    return std::nullopt;
+  }
+  const ImplicitSharingInfo *face_offsets_info = mesh.runtime->face_offsets_sharing_info;
+  BVHCacheKey key;
+  key.type = type;
+  key.tree_type = tree_type;
+  key.positions = layer_data_key(mesh.vert_data, CD_PROP_FLOAT3, "position", mesh.verts_num);
+  key.edges = layer_data_key(mesh.edge_data, CD_PROP_INT32_2D, ".edge_verts", mesh.edges_num);
+  key.corner_verts = layer_data_key(
+      mesh.corner_data, CD_PROP_INT32, ".corner_vert", mesh.corners_num);
+  key.face_offsets = {face_offsets_info,
+                      face_offsets_info ? face_offsets_info->version() : 0,
+                      mesh.faces_num};
+  for (const BVHCacheDataKey *data : bvhcache_key_data(key)) {
+    if (data->size > 0 && data->sharing_info == nullptr) {
+      return std::nullopt;
+    }
+  }
+  return key;
+}
+
+/* Trees are relatively large, only keep a few of them around. */
+#define BVHCACHE_UNUSED_TREES_MAX 16
+
+struct BVHCacheUnusedTree {
+  BVHCacheKey key;
   BVHTree *tree;
 };
 
+/** Trees of freed caches that may be reused, the least recently added tree comes first. */
+struct BVHCacheUnusedTrees {
+  std::mutex mutex;
+  blender::Vector<BVHCacheUnusedTree> trees;
+};
+
+static BVHCacheUnusedTrees &get_unused_trees()
+{
+  static BVHCacheUnusedTrees unused_trees;
+  return unused_trees;
+}
+
+static void bvhcache_unused_tree_free(BVHCacheUnusedTree &unused_tree)
+{
+  bvhcache_key_remove_weak_users(unused_tree.key);
+  BLI_bvhtree_free(unused_tree.tree);
+}
+
+/** Takes ownership of the tree and the weak users of the key. */
+static void bvhcache_unused_tree_add(const BVHCacheKey &key, BVHTree *tree)
+{
+  BVHCacheUnusedTrees &unused_trees = get_unused_trees();
+  std::lock_guard lock{unused_trees.mutex};
+  for (int64_t i = unused_trees.trees.size() - 1; i >= 0; i--) {
+    if (bvhcache_key_is_expired(unused_trees.trees[i].key)) {
+      bvhcache_unused_tree_free(unused_trees.trees[i]);
+      unused_trees.trees.remove(i);
+    }
+  }
+  if (unused_trees.trees.size() == BVHCACHE_UNUSED_TREES_MAX) {
+    bvhcache_unused_tree_free(unused_trees.trees.first());
+    unused_trees.trees.remove(0);
+  }
+  unused_trees.trees.append({key, tree});
+}
+
+/**
+ * Take a tree that was built for the same data out of the unused trees. Trees built for the same
+ * positions are preferred, otherwise \a r_needs_refit is set when the tree was built for the same
+ * topology with different positions.
+ */
+static BVHTree *bvhcache_unused_tree_take(const BVHCacheKey &key, bool &r_needs_refit)
+{
+  BVHCacheUnusedTrees &unused_trees = get_unused_trees();
+  std::lock_guard lock{unused_trees.mutex};
+  auto take = [&](const int64_t i) {
+    BVHTree *tree = unused_trees.trees[i].tree;
+    bvhcache_key_remove_weak_users(unused_trees.trees[i].key);
+    unused_trees.trees.remove(i);
+    return tree;
+  };
+  for (const int64_t i : unused_trees.trees.index_range()) {
+    const BVHCacheKey &other = unused_trees.trees[i].key;
+    if (bvhcache_key_topology_equal(key, other) && key.positions == other.positions) {
+      r_needs_refit = false;
+      return take(i);
+    }
+  }
+  if (!bvhcache_key_has_topology(key)) {
+    return nullptr;
+  }
+  for (const int64_t i : unused_trees.trees.index_range()) {
+    if (bvhcache_key_topology_equal(key, unused_trees.trees[i].key)) {
+      r_needs_refit = true;
+      return take(i);
+    }
+  }
+  return nullptr;
+}
+
+void bvhcache_free_unused_trees()
+{
+  BVHCacheUnusedTrees &unused_trees = get_unused_trees();
+  std::lock_guard lock{unused_trees.mutex};
+  for (BVHCacheUnusedTree &unused_tree : unused_trees.trees) {
+    bvhcache_unused_tree_free(unused_tree);
+  }
+  unused_trees.trees.clear_and_shrink();
+}
+
+/**
+ * A tree that only depends on the positions and topology. It is shared with copies of the mesh,
+ * and kept for reuse when the last cache using it is freed.
+ */
+struct BVHCacheSharedTree {
+  BVHTree *tree;
+  BVHCacheKey key;
+
+  BVHCacheSharedTree(BVHTree *tree, const BVHCacheKey &key) : tree(tree), key(key)
+  {
+    bvhcache_key_add_weak_users(key);
+  }
+
+  ~BVHCacheSharedTree()
+  {
+    bvhcache_unused_tree_add(key, tree);
+  }
+};
+
+struct BVHCacheItem {
+  bool is_filled = false;
+  BVHTree *tree = nullptr;
+  /** Set instead of owning #tree when the tree can be shared. */
+  std::shared_ptr<BVHCacheSharedTree> shared_tree;
+};
+
 struct BVHCache {
   BVHCacheItem items[BVHTREE_MAX_ITEM];
   ThreadMutex mutex;
@@ -109,10 +354,28 @@ bool bvhcache_has_tree(const BVHCache *bvh_cache, const BVHTree *tree)
 
 BVHCache *bvhcache_init()
 {
-  BVHCache *cache = MEM_cnew<BVHCache>(__func__);
+  BVHCache *cache = MEM_new<BVHCache>(__func__);
   BLI_mutex_init(&cache->mutex);
   return cache;
 }
+
+BVHCache *bvhcache_copy_shared(BVHCache *bvh_cache)
+{
+  BVHCache *cache = nullptr;
+  BLI_mutex_lock(&bvh_cache->mutex);
+  for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
+    const BVHCacheItem &item = bvh_cache->items[index];
+    if (item.shared_tree) {
+      if (cache == nullptr) {
+        cache = bvhcache_init();
+      }
+      cache->items[index] = item;
+    }
+  }
+  BLI_mutex_unlock(&bvh_cache->mutex);
+  return cache;
+}
+
 /**
  * Inserts a BVHTree of the given type under the cache
  * After that the caller no longer needs to worry when to free the BVHTree
@@ -121,23 +384,35 @@ BVHCache *bvhcache_init()
  * A call to this assumes that there was no previous cached tree of the given type
  * \warning The #BVHTree can be nullptr.
  */
-static void bvhcache_insert(BVHCache *bvh_cache, BVHTree *tree, BVHCacheType type)
+static void bvhcache_insert(BVHCache *bvh_cache,
+                            BVHTree *tree,
+                            BVHCacheType type,
+                            const std::optional<BVHCacheKey> &key)
 {
   BVHCacheItem *item = &bvh_cache->items[type];
   BLI_assert(!item->is_filled);
   item->tree = tree;
   item->is_filled = true;
+  if (tree && key) {
+    item->shared_tree = std::make_shared<BVHCacheSharedTree>(tree, *key);
+  }
 }
 
 void bvhcache_free(BVHCache *bvh_cache)
 {
   for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
     BVHCacheItem *item = &bvh_cache->items[index];
-    BLI_bvhtree_free(item->tree);
+    if (item->shared_tree) {
+      /* The tree is kept for reuse when this was the last user. */
+      item->shared_tree.reset();
+    }
+    else {
+      BLI_bvhtree_free(item->tree);
+    }
     item->tree = nullptr;
   }
   BLI_mutex_end(&bvh_cache->mutex);
-  MEM_freeN(bvh_cache);
+  MEM_delete(bvh_cache);
 }
 
 /**
@@ -555,6 +830,94 @@ static BVHTree *bvhtree_new_common(
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Refit
+ *
+ * Update the bounds of a tree that was built for the same topology with different positions,
+ * which is much cheaper than building a new tree. Leaves are indexed in insertion order, so
+ * masked elements have to be skipped the same way as when building the tree.
+ * \{ */
+
+template<typename Fn>
+static void bvhtree_refit(BVHTree *tree,
+                          const int64_t elems_num,
+                          const BitSpan elems_mask,
+                          const bool isolate,
+                          const Fn &update_leaf)
+{
+  if (elems_mask.is_empty()) {
+    const auto update_leaves = [&]() {
+      blender::threading::parallel_for(
+          IndexRange(elems_num), 1024, [&](const IndexRange range) {
+            for (const int i : range) {
+              update_leaf(i, i);
+            }
+          });
+    };
+    /* Same as for balancing, the caller may hold the lock of the cache. */
+    if (isolate) {
+      blender::threading::isolate_task(update_leaves);
+    }
+    else {
+      update_leaves();
+    }
+  }
+  else {
+    int leaf = 0;
+    for (const int i : IndexRange(elems_num)) {
+      if (elems_mask[i]) {
+        update_leaf(leaf, i);
+        leaf++;
+      }
+    }
+  }
+  BLI_bvhtree_update_tree(tree);
+}
+
+static BVHTree *bvhtree_from_mesh_verts_refit(BVHTree *tree,
+                                              const Span<float3> positions,
+                                              const BitSpan verts_mask,
+                                              const bool isolate)
+{
+  bvhtree_refit(tree, positions.size(), verts_mask, isolate, [&](const int leaf, const int i) {
+    BLI_bvhtree_update_node(tree, leaf, positions[i], nullptr, 1);
+  });
+  return tree;
+}
+
+static BVHTree *bvhtree_from_mesh_edges_refit(BVHTree *tree,
+                                              const Span<float3> positions,
+                                              const Span<blender::int2> edges,
+                                              const BitSpan edges_mask,
+                                              const bool isolate)
+{
+  bvhtree_refit(tree, edges.size(), edges_mask, isolate, [&](const int leaf, const int i) {
+    float co[2][3];
+    copy_v3_v3(co[0], positions[edges[i][0]]);
+    copy_v3_v3(co[1], positions[edges[i][1]]);
+    BLI_bvhtree_update_node(tree, leaf, co[0], nullptr, 2);
+  });
+  return tree;
+}
+
+static BVHTree *bvhtree_from_mesh_corner_tris_refit(BVHTree *tree,
+                                                    const Span<float3> positions,
+                                                    const Span<int> corner_verts,
+                                                    const Span<int3> corner_tris,
+                                                    const bool isolate)
+{
+  bvhtree_refit(tree, corner_tris.size(), {}, isolate, [&](const int leaf, const int i) {
+    float co[3][3];
+    copy_v3_v3(co[0], positions[corner_verts[corner_tris[i][0]]]);
+    copy_v3_v3(co[1], positions[corner_verts[corner_tris[i][1]]]);
+    copy_v3_v3(co[2], positions[corner_verts[corner_tris[i][2]]]);
+    BLI_bvhtree_update_node(tree, leaf, co[0], nullptr, 3);
+  });
+  return tree;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Vertex Builder
  * \{ */
@@ -935,86 +1298,119 @@ BVHTree *BKE_bvhtree_from_mesh_get(BVHTreeFromMesh *data,
     return data->tree;
   }
 
-  /* Create BVHTree. */
-
-  switch (bvh_cache_type) {
-    case BVHTREE_FROM_LOOSEVERTS: {
-      const LooseVertCache &loose_verts = mesh->loose_verts();
-      data->tree = bvhtree_from_mesh_verts_create_tree(
-          0.0f, tree_type, 6, positions, loose_verts.is_loose_bits, loose_verts.count);
-      break;
-    }
-    case BVHTREE_FROM_LOOSEVERTS_NO_HIDDEN: {
-      int mask_bits_act_len = -1;
-      const BitVector<> mask = loose_verts_no_hidden_mask_get(*mesh, &mask_bits_act_len);
-      data->tree = bvhtree_from_mesh_verts_create_tree(
-          0.0f, tree_type, 6, positions, mask, mask_bits_act_len);
-      break;
-    }
-    case BVHTREE_FROM_VERTS: {
-      data->tree = bvhtree_from_mesh_verts_create_tree(0.0f, tree_type, 6, positions, {}, -1);
-      break;
-    }
-    case BVHTREE_FROM_LOOSEEDGES: {
-      const LooseEdgeCache &loose_edges = mesh->loose_edges();
-      data->tree = bvhtree_from_mesh_edges_create_tree(
-          positions, edges, loose_edges.is_loose_bits, loose_edges.count, 0.0f, tree_type, 6);
-      break;
-    }
-    case BVHTREE_FROM_LOOSEEDGES_NO_HIDDEN: {
-      int mask_bits_act_len = -1;
-      const BitVector<> mask = loose_edges_no_hidden_mask_get(*mesh, &mask_bits_act_len);
-      data->tree = bvhtree_from_mesh_edges_create_tree(
-          positions, edges, mask, mask_bits_act_len, 0.0f, tree_type, 6);
-      break;
-    }
-    case BVHTREE_FROM_EDGES: {
-      data->tree = bvhtree_from_mesh_edges_create_tree(
-          positions, edges, {}, -1, 0.0f, tree_type, 6);
-      break;
-    }
-    case BVHTREE_FROM_FACES: {
-      BLI_assert(!(mesh->totface_legacy == 0 && mesh->faces_num != 0));
-      data->tree = bvhtree_from_mesh_faces_create_tree(
-          0.0f,
-          tree_type,
-          6,
-          positions,
-          (const MFace *)CustomData_get_layer(&mesh->fdata_legacy, CD_MFACE),
-          mesh->totface_legacy,
-          {},
-          -1);
-      break;
-    }
-    case BVHTREE_FROM_CORNER_TRIS_NO_HIDDEN: {
-      AttributeAccessor attributes = mesh->attributes();
-      int mask_bits_act_len = -1;
-      const BitVector<> mask = corner_tris_no_hidden_map_get(
-          mesh->faces(),
-          *attributes.lookup_or_default(".hide_poly", AttrDomain::Face, false),
-          corner_tris.size(),
-          &mask_bits_act_len);
-      data->tree = bvhtree_from_mesh_corner_tris_create_tree(
-          0.0f, tree_type, 6, positions, corner_verts, corner_tris, mask, mask_bits_act_len);
-      break;
-    }
-    case BVHTREE_FROM_CORNER_TRIS: {
-      data->tree = bvhtree_from_mesh_corner_tris_create_tree(
-          0.0f, tree_type, 6, positions, corner_verts, corner_tris, {}, -1);
-      break;
+  /* Reuse a tree built for the same data by a mesh that was freed, or create a new BVHTree. */
+  const std::optional<BVHCacheKey> key = bvhcache_key_from_mesh(*mesh, bvh_cache_type, tree_type);
+  bool needs_refit = false;
+  BVHTree *unused_tree = key ? bvhcache_unused_tree_take(*key, needs_refit) : nullptr;
+  if (unused_tree && !needs_refit) {
+    data->tree = unused_tree;
+  }
+  else {
+    switch (bvh_cache_type) {
+      case BVHTREE_FROM_LOOSEVERTS: {
+        const LooseVertCache &loose_verts = mesh->loose_verts();
+        if (unused_tree) {
+          data->tree = bvhtree_from_mesh_verts_refit(
+              unused_tree, positions, loose_verts.is_loose_bits, lock_started);
+          break;
+        }
+        data->tree = bvhtree_from_mesh_verts_create_tree(
+            0.0f, tree_type, 6, positions, loose_verts.is_loose_bits, loose_verts.count);
+        break;
+      }
+      case BVHTREE_FROM_LOOSEVERTS_NO_HIDDEN: {
+        int mask_bits_act_len = -1;
+        const BitVector<> mask = loose_verts_no_hidden_mask_get(*mesh, &mask_bits_act_len);
+        data->tree = bvhtree_from_mesh_verts_create_tree(
+            0.0f, tree_type, 6, positions, mask, mask_bits_act_len);
+        break;
+      }
+      case BVHTREE_FROM_VERTS: {
+        if (unused_tree) {
+          data->tree = bvhtree_from_mesh_verts_refit(unused_tree, positions, {}, lock_started);
+          break;
+        }
+        data->tree = bvhtree_from_mesh_verts_create_tree(0.0f, tree_type, 6, positions, {}, -1);
+        break;
+      }
+      case BVHTREE_FROM_LOOSEEDGES: {
+        const LooseEdgeCache &loose_edges = mesh->loose_edges();
+        if (unused_tree) {
+          data->tree = bvhtree_from_mesh_edges_refit(
+              unused_tree, positions, edges, loose_edges.is_loose_bits, lock_started);
+          break;
+        }
+        data->tree = bvhtree_from_mesh_edges_create_tree(
+            positions, edges, loose_edges.is_loose_bits, loose_edges.count, 0.0f, tree_type, 6);
+        break;
+      }
+      case BVHTREE_FROM_LOOSEEDGES_NO_HIDDEN: {
+        int mask_bits_act_len = -1;
+        const BitVector<> mask = loose_edges_no_hidden_mask_get(*mesh, &mask_bits_act_len);
+        data->tree = bvhtree_from_mesh_edges_create_tree(
+            positions, edges, mask, mask_bits_act_len, 0.0f, tree_type, 6);
+        break;
+      }
+      case BVHTREE_FROM_EDGES: {
+        if (unused_tree) {
+          data->tree = bvhtree_from_mesh_edges_refit(
+              unused_tree, positions, edges, {}, lock_started);
+          break;
+        }
+        data->tree = bvhtree_from_mesh_edges_create_tree(
+            positions, edges, {}, -1, 0.0f, tree_type, 6);
+        break;
+      }
+      case BVHTREE_FROM_FACES: {
+        BLI_assert(!(mesh->totface_legacy == 0 && mesh->faces_num != 0));
+        data->tree = bvhtree_from_mesh_faces_create_tree(
+            0.0f,
+            tree_type,
+            6,
+            positions,
+            (const MFace *)CustomData_get_layer(&mesh->fdata_legacy, CD_MFACE),
+            mesh->totface_legacy,
+            {},
+            -1);
+        break;
+      }
+      case BVHTREE_FROM_CORNER_TRIS_NO_HIDDEN: {
+        AttributeAccessor attributes = mesh->attributes();
+        int mask_bits_act_len = -1;
+        const BitVector<> mask = corner_tris_no_hidden_map_get(
+            mesh->faces(),
+            *attributes.lookup_or_default(".hide_poly", AttrDomain::Face, false),
+            corner_tris.size(),
+            &mask_bits_act_len);
+        data->tree = bvhtree_from_mesh_corner_tris_create_tree(
+            0.0f, tree_type, 6, positions, corner_verts, corner_tris, mask, mask_bits_act_len);
+        break;
+      }
+      case BVHTREE_FROM_CORNER_TRIS: {
+        if (unused_tree) {
+          data->tree = bvhtree_from_mesh_corner_tris_refit(
+              unused_tree, positions, corner_verts, corner_tris, lock_started);
+          break;
+        }
+        data->tree = bvhtree_from_mesh_corner_tris_create_tree(
+            0.0f, tree_type, 6, positions, corner_verts, corner_tris, {}, -1);
+        break;
+      }
+      case BVHTREE_MAX_ITEM:
+        BLI_assert_unreachable();
+        break;
     }
-    case BVHTREE_MAX_ITEM:
-      BLI_assert_unreachable();
-      break;
   }
 
-  bvhtree_balance(data->tree, lock_started);
+  if (!unused_tree) {
+    bvhtree_balance(data->tree, lock_started);
+  }
 
   /* Save on cache for later use */
   // printf("BVHTree built and saved on cache\n");
   BLI_assert(data->cached == false);
   data->cached = true;
-  bvhcache_insert(*bvh_cache_p, data->tree, bvh_cache_type);
+  bvhcache_insert(*bvh_cache_p, data->tree, bvh_cache_type, key);
   bvhcache_unlock(*bvh_cache_p, lock_started);
 
 #ifndef NDEBUG
@@ -0,0 +1,132 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "CLG_log.h"
+
+#include "DNA_mesh_types.h"
+
+#include "BLI_kdopbvh.h"
+#include "BLI_math_vector_types.hh"
+
+#include "BKE_bvhutils.hh"
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+
+namespace blender::bke::tests {
+
+class BVHCacheTest : public testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+
+  void TearDown() override
+  {
+    bvhcache_free_unused_trees();
+  }
+};
+
+static Mesh *create_tetrahedron()
+{
+  Mesh *mesh = BKE_mesh_new_nomain(4, 6, 4, 12);
+  mesh->vert_positions_for_write().copy_from(
+      {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}});
+  mesh->edges_for_write().copy_from({{0, 1}, {1, 2}, {2, 0}, {0, 3}, {1, 3}, {2, 3}});
+  mesh->face_offsets_for_write().copy_from({0, 3, 6, 9, 12});
+  mesh->corner_verts_for_write().copy_from({0, 2, 1, 0, 1, 3, 1, 2, 3, 2, 0, 3});
+  return mesh;
+}
+
+/** Index of the vertex in the tree that is closest to the given position. */
+static int find_nearest_vert(const BVHTree *tree, const float3 &co)
+{
+  BVHTreeNearest nearest;
+  nearest.index = -1;
+  nearest.dist_sq = FLT_MAX;
+  BLI_bvhtree_find_nearest(tree, co, &nearest, nullptr, nullptr);
+  return nearest.index;
+}
+
+TEST_F(BVHCacheTest, TreeIsSharedWithCopies)
+{
+  Mesh *mesh = create_tetrahedron();
+
+  BVHTreeFromMesh data;
+  BVHTree *tree = BKE_bvhtree_from_mesh_get(&data, mesh, BVHTREE_FROM_CORNER_TRIS, 2);
+  ASSERT_NE(tree, nullptr);
+  EXPECT_FALSE(data.cached);
+  free_bvhtree_from_mesh(&data);
+
+  EXPECT_EQ(BKE_bvhtree_from_mesh_get(&data, mesh, BVHTREE_FROM_CORNER_TRIS, 2), tree);
+  EXPECT_TRUE(data.cached);
+  free_bvhtree_from_mesh(&data);
+
+  Mesh *mesh_copy = BKE_mesh_copy_for_eval(mesh);
+  EXPECT_EQ(BKE_bvhtree_from_mesh_get(&data, mesh_copy, BVHTREE_FROM_CORNER_TRIS, 2), tree);
+  EXPECT_TRUE(data.cached);
+  free_bvhtree_from_mesh(&data);
+
+  /* The tree stays valid for the copy when the original mesh is freed. */
+  BKE_id_free(nullptr, mesh);
+  EXPECT_TRUE(bvhcache_has_tree(mesh_copy->runtime->bvh_cache, tree));
+  BKE_id_free(nullptr, mesh_copy);
+}
+
+TEST_F(BVHCacheTest, FreedTreeIsReused)
+{
+  Mesh *mesh = create_tetrahedron();
+  Mesh *mesh_copy = BKE_mesh_copy_for_eval(mesh);
+
+  BVHTreeFromMesh data;
+  BVHTree *tree = BKE_bvhtree_from_mesh_get(&data, mesh_copy, BVHTREE_FROM_VERTS, 2);
+  ASSERT_NE(tree, nullptr);
+  free_bvhtree_from_mesh(&data);
+  BKE_id_free(nullptr, mesh_copy);
+
+  /* The original mesh references the same data, so it can take over the tree of the copy. */
+  EXPECT_EQ(BKE_bvhtree_from_mesh_get(&data, mesh, BVHTREE_FROM_VERTS, 2), tree);
+  free_bvhtree_from_mesh(&data);
+  BKE_id_free(nullptr, mesh);
+}
+
+TEST_F(BVHCacheTest, PositionsChangeInvalidatesTree)
+{
+  Mesh *mesh = create_tetrahedron();
+
+  BVHTreeFromMesh data;
+  BVHTree *tree = BKE_bvhtree_from_mesh_get(&data, mesh, BVHTREE_FROM_VERTS, 2);
+  ASSERT_NE(tree, nullptr);
+  EXPECT_EQ(find_nearest_vert(tree, {10.0f, 0.0f, 0.0f}), 1);
+  free_bvhtree_from_mesh(&data);
+
+  mesh->vert_positions_for_write()[0] = {20.0f, 0.0f, 0.0f};
+  mesh->tag_positions_changed();
+  EXPECT_FALSE(bvhcache_has_tree(mesh->runtime->bvh_cache, tree));
+
+  /* The tree may be refit from the freed one, but must match the new positions. */
+  tree = BKE_bvhtree_from_mesh_get(&data, mesh, BVHTREE_FROM_VERTS, 2);
+  ASSERT_NE(tree, nullptr);
+  EXPECT_FALSE(data.cached);
+  EXPECT_EQ(find_nearest_vert(tree, {10.0f, 0.0f, 0.0f}), 0);
+  free_bvhtree_from_mesh(&data);
+
+  /* The freed tree is kept, but not used for a mesh with other data. */
+  BKE_id_free(nullptr, mesh);
+  Mesh *other_mesh = create_tetrahedron();
+  EXPECT_NE(BKE_bvhtree_from_mesh_get(&data, other_mesh, BVHTREE_FROM_VERTS, 2), tree);
+  free_bvhtree_from_mesh(&data);
+  BKE_id_free(nullptr, other_mesh);
+}
+
+}  // namespace blender::bke::tests
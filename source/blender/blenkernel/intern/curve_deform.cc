@@ -13,9 +13,11 @@
 #include <cstdlib>
 #include <cstring>
 
+#include "BLI_array.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_curve_types.h"
@@ -206,13 +208,11 @@ static void curve_deform_coords_impl(const Object *ob_curve,
                                      const short defaxis,
                                      BMEditMesh *em_target)
 {
+  using namespace blender;
   Curve *cu;
-  int a;
   CurveDeform cd;
   const bool is_neg_axis = (defaxis > 2);
   const bool invert_vgroup = (flag & MOD_CURVE_INVERT_VGROUP) != 0;
-  bool use_dverts = false;
-  int cd_dvert_offset;
 
   if (ob_curve->type != OB_CURVES_LEGACY) {
     return;
@@ -239,129 +239,73 @@ static void curve_deform_coords_impl(const Object *ob_curve,
     INIT_MINMAX(cd.dmin, cd.dmax);
   }
 
+  /* Gather the vertex group weights first, so that the deformation itself can be done in
+   * parallel for meshes and edit-meshes alike. Empty when all vertices are fully deformed. */
+  Array<float> weights;
   if (em_target != nullptr) {
-    cd_dvert_offset = CustomData_get_offset(&em_target->bm->vdata, CD_MDEFORMVERT);
+    const int cd_dvert_offset = CustomData_get_offset(&em_target->bm->vdata, CD_MDEFORMVERT);
     if (cd_dvert_offset != -1) {
-      use_dverts = true;
+      weights.reinitialize(vert_coords_len);
+      BMIter iter;
+      BMVert *v;
+      int a;
+      BM_ITER_MESH_INDEX (v, &iter, em_target->bm, BM_VERTS_OF_MESH, a) {
+        const MDeformVert *dv = static_cast<const MDeformVert *>(
+            BM_ELEM_CD_GET_VOID_P(v, cd_dvert_offset));
+        weights[a] = BKE_defvert_find_weight(dv, defgrp_index);
+      }
     }
   }
-  else {
-    if (dvert != nullptr) {
-      use_dverts = true;
+  else if (dvert != nullptr) {
+    weights.reinitialize(vert_coords_len);
+    threading::parallel_for(IndexRange(vert_coords_len), 4096, [&](const IndexRange range) {
+      for (const int a : range) {
+        weights[a] = BKE_defvert_find_weight(&dvert[a], defgrp_index);
+      }
+    });
+  }
+  if (!weights.is_empty() && invert_vgroup) {
+    for (float &weight : weights) {
+      weight = 1.0f - weight;
     }
   }
+  const bool use_dverts = !weights.is_empty();
 
-  if (use_dverts) {
-    if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
-
-#define DEFORM_OP(dvert) \
-  { \
-    const float weight = invert_vgroup ? 1.0f - BKE_defvert_find_weight(dvert, defgrp_index) : \
-                                         BKE_defvert_find_weight(dvert, defgrp_index); \
-    if (weight > 0.0f) { \
-      float vec[3]; \
-      mul_m4_v3(cd.curvespace, vert_coords[a]); \
-      copy_v3_v3(vec, vert_coords[a]); \
-      calc_curve_deform(ob_curve, vec, defaxis, &cd, nullptr); \
-      interp_v3_v3v3(vert_coords[a], vert_coords[a], vec, weight); \
-      mul_m4_v3(cd.objectspace, vert_coords[a]); \
-    } \
-  } \
-  ((void)0)
-
-      if (em_target != nullptr) {
-        BMIter iter;
-        BMVert *v;
-        BM_ITER_MESH_INDEX (v, &iter, em_target->bm, BM_VERTS_OF_MESH, a) {
-          dvert = static_cast<const MDeformVert *>(BM_ELEM_CD_GET_VOID_P(v, cd_dvert_offset));
-          DEFORM_OP(dvert);
-        }
-      }
-      else {
-        for (a = 0; a < vert_coords_len; a++) {
-          DEFORM_OP(&dvert[a]);
-        }
+  if (!(cu->flag & CU_DEFORM_BOUNDS_OFF)) {
+    /* The bounds of all deformed vertices in curve space are needed before deforming any. */
+    for (int a = 0; a < vert_coords_len; a++) {
+      if (!use_dverts || weights[a] > 0.0f) {
+        mul_m4_v3(cd.curvespace, vert_coords[a]);
+        minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]);
       }
-
-#undef DEFORM_OP
     }
-    else {
-
-#define DEFORM_OP_MINMAX(dvert) \
-  { \
-    const float weight = invert_vgroup ? 1.0f - BKE_defvert_find_weight(dvert, defgrp_index) : \
-                                         BKE_defvert_find_weight(dvert, defgrp_index); \
-    if (weight > 0.0f) { \
-      mul_m4_v3(cd.curvespace, vert_coords[a]); \
-      minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]); \
-    } \
-  } \
-  ((void)0)
-
-/* Already in 'cd.curvespace', previous for loop. */
-#define DEFORM_OP_CLAMPED(dvert) \
-  { \
-    const float weight = invert_vgroup ? 1.0f - BKE_defvert_find_weight(dvert, defgrp_index) : \
-                                         BKE_defvert_find_weight(dvert, defgrp_index); \
-    if (weight > 0.0f) { \
-      float vec[3]; \
-      copy_v3_v3(vec, vert_coords[a]); \
-      calc_curve_deform(ob_curve, vec, defaxis, &cd, nullptr); \
-      interp_v3_v3v3(vert_coords[a], vert_coords[a], vec, weight); \
-      mul_m4_v3(cd.objectspace, vert_coords[a]); \
-    } \
-  } \
-  ((void)0)
-
-      if (em_target != nullptr) {
-        BMIter iter;
-        BMVert *v;
-        BM_ITER_MESH_INDEX (v, &iter, em_target->bm, BM_VERTS_OF_MESH, a) {
-          dvert = static_cast<const MDeformVert *>(BM_ELEM_CD_GET_VOID_P(v, cd_dvert_offset));
-          DEFORM_OP_MINMAX(dvert);
-        }
+  }
 
-        BM_ITER_MESH_INDEX (v, &iter, em_target->bm, BM_VERTS_OF_MESH, a) {
-          dvert = static_cast<const MDeformVert *>(BM_ELEM_CD_GET_VOID_P(v, cd_dvert_offset));
-          DEFORM_OP_CLAMPED(dvert);
+  threading::parallel_for(IndexRange(vert_coords_len), 512, [&](const IndexRange range) {
+    for (const int a : range) {
+      if (use_dverts) {
+        const float weight = weights[a];
+        if (weight > 0.0f) {
+          if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
+            mul_m4_v3(cd.curvespace, vert_coords[a]);
+          }
+          float vec[3];
+          copy_v3_v3(vec, vert_coords[a]);
+          calc_curve_deform(ob_curve, vec, defaxis, &cd, nullptr);
+          interp_v3_v3v3(vert_coords[a], vert_coords[a], vec, weight);
+          mul_m4_v3(cd.objectspace, vert_coords[a]);
         }
       }
       else {
-
-        for (a = 0; a < vert_coords_len; a++) {
-          DEFORM_OP_MINMAX(&dvert[a]);
-        }
-
-        for (a = 0; a < vert_coords_len; a++) {
-          DEFORM_OP_CLAMPED(&dvert[a]);
+        if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
+          mul_m4_v3(cd.curvespace, vert_coords[a]);
         }
-      }
-    }
-
-#undef DEFORM_OP_MINMAX
-#undef DEFORM_OP_CLAMPED
-  }
-  else {
-    if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
-      for (a = 0; a < vert_coords_len; a++) {
-        mul_m4_v3(cd.curvespace, vert_coords[a]);
+        /* Otherwise already in 'cd.curvespace' from the bounds calculation. */
         calc_curve_deform(ob_curve, vert_coords[a], defaxis, &cd, nullptr);
         mul_m4_v3(cd.objectspace, vert_coords[a]);
       }
     }
-    else {
-      for (a = 0; a < vert_coords_len; a++) {
-        mul_m4_v3(cd.curvespace, vert_coords[a]);
-        minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]);
-      }
-
-      for (a = 0; a < vert_coords_len; a++) {
-        /* Already in 'cd.curvespace', previous for loop. */
-        calc_curve_deform(ob_curve, vert_coords[a], defaxis, &cd, nullptr);
-        mul_m4_v3(cd.objectspace, vert_coords[a]);
-      }
-    }
-  }
+  });
 }
 
 void BKE_curve_deform_coords(const Object *ob_curve,
@@ -35,6 +35,7 @@
 #include "BLI_string_ref.hh"
 #include "BLI_string_utf8.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #ifndef NDEBUG
@@ -4140,6 +4141,93 @@ void CustomData_bmesh_copy_block(CustomData &dst_data,
   }
 }
 
+/**
+ * Call the function with the size of trivially copyable elements as a compile-time constant for
+ * common sizes, so that the copies of a whole layer can be inlined.
+ */
+template<typename Fn> static void trivial_size_dispatch(const int size, const Fn &fn)
+{
+  switch (size) {
+    case 1:
+      fn(std::integral_constant<int, 1>());
+      break;
+    case 4:
+      fn(std::integral_constant<int, 4>());
+      break;
+    case 8:
+      fn(std::integral_constant<int, 8>());
+      break;
+    case 12:
+      fn(std::integral_constant<int, 12>());
+      break;
+    case 16:
+      fn(std::integral_constant<int, 16>());
+      break;
+    default:
+      fn(size);
+      break;
+  }
+}
+
+void CustomData_bmesh_layer_copy_from_array(const eCustomDataType type,
+                                            const void *src_data,
+                                            const Span<void *> dst_blocks,
+                                            const int dst_offset)
+{
+  const LayerTypeInfo &info = *layerType_getInfo(type);
+  if (src_data == nullptr) {
+    for (void *block : dst_blocks) {
+      if (block == nullptr) {
+        continue;
+      }
+      if (info.set_default_value) {
+        info.set_default_value(POINTER_OFFSET(block, dst_offset), 1);
+      }
+      else {
+        memset(POINTER_OFFSET(block, dst_offset), 0, info.size);
+      }
+    }
+    return;
+  }
+  if (info.copy) {
+    for (const int64_t i : dst_blocks.index_range()) {
+      if (dst_blocks[i] != nullptr) {
+        info.copy(
+            POINTER_OFFSET(src_data, info.size * i), POINTER_OFFSET(dst_blocks[i], dst_offset), 1);
+      }
+    }
+    return;
+  }
+  trivial_size_dispatch(info.size, [&](const auto size) {
+    for (const int64_t i : dst_blocks.index_range()) {
+      if (dst_blocks[i] != nullptr) {
+        memcpy(
+            POINTER_OFFSET(dst_blocks[i], dst_offset), POINTER_OFFSET(src_data, size * i), size);
+      }
+    }
+  });
+}
+
+void CustomData_bmesh_layer_copy_to_array(const eCustomDataType type,
+                                          const Span<const void *> src_blocks,
+                                          const int src_offset,
+                                          void *dst_data)
+{
+  const LayerTypeInfo &info = *layerType_getInfo(type);
+  if (info.copy) {
+    for (const int64_t i : src_blocks.index_range()) {
+      info.copy(
+          POINTER_OFFSET(src_blocks[i], src_offset), POINTER_OFFSET(dst_data, info.size * i), 1);
+    }
+    return;
+  }
+  trivial_size_dispatch(info.size, [&](const auto size) {
+    for (const int64_t i : src_blocks.index_range()) {
+      memcpy(POINTER_OFFSET(dst_data, size * i), POINTER_OFFSET(src_blocks[i], src_offset), size);
+    }
+  });
+}
+
 void CustomData_bmesh_copy_block(CustomData &data, void *src_block, void **dst_block)
 {
   if (*dst_block) {
@@ -5199,7 +5287,8 @@ void customdata_data_transfer_interp_normal_normals(const CustomDataTransferLaye
 void CustomData_data_transfer(const MeshPairRemap *me_remap,
                               const CustomDataTransferLayerMap *laymap)
 {
-  MeshPairRemapItem *mapit = me_remap->items;
+  using namespace blender;
+  const MeshPairRemapItem *items = me_remap->items;
   const int totelem = me_remap->items_num;
 
   const int data_type = laymap->data_type;
@@ -5212,19 +5301,11 @@ void CustomData_data_transfer(const MeshPairRemap *me_remap,
 
   cd_datatransfer_interp interp = nullptr;
 
-  size_t tmp_buff_size = 32;
-  const void **tmp_data_src = nullptr;
-
   /* NOTE: null data_src may happen and be valid (see vgroups...). */
   if (!data_dst) {
     return;
   }
 
-  if (data_src) {
-    tmp_data_src = (const void **)MEM_malloc_arrayN(
-        tmp_buff_size, sizeof(*tmp_data_src), __func__);
-  }
-
   if (int(data_type) & CD_FAKE) {
     data_step = laymap->elem_size;
     data_size = laymap->data_size;
@@ -5241,38 +5322,38 @@ void CustomData_data_transfer(const MeshPairRemap *me_remap,
 
   interp = laymap->interp ? laymap->interp : customdata_data_transfer_interp_generic;
 
-  for (int i = 0; i < totelem; i++, data_dst = POINTER_OFFSET(data_dst, data_step), mapit++) {
-    const int sources_num = mapit->sources_num;
-    const float mix_factor = laymap->mix_factor *
-                             (laymap->mix_weights ? laymap->mix_weights[i] : 1.0f);
+  /* Interpolation functions only write to their own destination element, so elements can be
+   * processed in parallel. */
+  threading::parallel_for(IndexRange(totelem), 1024, [&](const IndexRange range) {
+    Vector<const void *, 32> tmp_data_src;
 
-    if (!sources_num) {
-      /* No sources for this element, skip it. */
-      continue;
-    }
+    for (const int64_t i : range) {
+      const MeshPairRemapItem &mapit = items[i];
+      const int sources_num = mapit.sources_num;
+      const float mix_factor = laymap->mix_factor *
+                               (laymap->mix_weights ? laymap->mix_weights[i] : 1.0f);
 
-    if (tmp_data_src) {
-      if (UNLIKELY(sources_num > tmp_buff_size)) {
-        tmp_buff_size = size_t(sources_num);
-        tmp_data_src = (const void **)MEM_reallocN((void *)tmp_data_src,
-                                                   sizeof(*tmp_data_src) * tmp_buff_size);
+      if (!sources_num) {
+        /* No sources for this element, skip it. */
+        continue;
       }
 
-      for (int j = 0; j < sources_num; j++) {
-        const size_t src_idx = size_t(mapit->indices_src[j]);
-        tmp_data_src[j] = POINTER_OFFSET(data_src, (data_step * src_idx) + data_offset);
+      if (data_src) {
+        tmp_data_src.resize(sources_num);
+        for (int j = 0; j < sources_num; j++) {
+          const size_t src_idx = size_t(mapit.indices_src[j]);
+          tmp_data_src[j] = POINTER_OFFSET(data_src, (data_step * src_idx) + data_offset);
+        }
       }
-    }
 
-    interp(laymap,
-           POINTER_OFFSET(data_dst, data_offset),
-           tmp_data_src,
-           mapit->weights_src,
-           sources_num,
-           mix_factor);
-  }
-
-  MEM_SAFE_FREE(tmp_data_src);
+      interp(laymap,
+             POINTER_OFFSET(data_dst, (data_step * size_t(i)) + data_offset),
+             data_src ? tmp_data_src.data() : nullptr,
+             mapit.weights_src,
+             sources_num,
+             mix_factor);
+    }
+  });
 }
 
 /** \} */
@@ -6,6 +6,9 @@
  * \ingroup bke
  */
 
+#include <optional>
+#include <xxhash.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_customdata_types.h"
@@ -16,6 +19,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_math_matrix.h"
+#include "BLI_vector.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_attribute.hh"
@@ -1303,6 +1307,116 @@ void BKE_object_data_transfer_layout(Depsgraph *depsgraph,
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Geometry Mapping Cache
+ * \{ */
+
+struct DataTransferRemapCache {
+  /** Mappings of vertices, edges, corners and faces, indexed like in
+   * #BKE_object_data_transfer_ex. An empty mapping has not been computed yet. */
+  MeshPairRemap maps[4];
+  /** Hash of all inputs each mapping was computed from. */
+  uint64_t keys[4];
+};
+
+DataTransferRemapCache *BKE_data_transfer_remap_cache_new()
+{
+  return MEM_new<DataTransferRemapCache>(__func__);
+}
+
+void BKE_data_transfer_remap_cache_free(DataTransferRemapCache *cache)
+{
+  if (cache == nullptr) {
+    return;
+  }
+  for (MeshPairRemap &map : cache->maps) {
+    BKE_mesh_remap_free(&map);
+  }
+  MEM_delete(cache);
+}
+
+const MeshPairRemap *BKE_data_transfer_remap_cache_get_map(const DataTransferRemapCache *cache,
+                                                           const int index)
+{
+  BLI_assert(index >= 0 && index < ARRAY_SIZE(cache->maps));
+  return &cache->maps[index];
+}
+
+template<typename T> static uint64_t data_transfer_hash_span(const blender::Span<T> span)
+{
+  return XXH3_64bits(span.data(), size_t(span.size_in_bytes()));
+}
+
+/**
+ * Hash the geometry of both meshes that any mapping depends on. Face and vertex normals are
+ * derived from it, so they don't need to be hashed separately.
+ */
+static uint64_t data_transfer_remap_geometry_hash(const Mesh *me_src,
+                                                  const Mesh *me_dst,
+                                                  const SpaceTransform *space_transform)
+{
+  blender::Vector<uint64_t, 16> hashes;
+  for (const Mesh *mesh : {me_src, me_dst}) {
+    hashes.append(uint64_t(mesh->verts_num));
+    hashes.append(data_transfer_hash_span(mesh->vert_positions()));
+    hashes.append(data_transfer_hash_span(mesh->edges()));
+    hashes.append(data_transfer_hash_span(mesh->face_offsets()));
+    hashes.append(data_transfer_hash_span(mesh->corner_verts()));
+    hashes.append(data_transfer_hash_span(mesh->corner_edges()));
+  }
+  if (space_transform) {
+    hashes.append(XXH3_64bits(space_transform, sizeof(*space_transform)));
+  }
+  return XXH3_64bits(hashes.data(), size_t(hashes.as_span().size_in_bytes()));
+}
+
+/**
+ * Hash the additional inputs of corner mappings: custom and sharp corner normals are not derived
+ * from the positions alone, and islands depend on the source UV seams.
+ */
+static uint64_t data_transfer_remap_loops_hash(const Mesh *me_src,
+                                               const Mesh *me_dst,
+                                               const int map_mode,
+                                               const MeshRemapIslandsCalc island_callback,
+                                               const float islands_precision)
+{
+  blender::Vector<uint64_t, 8> hashes;
+  if (map_mode & (MREMAP_USE_NORMAL | MREMAP_USE_NORPROJ)) {
+    hashes.append(data_transfer_hash_span(me_dst->corner_normals()));
+    if (map_mode & MREMAP_USE_NORMAL) {
+      hashes.append(data_transfer_hash_span(me_src->corner_normals()));
+    }
+  }
+  if (island_callback) {
+    const blender::bke::AttributeAccessor attributes = me_src->attributes();
+    const blender::VArraySpan uv_seams = *attributes.lookup<bool>(".uv_seam",
+                                                                   blender::bke::AttrDomain::Edge);
+    hashes.append(uv_seams.is_empty() ? 1 : data_transfer_hash_span<bool>(uv_seams));
+    hashes.append(XXH3_64bits(&islands_precision, sizeof(islands_precision)));
+  }
+  return XXH3_64bits(hashes.data(), size_t(hashes.as_span().size_in_bytes()));
+}
+
+/**
+ * Check whether the cached mapping at \a index has to be (re)computed for \a key. Without a
+ * cache, mappings are always computed.
+ */
+static bool data_transfer_remap_cache_needs_update(DataTransferRemapCache *cache,
+                                                   const int index,
+                                                   const uint64_t key)
+{
+  if (cache == nullptr) {
+    return true;
+  }
+  if (cache->maps[index].items != nullptr && cache->keys[index] == key) {
+    return false;
+  }
+  cache->keys[index] = key;
+  return true;
+}
+
+/** \} */
+
 bool BKE_object_data_transfer_ex(Depsgraph *depsgraph,
                                  Object *ob_src,
                                  Object *ob_dst,
@@ -1324,6 +1438,7 @@ bool BKE_object_data_transfer_ex(Depsgraph *depsgraph,
                                  const float mix_factor,
                                  const char *vgroup_name,
                                  const bool invert_vgroup,
+                                 DataTransferRemapCache *remap_cache,
                                  ReportList *reports)
 {
 #define VDATA 0
@@ -1340,8 +1455,10 @@ bool BKE_object_data_transfer_ex(Depsgraph *depsgraph,
   int vg_idx = -1;
   float *weights[DATAMAX] = {nullptr};
 
-  MeshPairRemap geom_map[DATAMAX] = {{0}};
+  MeshPairRemap geom_map_local[DATAMAX] = {{0}};
+  MeshPairRemap *geom_map = remap_cache ? remap_cache->maps : geom_map_local;
   bool geom_map_init[DATAMAX] = {false};
+  std::optional<uint64_t> geometry_hash;
   ListBase lay_map = {nullptr};
   bool changed = false;
   bool is_modifier = false;
@@ -1393,6 +1510,20 @@ bool BKE_object_data_transfer_ex(Depsgraph *depsgraph,
         space_transform);
   }
 
+  /* Key of a cached mapping, combining the shared geometry hash with the mapping settings. */
+  auto remap_cache_key = [&](const int map_mode, const uint64_t extra_hash) -> uint64_t {
+    if (remap_cache == nullptr) {
+      return 0;
+    }
+    if (!geometry_hash) {
+      geometry_hash = data_transfer_remap_geometry_hash(me_src, me_dst, space_transform);
+    }
+    const float settings[] = {max_distance, ray_radius};
+    uint64_t key = XXH3_64bits_withSeed(&map_mode, sizeof(map_mode), *geometry_hash);
+    key = XXH3_64bits_withSeed(settings, sizeof(settings), key);
+    return XXH3_64bits_withSeed(&extra_hash, sizeof(extra_hash), key);
+  };
+
   /* Check all possible data types.
    * Note item mappings and destination mix weights are cached. */
   for (int i = 0; i < DT_TYPE_MAX; i++) {
@@ -1451,16 +1582,20 @@ bool BKE_object_data_transfer_ex(Depsgraph *depsgraph,
           continue;
         }
 
-        BKE_mesh_remap_calc_verts_from_mesh(
-            map_vert_mode,
-            space_transform,
-            max_distance,
-            ray_radius,
-            reinterpret_cast<const float(*)[3]>(positions_dst.data()),
-            num_verts_dst,
-            me_src,
-            me_dst,
-            &geom_map[VDATA]);
+        if (data_transfer_remap_cache_needs_update(
+                remap_cache, VDATA, remap_cache_key(map_vert_mode, 0)))
+        {
+          BKE_mesh_remap_calc_verts_from_mesh(
+              map_vert_mode,
+              space_transform,
+              max_distance,
+              ray_radius,
+              reinterpret_cast<const float(*)[3]>(positions_dst.data()),
+              num_verts_dst,
+              me_src,
+              me_dst,
+              &geom_map[VDATA]);
+        }
         geom_map_init[VDATA] = true;
       }
 
@@ -1528,18 +1663,22 @@ bool BKE_object_data_transfer_ex(Depsgraph *depsgraph,
           continue;
         }
 
-        BKE_mesh_remap_calc_edges_from_mesh(
-            map_edge_mode,
-            space_transform,
-            max_distance,
-            ray_radius,
-            reinterpret_cast<const float(*)[3]>(positions_dst.data()),
-            num_verts_dst,
-            edges_dst.data(),
-            edges_dst.size(),
-            me_src,
-            me_dst,
-            &geom_map[EDATA]);
+        if (data_transfer_remap_cache_needs_update(
+                remap_cache, EDATA, remap_cache_key(map_edge_mode, 0)))
+        {
+          BKE_mesh_remap_calc_edges_from_mesh(
+              map_edge_mode,
+              space_transform,
+              max_distance,
+              ray_radius,
+              reinterpret_cast<const float(*)[3]>(positions_dst.data()),
+              num_verts_dst,
+              edges_dst.data(),
+              edges_dst.size(),
+              me_src,
+              me_dst,
+              &geom_map[EDATA]);
+        }
         geom_map_init[EDATA] = true;
       }
 
@@ -1615,21 +1754,32 @@ bool BKE_object_data_transfer_ex(Depsgraph *depsgraph,
           continue;
         }
 
-        BKE_mesh_remap_calc_loops_from_mesh(
-            map_loop_mode,
-            space_transform,
-            max_distance,
-            ray_radius,
-            me_dst,
-            reinterpret_cast<const float(*)[3]>(positions_dst.data()),
-            num_verts_dst,
-            corner_verts_dst.data(),
-            corner_verts_dst.size(),
-            faces_dst,
-            me_src,
-            island_callback,
-            islands_handling_precision,
-            &geom_map[LDATA]);
+        if (data_transfer_remap_cache_needs_update(
+                remap_cache,
+                LDATA,
+                remap_cache_key(map_loop_mode,
+                                data_transfer_remap_loops_hash(me_src,
+                                                               me_dst,
+                                                               map_loop_mode,
+                                                               island_callback,
+                                                               islands_handling_precision))))
+        {
+          BKE_mesh_remap_calc_loops_from_mesh(
+              map_loop_mode,
+              space_transform,
+              max_distance,
+              ray_radius,
+              me_dst,
+              reinterpret_cast<const float(*)[3]>(positions_dst.data()),
+              num_verts_dst,
+              corner_verts_dst.data(),
+              corner_verts_dst.size(),
+              faces_dst,
+              me_src,
+              island_callback,
+              islands_handling_precision,
+              &geom_map[LDATA]);
+        }
         geom_map_init[LDATA] = true;
       }
 
@@ -1702,18 +1852,22 @@ bool BKE_object_data_transfer_ex(Depsgraph *depsgraph,
           continue;
         }
 
-        BKE_mesh_remap_calc_faces_from_mesh(
-            map_face_mode,
-            space_transform,
-            max_distance,
-            ray_radius,
-            me_dst,
-            reinterpret_cast<const float(*)[3]>(positions_dst.data()),
-            num_verts_dst,
-            corner_verts_dst.data(),
-            faces_dst,
-            me_src,
-            &geom_map[PDATA]);
+        if (data_transfer_remap_cache_needs_update(
+                remap_cache, PDATA, remap_cache_key(map_face_mode, 0)))
+        {
+          BKE_mesh_remap_calc_faces_from_mesh(
+              map_face_mode,
+              space_transform,
+              max_distance,
+              ray_radius,
+              me_dst,
+              reinterpret_cast<const float(*)[3]>(positions_dst.data()),
+              num_verts_dst,
+              corner_verts_dst.data(),
+              faces_dst,
+              me_src,
+              &geom_map[PDATA]);
+        }
         geom_map_init[PDATA] = true;
       }
 
@@ -1761,7 +1915,7 @@ bool BKE_object_data_transfer_ex(Depsgraph *depsgraph,
   }
 
   for (int i = 0; i < DATAMAX; i++) {
-    BKE_mesh_remap_free(&geom_map[i]);
+    BKE_mesh_remap_free(&geom_map_local[i]);
     MEM_SAFE_FREE(weights[i]);
   }
 
@@ -1817,5 +1971,6 @@ bool BKE_object_data_transfer_mesh(Depsgraph *depsgraph,
                                      mix_factor,
                                      vgroup_name,
                                      invert_vgroup,
+                                     nullptr,
                                      reports);
 }
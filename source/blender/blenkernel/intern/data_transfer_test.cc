@@ -0,0 +1,323 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "CLG_log.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BLI_math_vector_types.hh"
+
+#include "BKE_customdata.hh"
+#include "BKE_data_transfer.h"
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_main.hh"
+#include "BKE_mesh.hh"
+#include "BKE_mesh_remap.hh"
+#include "BKE_object.hh"
+#include "BKE_scene.hh"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_query.hh"
+
+#ifdef WITH_TBB
+#  include <tbb/task_arena.h>
+#endif
+
+namespace blender::bke::tests {
+
+/* Indices of the mappings in #DataTransferRemapCache. */
+enum { VDATA = 0, EDATA = 1, PDATA = 3 };
+
+/**
+ * A grid of `size * size` vertices with unit spacing, moved by \a offset. The heights vary, so
+ * that the faces are not all coplanar.
+ */
+static Mesh *create_grid(const int size, const float3 &offset)
+{
+  const int faces_num = (size - 1) * (size - 1);
+  Mesh *mesh = BKE_mesh_new_nomain(size * size, 0, faces_num, faces_num * 4);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  for (const int y : IndexRange(size)) {
+    for (const int x : IndexRange(size)) {
+      positions[y * size + x] = offset + float3(x, y, 0.1f * ((x * 7 + y * 3) % 5));
+    }
+  }
+  MutableSpan<int> face_offsets = mesh->face_offsets_for_write();
+  for (const int i : face_offsets.index_range()) {
+    face_offsets[i] = i * 4;
+  }
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  for (const int y : IndexRange(size - 1)) {
+    for (const int x : IndexRange(size - 1)) {
+      const int face = y * (size - 1) + x;
+      const int vert = y * size + x;
+      corner_verts[face * 4 + 0] = vert;
+      corner_verts[face * 4 + 1] = vert + 1;
+      corner_verts[face * 4 + 2] = vert + size + 1;
+      corner_verts[face * 4 + 3] = vert + size;
+    }
+  }
+  mesh_calc_edges(*mesh, false, false);
+  return mesh;
+}
+
+class DataTransferRemapCacheTest : public testing::Test {
+ public:
+  Main *bmain = nullptr;
+  Scene *scene = nullptr;
+  ViewLayer *view_layer = nullptr;
+  Depsgraph *depsgraph = nullptr;
+  Object *ob_src = nullptr;
+  Object *ob_dst = nullptr;
+  Mesh *me_dst = nullptr;
+  DataTransferRemapCache *remap_cache = nullptr;
+
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+    DEG_register_node_types();
+  }
+
+  static void TearDownTestSuite()
+  {
+    DEG_free_node_types();
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+    scene = BKE_scene_add(bmain, "Scene");
+    view_layer = static_cast<ViewLayer *>(scene->view_layers.first);
+    ob_src = add_mesh_object("Source", create_grid(8, float3(0.0f)));
+    ob_dst = add_mesh_object("Destination", create_grid(8, float3(0.2f, 0.3f, 0.1f)));
+    /* Like in the modifier, the destination is an evaluated copy of the object's mesh. */
+    me_dst = BKE_mesh_copy_for_eval(static_cast<const Mesh *>(ob_dst->data));
+    remap_cache = BKE_data_transfer_remap_cache_new();
+
+    depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
+    DEG_graph_build_from_view_layer(depsgraph);
+    BKE_scene_graph_update_tagged(depsgraph, bmain);
+  }
+
+  void TearDown() override
+  {
+    BKE_data_transfer_remap_cache_free(remap_cache);
+    BKE_id_free(nullptr, me_dst);
+    DEG_graph_free(depsgraph);
+    BKE_main_free(bmain);
+  }
+
+  Object *add_mesh_object(const char *name, Mesh *mesh)
+  {
+    Object *ob = BKE_object_add(bmain, scene, view_layer, OB_MESH, name);
+    BKE_mesh_nomain_to_mesh(mesh, static_cast<Mesh *>(ob->data), ob);
+    return ob;
+  }
+
+  /** Transfer vertex, edge and face data, with the source evaluated like in the modifier. */
+  void transfer(const int map_vert_mode, const float max_distance)
+  {
+    const int layers_select[DT_MULTILAYER_INDEX_MAX] = {0};
+    BKE_object_data_transfer_ex(depsgraph,
+                                DEG_get_evaluated_object(depsgraph, ob_src),
+                                ob_dst,
+                                me_dst,
+                                DT_TYPE_BWEIGHT_VERT | DT_TYPE_BWEIGHT_EDGE | DT_TYPE_SHARP_FACE,
+                                false,
+                                map_vert_mode,
+                                MREMAP_MODE_EDGE_NEAREST,
+                                MREMAP_MODE_LOOP_NEAREST_POLYNOR,
+                                MREMAP_MODE_POLY_NEAREST,
+                                nullptr,
+                                false,
+                                max_distance,
+                                0.0f,
+                                0.0f,
+                                layers_select,
+                                layers_select,
+                                CDT_MIX_TRANSFER,
+                                1.0f,
+                                nullptr,
+                                false,
+                                remap_cache,
+                                nullptr);
+  }
+
+  const MeshPairRemap &cached_map(const int index)
+  {
+    return *BKE_data_transfer_remap_cache_get_map(remap_cache, index);
+  }
+};
+
+TEST_F(DataTransferRemapCacheTest, UnchangedInputsReuseMaps)
+{
+  transfer(MREMAP_MODE_VERT_NEAREST, 10.0f);
+  const MeshPairRemapItem *vert_items = cached_map(VDATA).items;
+  const MeshPairRemapItem *edge_items = cached_map(EDATA).items;
+  const MeshPairRemapItem *face_items = cached_map(PDATA).items;
+  ASSERT_NE(vert_items, nullptr);
+  ASSERT_NE(edge_items, nullptr);
+  ASSERT_NE(face_items, nullptr);
+  EXPECT_EQ(cached_map(VDATA).items_num, me_dst->verts_num);
+
+  transfer(MREMAP_MODE_VERT_NEAREST, 10.0f);
+  EXPECT_EQ(cached_map(VDATA).items, vert_items);
+  EXPECT_EQ(cached_map(EDATA).items, edge_items);
+  EXPECT_EQ(cached_map(PDATA).items, face_items);
+}
+
+TEST_F(DataTransferRemapCacheTest, MovedSourceVertexRecomputesMaps)
+{
+  transfer(MREMAP_MODE_VERT_NEAREST, 10.0f);
+  const MeshPairRemapItem *vert_items = cached_map(VDATA).items;
+  const MeshPairRemapItem *face_items = cached_map(PDATA).items;
+  ASSERT_EQ(cached_map(VDATA).items[0].sources_num, 1);
+  EXPECT_EQ(cached_map(VDATA).items[0].indices_src[0], 0);
+
+  /* Move the source vertex closest to the first destination vertex away. */
+  Mesh *me_src = static_cast<Mesh *>(ob_src->data);
+  me_src->vert_positions_for_write()[0].z = 100.0f;
+  me_src->tag_positions_changed();
+  DEG_id_tag_update(&me_src->id, ID_RECALC_GEOMETRY);
+  BKE_scene_graph_update_tagged(depsgraph, bmain);
+
+  transfer(MREMAP_MODE_VERT_NEAREST, 10.0f);
+  EXPECT_NE(cached_map(VDATA).items, vert_items);
+  EXPECT_NE(cached_map(PDATA).items, face_items);
+  ASSERT_EQ(cached_map(VDATA).items[0].sources_num, 1);
+  EXPECT_NE(cached_map(VDATA).items[0].indices_src[0], 0);
+}
+
+TEST_F(DataTransferRemapCacheTest, ChangedSettingsRecomputeMaps)
+{
+  transfer(MREMAP_MODE_VERT_NEAREST, 10.0f);
+  const MeshPairRemapItem *vert_items = cached_map(VDATA).items;
+  const MeshPairRemapItem *edge_items = cached_map(EDATA).items;
+
+  /* Only the mapping using the changed mode is recomputed. */
+  transfer(MREMAP_MODE_VERT_EDGEINTERP_NEAREST, 10.0f);
+  EXPECT_NE(cached_map(VDATA).items, vert_items);
+  EXPECT_EQ(cached_map(VDATA).items[0].sources_num, 2);
+  EXPECT_EQ(cached_map(EDATA).items, edge_items);
+  vert_items = cached_map(VDATA).items;
+
+  /* All destination vertices are further away from the source than the maximum distance. */
+  transfer(MREMAP_MODE_VERT_EDGEINTERP_NEAREST, 0.01f);
+  EXPECT_NE(cached_map(VDATA).items, vert_items);
+  EXPECT_NE(cached_map(EDATA).items, edge_items);
+  for (const int i : IndexRange(cached_map(VDATA).items_num)) {
+    EXPECT_EQ(cached_map(VDATA).items[i].sources_num, 0);
+  }
+}
+
+class MeshRemapParallelTest : public testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+};
+
+static void expect_remap_eq(const MeshPairRemap &a, const MeshPairRemap &b)
+{
+  ASSERT_EQ(a.items_num, b.items_num);
+  for (const int i : IndexRange(a.items_num)) {
+    const MeshPairRemapItem &item_a = a.items[i];
+    const MeshPairRemapItem &item_b = b.items[i];
+    ASSERT_EQ(item_a.sources_num, item_b.sources_num);
+    EXPECT_EQ(item_a.island, item_b.island);
+    EXPECT_EQ(Span(item_a.indices_src, item_a.sources_num),
+              Span(item_b.indices_src, item_b.sources_num));
+    EXPECT_EQ(Span(item_a.weights_src, item_a.sources_num),
+              Span(item_b.weights_src, item_b.sources_num));
+  }
+}
+
+/**
+ * Compute a mapping with the default scheduler, where the items are split over several
+ * thread-local arenas, and on a single thread, and check that both are the same.
+ */
+template<typename Fn> static void expect_parallel_remap_matches_serial(const Fn &calc_remap)
+{
+  MeshPairRemap map_parallel = {0};
+  calc_remap(&map_parallel);
+
+  MeshPairRemap map_serial = {0};
+#ifdef WITH_TBB
+  tbb::task_arena single_thread_arena(1);
+  single_thread_arena.execute([&]() { calc_remap(&map_serial); });
+#else
+  calc_remap(&map_serial);
+#endif
+
+  expect_remap_eq(map_parallel, map_serial);
+  BKE_mesh_remap_free(&map_parallel);
+  BKE_mesh_remap_free(&map_serial);
+}
+
+TEST_F(MeshRemapParallelTest, VertsEdgesFaces)
+{
+  /* More than one grain of 1024 items of each type, so that multiple arenas are merged. */
+  Mesh *me_src = create_grid(40, float3(0.0f));
+  Mesh *me_dst = create_grid(40, float3(0.2f, 0.3f, 0.1f));
+  ASSERT_GT(me_dst->faces_num, 1024);
+  const float(*positions_dst)[3] = reinterpret_cast<const float(*)[3]>(
+      me_dst->vert_positions().data());
+
+  for (const int mode : {int(MREMAP_MODE_VERT_NEAREST), int(MREMAP_MODE_TOPOLOGY)}) {
+    expect_parallel_remap_matches_serial([&](MeshPairRemap *r_map) {
+      BKE_mesh_remap_calc_verts_from_mesh(
+          mode, nullptr, FLT_MAX, 0.0f, positions_dst, me_dst->verts_num, me_src, me_dst, r_map);
+    });
+  }
+  for (const int mode : {int(MREMAP_MODE_EDGE_NEAREST), int(MREMAP_MODE_TOPOLOGY)}) {
+    expect_parallel_remap_matches_serial([&](MeshPairRemap *r_map) {
+      BKE_mesh_remap_calc_edges_from_mesh(mode,
+                                          nullptr,
+                                          FLT_MAX,
+                                          0.0f,
+                                          positions_dst,
+                                          me_dst->verts_num,
+                                          me_dst->edges().data(),
+                                          me_dst->edges_num,
+                                          me_src,
+                                          me_dst,
+                                          r_map);
+    });
+  }
+  for (const int mode : {int(MREMAP_MODE_POLY_NEAREST), int(MREMAP_MODE_TOPOLOGY)}) {
+    expect_parallel_remap_matches_serial([&](MeshPairRemap *r_map) {
+      BKE_mesh_remap_calc_faces_from_mesh(mode,
+                                          nullptr,
+                                          FLT_MAX,
+                                          0.0f,
+                                          me_dst,
+                                          positions_dst,
+                                          me_dst->verts_num,
+                                          me_dst->corner_verts().data(),
+                                          me_dst->faces(),
+                                          me_src,
+                                          r_map);
+    });
+  }
+
+  BKE_id_free(nullptr, me_src);
+  BKE_id_free(nullptr, me_dst);
+}
+
+}  // namespace blender::bke::tests
@@ -21,6 +21,7 @@
 #include "DNA_object_types.h"
 #include "DNA_text_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_easing.h"
 #include "BLI_ghash.h"
@@ -28,6 +29,7 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_sort_utils.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 
 #include "BLT_translation.hh"
 
@@ -1077,10 +1079,25 @@ void fcurve_store_samples(FCurve *fcu, void *data, int start, int end, FcuSample
   FPoint *fpt = new_fpt = static_cast<FPoint *>(
       MEM_callocN(sizeof(FPoint) * (end - start + 1), "FPoint Samples"));
 
-  /* Use the sampling callback at 1-frame intervals from start to end frames. */
-  for (int cfra = start; cfra <= end; cfra++, fpt++) {
-    fpt->vec[0] = float(cfra);
-    fpt->vec[1] = sample_cb(fcu, data, float(cfra));
+  if (sample_cb == fcurve_samplingcb_evalcurve && fcu->driver == nullptr) {
+    /* Evaluate all frames at once, which is faster than evaluating them one by one. */
+    blender::Array<float> frames(end - start + 1);
+    blender::Array<float> values(end - start + 1);
+    for (const int i : frames.index_range()) {
+      frames[i] = float(start + i);
+    }
+    evaluate_fcurve_batch(fcu, frames, values);
+    for (const int i : frames.index_range()) {
+      new_fpt[i].vec[0] = frames[i];
+      new_fpt[i].vec[1] = values[i];
+    }
+  }
+  else {
+    /* Use the sampling callback at 1-frame intervals from start to end frames. */
+    for (int cfra = start; cfra <= end; cfra++, fpt++) {
+      fpt->vec[0] = float(cfra);
+      fpt->vec[1] = sample_cb(fcu, data, float(cfra));
+    }
   }
 
   /* Free any existing sample/keyframe data on curve. */
@@ -2076,9 +2093,69 @@ static float fcurve_eval_keyframes_extrapolate(
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
+/**
+ * Threshold used to find the keyframes around the evaluation time.
+ *
+ * The threshold here has the following constraints:
+ * - 0.001 is too coarse:
+ *   We get artifacts with 2cm driver movements at 1BU = 1m (see #40332).
+ *
+ * - 0.00001 is too fine:
+ *   Weird errors, like selecting the wrong keyframe range (see #39207), occur.
+ *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
+ */
+static constexpr float FCURVE_EVAL_KEY_THRESHOLD = 0.0001f;
+
+/** Control points of a Bezier segment between two keyframes, prepared for evaluation. */
+struct FCurveBezierSegment {
+  float v1[2], v2[2], v3[2], v4[2];
+  /** All points have the same value, so the curve is constant in this segment. */
+  bool is_flat;
+};
+
+/**
+ * The keyframe segment used by the previous evaluation time. When evaluating a curve for many
+ * consecutive times, most of them fall into the same segment, so the keyframe search and the
+ * preparation of the Bezier control points can be skipped.
+ */
+struct FCurveSegmentCache {
+  /** Index of the keyframe at the end of the segment, zero when no segment is cached. */
+  uint index = 0;
+  bool bezier_valid = false;
+  FCurveBezierSegment bezier;
+};
+
+static void fcurve_bezier_segment_init(const BezTriple *prevbezt,
+                                       const BezTriple *bezt,
+                                       FCurveBezierSegment &r_segment)
+{
+  /* (v1, v2) are the first keyframe and its 2nd handle. */
+  copy_v2_v2(r_segment.v1, prevbezt->vec[1]);
+  copy_v2_v2(r_segment.v2, prevbezt->vec[2]);
+  /* (v3, v4) are the last keyframe's 1st handle + the last keyframe. */
+  copy_v2_v2(r_segment.v3, bezt->vec[0]);
+  copy_v2_v2(r_segment.v4, bezt->vec[1]);
+
+  /* Optimization: If all the handles are flat/at the same values,
+   * the value is simply the shared value (see #40372 -> F91346).
+   */
+  r_segment.is_flat = fabsf(r_segment.v1[1] - r_segment.v4[1]) < FLT_EPSILON &&
+                      fabsf(r_segment.v2[1] - r_segment.v3[1]) < FLT_EPSILON &&
+                      fabsf(r_segment.v3[1] - r_segment.v4[1]) < FLT_EPSILON;
+  if (!r_segment.is_flat) {
+    /* Adjust handles so that they don't overlap (forming a loop). */
+    BKE_fcurve_correct_bezpart(r_segment.v1, r_segment.v2, r_segment.v3, r_segment.v4);
+  }
+}
+
+/**
+ * \param cache: Optional segment of the previous evaluation. It must only be used for curves with
+ * strictly increasing keyframe times, otherwise the binary search may find a different segment.
+ */
 static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
                                                const BezTriple *bezts,
-                                               float evaltime)
+                                               float evaltime,
+                                               FCurveSegmentCache *cache)
 {
   const float eps = 1.e-8f;
   uint a;
@@ -2086,17 +2163,22 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
   /* Evaluation-time occurs somewhere in the middle of the curve. */
   bool exact = false;
 
-  /* Use binary search to find appropriate keyframes...
-   *
-   * The threshold here has the following constraints:
-   * - 0.001 is too coarse:
-   *   We get artifacts with 2cm driver movements at 1BU = 1m (see #40332).
-   *
-   * - 0.00001 is too fine:
-   *   Weird errors, like selecting the wrong keyframe range (see #39207), occur.
-   *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
-   */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  if (cache && cache->index != 0 &&
+      evaltime - bezts[cache->index - 1].vec[1][0] > FCURVE_EVAL_KEY_THRESHOLD &&
+      bezts[cache->index].vec[1][0] - evaltime > FCURVE_EVAL_KEY_THRESHOLD)
+  {
+    /* Same segment as before, and not close to its keys, so the search would find it again. */
+    a = cache->index;
+  }
+  else {
+    /* Use binary search to find appropriate keyframes... */
+    a = BKE_fcurve_bezt_binarysearch_index_ex(
+        bezts, evaltime, fcu->totvert, FCURVE_EVAL_KEY_THRESHOLD, &exact);
+    if (cache) {
+      cache->index = (exact || a == 0 || a >= uint(fcu->totvert)) ? 0 : a;
+      cache->bezier_valid = false;
+    }
+  }
   const BezTriple *bezt = bezts + a;
 
   if (exact) {
@@ -2146,32 +2228,27 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
   switch (prevbezt->ipo) {
     /* Interpolation ...................................... */
     case BEZT_IPO_BEZ: {
-      float v1[2], v2[2], v3[2], v4[2], opl[32];
-
       /* Bezier interpolation. */
-      /* (v1, v2) are the first keyframe and its 2nd handle. */
-      v1[0] = prevbezt->vec[1][0];
-      v1[1] = prevbezt->vec[1][1];
-      v2[0] = prevbezt->vec[2][0];
-      v2[1] = prevbezt->vec[2][1];
-      /* (v3, v4) are the last keyframe's 1st handle + the last keyframe. */
-      v3[0] = bezt->vec[0][0];
-      v3[1] = bezt->vec[0][1];
-      v4[0] = bezt->vec[1][0];
-      v4[1] = bezt->vec[1][1];
-
-      if (fabsf(v1[1] - v4[1]) < FLT_EPSILON && fabsf(v2[1] - v3[1]) < FLT_EPSILON &&
-          fabsf(v3[1] - v4[1]) < FLT_EPSILON)
-      {
-        /* Optimization: If all the handles are flat/at the same values,
-         * the value is simply the shared value (see #40372 -> F91346).
-         */
+      FCurveBezierSegment local_segment;
+      const FCurveBezierSegment *segment = &local_segment;
+      if (cache && cache->index != 0) {
+        if (!cache->bezier_valid) {
+          fcurve_bezier_segment_init(prevbezt, bezt, cache->bezier);
+          cache->bezier_valid = true;
+        }
+        segment = &cache->bezier;
+      }
+      else {
+        fcurve_bezier_segment_init(prevbezt, bezt, local_segment);
+      }
+      const float *v1 = segment->v1, *v2 = segment->v2, *v3 = segment->v3, *v4 = segment->v4;
+
+      if (segment->is_flat) {
         return v1[1];
       }
-      /* Adjust handles so that they don't overlap (forming a loop). */
-      BKE_fcurve_correct_bezpart(v1, v2, v3, v4);
 
       /* Try to get a value for this position - if failure, try another set of points. */
+      float opl[32];
       if (!findzero(evaltime, v1[0], v2[0], v3[0], v4[0], opl)) {
         if (G.debug & G_DEBUG) {
           printf("    ERROR: findzero() failed at %f with %f %f %f %f\n",
@@ -2340,7 +2417,10 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
 }
 
 /* Calculate F-Curve value for 'evaltime' using #BezTriple keyframes. */
-static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime)
+static float fcurve_eval_keyframes(FCurve *fcu,
+                                   BezTriple *bezts,
+                                   float evaltime,
+                                   FCurveSegmentCache *cache = nullptr)
 {
   if (evaltime <= bezts->vec[1][0]) {
     return fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, 0, +1);
@@ -2351,7 +2431,7 @@ static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime
     return fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, fcu->totvert - 1, -1);
   }
 
-  return fcurve_eval_keyframes_interpolate(fcu, bezts, evaltime);
+  return fcurve_eval_keyframes_interpolate(fcu, bezts, evaltime, cache);
 }
 
 /* Calculate F-Curve value for 'evaltime' using #FPoint samples. */
@@ -2449,6 +2529,56 @@ float evaluate_fcurve_only_curve(FCurve *fcu, float evaltime)
   return evaluate_fcurve_ex(fcu, evaltime, 0.0);
 }
 
+/** Whether the keyframe times are strictly increasing, as required by #FCurveSegmentCache. */
+static bool fcurve_keys_are_strictly_sorted(const FCurve *fcu)
+{
+  for (int i = 1; i < fcu->totvert; i++) {
+    if (!(fcu->bezt[i - 1].vec[1][0] < fcu->bezt[i].vec[1][0])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void evaluate_fcurve_batch(FCurve *fcu,
+                           const blender::Span<float> times,
+                           blender::MutableSpan<float> r_values)
+{
+  BLI_assert(times.size() == r_values.size());
+  if (fcu->bezt == nullptr || fcu->totvert == 0 || !BLI_listbase_is_empty(&fcu->modifiers) ||
+      !fcurve_keys_are_strictly_sorted(fcu))
+  {
+    /* Modifiers and samples don't benefit from the segment cache. */
+    for (const int64_t i : times.index_range()) {
+      r_values[i] = evaluate_fcurve_ex(fcu, times[i], 0.0f);
+    }
+    return;
+  }
+
+  FCurveSegmentCache cache;
+  for (const int64_t i : times.index_range()) {
+    float cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, times[i], &cache);
+    /* Same as #evaluate_fcurve_ex. */
+    if (fcu->flag & FCURVE_INT_VALUES) {
+      cvalue = floorf(cvalue + 0.5f);
+    }
+    r_values[i] = cvalue;
+  }
+}
+
+void evaluate_fcurves_batch(const blender::Span<FCurve *> fcurves,
+                            const blender::Span<float> times,
+                            blender::MutableSpan<float> r_values)
+{
+  BLI_assert(r_values.size() == fcurves.size() * times.size());
+  const int64_t grain_size = std::max<int64_t>(1, 4096 / std::max<int64_t>(times.size(), 1));
+  blender::threading::parallel_for(fcurves.index_range(), grain_size, [&](const auto range) {
+    for (const int64_t i : range) {
+      evaluate_fcurve_batch(fcurves[i], times, r_values.slice(i * times.size(), times.size()));
+    }
+  });
+}
+
 float evaluate_fcurve_driver(PathResolvedRNA *anim_rna,
                              FCurve *fcu,
                              ChannelDriver *driver_orig,
@@ -1199,6 +1199,11 @@ static bool driver_compile_simple_expr(ChannelDriver *driver)
   if (atomic_cas_ptr((void **)&driver->expr_simple, nullptr, expr) != nullptr) {
     BLI_expr_pylike_free(expr);
   }
+  else if (!BLI_expr_pylike_is_valid(expr) && driver->expression[0] != '\0') {
+    /* Report once per compilation which drivers need Python, which serializes their
+     * evaluation with all other Python drivers. Use `--log "bke.fcurve"` to see these. */
+    CLOG_INFO(&LOG, 1, "driver expression needs Python: '%s'", driver->expression);
+  }
 
   return true;
 }
@@ -13,7 +13,9 @@
 
 #include "DNA_anim_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_vector.hh"
 
 namespace blender::bke::tests {
 using namespace blender::animrig;
@@ -209,6 +211,76 @@ TEST(evaluate_fcurve, ExtrapolationBezierKeys)
   BKE_fcurve_free(fcu);
 }
 
+/* Evaluate the curve at many consecutive times, including times on and very close to keys. */
+static void expect_batch_matches_single(FCurve *fcu)
+{
+  Vector<float> times;
+  for (int i = -40; i <= 200; i++) {
+    times.append(float(i) * 0.05f);
+  }
+  times.extend({3.0f, 3.00008f, 2.99992f, 5.0f, 1.0f, 0.5f, 4.5f});
+
+  Array<float> values(times.size());
+  evaluate_fcurve_batch(fcu, times, values);
+  for (const int64_t i : times.index_range()) {
+    EXPECT_EQ(values[i], evaluate_fcurve(fcu, times[i])) << "at time " << times[i];
+  }
+}
+
+TEST(evaluate_fcurve_batch, MatchesSingle)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  const KeyframeSettings settings = get_keyframe_settings(false);
+  insert_vert_fcurve(fcu, {1.0f, 7.0f}, settings, INSERTKEY_NOFLAGS);
+  insert_vert_fcurve(fcu, {3.0f, 13.0f}, settings, INSERTKEY_NOFLAGS);
+  insert_vert_fcurve(fcu, {4.0f, 13.0f}, settings, INSERTKEY_NOFLAGS);
+  insert_vert_fcurve(fcu, {5.0f, 13.0f}, settings, INSERTKEY_NOFLAGS);
+  insert_vert_fcurve(fcu, {7.5f, -2.0f}, settings, INSERTKEY_NOFLAGS);
+  insert_vert_fcurve(fcu, {8.0f, 4.0f}, settings, INSERTKEY_NOFLAGS);
+
+  expect_batch_matches_single(fcu);
+
+  fcu->extend = FCURVE_EXTRAPOLATE_LINEAR;
+  fcu->bezt[3].ipo = BEZT_IPO_LIN;
+  fcu->bezt[4].ipo = BEZT_IPO_CONST;
+  expect_batch_matches_single(fcu);
+
+  fcu->flag |= FCURVE_INT_VALUES;
+  expect_batch_matches_single(fcu);
+
+  /* Modifiers use the regular evaluation for every time. */
+  add_fmodifier(&fcu->modifiers, FMODIFIER_TYPE_NOISE, fcu);
+  expect_batch_matches_single(fcu);
+
+  BKE_fcurve_free(fcu);
+}
+
+TEST(evaluate_fcurve_batch, MultipleCurves)
+{
+  const KeyframeSettings settings = get_keyframe_settings(false);
+  Vector<FCurve *> fcurves;
+  for (const int i : IndexRange(5)) {
+    FCurve *fcu = BKE_fcurve_create();
+    insert_vert_fcurve(fcu, {1.0f, float(i)}, settings, INSERTKEY_NOFLAGS);
+    insert_vert_fcurve(fcu, {10.0f, float(i * 3)}, settings, INSERTKEY_NOFLAGS);
+    fcurves.append(fcu);
+  }
+  const Array<float> times = {0.0f, 2.5f, 5.0f, 7.5f, 10.0f, 12.5f};
+
+  Array<float> values(fcurves.size() * times.size());
+  evaluate_fcurves_batch(fcurves, times, values);
+  for (const int64_t curve : fcurves.index_range()) {
+    for (const int64_t i : times.index_range()) {
+      EXPECT_EQ(values[curve * times.size() + i], evaluate_fcurve(fcurves[curve], times[i]));
+    }
+  }
+
+  for (FCurve *fcu : fcurves) {
+    BKE_fcurve_free(fcu);
+  }
+}
+
 TEST(fcurve_subdivide, BKE_fcurve_bezt_subdivide_handles)
 {
   FCurve *fcu = BKE_fcurve_create();
@@ -15,6 +15,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_endian_switch.h"
+#include "BLI_index_mask.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.hh"
@@ -1614,9 +1615,19 @@ float *BKE_key_evaluate_object_ex(
       case ID_ME: {
         Mesh *mesh = (Mesh *)obdata;
         const int totvert = min_ii(tot, mesh->verts_num);
-        mesh->vert_positions_for_write().take_front(totvert).copy_from(
-            {reinterpret_cast<const blender::float3 *>(out), totvert});
-        mesh->tag_positions_changed();
+        blender::MutableSpan<blender::float3> positions =
+            mesh->vert_positions_for_write().take_front(totvert);
+        const blender::Span<blender::float3> key_positions(
+            reinterpret_cast<const blender::float3 *>(out), totvert);
+        /* Shape keys often only move a few vertices, which allows updating cached normals for
+         * the affected faces only. */
+        blender::IndexMaskMemory memory;
+        const blender::IndexMask changed_verts = blender::IndexMask::from_predicate(
+            positions.index_range(), blender::GrainSize(4096), memory, [&](const int64_t i) {
+              return positions[i] != key_positions[i];
+            });
+        positions.copy_from(key_positions);
+        mesh->tag_positions_changed(changed_verts);
         break;
       }
       case ID_LT: {
@@ -13,12 +13,18 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <limits>
+#include <mutex>
+#include <optional>
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_math_matrix.h"
+#include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector.h"
 #include "BLI_simd.hh"
+#include "BLI_struct_equality_utils.hh"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
 
@@ -141,25 +147,24 @@ LatticeDeformData *BKE_lattice_deform_data_create(const Object *oblatt, const Ob
   return lattice_deform_data;
 }
 
-void BKE_lattice_deform_data_eval_co(LatticeDeformData *lattice_deform_data,
-                                     float co[3],
-                                     float weight)
+/**
+ * The 4x4x4 lattice points that influence a coordinate, and their B-spline weights along every
+ * axis. Only depends on the coordinate and the rest state of the lattice, not on the positions of
+ * the lattice points, so it can be reused when only the lattice is animated.
+ */
+struct LatticeDeformCell {
+  /** Index of the second of the four points along each axis, before clamping. */
+  int ui, vi, wi;
+  float tu[4], tv[4], tw[4];
+};
+
+static void lattice_deform_cell_calc(const LatticeDeformData *lattice_deform_data,
+                                     const float co[3],
+                                     LatticeDeformCell *r_cell)
 {
-  float *latticedata = lattice_deform_data->latticedata;
-  float *lattice_weights = lattice_deform_data->lattice_weights;
-  BLI_assert(latticedata);
   const Lattice *lt = lattice_deform_data->lt;
-  float u, v, w, tu[4], tv[4], tw[4];
+  float u, v, w;
   float vec[3];
-  int idx_w, idx_v, idx_u;
-  int ui, vi, wi, uu, vv, ww;
-
-  /* vgroup influence */
-  float co_prev[4] = {0}, weight_blend = 0.0f;
-  copy_v3_v3(co_prev, co);
-#if BLI_HAVE_SSE2
-  __m128 co_vec = _mm_loadu_ps(co_prev);
-#endif
 
   /* co is in local coords, treat with latmat */
   mul_v3_m4v3(vec, lattice_deform_data->latmat, co);
@@ -168,39 +173,58 @@ void BKE_lattice_deform_data_eval_co(LatticeDeformData *lattice_deform_data,
 
   if (lt->pntsu > 1) {
     u = (vec[0] - lt->fu) / lt->du;
-    ui = int(floor(u));
-    u -= ui;
-    key_curve_position_weights(u, tu, lt->typeu);
+    r_cell->ui = int(floor(u));
+    u -= r_cell->ui;
+    key_curve_position_weights(u, r_cell->tu, lt->typeu);
   }
   else {
-    tu[0] = tu[2] = tu[3] = 0.0;
-    tu[1] = 1.0;
-    ui = 0;
+    r_cell->tu[0] = r_cell->tu[2] = r_cell->tu[3] = 0.0;
+    r_cell->tu[1] = 1.0;
+    r_cell->ui = 0;
   }
 
   if (lt->pntsv > 1) {
     v = (vec[1] - lt->fv) / lt->dv;
-    vi = int(floor(v));
-    v -= vi;
-    key_curve_position_weights(v, tv, lt->typev);
+    r_cell->vi = int(floor(v));
+    v -= r_cell->vi;
+    key_curve_position_weights(v, r_cell->tv, lt->typev);
   }
   else {
-    tv[0] = tv[2] = tv[3] = 0.0;
-    tv[1] = 1.0;
-    vi = 0;
+    r_cell->tv[0] = r_cell->tv[2] = r_cell->tv[3] = 0.0;
+    r_cell->tv[1] = 1.0;
+    r_cell->vi = 0;
   }
 
   if (lt->pntsw > 1) {
     w = (vec[2] - lt->fw) / lt->dw;
-    wi = int(floor(w));
-    w -= wi;
-    key_curve_position_weights(w, tw, lt->typew);
+    r_cell->wi = int(floor(w));
+    w -= r_cell->wi;
+    key_curve_position_weights(w, r_cell->tw, lt->typew);
   }
   else {
-    tw[0] = tw[2] = tw[3] = 0.0;
-    tw[1] = 1.0;
-    wi = 0;
+    r_cell->tw[0] = r_cell->tw[2] = r_cell->tw[3] = 0.0;
+    r_cell->tw[1] = 1.0;
+    r_cell->wi = 0;
   }
+}
+
+static void lattice_deform_cell_apply(const LatticeDeformData *lattice_deform_data,
+                                      const LatticeDeformCell *cell,
+                                      float co[3],
+                                      const float weight)
+{
+  const float *latticedata = lattice_deform_data->latticedata;
+  const float *lattice_weights = lattice_deform_data->lattice_weights;
+  BLI_assert(latticedata);
+  const Lattice *lt = lattice_deform_data->lt;
+  float u, v, w;
+
+  /* vgroup influence */
+  float co_prev[4] = {0}, weight_blend = 0.0f;
+  copy_v3_v3(co_prev, co);
+#if BLI_HAVE_SSE2
+  __m128 co_vec = _mm_loadu_ps(co_prev);
+#endif
 
   const int w_stride = lt->pntsu * lt->pntsv;
   const int idx_w_max = (lt->pntsw - 1) * lt->pntsu * lt->pntsv;
@@ -208,16 +232,21 @@ void BKE_lattice_deform_data_eval_co(LatticeDeformData *lattice_deform_data,
   const int idx_v_max = (lt->pntsv - 1) * lt->pntsu;
   const int idx_u_max = (lt->pntsu - 1);
 
-  for (ww = wi - 1; ww <= wi + 2; ww++) {
-    w = weight * tw[ww - wi + 1];
-    idx_w = std::clamp(ww * w_stride, 0, idx_w_max);
-    for (vv = vi - 1; vv <= vi + 2; vv++) {
-      v = w * tv[vv - vi + 1];
-      idx_v = std::clamp(vv * v_stride, 0, idx_v_max);
-      for (uu = ui - 1; uu <= ui + 2; uu++) {
-        u = v * tu[uu - ui + 1];
-        idx_u = std::clamp(uu, 0, idx_u_max);
-        const int idx = idx_w + idx_v + idx_u;
+  /* Clamp the point indices once, instead of in the innermost loop. */
+  int idx_w[4], idx_v[4], idx_u[4];
+  for (int i = 0; i < 4; i++) {
+    idx_w[i] = std::clamp((cell->wi - 1 + i) * w_stride, 0, idx_w_max);
+    idx_v[i] = std::clamp((cell->vi - 1 + i) * v_stride, 0, idx_v_max);
+    idx_u[i] = std::clamp(cell->ui - 1 + i, 0, idx_u_max);
+  }
+
+  for (int ww = 0; ww < 4; ww++) {
+    w = weight * cell->tw[ww];
+    for (int vv = 0; vv < 4; vv++) {
+      v = w * cell->tv[vv];
+      for (int uu = 0; uu < 4; uu++) {
+        u = v * cell->tu[uu];
+        const int idx = idx_w[ww] + idx_v[vv] + idx_u[uu];
 #if BLI_HAVE_SSE2
         {
           __m128 weight_vec = _mm_set1_ps(u);
@@ -253,6 +282,15 @@ void BKE_lattice_deform_data_eval_co(LatticeDeformData *lattice_deform_data,
   }
 }
 
+void BKE_lattice_deform_data_eval_co(LatticeDeformData *lattice_deform_data,
+                                     float co[3],
+                                     float weight)
+{
+  LatticeDeformCell cell;
+  lattice_deform_cell_calc(lattice_deform_data, co, &cell);
+  lattice_deform_cell_apply(lattice_deform_data, &cell, co, weight);
+}
+
 void BKE_lattice_deform_data_destroy(LatticeDeformData *lattice_deform_data)
 {
   if (lattice_deform_data->latticedata) {
@@ -264,6 +302,83 @@ void BKE_lattice_deform_data_destroy(LatticeDeformData *lattice_deform_data)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Lattice Deform Binding
+ *
+ * Computing the lattice cell of every vertex is a significant part of the deformation, but it
+ * only has to be redone when the vertex, the lattice resolution or the transform between the
+ * objects change. When only the lattice points are animated, the deformation is reduced to
+ * blending the stored cells with the new lattice points.
+ * \{ */
+
+namespace blender::bke {
+
+/** Everything besides the vertex positions that the lattice cells depend on. */
+struct LatticeDeformSpace {
+  float4x4 latmat;
+  int3 points_num;
+  int3 types;
+  float3 start;
+  float3 step;
+
+  BLI_STRUCT_EQUALITY_OPERATORS_5(LatticeDeformSpace, latmat, points_num, types, start, step)
+};
+
+struct LatticeDeformBinding {
+  /** Used when the same modifier is evaluated from multiple threads. */
+  std::mutex mutex;
+
+  std::optional<LatticeDeformSpace> space;
+  /** The vertex positions the cells were computed for. */
+  Array<float3> positions;
+  Array<LatticeDeformCell> cells;
+};
+
+LatticeDeformBinding *lattice_deform_binding_new()
+{
+  return MEM_new<LatticeDeformBinding>(__func__);
+}
+
+void lattice_deform_binding_free(LatticeDeformBinding *binding)
+{
+  MEM_delete(binding);
+}
+
+static LatticeDeformSpace lattice_deform_space_get(const LatticeDeformData &lattice_deform_data)
+{
+  const Lattice &lt = *lattice_deform_data.lt;
+  LatticeDeformSpace space;
+  space.latmat = float4x4(lattice_deform_data.latmat);
+  space.points_num = int3(lt.pntsu, lt.pntsv, lt.pntsw);
+  space.types = int3(lt.typeu, lt.typev, lt.typew);
+  space.start = float3(lt.fu, lt.fv, lt.fw);
+  space.step = float3(lt.du, lt.dv, lt.dw);
+  return space;
+}
+
+/**
+ * Invalidate all cells when the lattice space or the number of vertices changed. Cells of single
+ * vertices are recomputed during deformation when their position changed.
+ */
+static void lattice_deform_binding_update(LatticeDeformBinding &binding,
+                                          const LatticeDeformData &lattice_deform_data,
+                                          const int verts_num)
+{
+  const LatticeDeformSpace space = lattice_deform_space_get(lattice_deform_data);
+  if (binding.space == space && binding.positions.size() == verts_num) {
+    return;
+  }
+  binding.space = space;
+  binding.positions.reinitialize(verts_num);
+  binding.cells.reinitialize(verts_num);
+  /* NaN never compares equal, so every cell is computed on first use. */
+  binding.positions.fill(float3(std::numeric_limits<float>::quiet_NaN()));
+}
+
+}  // namespace blender::bke
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Lattice Deform #BKE_lattice_deform_coords API
  *
@@ -273,6 +388,9 @@ void BKE_lattice_deform_data_destroy(LatticeDeformData *lattice_deform_data)
 struct LatticeDeformUserdata {
   LatticeDeformData *lattice_deform_data;
   float (*vert_coords)[3];
+  /** Optional cells from a previous evaluation, see #LatticeDeformBinding. */
+  blender::MutableSpan<blender::float3> bound_positions;
+  blender::MutableSpan<LatticeDeformCell> bound_cells;
   const MDeformVert *dvert;
   int defgrp_index;
   float fac;
@@ -284,6 +402,24 @@ struct LatticeDeformUserdata {
   } bmesh;
 };
 
+static void lattice_deform_vert(const LatticeDeformUserdata *data,
+                                const int index,
+                                const float weight)
+{
+  float *co = data->vert_coords[index];
+  if (data->bound_cells.is_empty()) {
+    BKE_lattice_deform_data_eval_co(data->lattice_deform_data, co, weight);
+    return;
+  }
+  LatticeDeformCell &cell = data->bound_cells[index];
+  blender::float3 &bound_position = data->bound_positions[index];
+  if (bound_position != blender::float3(co)) {
+    lattice_deform_cell_calc(data->lattice_deform_data, co, &cell);
+    bound_position = co;
+  }
+  lattice_deform_cell_apply(data->lattice_deform_data, &cell, co, weight);
+}
+
 static void lattice_deform_vert_with_dvert(const LatticeDeformUserdata *data,
                                            const int index,
                                            const MDeformVert *dvert)
@@ -293,13 +429,11 @@ static void lattice_deform_vert_with_dvert(const LatticeDeformUserdata *data,
                              1.0f - BKE_defvert_find_weight(dvert, data->defgrp_index) :
                              BKE_defvert_find_weight(dvert, data->defgrp_index);
     if (weight > 0.0f) {
-      BKE_lattice_deform_data_eval_co(
-          data->lattice_deform_data, data->vert_coords[index], weight * data->fac);
+      lattice_deform_vert(data, index, weight * data->fac);
     }
   }
   else {
-    BKE_lattice_deform_data_eval_co(
-        data->lattice_deform_data, data->vert_coords[index], data->fac);
+    lattice_deform_vert(data, index, data->fac);
   }
 }
 
@@ -339,7 +473,8 @@ static void lattice_deform_coords_impl(const Object *ob_lattice,
                                        const char *defgrp_name,
                                        const float fac,
                                        const Mesh *me_target,
-                                       BMEditMesh *em_target)
+                                       BMEditMesh *em_target,
+                                       blender::bke::LatticeDeformBinding *binding)
 {
   LatticeDeformData *lattice_deform_data;
   const MDeformVert *dvert = nullptr;
@@ -386,6 +521,14 @@ static void lattice_deform_coords_impl(const Object *ob_lattice,
   data.invert_vgroup = (flag & MOD_LATTICE_INVERT_VGROUP) != 0;
   data.bmesh.cd_dvert_offset = cd_dvert_offset;
 
+  std::unique_lock<std::mutex> binding_lock;
+  if (binding && me_target && em_target == nullptr) {
+    binding_lock = std::unique_lock(binding->mutex);
+    blender::bke::lattice_deform_binding_update(*binding, *lattice_deform_data, vert_coords_len);
+    data.bound_positions = binding->positions;
+    data.bound_cells = binding->cells;
+  }
+
   if (em_target != nullptr) {
     /* While this could cause an extra loop over mesh data, in most cases this will
      * have already been properly set. */
@@ -429,6 +572,7 @@ void BKE_lattice_deform_coords(const Object *ob_lattice,
                              defgrp_name,
                              fac,
                              nullptr,
+                             nullptr,
                              nullptr);
 }
 
@@ -439,7 +583,8 @@ void BKE_lattice_deform_coords_with_mesh(const Object *ob_lattice,
                                          const short flag,
                                          const char *defgrp_name,
                                          const float fac,
-                                         const Mesh *me_target)
+                                         const Mesh *me_target,
+                                         blender::bke::LatticeDeformBinding *binding)
 {
   lattice_deform_coords_impl(ob_lattice,
                              ob_target,
@@ -449,7 +594,8 @@ void BKE_lattice_deform_coords_with_mesh(const Object *ob_lattice,
                              defgrp_name,
                              fac,
                              me_target,
-                             nullptr);
+                             nullptr,
+                             binding);
 }
 
 void BKE_lattice_deform_coords_with_editmesh(const Object *ob_lattice,
@@ -469,7 +615,8 @@ void BKE_lattice_deform_coords_with_editmesh(const Object *ob_lattice,
                              defgrp_name,
                              fac,
                              nullptr,
-                             em_target);
+                             em_target,
+                             nullptr);
 }
 
 /** \} */
@@ -3,20 +3,22 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 #include "testing/testing.h"
 
-#define DO_PERF_TESTS 0
-
-#if DO_PERF_TESTS
+#include "BKE_idtype.hh"
+#include "BKE_lattice.hh"
 
-#  include "BKE_idtype.hh"
-#  include "BKE_lattice.hh"
+#include "MEM_guardedalloc.h"
 
-#  include "MEM_guardedalloc.h"
+#include "DNA_curve_types.h"
+#include "DNA_lattice_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
 
-#  include "DNA_lattice_types.h"
-#  include "DNA_mesh_types.h"
-#  include "DNA_object_types.h"
+#include "BLI_array.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_rand.hh"
+#include "BLI_string.h"
 
-#  include "BLI_rand.hh"
+#define DO_PERF_TESTS 0
 
 namespace blender::bke::tests {
 
@@ -35,7 +37,7 @@ static void test_lattice_deform_init(LatticeDeformTestContext *ctx,
 {
   /* Generate random input data between -5 and 5. */
   ctx->coords = (float(*)[3])MEM_malloc_arrayN(num_items, sizeof(float[3]), __func__);
-  for (uint32_t index = 0; index < num_items; index++) {
+  for (int32_t index = 0; index < num_items; index++) {
     ctx->coords[index][0] = (rng->get_float() - 0.5f) * 10;
     ctx->coords[index][1] = (rng->get_float() - 0.5f) * 10;
     ctx->coords[index][2] = (rng->get_float() - 0.5f) * 10;
@@ -71,6 +73,61 @@ static void test_lattice_deform_free(LatticeDeformTestContext *ctx)
   IDType_ID_ME.free_data(&ctx->mesh.id);
 }
 
+TEST(lattice_deform, binding)
+{
+  const int32_t num_items = 1000;
+  LatticeDeformTestContext ctx = {dna::shallow_zero_initialize()};
+  RandomNumberGenerator rng;
+  test_lattice_deform_init(&ctx, &rng, num_items);
+  const int points_num = ctx.lattice.pntsu * ctx.lattice.pntsv * ctx.lattice.pntsw;
+
+  /* Positions inside and around the lattice. */
+  Array<float3> orig_coords(num_items);
+  for (float3 &co : orig_coords) {
+    co = float3(rng.get_float(), rng.get_float(), rng.get_float()) * 1.5f - 0.75f;
+  }
+
+  LatticeDeformBinding *binding = lattice_deform_binding_new();
+  for (const int iteration : IndexRange(3)) {
+    /* Mostly animate the lattice points, so that the cells of the previous iteration are reused.
+     * Moving a single vertex only requires its own cell to be recomputed. */
+    orig_coords[iteration] += float3(0.25f);
+    for (const int i : IndexRange(points_num)) {
+      ctx.lattice.def[i].vec[0] += (rng.get_float() - 0.5f) * 0.2f;
+      ctx.lattice.def[i].vec[1] += (rng.get_float() - 0.5f) * 0.2f;
+      ctx.lattice.def[i].vec[2] += (rng.get_float() - 0.5f) * 0.2f;
+    }
+
+    Array<float3> expected = orig_coords;
+    BKE_lattice_deform_coords_with_mesh(&ctx.ob_lattice,
+                                        &ctx.ob_mesh,
+                                        reinterpret_cast<float(*)[3]>(expected.data()),
+                                        num_items,
+                                        0,
+                                        nullptr,
+                                        1.0f,
+                                        &ctx.mesh);
+    Array<float3> result = orig_coords;
+    BKE_lattice_deform_coords_with_mesh(&ctx.ob_lattice,
+                                        &ctx.ob_mesh,
+                                        reinterpret_cast<float(*)[3]>(result.data()),
+                                        num_items,
+                                        0,
+                                        nullptr,
+                                        1.0f,
+                                        &ctx.mesh,
+                                        binding);
+    for (const int i : IndexRange(num_items)) {
+      EXPECT_EQ(result[i], expected[i]);
+    }
+  }
+  lattice_deform_binding_free(binding);
+
+  test_lattice_deform_free(&ctx);
+}
+
+#if DO_PERF_TESTS
+
 TEST(lattice_deform_performance, performance_no_dvert_1)
 {
   const int32_t num_items = 1;
@@ -126,5 +183,6 @@ TEST(lattice_deform_performance, performance_no_dvert_10000000)
   test_lattice_deform_free(&ctx);
 }
 
-}  // namespace blender::bke::tests
 #endif
+
+}  // namespace blender::bke::tests
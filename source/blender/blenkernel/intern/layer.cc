@@ -14,7 +14,9 @@
 #include "CLG_log.h"
 
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_mempool.h"
+#include "BLI_set.hh"
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
 #include "BLI_string_utils.hh"
@@ -820,8 +822,32 @@ struct LayerCollectionResync {
   bool is_used;
 };
 
+/**
+ * Lookup data of the old layers hierarchy, used to skip the search in
+ * #layer_collection_resync_find in the common cases, since it is quadratic with the number of
+ * collections.
+ */
+struct LayerCollectionResyncLookup {
+  /**
+   * Old child layers of a parent layer, by the collection they use. Only the first matching child
+   * is stored, which is also what the search would find first.
+   */
+  blender::Map<std::pair<const LayerCollectionResync *, const Collection *>,
+               LayerCollectionResync *>
+      children;
+  /**
+   * Number of old layers per collection that are neither used nor valid as child, i.e. the
+   * candidates that the search may find when a collection is not an old child of the parent.
+   */
+  blender::Map<const Collection *, int> unused_layers_num;
+};
+
 static LayerCollectionResync *layer_collection_resync_create_recurse(
-    LayerCollectionResync *parent_layer_resync, LayerCollection *layer, BLI_mempool *mempool)
+    LayerCollectionResync *parent_layer_resync,
+    const blender::Set<const Collection *> *parent_children_collections,
+    LayerCollection *layer,
+    BLI_mempool *mempool,
+    LayerCollectionResyncLookup &lookup)
 {
   LayerCollectionResync *layer_resync = static_cast<LayerCollectionResync *>(
       BLI_mempool_calloc(mempool));
@@ -834,26 +860,38 @@ static LayerCollectionResync *layer_collection_resync_create_recurse(
   }
 
   layer_resync->is_usable = (layer->collection != nullptr);
-  layer_resync->is_valid_as_child =
-      layer_resync->is_usable && (parent_layer_resync == nullptr ||
-                                  (parent_layer_resync->is_usable &&
-                                   BLI_findptr(&parent_layer_resync->layer->collection->children,
-                                               layer->collection,
-                                               offsetof(CollectionChild, collection)) != nullptr));
+  layer_resync->is_valid_as_child = layer_resync->is_usable &&
+                                    (parent_layer_resync == nullptr ||
+                                     (parent_layer_resync->is_usable &&
+                                      parent_children_collections->contains(layer->collection)));
+  if (layer_resync->is_usable && parent_layer_resync != nullptr) {
+    lookup.children.add({parent_layer_resync, layer->collection}, layer_resync);
+  }
   if (layer_resync->is_valid_as_child) {
     layer_resync->is_used = parent_layer_resync != nullptr ? parent_layer_resync->is_used : true;
   }
   else {
     layer_resync->is_used = false;
   }
+  if (layer_resync->is_usable && !layer_resync->is_used && !layer_resync->is_valid_as_child) {
+    lookup.unused_layers_num.add_or_modify(
+        layer->collection, [](int *num) { *num = 1; }, [](int *num) { (*num)++; });
+  }
 
   if (BLI_listbase_is_empty(&layer->layer_collections)) {
     layer_resync->is_valid_as_parent = layer_resync->is_usable;
   }
   else {
+    /* Current children collections, to check the validity of the old child layers. */
+    blender::Set<const Collection *> children_collections;
+    if (layer_resync->is_usable) {
+      LISTBASE_FOREACH (CollectionChild *, child, &layer->collection->children) {
+        children_collections.add(child->collection);
+      }
+    }
     LISTBASE_FOREACH (LayerCollection *, child_layer, &layer->layer_collections) {
       LayerCollectionResync *child_layer_resync = layer_collection_resync_create_recurse(
-          layer_resync, child_layer, mempool);
+          layer_resync, &children_collections, child_layer, mempool, lookup);
       if (layer_resync->is_usable && child_layer_resync->is_valid_as_child) {
         layer_resync->is_valid_as_parent = true;
       }
@@ -873,8 +911,10 @@ static LayerCollectionResync *layer_collection_resync_create_recurse(
   return layer_resync;
 }
 
-static LayerCollectionResync *layer_collection_resync_find(LayerCollectionResync *layer_resync,
-                                                           Collection *child_collection)
+static LayerCollectionResync *layer_collection_resync_find(
+    LayerCollectionResync *layer_resync,
+    Collection *child_collection,
+    const LayerCollectionResyncLookup &lookup)
 {
   /* Given the given parent, valid layer collection, find in the old hierarchy the best possible
    * unused layer matching the given child collection.
@@ -891,6 +931,19 @@ static LayerCollectionResync *layer_collection_resync_find(LayerCollectionResync
   BLI_assert(layer_resync->collection != child_collection);
   BLI_assert(child_collection != nullptr);
 
+  /* Unchanged hierarchy case: an old direct child of the given parent using the seeked collection
+   * is always the first valid candidate of the search below. */
+  if (LayerCollectionResync *child_layer_resync = lookup.children.lookup_default(
+          {layer_resync, child_collection}, nullptr))
+  {
+    return child_layer_resync;
+  }
+  /* Otherwise only unused layers that are not part of a valid hierarchy chain can be found. This
+   * is always the case for new collections. */
+  if (lookup.unused_layers_num.lookup_default(child_collection, 0) == 0) {
+    return nullptr;
+  }
+
   LayerCollectionResync *current_layer_resync = nullptr;
   LayerCollectionResync *root_layer_resync = layer_resync;
 
@@ -1087,6 +1140,7 @@ static void layer_collection_objects_sync(ViewLayer *view_layer,
 static void layer_collection_sync(ViewLayer *view_layer,
                                   LayerCollectionResync *layer_resync,
                                   BLI_mempool *layer_resync_mempool,
+                                  LayerCollectionResyncLookup &lookup,
                                   ListBase *r_lb_new_object_bases,
                                   const short parent_layer_flag,
                                   const short parent_collection_restrict,
@@ -1117,8 +1171,8 @@ static void layer_collection_sync(ViewLayer *view_layer,
       skipped_children++;
       continue;
     }
-    LayerCollectionResync *child_layer_resync = layer_collection_resync_find(layer_resync,
-                                                                             child_collection);
+    LayerCollectionResync *child_layer_resync = layer_collection_resync_find(
+        layer_resync, child_collection, lookup);
 
     if (child_layer_resync != nullptr) {
       BLI_assert(child_layer_resync->collection != nullptr);
@@ -1140,6 +1194,9 @@ static void layer_collection_sync(ViewLayer *view_layer,
                   layer_resync->collection->id.name);
       }
 
+      if (!child_layer_resync->is_used && !child_layer_resync->is_valid_as_child) {
+        lookup.unused_layers_num.lookup(child_collection)--;
+      }
       child_layer_resync->is_used = true;
 
       /* NOTE: Do not move the resync wrapper to match the new layer hierarchy, so that the old
@@ -1196,6 +1253,7 @@ static void layer_collection_sync(ViewLayer *view_layer,
     layer_collection_sync(view_layer,
                           child_layer_resync,
                           layer_resync_mempool,
+                          lookup,
                           r_lb_new_object_bases,
                           child_layer->flag,
                           child_collection_restrict,
@@ -1355,10 +1413,13 @@ void BKE_layer_collection_sync(const Scene *scene, ViewLayer *view_layer)
    * new collections hierarchy. */
   BLI_mempool *layer_resync_mempool = BLI_mempool_create(
       sizeof(LayerCollectionResync), 1024, 1024, BLI_MEMPOOL_NOP);
+  LayerCollectionResyncLookup lookup;
   LayerCollectionResync *master_layer_resync = layer_collection_resync_create_recurse(
+      nullptr,
       nullptr,
       static_cast<LayerCollection *>(view_layer->layer_collections.first),
-      layer_resync_mempool);
+      layer_resync_mempool,
+      lookup);
 
   /* Clear the cached flag indicating if the view layer has a collection exporter set. */
   view_layer->flag &= ~VIEW_LAYER_HAS_EXPORT_COLLECTIONS;
@@ -1369,6 +1430,7 @@ void BKE_layer_collection_sync(const Scene *scene, ViewLayer *view_layer)
   layer_collection_sync(view_layer,
                         master_layer_resync,
                         layer_resync_mempool,
+                        lookup,
                         &new_object_bases,
                         parent_exclude,
                         parent_restrict,
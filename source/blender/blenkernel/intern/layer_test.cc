@@ -5,10 +5,16 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "DNA_collection_types.h"
+
 #include "BKE_appdir.hh"
+#include "BKE_collection.hh"
 #include "BKE_idtype.hh"
 #include "BKE_layer.hh"
+#include "BKE_main.hh"
+#include "BKE_scene.hh"
 
+#include "BLI_listbase.h"
 #include "BLI_string.h"
 
 #include "RE_engine.h"
@@ -165,4 +171,222 @@ TEST(view_layer, aov_conflict)
   GHOST_DisposeSystemPaths();
 }
 
+class LayerCollectionResyncTest : public testing::Test {
+ public:
+  Main *bmain = nullptr;
+  Scene *scene = nullptr;
+  ViewLayer *view_layer = nullptr;
+
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+    scene = BKE_scene_add(bmain, "Scene");
+    view_layer = static_cast<ViewLayer *>(scene->view_layers.first);
+  }
+
+  void TearDown() override
+  {
+    BKE_main_free(bmain);
+  }
+
+  Collection *add_collection(Collection *parent, const char *name)
+  {
+    return BKE_collection_add(bmain, parent ? parent : scene->master_collection, name);
+  }
+
+  LayerCollection *master_layer()
+  {
+    return static_cast<LayerCollection *>(view_layer->layer_collections.first);
+  }
+
+  /** Resync the layer collections, and check that they match the collection hierarchy. */
+  void resync()
+  {
+    BKE_view_layer_synced_ensure(scene, view_layer);
+    expect_layer_tree_matches_collections(master_layer());
+  }
+
+  static void expect_layer_tree_matches_collections(const LayerCollection *layer)
+  {
+    ASSERT_EQ(BLI_listbase_count(&layer->layer_collections),
+              BLI_listbase_count(&layer->collection->children));
+    const LayerCollection *child_layer = static_cast<const LayerCollection *>(
+        layer->layer_collections.first);
+    LISTBASE_FOREACH (const CollectionChild *, child, &layer->collection->children) {
+      EXPECT_EQ(child_layer->collection, child->collection);
+      expect_layer_tree_matches_collections(child_layer);
+      child_layer = child_layer->next;
+    }
+  }
+
+  /** The layer of \a collection among the direct children of \a parent_layer. */
+  static LayerCollection *child_layer(LayerCollection *parent_layer, const Collection *collection)
+  {
+    LISTBASE_FOREACH (LayerCollection *, layer, &parent_layer->layer_collections) {
+      if (layer->collection == collection) {
+        return layer;
+      }
+    }
+    return nullptr;
+  }
+};
+
+TEST_F(LayerCollectionResyncTest, ReorderChildren)
+{
+  Collection *collection_a = add_collection(nullptr, "A");
+  Collection *collection_b = add_collection(nullptr, "B");
+  Collection *collection_c = add_collection(nullptr, "C");
+  Collection *collection_a1 = add_collection(collection_a, "A1");
+  resync();
+  LayerCollection *layer_a = child_layer(master_layer(), collection_a);
+  LayerCollection *layer_b = child_layer(master_layer(), collection_b);
+  LayerCollection *layer_c = child_layer(master_layer(), collection_c);
+  LayerCollection *layer_a1 = child_layer(layer_a, collection_a1);
+  layer_b->flag |= LAYER_COLLECTION_HIDE;
+  layer_c->flag |= LAYER_COLLECTION_EXCLUDE;
+  layer_a1->flag |= LAYER_COLLECTION_HOLDOUT;
+
+  BKE_collection_move(bmain,
+                      scene->master_collection,
+                      scene->master_collection,
+                      collection_a,
+                      false,
+                      collection_c);
+  resync();
+  EXPECT_EQ(master_layer()->layer_collections.first, layer_c);
+  BKE_collection_move(bmain,
+                      scene->master_collection,
+                      scene->master_collection,
+                      collection_b,
+                      true,
+                      collection_a);
+  resync();
+  EXPECT_EQ(master_layer()->layer_collections.last, layer_a);
+
+  /* The layers are reordered, not re-created. */
+  EXPECT_EQ(child_layer(master_layer(), collection_a), layer_a);
+  EXPECT_EQ(child_layer(master_layer(), collection_b), layer_b);
+  EXPECT_EQ(child_layer(master_layer(), collection_c), layer_c);
+  EXPECT_EQ(child_layer(layer_a, collection_a1), layer_a1);
+  EXPECT_EQ(layer_a->flag, 0);
+  EXPECT_EQ(layer_b->flag, LAYER_COLLECTION_HIDE);
+  EXPECT_EQ(layer_c->flag, LAYER_COLLECTION_EXCLUDE);
+  EXPECT_EQ(layer_a1->flag, LAYER_COLLECTION_HOLDOUT);
+}
+
+TEST_F(LayerCollectionResyncTest, MoveSubtreeToOtherParent)
+{
+  Collection *collection_a = add_collection(nullptr, "A");
+  Collection *collection_b = add_collection(nullptr, "B");
+  Collection *collection_a1 = add_collection(collection_a, "A1");
+  Collection *collection_a2 = add_collection(collection_a1, "A2");
+  resync();
+  LayerCollection *layer_a1 = child_layer(child_layer(master_layer(), collection_a),
+                                          collection_a1);
+  LayerCollection *layer_a2 = child_layer(layer_a1, collection_a2);
+  layer_a1->flag |= LAYER_COLLECTION_HIDE;
+  layer_a2->flag |= LAYER_COLLECTION_EXCLUDE;
+
+  BKE_collection_move(bmain, collection_b, collection_a, nullptr, false, collection_a1);
+  resync();
+
+  /* The old layers of the moved sub-tree are found under their old parent and re-used. */
+  LayerCollection *layer_a = child_layer(master_layer(), collection_a);
+  LayerCollection *layer_b = child_layer(master_layer(), collection_b);
+  EXPECT_TRUE(BLI_listbase_is_empty(&layer_a->layer_collections));
+  EXPECT_EQ(child_layer(layer_b, collection_a1), layer_a1);
+  EXPECT_EQ(child_layer(layer_a1, collection_a2), layer_a2);
+  EXPECT_EQ(layer_a1->flag, LAYER_COLLECTION_HIDE);
+  EXPECT_EQ(layer_a2->flag, LAYER_COLLECTION_EXCLUDE);
+}
+
+TEST_F(LayerCollectionResyncTest, RemoveAndReAddChild)
+{
+  Collection *collection_a = add_collection(nullptr, "A");
+  Collection *collection_b = add_collection(nullptr, "B");
+  Collection *collection_a1 = add_collection(collection_a, "A1");
+  resync();
+  LayerCollection *layer_a = child_layer(master_layer(), collection_a);
+  LayerCollection *layer_b = child_layer(master_layer(), collection_b);
+  LayerCollection *layer_a1 = child_layer(layer_a, collection_a1);
+  layer_a->flag |= LAYER_COLLECTION_HIDE;
+  layer_b->flag |= LAYER_COLLECTION_INDIRECT_ONLY;
+  layer_a1->flag |= LAYER_COLLECTION_EXCLUDE;
+
+  /* Without a resync in-between, the existing layers are kept for the re-added collection. */
+  BKE_layer_collection_resync_forbid();
+  BKE_collection_child_remove(bmain, scene->master_collection, collection_a);
+  BKE_collection_child_add(bmain, scene->master_collection, collection_a);
+  BKE_layer_collection_resync_allow();
+  BKE_main_collection_sync(bmain);
+  resync();
+  EXPECT_EQ(master_layer()->layer_collections.first, layer_b);
+  EXPECT_EQ(master_layer()->layer_collections.last, layer_a);
+  EXPECT_EQ(child_layer(layer_a, collection_a1), layer_a1);
+  EXPECT_EQ(layer_a->flag, LAYER_COLLECTION_HIDE);
+  EXPECT_EQ(layer_b->flag, LAYER_COLLECTION_INDIRECT_ONLY);
+  EXPECT_EQ(layer_a1->flag, LAYER_COLLECTION_EXCLUDE);
+
+  /* With a resync in-between, the layers of the removed collection are freed, and new ones
+   * inheriting the flags of the parent layer are created when it is added again. */
+  BKE_collection_child_remove(bmain, scene->master_collection, collection_a);
+  resync();
+  EXPECT_EQ(child_layer(master_layer(), collection_a), nullptr);
+  BKE_collection_child_add(bmain, scene->master_collection, collection_a);
+  resync();
+  layer_a = child_layer(master_layer(), collection_a);
+  ASSERT_NE(layer_a, nullptr);
+  EXPECT_EQ(layer_a->flag, 0);
+  EXPECT_EQ(child_layer(layer_a, collection_a1)->flag, 0);
+  EXPECT_EQ(child_layer(master_layer(), collection_b), layer_b);
+  EXPECT_EQ(layer_b->flag, LAYER_COLLECTION_INDIRECT_ONLY);
+}
+
+TEST_F(LayerCollectionResyncTest, LinkChildUnderTwoParents)
+{
+  Collection *collection_a = add_collection(nullptr, "A");
+  Collection *collection_b = add_collection(nullptr, "B");
+  Collection *collection_c = add_collection(collection_a, "C");
+  Collection *collection_c1 = add_collection(collection_c, "C1");
+  resync();
+  LayerCollection *layer_a = child_layer(master_layer(), collection_a);
+  LayerCollection *layer_b = child_layer(master_layer(), collection_b);
+  LayerCollection *layer_c = child_layer(layer_a, collection_c);
+  LayerCollection *layer_c1 = child_layer(layer_c, collection_c1);
+  layer_c->flag |= LAYER_COLLECTION_HIDE;
+  layer_c1->flag |= LAYER_COLLECTION_EXCLUDE;
+
+  /* The existing layers stay under the first parent, the second parent gets new layers. */
+  BKE_collection_child_add(bmain, collection_b, collection_c);
+  resync();
+  EXPECT_EQ(child_layer(layer_a, collection_c), layer_c);
+  EXPECT_EQ(child_layer(layer_c, collection_c1), layer_c1);
+  EXPECT_EQ(layer_c->flag, LAYER_COLLECTION_HIDE);
+  EXPECT_EQ(layer_c1->flag, LAYER_COLLECTION_EXCLUDE);
+  LayerCollection *layer_c_in_b = child_layer(layer_b, collection_c);
+  ASSERT_NE(layer_c_in_b, nullptr);
+  EXPECT_NE(layer_c_in_b, layer_c);
+  EXPECT_EQ(layer_c_in_b->flag, 0);
+  layer_c_in_b->flag |= LAYER_COLLECTION_INDIRECT_ONLY;
+
+  /* Both instances keep their own flags on further resyncs. */
+  BKE_main_collection_sync(bmain);
+  resync();
+  EXPECT_EQ(child_layer(layer_a, collection_c), layer_c);
+  EXPECT_EQ(child_layer(layer_b, collection_c), layer_c_in_b);
+  EXPECT_EQ(layer_c->flag, LAYER_COLLECTION_HIDE);
+  EXPECT_EQ(layer_c_in_b->flag, LAYER_COLLECTION_INDIRECT_ONLY);
+}
+
 }  // namespace blender::bke::tests
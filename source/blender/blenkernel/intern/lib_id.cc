@@ -35,7 +35,9 @@
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
 #include "BLI_linklist.h"
+#include "BLI_map.hh"
 #include "BLI_memarena.h"
+#include "BLI_sort.hh"
 #include "BLI_string_utils.hh"
 
 #include "BLT_translation.hh"
@@ -1061,6 +1063,51 @@ void BKE_libblock_management_main_add(Main *bmain, void *idv)
   BKE_lib_libblock_session_uid_ensure(id);
 }
 
+void BKE_libblock_management_main_add_multiple(Main *bmain, const blender::Span<ID *> ids)
+{
+  BLI_assert(bmain != nullptr);
+
+  blender::Vector<ID *> ids_to_add;
+  for (ID *id : ids) {
+    if ((id->tag & LIB_TAG_NO_MAIN) == 0) {
+      continue;
+    }
+    if ((id->tag & LIB_TAG_NOT_ALLOCATED) != 0) {
+      /* We cannot add non-allocated ID to Main! */
+      continue;
+    }
+    /* We cannot allow non-userrefcounting IDs in Main database! */
+    if ((id->tag & LIB_TAG_NO_USER_REFCOUNT) != 0) {
+      BKE_library_foreach_ID_link(bmain, id, libblock_management_us_plus, nullptr, IDWALK_NOP);
+    }
+    ids_to_add.append(id);
+  }
+
+  /* Names only have to be unique per ID type and library. */
+  blender::Map<std::pair<short, Library *>, blender::Vector<ID *>> ids_by_type_and_lib;
+  for (ID *id : ids_to_add) {
+    ids_by_type_and_lib.lookup_or_add_default({GS(id->name), id->lib}).append(id);
+  }
+
+  BKE_main_lock(bmain);
+  for (const blender::Vector<ID *> &ids_group : ids_by_type_and_lib.values()) {
+    ListBase *lb = which_libbase(bmain, GS(ids_group.first()->name));
+    for (ID *id : ids_group) {
+      BLI_addtail(lb, id);
+    }
+    BKE_id_new_names_validate(bmain, lb, ids_group, true);
+  }
+  for (ID *id : ids_to_add) {
+    id->tag &= ~(LIB_TAG_NO_MAIN | LIB_TAG_NO_USER_REFCOUNT);
+  }
+  bmain->is_memfile_undo_written = false;
+  BKE_main_unlock(bmain);
+
+  for (ID *id : ids_to_add) {
+    BKE_lib_libblock_session_uid_ensure(id);
+  }
+}
+
 void BKE_libblock_management_main_remove(Main *bmain, void *idv)
 {
   ID *id = static_cast<ID *>(idv);
@@ -1178,23 +1225,16 @@ void BKE_main_id_repair_duplicate_names_listbase(Main *bmain, ListBase *lb)
     return;
   }
 
-  /* Fill an array because renaming sorts. */
-  ID **id_array = static_cast<ID **>(MEM_mallocN(sizeof(*id_array) * lb_len, __func__));
+  /* Collect the duplicates first because renaming sorts. */
+  blender::Vector<ID *> ids_duplicate;
   GSet *gset = BLI_gset_str_new_ex(__func__, lb_len);
-  int i = 0;
   LISTBASE_FOREACH (ID *, id, lb) {
-    if (!ID_IS_LINKED(id)) {
-      id_array[i] = id;
-      i++;
-    }
-  }
-  for (i = 0; i < lb_len; i++) {
-    if (!BLI_gset_add(gset, id_array[i]->name + 2)) {
-      BKE_id_new_name_validate(bmain, lb, id_array[i], nullptr, false);
+    if (!ID_IS_LINKED(id) && !BLI_gset_add(gset, id->name + 2)) {
+      ids_duplicate.append(id);
     }
   }
   BLI_gset_free(gset, nullptr);
-  MEM_freeN(id_array);
+  BKE_id_new_names_validate(bmain, lb, ids_duplicate, false);
 }
 
 void BKE_main_lib_objects_recalc_all(Main *bmain)
@@ -1770,6 +1810,61 @@ bool BKE_id_new_name_validate(
   return result;
 }
 
+void BKE_id_new_names_validate(Main *bmain,
+                               ListBase *lb,
+                               const blender::Span<ID *> ids,
+                               const bool do_linked_data)
+{
+  blender::Vector<ID *> ids_to_rename;
+  for (ID *id : ids) {
+    /* If library, don't rename (unless explicitly required), but do ensure proper sorting. */
+    if (!do_linked_data && ID_IS_LINKED(id)) {
+      continue;
+    }
+    char *name = id->name + 2;
+    if (name[0] == '\0') {
+      /* Disallow empty names. */
+      BLI_strncpy_utf8(
+          name, DATA_(BKE_idtype_idcode_to_name(GS(id->name))), sizeof(id->name) - 2);
+    }
+    else {
+      /* disallow non utf8 chars,
+       * the interface checks for this but new ID's based on file names don't */
+      BLI_str_utf8_invalid_strip(name, strlen(name));
+    }
+    ids_to_rename.append(id);
+  }
+
+  /* Unique names per library, a single batch is enough in the common case. */
+  blender::Map<Library *, blender::Vector<ID *>> ids_by_lib;
+  for (ID *id : ids_to_rename) {
+    ids_by_lib.lookup_or_add_default(id->lib).append(id);
+  }
+  for (const blender::Vector<ID *> &ids_group : ids_by_lib.values()) {
+    BKE_main_namemap_get_names(bmain, ids_group);
+  }
+
+  /* Insert the IDs in alphabetical order, so that each one can usually be inserted right after
+   * the previous one. They are removed from the list first, #id_sort_by_name expects all other
+   * IDs to be sorted already. */
+  blender::Vector<ID *> ids_sorted(ids);
+  blender::parallel_sort(ids_sorted.begin(), ids_sorted.end(), [](const ID *a, const ID *b) {
+    if (a->lib != b->lib) {
+      return a->lib < b->lib;
+    }
+    return BLI_strcasecmp(a->name, b->name) < 0;
+  });
+  for (ID *id : ids_sorted) {
+    BLI_remlink(lb, id);
+  }
+  ID *id_prev = nullptr;
+  for (ID *id : ids_sorted) {
+    BLI_addtail(lb, id);
+    id_sort_by_name(lb, id, id_prev);
+    id_prev = id;
+  }
+}
+
 void BKE_main_id_newptr_and_tag_clear(Main *bmain)
 {
   ID *id;
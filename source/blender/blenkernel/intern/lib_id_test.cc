@@ -549,4 +549,39 @@ TEST(lib_id_main_unique_name, name_huge_number_suffix)
   EXPECT_EQ(ctx.bmain->name_map_global, nullptr);
 }
 
+TEST(lib_id_main_unique_name, add_multiple)
+{
+  LibIDMainSortTestContext ctx;
+  LibIDMainSortTestContext ctx_ref;
+
+  const char *names[] = {"Foo", "Bar", "Foo.001", "Foo.1", "Foo.002", "", "Bar.1000"};
+  BKE_id_new(ctx.bmain, ID_OB, "Foo");
+  BKE_id_new(ctx_ref.bmain, ID_OB, "Foo");
+
+  /* Adding all IDs at once should give the same names as adding them one by one. */
+  Vector<ID *> ids;
+  Vector<ID *> ids_ref;
+  for (const int i : IndexRange(3000)) {
+    const char *name = names[i % ARRAY_SIZE(names)];
+    ids.append(static_cast<ID *>(BKE_id_new_nomain(ID_OB, name)));
+    ids_ref.append(static_cast<ID *>(BKE_id_new(ctx_ref.bmain, ID_OB, name)));
+  }
+  BKE_libblock_management_main_add_multiple(ctx.bmain, ids);
+
+  for (const int i : ids.index_range()) {
+    EXPECT_STREQ(ids[i]->name + 2, ids_ref[i]->name + 2);
+    EXPECT_EQ(ids[i]->tag & LIB_TAG_NO_MAIN, 0);
+  }
+  EXPECT_EQ(BLI_listbase_count(&ctx.bmain->objects), 3001);
+  LISTBASE_FOREACH (ID *, id, &ctx.bmain->objects) {
+    if (id->next != nullptr) {
+      EXPECT_LT(BLI_strcasecmp(id->name, static_cast<ID *>(id->next)->name), 0);
+    }
+  }
+
+  EXPECT_TRUE(BKE_main_namemap_validate(ctx.bmain));
+
+  EXPECT_EQ(ctx.bmain->name_map_global, nullptr);
+}
+
 }  // namespace blender::bke::tests
@@ -2293,6 +2293,9 @@ static bool lib_override_library_resync(Main *bmain,
   LibOverrideMissingIDsData missing_ids_data = lib_override_library_resync_build_missing_ids_data(
       bmain);
 
+  /* New overrides that do not replace an old one, added to Main all at once after the loop. */
+  blender::Vector<ID *> id_override_new_to_add;
+
   ListBase *lb;
   FOREACH_MAIN_LISTBASE_BEGIN (bmain, lb) {
     FOREACH_MAIN_LISTBASE_ID_BEGIN (lb, id) {
@@ -2380,15 +2383,16 @@ static bool lib_override_library_resync(Main *bmain,
         BLI_addtail(no_main_ids_list, id_override_old);
       }
       else {
-        /* Add to proper main list, ensure unique name for local ID, sort, and clear relevant
-         * tags. */
-        BKE_libblock_management_main_add(bmain, id_override_new);
+        id_override_new_to_add.append(id_override_new);
       }
     }
     FOREACH_MAIN_LISTBASE_ID_END;
   }
   FOREACH_MAIN_LISTBASE_END;
 
+  /* Add to proper main list, ensure unique name for local ID, sort, and clear relevant tags. */
+  BKE_libblock_management_main_add_multiple(bmain, id_override_new_to_add);
+
   /* We remap old to new override usages in a separate loop, after all new overrides have
    * been added to Main. */
   lib_override_library_remap(bmain, id_root_reference, linkedref_to_old_override);
@@ -12,7 +12,10 @@
 
 #include "BLI_array.hh"
 #include "BLI_linklist.h"
+#include "BLI_set.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+#include "BLI_vector_set.hh"
 
 #include "DNA_collection_types.h"
 #include "DNA_object_types.h"
@@ -344,46 +347,48 @@ static void libblock_remap_data_preprocess(ID *id_owner,
 }
 
 /**
- * Can be called with both old_ob and new_ob being nullptr,
- * this means we have to check whole Main database then.
+ * Main-wide post-processing of a remapping operation. Each of these updates has to go over the
+ * whole Main database, so they are accumulated over all remapped ID pairs (and relinked IDs) and
+ * only applied once, see #libblock_remap_data_postprocess_apply.
  */
-static void libblock_remap_data_postprocess_object_update(Main *bmain,
+struct IDRemapPostprocess {
+  /** Remove invalid objects from collections, and tag meta-ball basis objects for update. */
+  bool do_object_update = false;
+  /** Objects that were remapped, only their meta-ball basis objects are tagged for update. */
+  blender::Vector<Object *> old_objects;
+  /** Tag all meta-ball basis objects for update. */
+  bool do_object_update_all = false;
+  /** Collections to remove nullptr children from, a nullptr item means all collections. */
+  blender::VectorSet<Collection *> collections_null_children_remove;
+  bool do_collections_parent_relations_rebuild = false;
+  bool do_collection_sync = false;
+  /** Objects using one of these IDs as object data were relinked to it. */
+  blender::Set<ID *> new_obdata_ids;
+  /** Only check these objects for relinked object data, all objects when empty. */
+  blender::VectorSet<Object *> obdata_relink_objects;
+};
+
+/**
+ * Object remapping post-processing. A nullptr old_ob means that the whole Main database has to be
+ * checked.
+ */
+static void libblock_remap_data_postprocess_object_update(IDRemapPostprocess &postprocess,
                                                           Object *old_ob,
-                                                          Object * /*new_ob*/,
                                                           const bool do_sync_collection)
 {
-  /* Will only effectively process collections that have been tagged with
-   * #COLLECTION_TAG_COLLECTION_OBJECT_DIRTY. See #collection_foreach_id callback. */
-  BKE_collections_object_remove_invalids(bmain);
-
-  if (do_sync_collection) {
-    BKE_main_collection_sync_remap(bmain);
-  }
-
+  postprocess.do_object_update = true;
   if (old_ob == nullptr) {
-    for (Object *ob = static_cast<Object *>(bmain->objects.first); ob != nullptr;
-         ob = static_cast<Object *>(ob->id.next))
-    {
-      if (ob->type == OB_MBALL && BKE_mball_is_basis(ob)) {
-        DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-      }
-    }
+    postprocess.do_object_update_all = true;
   }
   else {
-    for (Object *ob = static_cast<Object *>(bmain->objects.first); ob != nullptr;
-         ob = static_cast<Object *>(ob->id.next))
-    {
-      if (ob->type == OB_MBALL && BKE_mball_is_basis_for(ob, old_ob)) {
-        DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-        break; /* There is only one basis... */
-      }
-    }
+    postprocess.old_objects.append(old_ob);
   }
+  postprocess.do_collection_sync |= do_sync_collection;
 }
 
 /* Can be called with both old_collection and new_collection being nullptr,
  * this means we have to check whole Main database then. */
-static void libblock_remap_data_postprocess_collection_update(Main *bmain,
+static void libblock_remap_data_postprocess_collection_update(IDRemapPostprocess &postprocess,
                                                               Collection *owner_collection,
                                                               Collection * /*old_collection*/,
                                                               Collection *new_collection)
@@ -393,16 +398,16 @@ static void libblock_remap_data_postprocess_collection_update(Main *bmain,
      * and BKE_main_collection_sync_remap() does not tolerate any of those, so for now always check
      * whole existing collections for nullptr pointers.
      * I'd consider optimizing that whole collection remapping process a TODO: for later. */
-    BKE_collections_child_remove_nulls(bmain, owner_collection, nullptr /*old_collection*/);
+    postprocess.collections_null_children_remove.add(owner_collection);
   }
   else {
     /* Temp safe fix, but a "tad" brute force... We should probably be able to use parents from
      * old_collection instead? */
     /* NOTE: Also takes care of duplicated child collections that remapping may have created. */
-    BKE_main_collections_parent_relations_rebuild(bmain);
+    postprocess.do_collections_parent_relations_rebuild = true;
   }
 
-  BKE_main_collection_sync_remap(bmain);
+  postprocess.do_collection_sync = true;
 }
 
 static void libblock_remap_data_postprocess_obdata_relink(Main *bmain, Object *ob, ID *new_id)
@@ -423,10 +428,70 @@ static void libblock_remap_data_postprocess_obdata_relink(Main *bmain, Object *o
   }
 }
 
-static void libblock_remap_data_postprocess_nodetree_update(Main *bmain, ID *new_id)
+static void libblock_remap_data_postprocess_apply(Main *bmain,
+                                                  const IDRemapPostprocess &postprocess)
 {
-  /* Update all group nodes using a node group. */
-  ntreeUpdateAllUsers(bmain, new_id);
+  if (postprocess.do_object_update) {
+    /* Will only effectively process collections that have been tagged with
+     * #COLLECTION_TAG_COLLECTION_OBJECT_DIRTY. See #collection_foreach_id callback. */
+    BKE_collections_object_remove_invalids(bmain);
+
+    for (Object *ob = static_cast<Object *>(bmain->objects.first); ob != nullptr;
+         ob = static_cast<Object *>(ob->id.next))
+    {
+      if (ob->type != OB_MBALL) {
+        continue;
+      }
+      if (postprocess.do_object_update_all) {
+        if (BKE_mball_is_basis(ob)) {
+          DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
+        }
+        continue;
+      }
+      for (const Object *old_ob : postprocess.old_objects) {
+        if (BKE_mball_is_basis_for(ob, old_ob)) {
+          DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
+          break;
+        }
+      }
+    }
+  }
+
+  if (postprocess.collections_null_children_remove.contains(nullptr)) {
+    BKE_collections_child_remove_nulls(bmain, nullptr, nullptr);
+  }
+  else {
+    for (Collection *owner_collection : postprocess.collections_null_children_remove) {
+      BKE_collections_child_remove_nulls(bmain, owner_collection, nullptr);
+    }
+  }
+  if (postprocess.do_collections_parent_relations_rebuild) {
+    BKE_main_collections_parent_relations_rebuild(bmain);
+  }
+  if (postprocess.do_collection_sync) {
+    BKE_main_collection_sync_remap(bmain);
+  }
+
+  if (!postprocess.new_obdata_ids.is_empty()) {
+    auto relink_obdata = [&](Object *ob) {
+      if (ob->data != nullptr && postprocess.new_obdata_ids.contains(static_cast<ID *>(ob->data)))
+      {
+        libblock_remap_data_postprocess_obdata_relink(bmain, ob, static_cast<ID *>(ob->data));
+      }
+    };
+    if (postprocess.obdata_relink_objects.is_empty()) {
+      for (Object *ob = static_cast<Object *>(bmain->objects.first); ob;
+           ob = static_cast<Object *>(ob->id.next))
+      {
+        relink_obdata(ob);
+      }
+    }
+    else {
+      for (Object *ob : postprocess.obdata_relink_objects) {
+        relink_obdata(ob);
+      }
+    }
+  }
 }
 
 static void libblock_remap_data_update_tags(ID *old_id, ID *new_id, IDRemap *id_remap_data)
@@ -552,7 +617,11 @@ static void libblock_remap_data(
   });
 }
 
-static void libblock_remap_foreach_idpair(ID *old_id, ID *new_id, Main *bmain, int remap_flags)
+static void libblock_remap_foreach_idpair(ID *old_id,
+                                          ID *new_id,
+                                          int remap_flags,
+                                          IDRemapPostprocess &postprocess,
+                                          blender::Vector<ID *> &nodetree_new_ids)
 {
   if (old_id == new_id) {
     return;
@@ -603,12 +672,11 @@ static void libblock_remap_foreach_idpair(ID *old_id, ID *new_id, Main *bmain, i
    * Maybe we should do a per-ID callback for this instead? */
   switch (GS(old_id->name)) {
     case ID_OB:
-      libblock_remap_data_postprocess_object_update(
-          bmain, (Object *)old_id, (Object *)new_id, true);
+      libblock_remap_data_postprocess_object_update(postprocess, (Object *)old_id, true);
       break;
     case ID_GR:
       libblock_remap_data_postprocess_collection_update(
-          bmain, nullptr, (Collection *)old_id, (Collection *)new_id);
+          postprocess, nullptr, (Collection *)old_id, (Collection *)new_id);
       break;
     case ID_ME:
     case ID_CU_LEGACY:
@@ -617,11 +685,7 @@ static void libblock_remap_foreach_idpair(ID *old_id, ID *new_id, Main *bmain, i
     case ID_PT:
     case ID_VO:
       if (new_id) { /* Only affects us in case obdata was relinked (changed). */
-        for (Object *ob = static_cast<Object *>(bmain->objects.first); ob;
-             ob = static_cast<Object *>(ob->id.next))
-        {
-          libblock_remap_data_postprocess_obdata_relink(bmain, ob, new_id);
-        }
+        postprocess.new_obdata_ids.add(new_id);
       }
       break;
     default:
@@ -629,15 +693,9 @@ static void libblock_remap_foreach_idpair(ID *old_id, ID *new_id, Main *bmain, i
   }
 
   /* Node trees may virtually use any kind of data-block... */
-  /* XXX Yuck!!!! nodetree update can do pretty much any thing when talking about py nodes,
-   *     including creating new data-blocks (see #50385), so we need to unlock main here. :(
-   *     Why can't we have re-entrent locks? */
-  BKE_main_unlock(bmain);
-  libblock_remap_data_postprocess_nodetree_update(bmain, new_id);
-  BKE_main_lock(bmain);
-
-  /* Full rebuild of DEG! */
-  DEG_relations_tag_update(bmain);
+  if (new_id) {
+    nodetree_new_ids.append(new_id);
+  }
 
   BKE_libblock_runtime_reset_remapping_status(old_id);
 }
@@ -651,9 +709,22 @@ void BKE_libblock_remap_multiple_locked(Main *bmain, IDRemapper &mappings, const
 
   libblock_remap_data(bmain, nullptr, ID_REMAP_TYPE_REMAP, mappings, remap_flags);
 
+  /* Main-wide updates are only done once for all remapped IDs, since each of them has to loop
+   * over whole Main. */
+  IDRemapPostprocess postprocess;
+  blender::Vector<ID *> nodetree_new_ids;
   mappings.iter([&](ID *old_id, ID *new_id) {
-    libblock_remap_foreach_idpair(old_id, new_id, bmain, remap_flags);
+    libblock_remap_foreach_idpair(old_id, new_id, remap_flags, postprocess, nodetree_new_ids);
   });
+  libblock_remap_data_postprocess_apply(bmain, postprocess);
+
+  /* XXX Yuck!!!! nodetree update can do pretty much any thing when talking about py nodes,
+   *     including creating new data-blocks (see #50385), so we need to unlock main here. :(
+   *     Why can't we have re-entrent locks? */
+  BKE_main_unlock(bmain);
+  /* Update all group nodes using a node group. */
+  ntreeUpdateAllUsers(bmain, nodetree_new_ids);
+  BKE_main_lock(bmain);
 
   /* We assume editors do not hold references to their IDs... This is false in some cases
    * (Image is especially tricky here),
@@ -728,8 +799,8 @@ void BKE_libblock_unlink(Main *bmain, void *idv, const bool do_skip_indirect)
 
 static void libblock_relink_foreach_idpair(ID *old_id,
                                            ID *new_id,
-                                           Main *bmain,
-                                           const blender::Span<ID *> ids)
+                                           const blender::Span<ID *> ids,
+                                           IDRemapPostprocess &postprocess)
 {
   BLI_assert(old_id != nullptr);
   BLI_assert((new_id == nullptr) || GS(old_id->name) == GS(new_id->name));
@@ -754,14 +825,13 @@ static void libblock_relink_foreach_idpair(ID *old_id,
         switch (GS(old_id->name)) {
           case ID_OB:
             if (!is_object_update_processed) {
-              libblock_remap_data_postprocess_object_update(
-                  bmain, (Object *)old_id, (Object *)new_id, true);
+              libblock_remap_data_postprocess_object_update(postprocess, (Object *)old_id, true);
               is_object_update_processed = true;
             }
             break;
           case ID_GR:
             libblock_remap_data_postprocess_collection_update(
-                bmain, owner_collection, (Collection *)old_id, (Collection *)new_id);
+                postprocess, owner_collection, (Collection *)old_id, (Collection *)new_id);
             break;
           default:
             break;
@@ -770,7 +840,8 @@ static void libblock_relink_foreach_idpair(ID *old_id,
       }
       case ID_OB:
         if (new_id != nullptr) { /* Only affects us in case obdata was relinked (changed). */
-          libblock_remap_data_postprocess_obdata_relink(bmain, (Object *)id_iter, new_id);
+          postprocess.new_obdata_ids.add(new_id);
+          postprocess.obdata_relink_objects.add((Object *)id_iter);
         }
         break;
       default:
@@ -795,10 +866,12 @@ void BKE_libblock_relink_multiple(Main *bmain,
     return;
   }
 
+  /* Main-wide updates are only done once for all relinked IDs and remapped pairs. */
+  IDRemapPostprocess postprocess;
   switch (remap_type) {
     case ID_REMAP_TYPE_REMAP: {
       id_remapper.iter([&](ID *old_id, ID *new_id) {
-        libblock_relink_foreach_idpair(old_id, new_id, bmain, ids);
+        libblock_relink_foreach_idpair(old_id, new_id, ids, postprocess);
       });
       break;
     }
@@ -820,11 +893,11 @@ void BKE_libblock_relink_multiple(Main *bmain,
               /* We only want to affect Object pointers here, not Collection ones, LayerCollections
                * will be resynced as part of the call to
                * `libblock_remap_data_postprocess_collection_update` below. */
-              libblock_remap_data_postprocess_object_update(bmain, nullptr, nullptr, false);
+              libblock_remap_data_postprocess_object_update(postprocess, nullptr, false);
               is_object_update_processed = true;
             }
             libblock_remap_data_postprocess_collection_update(
-                bmain, owner_collection, nullptr, nullptr);
+                postprocess, owner_collection, nullptr, nullptr);
             break;
           }
           default:
@@ -837,6 +910,7 @@ void BKE_libblock_relink_multiple(Main *bmain,
     default:
       BLI_assert_unreachable();
   }
+  libblock_remap_data_postprocess_apply(bmain, postprocess);
 
   DEG_relations_tag_update(bmain);
 }
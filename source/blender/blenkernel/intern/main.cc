@@ -402,8 +402,8 @@ void BKE_main_merge(Main *bmain_dst, Main **r_bmain_src, MainMergeReport &report
 
   for (ID *id_iter_src : ids_to_move) {
     BKE_libblock_management_main_remove(bmain_src, id_iter_src);
-    BKE_libblock_management_main_add(bmain_dst, id_iter_src);
   }
+  BKE_libblock_management_main_add_multiple(bmain_dst, ids_to_move);
 
   /* The other data has to be remapped once all IDs are in `bmain_dst`, to ensure that additional
    * update process (e.g. collection hierarchy handling) happens as expected with the correct set
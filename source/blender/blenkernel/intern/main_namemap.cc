@@ -17,10 +17,13 @@
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
 #include "BLI_math_base.hh"
+#include "BLI_offset_indices.hh"
 #include "BLI_set.hh"
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
+#include "BLI_vector_set.hh"
 
 #include "DNA_ID.h"
 
@@ -221,16 +224,21 @@ void BKE_main_namemap_clear(Main *bmain)
 /* `do_global` will generate a namemap for all IDs in current Main, regardless of their library.
  * Note that duplicates (e.g.local ID and linked ID with same name) will only generate a single
  * entry in the map then. */
-static void main_namemap_populate(
-    UniqueName_Map *name_map, Main *bmain, Library *library, ID *ignore_id, const bool do_global)
+static void main_namemap_populate(UniqueName_Map *name_map,
+                                  Main *bmain,
+                                  Library *library,
+                                  const Span<ID *> ignore_ids,
+                                  const bool do_global)
 {
   BLI_assert_msg(name_map != nullptr, "name_map should not be null");
   for (UniqueName_TypeMap &type_map : name_map->type_maps) {
     type_map.base_name_to_num_suffix.clear();
   }
+  Set<const ID *> ignore_ids_set;
+  ignore_ids_set.add_multiple(ignore_ids);
   ID *id;
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
-    if ((id == ignore_id) || (!do_global && (id->lib != library))) {
+    if (ignore_ids_set.contains(id) || (!do_global && (id->lib != library))) {
       continue;
     }
     UniqueName_TypeMap *type_map = name_map->find_by_type(GS(id->name));
@@ -263,16 +271,17 @@ static void main_namemap_populate(
 
 /* Get the name map object used for the given Main/ID.
  * Lazily creates and populates the contents of the name map, if ensure_created is true.
- * NOTE: if the contents are populated, the name of the given ID itself is not added. */
+ * NOTE: if the contents are populated, the names of the `ignore_ids` are not added. */
 static UniqueName_Map *get_namemap_for(Main *bmain,
                                        ID *id,
+                                       const Span<ID *> ignore_ids,
                                        const bool ensure_created,
                                        const bool do_global)
 {
   if (do_global) {
     if (ensure_created && bmain->name_map_global == nullptr) {
       bmain->name_map_global = BKE_main_namemap_create();
-      main_namemap_populate(bmain->name_map_global, bmain, id->lib, id, true);
+      main_namemap_populate(bmain->name_map_global, bmain, id->lib, ignore_ids, true);
     }
     return bmain->name_map_global;
   }
@@ -280,17 +289,26 @@ static UniqueName_Map *get_namemap_for(Main *bmain,
   if (id->lib != nullptr) {
     if (ensure_created && id->lib->runtime.name_map == nullptr) {
       id->lib->runtime.name_map = BKE_main_namemap_create();
-      main_namemap_populate(id->lib->runtime.name_map, bmain, id->lib, id, false);
+      main_namemap_populate(id->lib->runtime.name_map, bmain, id->lib, ignore_ids, false);
     }
     return id->lib->runtime.name_map;
   }
   if (ensure_created && bmain->name_map == nullptr) {
     bmain->name_map = BKE_main_namemap_create();
-    main_namemap_populate(bmain->name_map, bmain, id->lib, id, false);
+    main_namemap_populate(bmain->name_map, bmain, id->lib, ignore_ids, false);
   }
   return bmain->name_map;
 }
 
+/* NOTE: if the contents are populated, the name of the given ID itself is not added. */
+static UniqueName_Map *get_namemap_for(Main *bmain,
+                                       ID *id,
+                                       const bool ensure_created,
+                                       const bool do_global)
+{
+  return get_namemap_for(bmain, id, Span<ID *>(&id, 1), ensure_created, do_global);
+}
+
 /* Tries to add given name to the given name_map, returns `true` if added, `false` if it was
  * already in the namemap. */
 static bool namemap_add_name(UniqueName_Map *name_map, ID *id, const char *name, const int number)
@@ -312,6 +330,31 @@ static bool namemap_add_name(UniqueName_Map *name_map, ID *id, const char *name,
   return true;
 }
 
+/* Pick and mark as used the number suffix for a name whose base name is already used. */
+static int namemap_use_number(UniqueName_Value &val, const int number)
+{
+  if (val.use_if_unused(number)) {
+    /* Our particular number suffix is not used yet: use it. */
+    return number;
+  }
+
+  /* Find lowest free under 1k and use it. */
+  int number_to_use = val.use_smallest_unused();
+
+  /* Did not find one under 1k. */
+  if (number_to_use == -1) {
+    if (number >= MIN_NUMBER && number > val.max_value) {
+      val.max_value = number;
+      number_to_use = number;
+    }
+    else {
+      val.max_value++;
+      number_to_use = val.max_value;
+    }
+  }
+  return number_to_use;
+}
+
 bool BKE_main_namemap_get_name(Main *bmain, ID *id, char *name, const bool do_unique_in_bmain)
 {
 #ifndef __GNUC__ /* GCC warns with `nonull-compare`. */
@@ -360,27 +403,7 @@ bool BKE_main_namemap_get_name(Main *bmain, ID *id, char *name, const bool do_un
     }
 
     /* The base name is already used. But our number suffix might not be used yet. */
-    int number_to_use = -1;
-    if (val.use_if_unused(number)) {
-      /* Our particular number suffix is not used yet: use it. */
-      number_to_use = number;
-    }
-    else {
-      /* Find lowest free under 1k and use it. */
-      number_to_use = val.use_smallest_unused();
-
-      /* Did not find one under 1k. */
-      if (number_to_use == -1) {
-        if (number >= MIN_NUMBER && number > val.max_value) {
-          val.max_value = number;
-          number_to_use = number;
-        }
-        else {
-          val.max_value++;
-          number_to_use = val.max_value;
-        }
-      }
-    }
+    const int number_to_use = namemap_use_number(val, number);
 
     /* Try to build final name from the current base name and the number.
      * Note that this can fail due to too long base name, or a too large number,
@@ -405,6 +428,125 @@ bool BKE_main_namemap_get_name(Main *bmain, ID *id, char *name, const bool do_un
   return is_name_changed;
 }
 
+void BKE_main_namemap_get_names(Main *bmain, const Span<ID *> ids)
+{
+  if (ids.is_empty()) {
+    return;
+  }
+  ID *id_first = ids.first();
+#ifndef NDEBUG
+  for (const ID *id : ids) {
+    BLI_assert(GS(id->name) == GS(id_first->name));
+    BLI_assert(id->lib == id_first->lib);
+  }
+#endif
+  UniqueName_Map *name_map = get_namemap_for(bmain, id_first, ids, true, false);
+  UniqueName_Map *name_map_other = get_namemap_for(bmain, id_first, ids, false, true);
+  BLI_assert(name_map != nullptr);
+  UniqueName_TypeMap *type_map = name_map->find_by_type(GS(id_first->name));
+  BLI_assert(type_map != nullptr);
+
+  /* Get the name and number parts ("name.number") of all names. */
+  Array<UniqueName_Key> base_names(ids.size());
+  Array<size_t> base_name_lens(ids.size());
+  Array<int> numbers(ids.size());
+  threading::parallel_for(ids.index_range(), 1024, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      numbers[i] = MIN_NUMBER;
+      base_name_lens[i] = BLI_string_split_name_number(
+          ids[i]->name + 2, '.', base_names[i].name, &numbers[i]);
+    }
+  });
+
+  /* Group the IDs by base name, keeping their order within each group. A full name always splits
+   * into the same base name, so names from different groups never collide, and every group can
+   * be handled independently. */
+  VectorSet<UniqueName_Key> groups;
+  Array<int> group_indices(ids.size());
+  for (const int64_t i : ids.index_range()) {
+    group_indices[i] = int(groups.index_of_or_add(base_names[i]));
+  }
+  Array<int> group_offsets_data(groups.size() + 1, 0);
+  offset_indices::build_reverse_offsets(group_indices, group_offsets_data);
+  const OffsetIndices<int> group_offsets(group_offsets_data);
+  Array<int> group_items(ids.size());
+  {
+    Array<int> group_fill(groups.size(), 0);
+    for (const int64_t i : ids.index_range()) {
+      const int group = group_indices[i];
+      group_items[group_offsets[group][group_fill[group]++]] = int(i);
+    }
+  }
+
+  /* Add the entries of all base names first, the map must not change while it is accessed from
+   * multiple threads below. */
+  Array<bool> group_is_new(groups.size());
+  for (const int64_t group : groups.index_range()) {
+    bool added_new = false;
+    type_map->base_name_to_num_suffix.lookup_or_add_cb(groups[group], [&]() {
+      added_new = true;
+      return UniqueName_Value();
+    });
+    group_is_new[group] = added_new;
+  }
+  Array<UniqueName_Value *> group_values(groups.size());
+  for (const int64_t group : groups.index_range()) {
+    group_values[group] = type_map->base_name_to_num_suffix.lookup_ptr(groups[group]);
+  }
+
+  /* Same logic as #BKE_main_namemap_get_name. Names that have to be truncated get a different
+   * base name, they are handled separately afterwards. */
+  Array<bool> is_truncated(ids.size(), false);
+  threading::parallel_for(groups.index_range(), 64, [&](const IndexRange range) {
+    /* Names assigned in the current group, they are only added to the name map afterwards. */
+    Set<StringRef> group_names;
+    UniqueName_Key key;
+    for (const int64_t group : range) {
+      group_names.clear();
+      UniqueName_Value &val = *group_values[group];
+      bool added_new = group_is_new[group];
+      for (const int i : group_items.as_span().slice(group_offsets[group])) {
+        char *name = ids[i]->name + 2;
+        STRNCPY(key.name, name);
+        const bool has_dup = type_map->full_names.contains(key) || group_names.contains(name);
+        if (added_new || !has_dup) {
+          added_new = false;
+          val.mark_used(numbers[i]);
+          group_names.add(name);
+          continue;
+        }
+
+        const int number_to_use = namemap_use_number(val, numbers[i]);
+        BLI_assert(number_to_use >= MIN_NUMBER);
+        if (id_name_final_build(name, base_names[i].name, base_name_lens[i], number_to_use)) {
+          numbers[i] = number_to_use;
+          group_names.add(name);
+        }
+        else {
+          is_truncated[i] = true;
+        }
+      }
+    }
+  });
+
+  UniqueName_Key key;
+  for (const int64_t i : ids.index_range()) {
+    if (is_truncated[i]) {
+      continue;
+    }
+    STRNCPY(key.name, ids[i]->name + 2);
+    type_map->full_names.add(key);
+    if (name_map_other != nullptr) {
+      namemap_add_name(name_map_other, ids[i], ids[i]->name + 2, numbers[i]);
+    }
+  }
+  for (const int64_t i : ids.index_range()) {
+    if (is_truncated[i]) {
+      BKE_main_namemap_get_name(bmain, ids[i], ids[i]->name + 2, false);
+    }
+  }
+}
+
 static void namemap_remove_name(UniqueName_Map *name_map, ID *id, const char *name)
 {
   BLI_assert(strlen(name) < MAX_NAME);
@@ -19,14 +19,20 @@
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
+#include "BLI_array.hh"
+#include "BLI_bit_vector.hh"
+#include "BLI_map.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
 #include "BLI_memarena.h"
+#include "BLI_offset_indices.hh"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.hh"
 #include "BKE_mball_tessellate.hh" /* own include */
@@ -39,45 +45,8 @@
 
 #include "BLI_strict_flags.h" /* Keep last. */
 
-/* experimental (faster) normal calculation (see #103021) */
-#define USE_ACCUM_NORMAL
-
-#define MBALL_ARRAY_LEN_INIT 4096
-
 /* Data types */
 
-/** Corner of a cube. */
-struct CORNER {
-  int i, j, k;        /* (i, j, k) is index within lattice */
-  float co[3], value; /* location and function value */
-  CORNER *next;
-};
-
-/** Partitioning cell (cube). */
-struct CUBE {
-  int i, j, k;        /* lattice location of cube */
-  CORNER *corners[8]; /* eight corners */
-};
-
-/** Linked list of cubes acting as stack. */
-struct CUBES {
-  CUBE cube;   /* a single cube */
-  CUBES *next; /* remaining elements */
-};
-
-/** List of cube locations. */
-struct CENTERLIST {
-  int i, j, k;      /* cube location */
-  CENTERLIST *next; /* remaining elements */
-};
-
-/** List of edges. */
-struct EDGELIST {
-  int i1, j1, k1, i2, j2, k2; /* edge corner ids */
-  int vid;                    /* vertex id */
-  EDGELIST *next;             /* remaining elements */
-};
-
 /** List of integers. */
 struct INTLIST {
   int i;         /* an integer */
@@ -90,55 +59,26 @@ struct INTLISTS {
   INTLISTS *next; /* remaining elements */
 };
 
-/** An AABB with pointer to metal-elem. */
+/** An AABB. */
 struct Box {
   float min[3], max[3];
-  const MetaElem *ml;
-};
-
-struct MetaballBVHNode { /* node */
-  Box bb[2];             /* AABB of children */
-  MetaballBVHNode *child[2];
 };
 
 /** Parameters, storage. */
 struct PROCESS {
   float thresh, size; /* mball threshold, single cube size */
-  float delta;        /* small delta for calculating normals */
   uint converge_res;  /* converge procedure resolution (more = slower) */
 
   MetaElem **mainb;  /* array of all meta-elems. */
   uint totelem, mem; /* number of meta-elems. */
 
-  MetaballBVHNode metaball_bvh; /* The simplest bvh */
-  Box allbb;                    /* Bounding box of all meta-elems */
-
-  MetaballBVHNode **bvh_queue; /* Queue used during bvh traversal */
-  uint bvh_queue_size;
-
-  CUBES *cubes;         /* stack of cubes waiting for polygonization */
-  CENTERLIST **centers; /* cube center hash table */
-  CORNER **corners;     /* corner value hash table */
-  EDGELIST **edges;     /* edge and vertex id hash table */
-
-  int (*indices)[4]; /* output indices */
-  uint totindex;     /* size of memory allocated for indices */
-  uint curindex;     /* number of currently added indices */
-
-  blender::Vector<blender::float3> co; /* surface vertices positions */
-  blender::Vector<blender::float3> no; /* surface vertex normals */
+  Box allbb; /* Bounding box of all meta-elems */
 
   /* memory allocation from common pool */
   MemArena *pgn_elements;
 };
 
-/* Forward declarations */
-static int vertid(PROCESS *process, const CORNER *c1, const CORNER *c2);
-static void add_cube(PROCESS *process, int i, int j, int k);
-static void make_face(PROCESS *process, int i1, int i2, int i3, int i4);
-static void converge(PROCESS *process, const CORNER *c1, const CORNER *c2, float r_p[3]);
-
-/* ******************* SIMPLE BVH ********************* */
+/* ******************* BOUNDING BOXES ********************* */
 
 static void make_box_union(const BoundBox *a, const Box *b, Box *r_out)
 {
@@ -151,107 +91,6 @@ static void make_box_union(const BoundBox *a, const Box *b, Box *r_out)
   r_out->max[2] = max_ff(a->vec[6][2], b->max[2]);
 }
 
-static void make_box_from_metaelem(Box *r, const MetaElem *ml)
-{
-  copy_v3_v3(r->max, ml->bb->vec[6]);
-  copy_v3_v3(r->min, ml->bb->vec[0]);
-  r->ml = ml;
-}
-
-/**
- * Partitions part of #process.mainb array [start, end) along axis s. Returns i,
- * where centroids of elements in the [start, i) segment lie "on the right side" of div,
- * and elements in the [i, end) segment lie "on the left"
- */
-static uint partition_mainb(MetaElem **mainb, uint start, uint end, uint s, float div)
-{
-  uint i = start, j = end - 1;
-  div *= 2.0f;
-
-  while (true) {
-    while (i < j && div > (mainb[i]->bb->vec[6][s] + mainb[i]->bb->vec[0][s])) {
-      i++;
-    }
-    while (j > i && div < (mainb[j]->bb->vec[6][s] + mainb[j]->bb->vec[0][s])) {
-      j--;
-    }
-
-    if (i >= j) {
-      break;
-    }
-
-    std::swap(mainb[i], mainb[j]);
-    i++;
-    j--;
-  }
-
-  if (i == start) {
-    i++;
-  }
-
-  return i;
-}
-
-/**
- * Recursively builds a BVH, dividing elements along the middle of the longest axis of allbox.
- */
-static void build_bvh_spatial(
-    PROCESS *process, MetaballBVHNode *node, uint start, uint end, const Box *allbox)
-{
-  uint part, j, s;
-  float dim[3], div;
-
-  /* Maximum bvh queue size is number of nodes which are made, equals calls to this function. */
-  process->bvh_queue_size++;
-
-  dim[0] = allbox->max[0] - allbox->min[0];
-  dim[1] = allbox->max[1] - allbox->min[1];
-  dim[2] = allbox->max[2] - allbox->min[2];
-
-  s = 0;
-  if (dim[1] > dim[0] && dim[1] > dim[2]) {
-    s = 1;
-  }
-  else if (dim[2] > dim[1] && dim[2] > dim[0]) {
-    s = 2;
-  }
-
-  div = allbox->min[s] + (dim[s] / 2.0f);
-
-  part = partition_mainb(process->mainb, start, end, s, div);
-
-  make_box_from_metaelem(&node->bb[0], process->mainb[start]);
-  node->child[0] = nullptr;
-
-  if (part > start + 1) {
-    for (j = start; j < part; j++) {
-      make_box_union(process->mainb[j]->bb, &node->bb[0], &node->bb[0]);
-    }
-
-    node->child[0] = static_cast<MetaballBVHNode *>(
-        BLI_memarena_alloc(process->pgn_elements, sizeof(MetaballBVHNode)));
-    build_bvh_spatial(process, node->child[0], start, part, &node->bb[0]);
-  }
-
-  node->child[1] = nullptr;
-  if (part < end) {
-    make_box_from_metaelem(&node->bb[1], process->mainb[part]);
-
-    if (part < end - 1) {
-      for (j = part; j < end; j++) {
-        make_box_union(process->mainb[j]->bb, &node->bb[1], &node->bb[1]);
-      }
-
-      node->child[1] = static_cast<MetaballBVHNode *>(
-          BLI_memarena_alloc(process->pgn_elements, sizeof(MetaballBVHNode)));
-      build_bvh_spatial(process, node->child[1], part, end, &node->bb[1]);
-    }
-  }
-  else {
-    INIT_MINMAX(node->bb[1].min, node->bb[1].max);
-  }
-}
-
 /* ******************** ARITH ************************* */
 
 /**
@@ -282,19 +121,7 @@ static void build_bvh_spatial(
 #define RTN 6 /* Right top near corner. */
 #define RTF 7 /* Right top far corner. */
 
-/**
- * the LBN corner of cube (i, j, k), corresponds with location
- * (i-0.5)*size, (j-0.5)*size, (k-0.5)*size)
- */
-
-#define HASHBIT (5)
-/** Hash table size (32768). */
-#define HASHSIZE size_t(1 << (3 * HASHBIT))
-
-#define HASH(i, j, k) ((((((i) & 31) << 5) | ((j) & 31)) << 5) | ((k) & 31))
-
 #define MB_BIT(i, bit) (((i) >> (bit)) & 1)
-// #define FLIP(i, bit) ((i) ^ 1 << (bit)) /* flip the given bit of i */
 
 /* ******************** DENSITY COPMPUTATION ********************* */
 
@@ -400,107 +227,12 @@ static float densfunc(const MetaElem *ball, float x, float y, float z)
   return (dist2 < 0.0f) ? 0.0f : (ball->s * dist2 * dist2 * dist2);
 }
 
-/**
- * Computes density at given position form all meta-balls which contain this point in their box.
- * Traverses BVH using a queue.
- */
-static float metaball(PROCESS *process, float x, float y, float z)
-{
-  float dens = 0.0f;
-  uint front = 0, back = 0;
-  MetaballBVHNode *node;
-
-  process->bvh_queue[front++] = &process->metaball_bvh;
-
-  while (front != back) {
-    node = process->bvh_queue[back++];
-
-    for (int i = 0; i < 2; i++) {
-      if ((node->bb[i].min[0] <= x) && (node->bb[i].max[0] >= x) && (node->bb[i].min[1] <= y) &&
-          (node->bb[i].max[1] >= y) && (node->bb[i].min[2] <= z) && (node->bb[i].max[2] >= z))
-      {
-        if (node->child[i]) {
-          process->bvh_queue[front++] = node->child[i];
-        }
-        else {
-          dens += densfunc(node->bb[i].ml, x, y, z);
-        }
-      }
-    }
-  }
-
-  return process->thresh - dens;
-}
-
-/**
- * Adds face to indices, expands memory if needed.
- */
-static void make_face(PROCESS *process, int i1, int i2, int i3, int i4)
-{
-#ifdef USE_ACCUM_NORMAL
-  float n[3];
-#endif
-
-  if (UNLIKELY(process->totindex == process->curindex)) {
-    process->totindex = process->totindex ? (process->totindex * 2) : MBALL_ARRAY_LEN_INIT;
-    process->indices = static_cast<int(*)[4]>(
-        MEM_reallocN(process->indices, sizeof(int[4]) * process->totindex));
-  }
-
-  int *cur = process->indices[process->curindex++];
-
-  /* Treat triangles as fake quads. */
-  cur[0] = i1;
-  cur[1] = i2;
-  cur[2] = i3;
-  cur[3] = i4;
-
-#ifdef USE_ACCUM_NORMAL
-  if (i4 == i3) {
-    normal_tri_v3(n, process->co[i1], process->co[i2], process->co[i3]);
-    accumulate_vertex_normals_v3(process->no[i1],
-                                 process->no[i2],
-                                 process->no[i3],
-                                 nullptr,
-                                 n,
-                                 process->co[i1],
-                                 process->co[i2],
-                                 process->co[i3],
-                                 nullptr);
-  }
-  else {
-    normal_quad_v3(n, process->co[i1], process->co[i2], process->co[i3], process->co[i4]);
-    accumulate_vertex_normals_v3(process->no[i1],
-                                 process->no[i2],
-                                 process->no[i3],
-                                 process->no[i4],
-                                 n,
-                                 process->co[i1],
-                                 process->co[i2],
-                                 process->co[i3],
-                                 process->co[i4]);
-  }
-#endif
-}
-
 /* Frees allocated memory */
 static void freepolygonize(PROCESS *process)
 {
-  if (process->corners) {
-    MEM_freeN(process->corners);
-  }
-  if (process->edges) {
-    MEM_freeN(process->edges);
-  }
-  if (process->centers) {
-    MEM_freeN(process->centers);
-  }
   if (process->mainb) {
     MEM_freeN(process->mainb);
   }
-  if (process->bvh_queue) {
-    MEM_freeN(process->bvh_queue);
-  }
   if (process->pgn_elements) {
     BLI_memarena_free(process->pgn_elements);
   }
@@ -524,7 +256,6 @@ static void freepolygonize(PROCESS *process)
 #define TF 11 /* top far edge */
 
 static INTLISTS *cubetable[256];
-static char faces[256];
 
 /* edge: LB, LT, LN, LF, RB, RT, RN, RF, BN, BF, TN, TF */
 static int corner1[12] = {
@@ -586,120 +317,6 @@ static int rightface[12] = {
 };
 /* face on right when going corner1 to corner2 */
 
-/**
- * triangulate the cube directly, without decomposition
- */
-static void docube(PROCESS *process, CUBE *cube)
-{
-  INTLISTS *polys;
-  CORNER *c1, *c2;
-  int i, index = 0, count, indexar[8];
-
-  /* Determine which case cube falls into. */
-  for (i = 0; i < 8; i++) {
-    if (cube->corners[i]->value > 0.0f) {
-      index += (1 << i);
-    }
-  }
-
-  /* Using faces[] table, adds neighboring cube if surface intersects face in this direction. */
-  if (MB_BIT(faces[index], 0)) {
-    add_cube(process, cube->i - 1, cube->j, cube->k);
-  }
-  if (MB_BIT(faces[index], 1)) {
-    add_cube(process, cube->i + 1, cube->j, cube->k);
-  }
-  if (MB_BIT(faces[index], 2)) {
-    add_cube(process, cube->i, cube->j - 1, cube->k);
-  }
-  if (MB_BIT(faces[index], 3)) {
-    add_cube(process, cube->i, cube->j + 1, cube->k);
-  }
-  if (MB_BIT(faces[index], 4)) {
-    add_cube(process, cube->i, cube->j, cube->k - 1);
-  }
-  if (MB_BIT(faces[index], 5)) {
-    add_cube(process, cube->i, cube->j, cube->k + 1);
-  }
-
-  /* Using cubetable[], determines polygons for output. */
-  for (polys = cubetable[index]; polys; polys = polys->next) {
-    INTLIST *edges;
-
-    count = 0;
-    /* Sets needed vertex id's lying on the edges. */
-    for (edges = polys->list; edges; edges = edges->next) {
-      c1 = cube->corners[corner1[edges->i]];
-      c2 = cube->corners[corner2[edges->i]];
-
-      indexar[count] = vertid(process, c1, c2);
-      count++;
-    }
-
-    /* Adds faces to output. */
-    if (count > 2) {
-      switch (count) {
-        case 3:
-          make_face(process, indexar[2], indexar[1], indexar[0], indexar[0]); /* triangle */
-          break;
-        case 4:
-          make_face(process, indexar[3], indexar[2], indexar[1], indexar[0]);
-          break;
-        case 5:
-          make_face(process, indexar[3], indexar[2], indexar[1], indexar[0]);
-          make_face(process, indexar[4], indexar[3], indexar[0], indexar[0]); /* triangle */
-          break;
-        case 6:
-          make_face(process, indexar[3], indexar[2], indexar[1], indexar[0]);
-          make_face(process, indexar[5], indexar[4], indexar[3], indexar[0]);
-          break;
-        case 7:
-          make_face(process, indexar[3], indexar[2], indexar[1], indexar[0]);
-          make_face(process, indexar[5], indexar[4], indexar[3], indexar[0]);
-          make_face(process, indexar[6], indexar[5], indexar[0], indexar[0]); /* triangle */
-          break;
-      }
-    }
-  }
-}
-
-/**
- * return corner with the given lattice location
- * set (and cache) its function value
- */
-static CORNER *setcorner(PROCESS *process, int i, int j, int k)
-{
-  /* for speed, do corner value caching here */
-  CORNER *c;
-  int index;
-
-  /* does corner exist? */
-  index = HASH(i, j, k);
-  c = process->corners[index];
-
-  for (; c != nullptr; c = c->next) {
-    if (c->i == i && c->j == j && c->k == k) {
-      return c;
-    }
-  }
-
-  c = static_cast<CORNER *>(BLI_memarena_alloc(process->pgn_elements, sizeof(CORNER)));
-
-  c->i = i;
-  c->co[0] = (float(i) - 0.5f) * process->size;
-  c->j = j;
-  c->co[1] = (float(j) - 0.5f) * process->size;
-  c->k = k;
-  c->co[2] = (float(k) - 0.5f) * process->size;
-
-  c->value = metaball(process, c->co[0], c->co[1], c->co[2]);
-
-  c->next = process->corners[index];
-  process->corners[index] = c;
-
-  return c;
-}
-
 /**
  * return next clockwise edge from given edge around given face
  */
@@ -794,35 +411,6 @@ static void makecubetable()
       }
     }
   }
-
-  for (i = 0; i < 256; i++) {
-    INTLISTS *polys;
-    faces[i] = 0;
-    for (polys = cubetable[i]; polys; polys = polys->next) {
-      INTLIST *edges;
-
-      for (edges = polys->list; edges; edges = edges->next) {
-        if (ELEM(edges->i, LB, LT, LN, LF)) {
-          faces[i] |= 1 << L;
-        }
-        if (ELEM(edges->i, RB, RT, RN, RF)) {
-          faces[i] |= 1 << R;
-        }
-        if (ELEM(edges->i, LB, RB, BN, BF)) {
-          faces[i] |= 1 << B;
-        }
-        if (ELEM(edges->i, LT, RT, TN, TF)) {
-          faces[i] |= 1 << T;
-        }
-        if (ELEM(edges->i, LN, RN, BN, TN)) {
-          faces[i] |= 1 << N;
-        }
-        if (ELEM(edges->i, LF, RF, BF, TF)) {
-          faces[i] |= 1 << F;
-        }
-      }
-    }
-  }
 }
 
 void BKE_mball_cubeTable_free()
@@ -846,175 +434,254 @@ void BKE_mball_cubeTable_free()
   }
 }
 
-/**** Storage ****/
+/**** Parallel Polygonization ****/
 
 /**
- * Inserts cube at lattice i, j, k into hash table, marking it as "done"
+ * The lattice is split into bricks of BRICK_SIZE^3 cubes. The field is constant outside of the
+ * meta-elements, so only bricks that overlap the bounding box of at least one meta-element can
+ * contain the surface and are created. The cubes intersected by the surface are found by walking
+ * over the surface from a few starting cubes, like in the original polygonizer. All bricks walk in
+ * parallel, cubes reached in a neighbor brick are handed over to it for the next round.
  */
-static int setcenter(PROCESS *process, CENTERLIST *table[], const int i, const int j, const int k)
+#define BRICK_SIZE 16
+/** Number of lattice corners of a brick along each axis. */
+#define BRICK_CORNERS (BRICK_SIZE + 1)
+
+struct Brick {
+  /** The brick contains the cubes in [index * BRICK_SIZE, (index + 1) * BRICK_SIZE). */
+  blender::int3 index;
+  /**
+   * Meta-elements that may contain a corner of the brick. They are in the same order as in
+   * #PROCESS.mainb, so that all bricks sharing a corner compute exactly the same field value.
+   */
+  blender::Vector<const MetaElem *> elems;
+
+  /** Field values of the corners, only computed when a cube using them is visited. */
+  blender::Array<float> values;
+  blender::BitVector<> values_computed;
+  blender::BitVector<> cubes_visited;
+  /** Local cubes to visit in the next round. */
+  blender::Vector<blender::int3> cubes_pending;
+  /** Cubes in neighbor bricks reached in the current round, in lattice coordinates. */
+  blender::Vector<blender::int3> cubes_outgoing;
+
+  /** Local index and polygonization case of the cubes intersected by the surface. */
+  blender::Vector<int> cubes;
+  blender::Vector<uint8_t> cube_cases;
+  /**
+   * Vertices on the lattice edges owned by the brick, which are the edges starting at the first
+   * BRICK_SIZE^3 corners. The map key is #brick_edge_key.
+   */
+  blender::Vector<blender::float3> co;
+  blender::Map<int, int> edge_verts;
+  /** Index of the first vertex of the brick in the result mesh. */
+  int vert_offset;
+
+  /** Faces, triangles are stored as quads with the last index repeated. */
+  blender::Vector<blender::int4> faces;
+};
+
+static int brick_corner_index(const blender::int3 &local)
 {
-  int index;
-  CENTERLIST *newc, *l, *q;
+  return (local[2] * BRICK_CORNERS + local[1]) * BRICK_CORNERS + local[0];
+}
 
-  index = HASH(i, j, k);
-  q = table[index];
+static int brick_cube_index(const blender::int3 &local)
+{
+  return (local[2] * BRICK_SIZE + local[1]) * BRICK_SIZE + local[0];
+}
 
-  for (l = q; l != nullptr; l = l->next) {
-    if (l->i == i && l->j == j && l->k == k) {
-      return 1;
-    }
-  }
+static int brick_edge_key(const blender::int3 &local, const int axis)
+{
+  return brick_cube_index(local) * 3 + axis;
+}
 
-  newc = static_cast<CENTERLIST *>(BLI_memarena_alloc(process->pgn_elements, sizeof(CENTERLIST)));
-  newc->i = i;
-  newc->j = j;
-  newc->k = k;
-  newc->next = q;
-  table[index] = newc;
+static blender::int3 brick_index_of_cube(const blender::int3 &cube)
+{
+  return {divide_floor_i(cube[0], BRICK_SIZE),
+          divide_floor_i(cube[1], BRICK_SIZE),
+          divide_floor_i(cube[2], BRICK_SIZE)};
+}
 
-  return 0;
+static blender::int3 cube_corner_offset(const int corner)
+{
+  return {MB_BIT(corner, 2), MB_BIT(corner, 1), MB_BIT(corner, 0)};
 }
 
 /**
- * Sets vid of vertex lying on given edge.
+ * The location of lattice corner (i, j, k) is ((i - 0.5) * size, (j - 0.5) * size, ...).
  */
-static void setedge(PROCESS *process, int i1, int j1, int k1, int i2, int j2, int k2, int vid)
+static blender::float3 lattice_corner_co(const PROCESS *process, const blender::int3 &corner)
 {
-  int index;
-  EDGELIST *newe;
-
-  if (i1 > i2 || (i1 == i2 && (j1 > j2 || (j1 == j2 && k1 > k2)))) {
-    int t = i1;
-    i1 = i2;
-    i2 = t;
-    t = j1;
-    j1 = j2;
-    j2 = t;
-    t = k1;
-    k1 = k2;
-    k2 = t;
-  }
-  index = HASH(i1, j1, k1) + HASH(i2, j2, k2);
-  newe = static_cast<EDGELIST *>(BLI_memarena_alloc(process->pgn_elements, sizeof(EDGELIST)));
-
-  newe->i1 = i1;
-  newe->j1 = j1;
-  newe->k1 = k1;
-  newe->i2 = i2;
-  newe->j2 = j2;
-  newe->k2 = k2;
-  newe->vid = vid;
-  newe->next = process->edges[index];
-  process->edges[index] = newe;
+  return (blender::float3(corner) - 0.5f) * process->size;
 }
 
 /**
- * \return vertex id for edge; return -1 if not set
+ * Range of lattice corners that can be inside the bounding box of the meta-element, padded to
+ * be safe against rounding errors.
  */
-static int getedge(EDGELIST *table[], int i1, int j1, int k1, int i2, int j2, int k2)
+static void metaelem_corner_range(const PROCESS *process,
+                                  const MetaElem *ml,
+                                  blender::int3 &r_min,
+                                  blender::int3 &r_max)
 {
-  EDGELIST *q;
-
-  if (i1 > i2 || (i1 == i2 && (j1 > j2 || (j1 == j2 && k1 > k2)))) {
-    int t = i1;
-    i1 = i2;
-    i2 = t;
-    t = j1;
-    j1 = j2;
-    j2 = t;
-    t = k1;
-    k1 = k2;
-    k2 = t;
+  for (int axis = 0; axis < 3; axis++) {
+    r_min[axis] = int(floorf(ml->bb->vec[0][axis] / process->size + 0.5f)) - 1;
+    r_max[axis] = int(ceilf(ml->bb->vec[6][axis] / process->size + 0.5f)) + 1;
   }
-  q = table[HASH(i1, j1, k1) + HASH(i2, j2, k2)];
-  for (; q != nullptr; q = q->next) {
-    if (q->i1 == i1 && q->j1 == j1 && q->k1 == k1 && q->i2 == i2 && q->j2 == j2 && q->k2 == k2) {
-      return q->vid;
+}
+
+static bool metaelem_bounds_contain(const MetaElem *ml, const blender::float3 &co)
+{
+  const float *min = ml->bb->vec[0];
+  const float *max = ml->bb->vec[6];
+  return (min[0] <= co[0]) && (max[0] >= co[0]) && (min[1] <= co[1]) && (max[1] >= co[1]) &&
+         (min[2] <= co[2]) && (max[2] >= co[2]);
+}
+
+/**
+ * Computes density at given position from all meta-balls of the brick which contain this point
+ * in their box.
+ */
+static float brick_metaball(const PROCESS *process, const Brick &brick, const blender::float3 &co)
+{
+  float dens = 0.0f;
+  for (const MetaElem *ml : brick.elems) {
+    if (metaelem_bounds_contain(ml, co)) {
+      dens += densfunc(ml, co[0], co[1], co[2]);
     }
   }
-  return -1;
+  return process->thresh - dens;
 }
 
 /**
- * Adds a vertex, expands memory if needed.
+ * Create the bricks that overlap the bounding box of any meta-element and gather the
+ * meta-elements affecting each brick.
  */
-static void addtovertices(PROCESS *process, const float v[3], const float no[3])
+static blender::Vector<Brick> make_bricks(const PROCESS *process,
+                                          blender::Map<blender::int3, int> &r_brick_indices)
 {
-  process->co.append(v);
-  process->no.append(no);
+  using namespace blender;
+  Vector<Brick> bricks;
+  for (uint i = 0; i < process->totelem; i++) {
+    const MetaElem *ml = process->mainb[i];
+    int3 corner_min, corner_max;
+    metaelem_corner_range(process, ml, corner_min, corner_max);
+
+    /* The corners of a brick are [index * BRICK_SIZE, (index + 1) * BRICK_SIZE]. */
+    const int3 brick_min = brick_index_of_cube(corner_min - 1);
+    const int3 brick_max = brick_index_of_cube(corner_max);
+
+    int3 index;
+    for (index[2] = brick_min[2]; index[2] <= brick_max[2]; index[2]++) {
+      for (index[1] = brick_min[1]; index[1] <= brick_max[1]; index[1]++) {
+        for (index[0] = brick_min[0]; index[0] <= brick_max[0]; index[0]++) {
+          const int brick_index = r_brick_indices.lookup_or_add_cb(index, [&]() {
+            Brick brick;
+            brick.index = index;
+            bricks.append(std::move(brick));
+            return int(bricks.size() - 1);
+          });
+          bricks[brick_index].elems.append(ml);
+        }
+      }
+    }
+  }
+  return bricks;
 }
 
-#ifndef USE_ACCUM_NORMAL
 /**
- * Computes normal from density field at given point.
- *
- * \note Doesn't do normalization!
+ * Field value at a lattice corner, computed with the brick containing the corner. Corners outside
+ * of all bricks are outside of all meta-elements.
  */
-static void vnormal(PROCESS *process, const float point[3], float r_no[3])
+static float lattice_corner_value(const PROCESS *process,
+                                  const blender::Span<Brick> bricks,
+                                  const blender::Map<blender::int3, int> &brick_indices,
+                                  const blender::int3 &corner)
 {
-  const float delta = process->delta;
-  const float f = metaball(process, point[0], point[1], point[2]);
-
-  r_no[0] = metaball(process, point[0] + delta, point[1], point[2]) - f;
-  r_no[1] = metaball(process, point[0], point[1] + delta, point[2]) - f;
-  r_no[2] = metaball(process, point[0], point[1], point[2] + delta) - f;
+  const int *brick_index = brick_indices.lookup_ptr(brick_index_of_cube(corner));
+  if (brick_index == nullptr) {
+    return process->thresh;
+  }
+  return brick_metaball(process, bricks[*brick_index], lattice_corner_co(process, corner));
 }
-#endif /* !USE_ACCUM_NORMAL */
 
 /**
- * \return the id of vertex between two corners.
- *
- * If it wasn't previously computed, does #converge() and adds vertex to process.
+ * Find at most 26 cubes to start polygonization from, by marching from the center of the
+ * meta-element in all directions until the field changes sign.
  */
-static int vertid(PROCESS *process, const CORNER *c1, const CORNER *c2)
+static void find_first_points(const PROCESS *process,
+                              const blender::Span<Brick> bricks,
+                              const blender::Map<blender::int3, int> &brick_indices,
+                              const MetaElem *ml,
+                              blender::Vector<blender::int3> &r_cubes)
 {
-  float v[3], no[3];
-  int vid = getedge(process->edges, c1->i, c1->j, c1->k, c2->i, c2->j, c2->k);
-
-  if (vid != -1) {
-    return vid; /* previously computed */
+  using namespace blender;
+  int3 center, lbn, rtf, dir;
+  for (int axis = 0; axis < 3; axis++) {
+    const float mid = (ml->bb->vec[0][axis] + ml->bb->vec[6][axis]) * 0.5f;
+    center[axis] = int(floorf(mid / process->size + 1.0f));
+    rtf[axis] = int(ceilf(ml->bb->vec[6][axis] / process->size + 0.5f));
+    lbn[axis] = int(ceilf(ml->bb->vec[0][axis] / process->size + 0.5f)) - 1;
   }
 
-  converge(process, c1, c2, v); /* position */
-
-#ifdef USE_ACCUM_NORMAL
-  zero_v3(no);
-#else
-  vnormal(process, v, no);
-#endif
+  const float center_value = lattice_corner_value(process, bricks, brick_indices, center);
+  for (dir[0] = -1; dir[0] <= 1; dir[0]++) {
+    for (dir[1] = -1; dir[1] <= 1; dir[1]++) {
+      for (dir[2] = -1; dir[2] <= 1; dir[2]++) {
+        if (dir[0] == 0 && dir[1] == 0 && dir[2] == 0) {
+          continue;
+        }
 
-  addtovertices(process, v, no); /* save vertex */
-  vid = int(process->co.size()) - 1;
-  setedge(process, c1->i, c1->j, c1->k, c2->i, c2->j, c2->k, vid);
+        int3 it = center;
+        float b = center_value;
+        do {
+          it += dir;
+          const float a = b;
+          b = lattice_corner_value(process, bricks, brick_indices, it);
 
-  return vid;
+          if (a * b < 0.0f) {
+            r_cubes.append(math::min(it - dir, it));
+            break;
+          }
+        } while ((it[0] > lbn[0]) && (it[1] > lbn[1]) && (it[2] > lbn[2]) && (it[0] < rtf[0]) &&
+                 (it[1] < rtf[1]) && (it[2] < rtf[2]));
+      }
+    }
+  }
 }
 
 /**
  * Given two corners, computes approximation of surface intersection point between them.
  * In case of small threshold, do bisection.
  */
-static void converge(PROCESS *process, const CORNER *c1, const CORNER *c2, float r_p[3])
+static blender::float3 converge(const PROCESS *process,
+                                const Brick &brick,
+                                const blender::float3 &co_a,
+                                const float value_a,
+                                const blender::float3 &co_b,
+                                const float value_b)
 {
   float c1_value, c1_co[3];
   float c2_value, c2_co[3];
+  float r_p[3];
 
-  if (c1->value < c2->value) {
-    c1_value = c2->value;
-    copy_v3_v3(c1_co, c2->co);
-    c2_value = c1->value;
-    copy_v3_v3(c2_co, c1->co);
+  if (value_a < value_b) {
+    c1_value = value_b;
+    copy_v3_v3(c1_co, co_b);
+    c2_value = value_a;
+    copy_v3_v3(c2_co, co_a);
   }
   else {
-    c1_value = c1->value;
-    copy_v3_v3(c1_co, c1->co);
-    c2_value = c2->value;
-    copy_v3_v3(c2_co, c2->co);
+    c1_value = value_a;
+    copy_v3_v3(c1_co, co_a);
+    c2_value = value_b;
+    copy_v3_v3(c2_co, co_b);
   }
 
   for (uint i = 0; i < process->converge_res; i++) {
     interp_v3_v3v3(r_p, c1_co, c2_co, 0.5f);
-    float dens = metaball(process, r_p[0], r_p[1], r_p[2]);
+    float dens = brick_metaball(process, brick, r_p);
 
     if (dens > 0.0f) {
       c1_value = dens;
@@ -1028,134 +695,287 @@ static void converge(PROCESS *process, const CORNER *c1, const CORNER *c2, float
 
   float tmp = -c1_value / (c2_value - c1_value);
   interp_v3_v3v3(r_p, c1_co, c2_co, tmp);
+  return r_p;
 }
 
-/**
- * Adds cube at given lattice position to cube stack of process.
- */
-static void add_cube(PROCESS *process, int i, int j, int k)
+static float brick_corner_value(const PROCESS *process, Brick &brick, const blender::int3 &local)
 {
-  CUBES *ncube;
-  int n;
-
-  /* test if cube has been found before */
-  if (setcenter(process, process->centers, i, j, k) == 0) {
-    /* push cube on stack: */
-    ncube = static_cast<CUBES *>(BLI_memarena_alloc(process->pgn_elements, sizeof(CUBES)));
-    ncube->next = process->cubes;
-    process->cubes = ncube;
-
-    ncube->cube.i = i;
-    ncube->cube.j = j;
-    ncube->cube.k = k;
-
-    /* set corners of initial cube: */
-    for (n = 0; n < 8; n++) {
-      ncube->cube.corners[n] = setcorner(
-          process, i + MB_BIT(n, 2), j + MB_BIT(n, 1), k + MB_BIT(n, 0));
-    }
+  const int index = brick_corner_index(local);
+  if (!brick.values_computed[index]) {
+    brick.values[index] = brick_metaball(
+        process, brick, lattice_corner_co(process, brick.index * BRICK_SIZE + local));
+    brick.values_computed[index].set();
   }
-}
-
-static void next_lattice(int r[3], const float pos[3], const float size)
-{
-  r[0] = int(ceil((pos[0] / size) + 0.5f));
-  r[1] = int(ceil((pos[1] / size) + 0.5f));
-  r[2] = int(ceil((pos[2] / size) + 0.5f));
-}
-static void prev_lattice(int r[3], const float pos[3], const float size)
-{
-  next_lattice(r, pos, size);
-  r[0]--;
-  r[1]--;
-  r[2]--;
-}
-static void closest_latice(int r[3], const float pos[3], const float size)
-{
-  r[0] = int(floorf(pos[0] / size + 1.0f));
-  r[1] = int(floorf(pos[1] / size + 1.0f));
-  r[2] = int(floorf(pos[2] / size + 1.0f));
+  return brick.values[index];
 }
 
 /**
- * Find at most 26 cubes to start polygonization from.
+ * Visit the pending cubes of the brick and the cubes reached from them over the surface. Records
+ * the intersected cubes and computes the vertices on the edges owned by the brick.
  */
-static void find_first_points(PROCESS *process, const uint em)
+static void polygonize_brick_verts(const PROCESS *process, Brick &brick)
 {
-  const MetaElem *ml;
-  blender::int3 center, lbn, rtf, it, dir, add;
-  float tmp[3], a, b;
-
-  ml = process->mainb[em];
+  using namespace blender;
+  const int3 corner_start = brick.index * BRICK_SIZE;
+  if (brick.values.is_empty()) {
+    brick.values.reinitialize(BRICK_CORNERS * BRICK_CORNERS * BRICK_CORNERS);
+    brick.values_computed.resize(brick.values.size(), false);
+    brick.cubes_visited.resize(BRICK_SIZE * BRICK_SIZE * BRICK_SIZE, false);
+  }
 
-  mid_v3_v3v3(tmp, ml->bb->vec[0], ml->bb->vec[6]);
-  closest_latice(center, tmp, process->size);
-  prev_lattice(lbn, ml->bb->vec[0], process->size);
-  next_lattice(rtf, ml->bb->vec[6], process->size);
+  /* Corners on the low and high side of the cube along each axis. */
+  static const uint8_t face_corners[3][2] = {{0x0F, 0xF0}, {0x33, 0xCC}, {0x55, 0xAA}};
 
-  for (dir[0] = -1; dir[0] <= 1; dir[0]++) {
-    for (dir[1] = -1; dir[1] <= 1; dir[1]++) {
-      for (dir[2] = -1; dir[2] <= 1; dir[2]++) {
-        if (dir[0] == 0 && dir[1] == 0 && dir[2] == 0) {
+  Vector<int3> stack = std::move(brick.cubes_pending);
+  brick.cubes_pending.clear();
+  while (!stack.is_empty()) {
+    const int3 local = stack.pop_last();
+    if (brick.cubes_visited[brick_cube_index(local)]) {
+      continue;
+    }
+    brick.cubes_visited[brick_cube_index(local)].set();
+
+    /* Determine which case cube falls into. */
+    float values[8];
+    int cube_case = 0;
+    for (int n = 0; n < 8; n++) {
+      values[n] = brick_corner_value(process, brick, local + cube_corner_offset(n));
+      if (values[n] > 0.0f) {
+        cube_case += (1 << n);
+      }
+    }
+    if (cubetable[cube_case] == nullptr) {
+      continue;
+    }
+    brick.cubes.append(brick_corner_index(local));
+    brick.cube_cases.append(uint8_t(cube_case));
+
+    /* Add neighboring cube if surface intersects face in this direction. */
+    for (int axis = 0; axis < 3; axis++) {
+      for (int side = 0; side < 2; side++) {
+        const int face_case = cube_case & face_corners[axis][side];
+        if (ELEM(face_case, 0, face_corners[axis][side])) {
           continue;
         }
+        int3 neighbor = local;
+        neighbor[axis] += side ? 1 : -1;
+        if (neighbor[axis] < 0 || neighbor[axis] >= BRICK_SIZE) {
+          brick.cubes_outgoing.append(corner_start + neighbor);
+        }
+        else if (!brick.cubes_visited[brick_cube_index(neighbor)]) {
+          stack.append(neighbor);
+        }
+      }
+    }
 
-        copy_v3_v3_int(it, center);
+    /* Add vertices on the intersected edges owned by the brick. */
+    for (int edge = 0; edge < 12; edge++) {
+      const int c1 = corner1[edge];
+      const int c2 = corner2[edge];
+      if ((values[c1] > 0.0f) == (values[c2] > 0.0f)) {
+        continue;
+      }
+      const int3 corner_a = local + cube_corner_offset(c1);
+      const int3 corner_b = local + cube_corner_offset(c2);
+      const int3 start = math::min(corner_a, corner_b);
+      if (math::reduce_max(start) >= BRICK_SIZE) {
+        continue;
+      }
+      const int axis = (corner_a[0] != corner_b[0]) ? 0 : ((corner_a[1] != corner_b[1]) ? 1 : 2);
+      brick.edge_verts.add_or_modify(
+          brick_edge_key(start, axis),
+          [&](int *vert) {
+            *vert = int(brick.co.size());
+            brick.co.append(converge(process,
+                                     brick,
+                                     lattice_corner_co(process, corner_start + corner_a),
+                                     values[c1],
+                                     lattice_corner_co(process, corner_start + corner_b),
+                                     values[c2]));
+          },
+          [](int * /*vert*/) {});
+    }
+  }
+}
 
-        b = setcorner(process, it[0], it[1], it[2])->value;
-        do {
-          it[0] += dir[0];
-          it[1] += dir[1];
-          it[2] += dir[2];
-          a = b;
-          b = setcorner(process, it[0], it[1], it[2])->value;
+/**
+ * Triangulate the intersected cubes of the brick directly, without decomposition. Vertices on
+ * edges owned by neighbor bricks are looked up in these bricks.
+ */
+static void polygonize_brick_faces(const blender::Span<Brick> bricks,
+                                   const blender::Map<blender::int3, int> &brick_indices,
+                                   Brick &brick)
+{
+  using namespace blender;
+  const int3 corner_start = brick.index * BRICK_SIZE;
+
+  auto vertid = [&](const int3 &cube, const int edge) {
+    const int3 c1 = cube + int3(MB_BIT(corner1[edge], 2),
+                                MB_BIT(corner1[edge], 1),
+                                MB_BIT(corner1[edge], 0));
+    const int3 c2 = cube + int3(MB_BIT(corner2[edge], 2),
+                                MB_BIT(corner2[edge], 1),
+                                MB_BIT(corner2[edge], 0));
+    const int axis = (c1[0] != c2[0]) ? 0 : ((c1[1] != c2[1]) ? 1 : 2);
+    const int3 corner = math::min(c1, c2);
+    const int3 owner_index = brick_index_of_cube(corner);
+    const Brick &owner = (owner_index == brick.index) ? brick :
+                                                         bricks[brick_indices.lookup(owner_index)];
+    const int3 local = corner - owner_index * BRICK_SIZE;
+    return owner.vert_offset + owner.edge_verts.lookup(brick_edge_key(local, axis));
+  };
+
+  for (const int64_t i : brick.cubes.index_range()) {
+    const int cube_index = brick.cubes[i];
+    const int3 cube = corner_start + int3(cube_index % BRICK_CORNERS,
+                                          (cube_index / BRICK_CORNERS) % BRICK_CORNERS,
+                                          cube_index / (BRICK_CORNERS * BRICK_CORNERS));
+
+    /* Using cubetable[], determines polygons for output. */
+    for (const INTLISTS *polys = cubetable[brick.cube_cases[i]]; polys; polys = polys->next) {
+      int count = 0, indexar[8];
+      /* Sets needed vertex id's lying on the edges. */
+      for (const INTLIST *edges = polys->list; edges; edges = edges->next) {
+        indexar[count] = vertid(cube, edges->i);
+        count++;
+      }
 
-          if (a * b < 0.0f) {
-            add[0] = it[0] - dir[0];
-            add[1] = it[1] - dir[1];
-            add[2] = it[2] - dir[2];
-            add = blender::math::min(add, it);
-            add_cube(process, add[0], add[1], add[2]);
-            break;
-          }
-        } while ((it[0] > lbn[0]) && (it[1] > lbn[1]) && (it[2] > lbn[2]) && (it[0] < rtf[0]) &&
-                 (it[1] < rtf[1]) && (it[2] < rtf[2]));
+      /* Adds faces to output. */
+      switch (count) {
+        case 3:
+          brick.faces.append({indexar[2], indexar[1], indexar[0], indexar[0]}); /* triangle */
+          break;
+        case 4:
+          brick.faces.append({indexar[3], indexar[2], indexar[1], indexar[0]});
+          break;
+        case 5:
+          brick.faces.append({indexar[3], indexar[2], indexar[1], indexar[0]});
+          brick.faces.append({indexar[4], indexar[3], indexar[0], indexar[0]}); /* triangle */
+          break;
+        case 6:
+          brick.faces.append({indexar[3], indexar[2], indexar[1], indexar[0]});
+          brick.faces.append({indexar[5], indexar[4], indexar[3], indexar[0]});
+          break;
+        case 7:
+          brick.faces.append({indexar[3], indexar[2], indexar[1], indexar[0]});
+          brick.faces.append({indexar[5], indexar[4], indexar[3], indexar[0]});
+          brick.faces.append({indexar[6], indexar[5], indexar[0], indexar[0]}); /* triangle */
+          break;
       }
     }
   }
 }
 
 /**
- * The main polygonization processing function.
- * Allocates memory, makes cube-table,
- * finds starting surface points
- * and processes cubes on the stack until none left.
+ * Hand the cubes reached by the bricks in the last round over to the bricks containing them.
+ * \return True if any brick has cubes to visit.
  */
-static void polygonize(PROCESS *process)
+static bool bricks_distribute_cubes(blender::MutableSpan<Brick> bricks,
+                                    const blender::Map<blender::int3, int> &brick_indices,
+                                    const blender::Span<blender::int3> cubes)
 {
-  CUBE c;
-
-  process->centers = static_cast<CENTERLIST **>(
-      MEM_callocN(HASHSIZE * sizeof(CENTERLIST *), "mbproc->centers"));
-  process->corners = static_cast<CORNER **>(
-      MEM_callocN(HASHSIZE * sizeof(CORNER *), "mbproc->corners"));
-  process->edges = static_cast<EDGELIST **>(
-      MEM_callocN(2 * HASHSIZE * sizeof(EDGELIST *), "mbproc->edges"));
-  process->bvh_queue = static_cast<MetaballBVHNode **>(
-      MEM_callocN(sizeof(MetaballBVHNode *) * process->bvh_queue_size, "Metaball BVH Queue"));
+  using namespace blender;
+  bool has_pending = false;
+  for (const int3 &cube : cubes) {
+    const int3 brick_index = brick_index_of_cube(cube);
+    if (const int *index = brick_indices.lookup_ptr(brick_index)) {
+      bricks[*index].cubes_pending.append(cube - brick_index * BRICK_SIZE);
+      has_pending = true;
+    }
+  }
+  return has_pending;
+}
 
+/**
+ * The main polygonization processing function. Makes the cube-table, finds the starting cubes and
+ * walks over the surface in all bricks in parallel, and then creates the faces, which may use
+ * vertices of the neighbor bricks.
+ */
+static Mesh *polygonize(PROCESS *process)
+{
+  using namespace blender;
   makecubetable();
 
-  for (uint i = 0; i < process->totelem; i++) {
-    find_first_points(process, i);
+  Map<int3, int> brick_indices;
+  Vector<Brick> bricks = make_bricks(process, brick_indices);
+
+  Array<Vector<int3>> first_cubes(process->totelem);
+  threading::parallel_for(first_cubes.index_range(), 64, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      find_first_points(process, bricks, brick_indices, process->mainb[i], first_cubes[i]);
+    }
+  });
+  bool has_pending = false;
+  for (const Span<int3> cubes : first_cubes) {
+    has_pending |= bricks_distribute_cubes(bricks, brick_indices, cubes);
   }
 
-  while (process->cubes != nullptr) {
-    c = process->cubes->cube;
-    process->cubes = process->cubes->next;
+  while (has_pending) {
+    Vector<int> active_bricks;
+    for (const int64_t i : bricks.index_range()) {
+      if (!bricks[i].cubes_pending.is_empty()) {
+        active_bricks.append(int(i));
+      }
+    }
+    threading::parallel_for(active_bricks.index_range(), 1, [&](const IndexRange range) {
+      for (const int i : active_bricks.as_span().slice(range)) {
+        polygonize_brick_verts(process, bricks[i]);
+      }
+    });
+    has_pending = false;
+    for (const int i : active_bricks) {
+      has_pending |= bricks_distribute_cubes(bricks, brick_indices, bricks[i].cubes_outgoing);
+      bricks[i].cubes_outgoing.clear();
+    }
+  }
 
-    docube(process, &c);
+  int verts_num = 0;
+  for (Brick &brick : bricks) {
+    brick.vert_offset = verts_num;
+    verts_num += int(brick.co.size());
   }
+
+  threading::parallel_for(bricks.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      polygonize_brick_faces(bricks, brick_indices, bricks[i]);
+    }
+  });
+
+  Vector<int4> faces;
+  for (Brick &brick : bricks) {
+    faces.extend(brick.faces);
+    brick.faces.clear_and_shrink();
+  }
+  if (faces.is_empty()) {
+    return nullptr;
+  }
+
+  Array<int> face_offset_data(faces.size() + 1);
+  threading::parallel_for(faces.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      face_offset_data[i] = faces[i][2] != faces[i][3] ? 4 : 3;
+    }
+  });
+  const OffsetIndices<int> face_offsets = offset_indices::accumulate_counts_to_offsets(
+      face_offset_data);
+
+  Mesh *mesh = BKE_mesh_new_nomain(verts_num, 0, int(faces.size()), face_offsets.total_size());
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  threading::parallel_for(bricks.index_range(), 16, [&](const IndexRange range) {
+    for (const Brick &brick : bricks.as_span().slice(range)) {
+      positions.slice(brick.vert_offset, brick.co.size()).copy_from(brick.co);
+    }
+  });
+  mesh->face_offsets_for_write().copy_from(face_offset_data);
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  threading::parallel_for(faces.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const IndexRange face = face_offsets[i];
+      corner_verts.slice(face).copy_from(Span<int>(&faces[i][0], face.size()));
+    }
+  });
+
+  return mesh;
 }
 
 static bool object_has_zero_axis_matrix(const Object *bob)
@@ -1174,7 +994,7 @@ static bool object_has_zero_axis_matrix(const Object *bob)
 /**
  * Iterates over ALL objects in the scene and all of its sets, including
  * making all duplis (not only meta-elements). Copies meta-elements to #process.mainb array.
- * Computes bounding boxes for building BVH.
+ * Computes the bounding box of all meta-elements.
  */
 static void init_meta(Depsgraph *depsgraph, PROCESS *process, Scene *scene, Object *ob)
 {
@@ -1397,10 +1217,6 @@ Mesh *BKE_mball_polygonize(Depsgraph *depsgraph, Scene *scene, Object *ob)
     }
   }
 
-  process.delta = process.size * 0.001f;
-
-  process.co.reserve(MBALL_ARRAY_LEN_INIT);
-  process.no.reserve(MBALL_ARRAY_LEN_INIT);
   process.pgn_elements = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, "Metaball memarena");
 
   /* initialize all mainb (MetaElems) */
@@ -1410,8 +1226,6 @@ Mesh *BKE_mball_polygonize(Depsgraph *depsgraph, Scene *scene, Object *ob)
     return nullptr;
   }
 
-  build_bvh_spatial(&process, &process.metaball_bvh, 0, process.totelem, &process.allbb);
-
   /* Don't polygonize meta-balls with too high resolution (base meta-ball too small).
    * NOTE: Epsilon was 0.0001f but this was giving problems for blood animation for
    * the open movie "Sintel", using 0.00001f. */
@@ -1423,49 +1237,13 @@ Mesh *BKE_mball_polygonize(Depsgraph *depsgraph, Scene *scene, Object *ob)
     return nullptr;
   }
 
-  polygonize(&process);
-  if (process.curindex == 0) {
-    freepolygonize(&process);
-    return nullptr;
-  }
-
+  Mesh *mesh = polygonize(&process);
   freepolygonize(&process);
-
-  int corners_num = 0;
-  for (uint i = 0; i < process.curindex; i++) {
-    const int *indices = process.indices[i];
-    const int count = indices[2] != indices[3] ? 4 : 3;
-    corners_num += count;
-  }
-
-  Mesh *mesh = BKE_mesh_new_nomain(int(process.co.size()), 0, int(process.curindex), corners_num);
-  mesh->vert_positions_for_write().copy_from(process.co);
-  blender::MutableSpan<int> face_offsets = mesh->face_offsets_for_write();
-  blender::MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
-
-  int loop_offset = 0;
-  for (int i = 0; i < mesh->faces_num; i++) {
-    const int *indices = process.indices[i];
-
-    const int count = indices[2] != indices[3] ? 4 : 3;
-    face_offsets[i] = loop_offset;
-
-    corner_verts[loop_offset] = indices[0];
-    corner_verts[loop_offset + 1] = indices[1];
-    corner_verts[loop_offset + 2] = indices[2];
-    if (count == 4) {
-      corner_verts[loop_offset + 3] = indices[3];
-    }
-
-    loop_offset += count;
-  }
-  MEM_freeN(process.indices);
-
-  for (int i = 0; i < mesh->verts_num; i++) {
-    normalize_v3(process.no[i]);
+  if (mesh == nullptr) {
+    return nullptr;
   }
-  blender::bke::mesh_vert_normals_assign(*mesh, std::move(process.no));
 
+  /* Vertex normals are computed lazily by the mesh from the angle weighted face normals. */
   blender::bke::mesh_calc_edges(*mesh, false, false);
 
   return mesh;
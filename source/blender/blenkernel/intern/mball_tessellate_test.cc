@@ -0,0 +1,111 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "CLG_log.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meta_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BLI_math_vector.hh"
+
+#include "BKE_idtype.hh"
+#include "BKE_main.hh"
+#include "BKE_mball.hh"
+#include "BKE_mball_tessellate.hh"
+#include "BKE_mesh.hh"
+#include "BKE_object.hh"
+#include "BKE_scene.hh"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_query.hh"
+
+namespace blender::bke::tests {
+
+class MetaballTessellateTest : public testing::Test {
+ public:
+  Main *bmain = nullptr;
+  Scene *scene = nullptr;
+  ViewLayer *view_layer = nullptr;
+  Depsgraph *depsgraph = nullptr;
+
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+    DEG_register_node_types();
+  }
+
+  static void TearDownTestSuite()
+  {
+    BKE_mball_cubeTable_free();
+    DEG_free_node_types();
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+    scene = BKE_scene_add(bmain, "Scene");
+    view_layer = static_cast<ViewLayer *>(scene->view_layers.first);
+  }
+
+  void TearDown() override
+  {
+    if (depsgraph) {
+      DEG_graph_free(depsgraph);
+    }
+    BKE_main_free(bmain);
+  }
+
+  const Mesh *evaluate(Object *ob)
+  {
+    depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
+    DEG_graph_build_from_view_layer(depsgraph);
+    BKE_scene_graph_update_tagged(depsgraph, bmain);
+    return BKE_object_get_evaluated_mesh(DEG_get_evaluated_object(depsgraph, ob));
+  }
+};
+
+/** Volume enclosed by a closed mesh, computed from the tetrahedra spanned by its face fans. */
+static float mesh_volume(const Mesh &mesh)
+{
+  const Span<float3> positions = mesh.vert_positions();
+  const OffsetIndices<int> faces = mesh.faces();
+  const Span<int> corner_verts = mesh.corner_verts();
+  float volume = 0.0f;
+  for (const int face_i : faces.index_range()) {
+    const IndexRange face = faces[face_i];
+    const float3 &first = positions[corner_verts[face.first()]];
+    for (const int corner : face.drop_front(1).drop_back(1)) {
+      const float3 &a = positions[corner_verts[corner]];
+      const float3 &b = positions[corner_verts[corner + 1]];
+      volume += math::dot(first, math::cross(a, b)) / 6.0f;
+    }
+  }
+  return volume;
+}
+
+TEST_F(MetaballTessellateTest, TwoBalls)
+{
+  Object *ob = BKE_object_add(bmain, scene, view_layer, OB_MBALL, "Meta");
+  MetaBall *mb = static_cast<MetaBall *>(ob->data);
+  BKE_mball_element_add(mb, MB_BALL);
+  MetaElem *ml = BKE_mball_element_add(mb, MB_BALL);
+  ml->x = 2.0f;
+
+  const Mesh *mesh = evaluate(ob);
+  ASSERT_NE(mesh, nullptr);
+
+  /* Reference values computed with the previous serial polygonizer. */
+  EXPECT_EQ(mesh->verts_num, 256);
+  EXPECT_EQ(mesh->faces_num, 298);
+  EXPECT_NEAR(mesh_volume(*mesh), 12.6867f, 1e-3f);
+}
+
+}  // namespace blender::bke::tests
@@ -19,6 +19,7 @@
 
 #include "BLI_array_utils.hh"
 #include "BLI_bit_vector.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_linklist.h"
 #include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
@@ -148,10 +149,18 @@ void normals_calc_faces(const Span<float3> positions,
                         MutableSpan<float3> face_normals)
 {
   BLI_assert(faces.size() == face_normals.size());
-  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
-    for (const int i : range) {
-      face_normals[i] = normal_calc_ngon(positions, corner_verts.slice(faces[i]));
-    }
+  normals_calc_faces(positions, faces, corner_verts, faces.index_range(), face_normals);
+}
+
+void normals_calc_faces(const Span<float3> positions,
+                        const OffsetIndices<int> faces,
+                        const Span<int> corner_verts,
+                        const IndexMask &face_mask,
+                        MutableSpan<float3> face_normals)
+{
+  BLI_assert(faces.size() == face_normals.size());
+  face_mask.foreach_index(GrainSize(1024), [&](const int i) {
+    face_normals[i] = normal_calc_ngon(positions, corner_verts.slice(faces[i]));
   });
 }
 
@@ -162,27 +171,42 @@ void normals_calc_verts(const Span<float3> vert_positions,
                         const Span<float3> face_normals,
                         MutableSpan<float3> vert_normals)
 {
-  const Span<float3> positions = vert_positions;
-  threading::parallel_for(positions.index_range(), 1024, [&](const IndexRange range) {
-    for (const int vert : range) {
-      const Span<int> vert_faces = vert_to_face_map[vert];
-      if (vert_faces.is_empty()) {
-        vert_normals[vert] = math::normalize(positions[vert]);
-        continue;
-      }
+  normals_calc_verts(vert_positions,
+                     faces,
+                     corner_verts,
+                     vert_to_face_map,
+                     face_normals,
+                     vert_positions.index_range(),
+                     vert_normals);
+}
 
-      float3 vert_normal(0);
-      for (const int face : vert_faces) {
-        const int2 adjacent_verts = face_find_adjacent_verts(faces[face], corner_verts, vert);
-        const float3 dir_prev = math::normalize(positions[adjacent_verts[0]] - positions[vert]);
-        const float3 dir_next = math::normalize(positions[adjacent_verts[1]] - positions[vert]);
-        const float factor = math::safe_acos_approx(math::dot(dir_prev, dir_next));
+void normals_calc_verts(const Span<float3> vert_positions,
+                        const OffsetIndices<int> faces,
+                        const Span<int> corner_verts,
+                        const GroupedSpan<int> vert_to_face_map,
+                        const Span<float3> face_normals,
+                        const IndexMask &vert_mask,
+                        MutableSpan<float3> vert_normals)
+{
+  const Span<float3> positions = vert_positions;
+  vert_mask.foreach_index(GrainSize(1024), [&](const int vert) {
+    const Span<int> vert_faces = vert_to_face_map[vert];
+    if (vert_faces.is_empty()) {
+      vert_normals[vert] = math::normalize(positions[vert]);
+      return;
+    }
 
-        vert_normal += face_normals[face] * factor;
-      }
+    float3 vert_normal(0);
+    for (const int face : vert_faces) {
+      const int2 adjacent_verts = face_find_adjacent_verts(faces[face], corner_verts, vert);
+      const float3 dir_prev = math::normalize(positions[adjacent_verts[0]] - positions[vert]);
+      const float3 dir_next = math::normalize(positions[adjacent_verts[1]] - positions[vert]);
+      const float factor = math::safe_acos_approx(math::dot(dir_prev, dir_next));
 
-      vert_normals[vert] = math::normalize(vert_normal);
+      vert_normal += face_normals[face] * factor;
     }
+
+    vert_normals[vert] = math::normalize(vert_normal);
   });
 }
 
@@ -285,21 +309,30 @@ blender::Span<blender::float3> Mesh::corner_normals() const
         break;
       }
       case MeshNormalDomain::Corner: {
-        const AttributeAccessor attributes = this->attributes();
-        const VArraySpan sharp_edges = *attributes.lookup<bool>("sharp_edge", AttrDomain::Edge);
-        const VArraySpan sharp_faces = *attributes.lookup<bool>("sharp_face", AttrDomain::Face);
+        this->runtime->corner_normal_fans_cache.ensure([&](CornerNormalFans &r_fans) {
+          const AttributeAccessor attributes = this->attributes();
+          const VArraySpan sharp_edges = *attributes.lookup<bool>("sharp_edge", AttrDomain::Edge);
+          const VArraySpan sharp_faces = *attributes.lookup<bool>("sharp_face", AttrDomain::Face);
+          mesh::corner_normal_fans_calc(faces,
+                                        this->corner_verts(),
+                                        this->corner_edges(),
+                                        this->corner_to_face_map(),
+                                        sharp_edges,
+                                        sharp_faces,
+                                        this->edges_num,
+                                        r_fans);
+        });
         const short2 *custom_normals = static_cast<const short2 *>(
             CustomData_get_layer(&this->corner_data, CD_CUSTOMLOOPNORMAL));
         mesh::normals_calc_corners(this->vert_positions(),
                                    this->edges(),
-                                   this->faces(),
+                                   faces,
                                    this->corner_verts(),
                                    this->corner_edges(),
                                    this->corner_to_face_map(),
                                    this->vert_normals(),
                                    this->face_normals(),
-                                   sharp_edges,
-                                   sharp_faces,
+                                   this->runtime->corner_normal_fans_cache.data(),
                                    custom_normals,
                                    nullptr,
                                    r_data);
@@ -1020,24 +1053,24 @@ static void split_corner_normal_fan_do(CornerSplitTaskDataCommon *common_data,
 }
 
 /**
- * Check whether given corner is part of an unknown-so-far cyclic smooth fan, or not.
- * Needed because cyclic smooth fans have no obvious 'entry point',
- * and yet we need to walk them once, and only once.
+ * Check whether the given corner starts a cyclic smooth fan, i.e. a fan around a vertex without
+ * any sharp edge. Cyclic smooth fans have no obvious 'entry point', yet they need to be walked
+ * once and only once, so the corner with the smallest index in the fan is used. That makes the
+ * result independent of the order in which corners are checked, so all corners can be checked in
+ * parallel.
  */
-static bool corner_split_generator_check_cyclic_smooth_fan(const Span<int> corner_verts,
-                                                           const Span<int> corner_edges,
-                                                           const OffsetIndices<int> faces,
-                                                           const Span<int2> edge_to_corners,
-                                                           const Span<int> corner_to_face,
-                                                           const int2 e2l_prev,
-                                                           MutableBitSpan skip_corners,
-                                                           const int corner,
-                                                           const int corner_prev)
+static bool corner_starts_cyclic_smooth_fan(const Span<int> corner_verts,
+                                            const Span<int> corner_edges,
+                                            const OffsetIndices<int> faces,
+                                            const Span<int2> edge_to_corners,
+                                            const Span<int> corner_to_face,
+                                            const int corner,
+                                            const int corner_prev)
 {
   /* The vertex we are "fanning" around. */
   const int vert_pivot = corner_verts[corner];
 
-  int2 e2lfan_curr = e2l_prev;
+  int2 e2lfan_curr = edge_to_corners[corner_edges[corner_prev]];
   if (IS_EDGE_SHARP(e2lfan_curr)) {
     /* Sharp corner, so not a cyclic smooth fan. */
     return false;
@@ -1049,13 +1082,8 @@ static bool corner_split_generator_check_cyclic_smooth_fan(const Span<int> corne
   int fan_corner = corner_prev;
   int vert_corner = corner;
 
-  BLI_assert(fan_corner >= 0);
-  BLI_assert(vert_corner >= 0);
-
-  BLI_assert(!skip_corners[vert_corner]);
-  skip_corners[vert_corner].set();
-
-  while (true) {
+  /* A fan can't have more corners than the mesh, this only protects against invalid topology. */
+  for ([[maybe_unused]] const int i : corner_verts.index_range()) {
     /* Find next corner of the smooth fan. */
     corner_manifold_fan_around_vert_next(
         corner_verts, faces, corner_to_face, e2lfan_curr, vert_pivot, &fan_corner, &vert_corner);
@@ -1066,101 +1094,118 @@ static bool corner_split_generator_check_cyclic_smooth_fan(const Span<int> corne
       /* Sharp corner/edge, so not a cyclic smooth fan. */
       return false;
     }
-    /* Smooth corner/edge. */
-    if (skip_corners[vert_corner]) {
-      if (vert_corner == corner) {
-        /* We walked around a whole cyclic smooth fan without finding any already-processed corner,
-         * means we can use initial current / previous edge as start for this smooth fan. */
-        return true;
-      }
-      /* Already checked in some previous looping, we can abort. */
+    if (vert_corner == corner) {
+      /* We walked around a whole cyclic smooth fan without finding a corner with a smaller index,
+       * so this corner is used as start for this smooth fan. */
+      return true;
+    }
+    if (vert_corner < corner) {
+      /* The fan is started by another corner, or it is not cyclic. */
       return false;
     }
-
-    /* We can skip it in future, and keep checking the smooth fan. */
-    skip_corners[vert_corner].set();
   }
+  return false;
 }
 
-static void corner_split_generator(CornerSplitTaskDataCommon *common_data,
-                                   Vector<int, 32> &r_single_corners,
-                                   Vector<int, 32> &r_fan_corners)
-{
-  const Span<int> corner_verts = common_data->corner_verts;
-  const Span<int> corner_edges = common_data->corner_edges;
-  const OffsetIndices faces = common_data->faces;
-  const Span<int> corner_to_face = common_data->corner_to_face;
-  const Span<int2> edge_to_corners = common_data->edge_to_corners;
-
-  BitVector<> skip_corners(corner_verts.size(), false);
+enum class CornerFanType : int8_t {
+  /** The corner is part of a fan started by another corner. */
+  None,
+  /** Both edges around the vertex are sharp in the face, the corner takes the face normal. */
+  Single,
+  /** The corner starts a smooth fan. */
+  Fan,
+};
 
+void corner_normal_fans_calc(const OffsetIndices<int> faces,
+                             const Span<int> corner_verts,
+                             const Span<int> corner_edges,
+                             const Span<int> corner_to_face_map,
+                             const Span<bool> sharp_edges,
+                             const Span<bool> sharp_faces,
+                             const int edges_num,
+                             CornerNormalFans &r_fans)
+{
 #ifdef DEBUG_TIME
   SCOPED_TIMER_AVERAGED(__func__);
 #endif
 
-  /* We now know edges that can be smoothed (with their vector, and their two corners),
-   * and edges that will be hard! Now, time to generate the normals.
-   */
-  for (const int face_index : faces.index_range()) {
-    const IndexRange face = faces[face_index];
-
-    for (const int corner : face) {
-      const int corner_prev = mesh::face_corner_prev(face, corner);
-
-#if 0
-      printf("Checking corner %d / edge %u / vert %u (sharp edge: %d, skiploop: %d)",
-             corner,
-             corner_edges[corner],
-             corner_verts[corner],
-             IS_EDGE_SHARP(edge_to_corners[corner_edges[corner]]),
-             skip_corners[corner]);
-#endif
+  /**
+   * Mapping edge -> corners.
+   * If that edge is used by more than two corners (faces),
+   * it is always sharp (and tagged as such, see below).
+   * We also use the second corner index as a kind of flag:
+   *
+   * - smooth edge: > 0.
+   * - sharp edge: < 0 (INDEX_INVALID || INDEX_UNSET).
+   * - unset: INDEX_UNSET.
+   *
+   * Note that currently we only have two values for second corner of sharp edges.
+   * However, if needed, we can store the negated value of corner index instead of INDEX_INVALID
+   * to retrieve the real value later in code).
+   * Note also that loose edges always have both values set to 0! */
+  r_fans.edge_to_corners.reinitialize(edges_num);
+  r_fans.edge_to_corners.fill(int2(0));
+  const Span<int2> edge_to_corners = r_fans.edge_to_corners;
 
-      /* A smooth edge, we have to check for cyclic smooth fan case.
-       * If we find a new, never-processed cyclic smooth fan, we can do it now using that
-       * corner/edge as 'entry point', otherwise we can skip it. */
-
-      /* NOTE: In theory, we could make #corner_split_generator_check_cyclic_smooth_fan() store
-       * vert_corner'es and edge indexes in two stacks, to avoid having to fan again around
-       * the vert during actual computation of `clnor` & `clnorspace`.
-       * However, this would complicate the code, add more memory usage, and despite its logical
-       * complexity, #corner_manifold_fan_around_vert_next() is quite cheap in term of CPU cycles,
-       * so really think it's not worth it. */
-      if (!IS_EDGE_SHARP(edge_to_corners[corner_edges[corner]]) &&
-          (skip_corners[corner] || !corner_split_generator_check_cyclic_smooth_fan(
-                                       corner_verts,
-                                       corner_edges,
-                                       faces,
-                                       edge_to_corners,
-                                       corner_to_face,
-                                       edge_to_corners[corner_edges[corner_prev]],
-                                       skip_corners,
-                                       corner,
-                                       corner_prev)))
-      {
-        // printf("SKIPPING!\n");
-      }
-      else {
-        if (IS_EDGE_SHARP(edge_to_corners[corner_edges[corner]]) &&
-            IS_EDGE_SHARP(edge_to_corners[corner_edges[corner_prev]]))
-        {
+  /* This first corner check which edges are actually smooth. */
+  build_edge_to_corner_map_with_flip_and_sharp(
+      faces, corner_verts, corner_edges, sharp_faces, sharp_edges, r_fans.edge_to_corners);
+
+  /* We now know edges that can be smoothed (with their two corners), and edges that will be hard!
+   * Now, time to find the fans of corners that share a normal. */
+  Array<CornerFanType> fan_types(corner_verts.size());
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int face_index : range) {
+      const IndexRange face = faces[face_index];
+      for (const int corner : face) {
+        const int corner_prev = mesh::face_corner_prev(face, corner);
+        const bool edge_is_sharp = IS_EDGE_SHARP(edge_to_corners[corner_edges[corner]]);
+        if (!edge_is_sharp) {
+          /* A smooth edge, the corner only starts a fan if it is the entry point of a cyclic
+           * smooth fan. Otherwise, the fan is started by the corner with the sharp edge.
+           *
+           * We do not need to check/tag corners as already computed. Due to the fact that a
+           * corner only points to one of its two edges, the same fan will never be walked more
+           * than once. Since we consider edges that have neighbor faces with inverted (flipped)
+           * normals as sharp, we are sure that no fan will be skipped, even only considering the
+           * case (sharp current edge, smooth previous edge), and not the alternative (smooth
+           * current edge, sharp previous edge). All this due/thanks to the link between normals
+           * and corner ordering (i.e. winding). */
+          fan_types[corner] = corner_starts_cyclic_smooth_fan(corner_verts,
+                                                              corner_edges,
+                                                              faces,
+                                                              edge_to_corners,
+                                                              corner_to_face_map,
+                                                              corner,
+                                                              corner_prev) ?
+                                  CornerFanType::Fan :
+                                  CornerFanType::None;
+        }
+        else if (IS_EDGE_SHARP(edge_to_corners[corner_edges[corner_prev]])) {
           /* Simple case (both edges around that vertex are sharp in current face),
            * this corner just takes its face normal. */
-          r_single_corners.append(corner);
+          fan_types[corner] = CornerFanType::Single;
         }
         else {
-          /* We do not need to check/tag corners as already computed. Due to the fact that a corner
-           * only points to one of its two edges, the same fan will never be walked more than once.
-           * Since we consider edges that have neighbor faces with inverted (flipped) normals as
-           * sharp, we are sure that no fan will be skipped, even only considering the case (sharp
-           * current edge, smooth previous edge), and not the alternative (smooth current edge,
-           * sharp previous edge). All this due/thanks to the link between normals and corner
-           * ordering (i.e. winding). */
-          r_fan_corners.append(corner);
+          fan_types[corner] = CornerFanType::Fan;
         }
       }
     }
-  }
+  });
+
+  IndexMaskMemory memory;
+  const IndexMask single_corners = IndexMask::from_predicate(
+      fan_types.index_range(), GrainSize(4096), memory, [&](const int64_t corner) {
+        return fan_types[corner] == CornerFanType::Single;
+      });
+  const IndexMask fan_corners = IndexMask::from_predicate(
+      fan_types.index_range(), GrainSize(4096), memory, [&](const int64_t corner) {
+        return fan_types[corner] == CornerFanType::Fan;
+      });
+  r_fans.single_corners.reinitialize(single_corners.size());
+  single_corners.to_indices(r_fans.single_corners.as_mutable_span());
+  r_fans.fan_corners.reinitialize(fan_corners.size());
+  fan_corners.to_indices(r_fans.fan_corners.as_mutable_span());
 }
 
 void normals_calc_corners(const Span<float3> vert_positions,
@@ -1177,22 +1222,42 @@ void normals_calc_corners(const Span<float3> vert_positions,
                           CornerNormalSpaceArray *r_lnors_spacearr,
                           MutableSpan<float3> r_corner_normals)
 {
-  /**
-   * Mapping edge -> corners.
-   * If that edge is used by more than two corners (faces),
-   * it is always sharp (and tagged as such, see below).
-   * We also use the second corner index as a kind of flag:
-   *
-   * - smooth edge: > 0.
-   * - sharp edge: < 0 (INDEX_INVALID || INDEX_UNSET).
-   * - unset: INDEX_UNSET.
-   *
-   * Note that currently we only have two values for second corner of sharp edges.
-   * However, if needed, we can store the negated value of corner index instead of INDEX_INVALID
-   * to retrieve the real value later in code).
-   * Note also that loose edges always have both values set to 0! */
-  Array<int2> edge_to_corners(edges.size(), int2(0));
+  CornerNormalFans fans;
+  corner_normal_fans_calc(faces,
+                          corner_verts,
+                          corner_edges,
+                          corner_to_face_map,
+                          sharp_edges,
+                          sharp_faces,
+                          edges.size(),
+                          fans);
+  normals_calc_corners(vert_positions,
+                       edges,
+                       faces,
+                       corner_verts,
+                       corner_edges,
+                       corner_to_face_map,
+                       vert_normals,
+                       face_normals,
+                       fans,
+                       clnors_data,
+                       r_lnors_spacearr,
+                       r_corner_normals);
+}
 
+void normals_calc_corners(const Span<float3> vert_positions,
+                          const Span<int2> edges,
+                          const OffsetIndices<int> faces,
+                          const Span<int> corner_verts,
+                          const Span<int> corner_edges,
+                          const Span<int> corner_to_face_map,
+                          const Span<float3> vert_normals,
+                          const Span<float3> face_normals,
+                          const CornerNormalFans &fans,
+                          const short2 *clnors_data,
+                          CornerNormalSpaceArray *r_lnors_spacearr,
+                          MutableSpan<float3> r_corner_normals)
+{
   CornerNormalSpaceArray _lnors_spacearr;
 
 #ifdef DEBUG_TIME
@@ -1214,7 +1279,7 @@ void normals_calc_corners(const Span<float3> vert_positions,
   common_data.faces = faces;
   common_data.corner_verts = corner_verts;
   common_data.corner_edges = corner_edges;
-  common_data.edge_to_corners = edge_to_corners;
+  common_data.edge_to_corners = fans.edge_to_corners;
   common_data.corner_to_face = corner_to_face_map;
   common_data.face_normals = face_normals;
   common_data.vert_normals = vert_normals;
@@ -1223,13 +1288,8 @@ void normals_calc_corners(const Span<float3> vert_positions,
    * This way we don't have to compute those later! */
   array_utils::gather(vert_normals, corner_verts, r_corner_normals, 1024);
 
-  /* This first corner check which edges are actually smooth, and compute edge vectors. */
-  build_edge_to_corner_map_with_flip_and_sharp(
-      faces, corner_verts, corner_edges, sharp_faces, sharp_edges, edge_to_corners);
-
-  Vector<int, 32> single_corners;
-  Vector<int, 32> fan_corners;
-  corner_split_generator(&common_data, single_corners, fan_corners);
+  const Span<int> single_corners = fans.single_corners;
+  const Span<int> fan_corners = fans.fan_corners;
 
   if (r_lnors_spacearr) {
     r_lnors_spacearr->spaces.reinitialize(single_corners.size() + fan_corners.size());
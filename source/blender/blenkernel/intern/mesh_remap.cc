@@ -17,6 +17,7 @@
 #include "BLI_array.hh"
 #include "BLI_astar.h"
 #include "BLI_bit_vector.hh"
+#include "BLI_enumerable_thread_specific.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_solvers.h"
@@ -25,6 +26,7 @@
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_rand.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_bvhutils.hh"
@@ -358,6 +360,29 @@ void BKE_mesh_remap_item_define_invalid(MeshPairRemap *map, const int index)
   mesh_remap_item_define(map, index, FLT_MAX, 0, 0, nullptr, nullptr);
 }
 
+/**
+ * Call \a fn on ranges of the destination items in parallel. Each thread gets its own copy of
+ * \a map with a separate memory arena, so that it can define items without locking. The arenas
+ * are merged into the one of \a map afterwards.
+ */
+template<typename Fn>
+static void mesh_remap_items_define_parallel(MeshPairRemap *map, const int items_num, const Fn &fn)
+{
+  using namespace blender;
+  threading::EnumerableThreadSpecific<MeshPairRemap> all_thread_maps([&]() {
+    MeshPairRemap thread_map = *map;
+    thread_map.mem = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, "mesh_remap_thread_map");
+    return thread_map;
+  });
+  threading::parallel_for(IndexRange(items_num), 1024, [&](const IndexRange range) {
+    fn(all_thread_maps.local(), range);
+  });
+  for (MeshPairRemap &thread_map : all_thread_maps) {
+    BLI_memarena_merge(map->mem, thread_map.mem);
+    BLI_memarena_free(thread_map.mem);
+  }
+}
+
 static int mesh_remap_interp_face_data_get(const blender::IndexRange face,
                                            const blender::Span<int> corner_verts,
                                            const blender::Span<blender::float3> positions_src,
@@ -456,9 +481,9 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
                                          Mesh *me_dst,
                                          MeshPairRemap *r_map)
 {
+  using namespace blender;
   const float full_weight = 1.0f;
   const float max_dist_sq = max_dist * max_dist;
-  int i;
 
   BLI_assert(mode & MREMAP_MODE_VERT);
 
@@ -466,86 +491,103 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
 
   if (mode == MREMAP_MODE_TOPOLOGY) {
     BLI_assert(numverts_dst == me_src->verts_num);
-    for (i = 0; i < numverts_dst; i++) {
-      mesh_remap_item_define(r_map, i, FLT_MAX, 0, 1, &i, &full_weight);
-    }
+    mesh_remap_items_define_parallel(
+        r_map, numverts_dst, [&](MeshPairRemap &map, const IndexRange range) {
+          for (const int64_t i : range) {
+            const int index = int(i);
+            mesh_remap_item_define(&map, index, FLT_MAX, 0, 1, &index, &full_weight);
+          }
+        });
   }
   else {
     BVHTreeFromMesh treedata = {nullptr};
-    BVHTreeNearest nearest = {0};
-    BVHTreeRayHit rayhit = {0};
-    float hit_dist;
-    float tmp_co[3], tmp_no[3];
 
     if (mode == MREMAP_MODE_VERT_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
-      nearest.index = -1;
 
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, vert_positions_dst[i]);
+      mesh_remap_items_define_parallel(
+          r_map, numverts_dst, [&](MeshPairRemap &map, const IndexRange range) {
+            BVHTreeNearest nearest = {0};
+            nearest.index = -1;
+            float hit_dist;
+            float tmp_co[3];
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+            for (const int64_t i : range) {
+              copy_v3_v3(tmp_co, vert_positions_dst[i]);
 
-        if (mesh_remap_bvhtree_query_nearest(&treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
-        {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
-        }
-        else {
-          /* No source for this dest vertex! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
+              /* Convert the vertex to tree coordinates, if needed. */
+              if (space_transform) {
+                BLI_space_transform_apply(space_transform, tmp_co);
+              }
+
+              if (mesh_remap_bvhtree_query_nearest(
+                      &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
+              {
+                mesh_remap_item_define(
+                    &map, int(i), hit_dist, 0, 1, &nearest.index, &full_weight);
+              }
+              else {
+                /* No source for this dest vertex! */
+                BKE_mesh_remap_item_define_invalid(&map, int(i));
+              }
+            }
+          });
     }
     else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
       const blender::Span<blender::int2> edges_src = me_src->edges();
       const blender::Span<blender::float3> positions_src = me_src->vert_positions();
 
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
 
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, vert_positions_dst[i]);
+      mesh_remap_items_define_parallel(
+          r_map, numverts_dst, [&](MeshPairRemap &map, const IndexRange range) {
+            BVHTreeNearest nearest = {0};
+            nearest.index = -1;
+            float hit_dist;
+            float tmp_co[3];
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+            for (const int64_t i : range) {
+              copy_v3_v3(tmp_co, vert_positions_dst[i]);
 
-        if (mesh_remap_bvhtree_query_nearest(&treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
-        {
-          const blender::int2 &edge = edges_src[nearest.index];
-          const float *v1cos = positions_src[edge[0]];
-          const float *v2cos = positions_src[edge[1]];
-
-          if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
-            const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
-            const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
-            const int index = (dist_v1 > dist_v2) ? edge[1] : edge[0];
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
-          }
-          else if (mode == MREMAP_MODE_VERT_EDGEINTERP_NEAREST) {
-            int indices[2];
-            float weights[2];
+              /* Convert the vertex to tree coordinates, if needed. */
+              if (space_transform) {
+                BLI_space_transform_apply(space_transform, tmp_co);
+              }
 
-            indices[0] = edge[0];
-            indices[1] = edge[1];
+              if (mesh_remap_bvhtree_query_nearest(
+                      &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
+              {
+                const blender::int2 &edge = edges_src[nearest.index];
+                const float *v1cos = positions_src[edge[0]];
+                const float *v2cos = positions_src[edge[1]];
+
+                if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
+                  const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
+                  const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
+                  const int index = (dist_v1 > dist_v2) ? edge[1] : edge[0];
+                  mesh_remap_item_define(&map, int(i), hit_dist, 0, 1, &index, &full_weight);
+                }
+                else if (mode == MREMAP_MODE_VERT_EDGEINTERP_NEAREST) {
+                  int indices[2];
+                  float weights[2];
 
-            /* Weight is inverse of point factor here... */
-            weights[0] = line_point_factor_v3(tmp_co, v2cos, v1cos);
-            CLAMP(weights[0], 0.0f, 1.0f);
-            weights[1] = 1.0f - weights[0];
+                  indices[0] = edge[0];
+                  indices[1] = edge[1];
 
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 2, indices, weights);
-          }
-        }
-        else {
-          /* No source for this dest vertex! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
+                  /* Weight is inverse of point factor here... */
+                  weights[0] = line_point_factor_v3(tmp_co, v2cos, v1cos);
+                  CLAMP(weights[0], 0.0f, 1.0f);
+                  weights[1] = 1.0f - weights[0];
+
+                  mesh_remap_item_define(&map, int(i), hit_dist, 0, 2, indices, weights);
+                }
+              }
+              else {
+                /* No source for this dest vertex! */
+                BKE_mesh_remap_item_define_invalid(&map, int(i));
+              }
+            }
+          });
     }
     else if (ELEM(mode,
                   MREMAP_MODE_VERT_FACE_NEAREST,
@@ -558,108 +600,111 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
       const blender::Span<blender::float3> vert_normals_dst = me_dst->vert_normals();
       const blender::Span<int> tri_faces = me_src->corner_tri_faces();
 
-      size_t tmp_buff_size = MREMAP_DEFAULT_BUFSIZE;
-      float(*vcos)[3] = static_cast<float(*)[3]>(
-          MEM_mallocN(sizeof(*vcos) * tmp_buff_size, __func__));
-      int *indices = static_cast<int *>(MEM_mallocN(sizeof(*indices) * tmp_buff_size, __func__));
-      float *weights = static_cast<float *>(
-          MEM_mallocN(sizeof(*weights) * tmp_buff_size, __func__));
-
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_CORNER_TRIS, 2);
 
-      if (mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
-        for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, vert_positions_dst[i]);
-          copy_v3_v3(tmp_no, vert_normals_dst[i]);
-
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-            BLI_space_transform_apply_normal(space_transform, tmp_no);
-          }
-
-          if (mesh_remap_bvhtree_query_raycast(
-                  &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist))
-          {
-            const int face_index = tri_faces[rayhit.index];
-            const int sources_num = mesh_remap_interp_face_data_get(faces_src[face_index],
-                                                                    corner_verts_src,
-                                                                    positions_src,
-                                                                    rayhit.co,
-                                                                    &tmp_buff_size,
-                                                                    &vcos,
-                                                                    false,
-                                                                    &indices,
-                                                                    &weights,
-                                                                    true,
-                                                                    nullptr);
-
-            mesh_remap_item_define(r_map, i, hit_dist, 0, sources_num, indices, weights);
-          }
-          else {
-            /* No source for this dest vertex! */
-            BKE_mesh_remap_item_define_invalid(r_map, i);
-          }
-        }
-      }
-      else {
-        nearest.index = -1;
-
-        for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, vert_positions_dst[i]);
-
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-          }
+      mesh_remap_items_define_parallel(
+          r_map, numverts_dst, [&](MeshPairRemap &map, const IndexRange range) {
+            BVHTreeNearest nearest = {0};
+            nearest.index = -1;
+            BVHTreeRayHit rayhit = {0};
+            float hit_dist;
+            float tmp_co[3], tmp_no[3];
+
+            size_t tmp_buff_size = MREMAP_DEFAULT_BUFSIZE;
+            float(*vcos)[3] = static_cast<float(*)[3]>(
+                MEM_mallocN(sizeof(*vcos) * tmp_buff_size, __func__));
+            int *indices = static_cast<int *>(
+                MEM_mallocN(sizeof(*indices) * tmp_buff_size, __func__));
+            float *weights = static_cast<float *>(
+                MEM_mallocN(sizeof(*weights) * tmp_buff_size, __func__));
+
+            for (const int64_t i : range) {
+              copy_v3_v3(tmp_co, vert_positions_dst[i]);
+              if (mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
+                copy_v3_v3(tmp_no, vert_normals_dst[i]);
+              }
 
-          if (mesh_remap_bvhtree_query_nearest(
-                  &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
-          {
-            const int face_index = tri_faces[nearest.index];
-
-            if (mode == MREMAP_MODE_VERT_FACE_NEAREST) {
-              int index;
-              mesh_remap_interp_face_data_get(faces_src[face_index],
-                                              corner_verts_src,
-                                              positions_src,
-                                              nearest.co,
-                                              &tmp_buff_size,
-                                              &vcos,
-                                              false,
-                                              &indices,
-                                              &weights,
-                                              false,
-                                              &index);
+              /* Convert the vertex to tree coordinates, if needed. */
+              if (space_transform) {
+                BLI_space_transform_apply(space_transform, tmp_co);
+                if (mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
+                  BLI_space_transform_apply_normal(space_transform, tmp_no);
+                }
+              }
 
-              mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
-            }
-            else if (mode == MREMAP_MODE_VERT_POLYINTERP_NEAREST) {
-              const int sources_num = mesh_remap_interp_face_data_get(faces_src[face_index],
-                                                                      corner_verts_src,
-                                                                      positions_src,
-                                                                      nearest.co,
-                                                                      &tmp_buff_size,
-                                                                      &vcos,
-                                                                      false,
-                                                                      &indices,
-                                                                      &weights,
-                                                                      true,
-                                                                      nullptr);
-
-              mesh_remap_item_define(r_map, i, hit_dist, 0, sources_num, indices, weights);
+              if (mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
+                if (mesh_remap_bvhtree_query_raycast(
+                        &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist))
+                {
+                  const int face_index = tri_faces[rayhit.index];
+                  const int sources_num = mesh_remap_interp_face_data_get(faces_src[face_index],
+                                                                          corner_verts_src,
+                                                                          positions_src,
+                                                                          rayhit.co,
+                                                                          &tmp_buff_size,
+                                                                          &vcos,
+                                                                          false,
+                                                                          &indices,
+                                                                          &weights,
+                                                                          true,
+                                                                          nullptr);
+
+                  mesh_remap_item_define(
+                      &map, int(i), hit_dist, 0, sources_num, indices, weights);
+                }
+                else {
+                  /* No source for this dest vertex! */
+                  BKE_mesh_remap_item_define_invalid(&map, int(i));
+                }
+              }
+              else if (mesh_remap_bvhtree_query_nearest(
+                           &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
+              {
+                const int face_index = tri_faces[nearest.index];
+
+                if (mode == MREMAP_MODE_VERT_FACE_NEAREST) {
+                  int index;
+                  mesh_remap_interp_face_data_get(faces_src[face_index],
+                                                  corner_verts_src,
+                                                  positions_src,
+                                                  nearest.co,
+                                                  &tmp_buff_size,
+                                                  &vcos,
+                                                  false,
+                                                  &indices,
+                                                  &weights,
+                                                  false,
+                                                  &index);
+
+                  mesh_remap_item_define(&map, int(i), hit_dist, 0, 1, &index, &full_weight);
+                }
+                else if (mode == MREMAP_MODE_VERT_POLYINTERP_NEAREST) {
+                  const int sources_num = mesh_remap_interp_face_data_get(faces_src[face_index],
+                                                                          corner_verts_src,
+                                                                          positions_src,
+                                                                          nearest.co,
+                                                                          &tmp_buff_size,
+                                                                          &vcos,
+                                                                          false,
+                                                                          &indices,
+                                                                          &weights,
+                                                                          true,
+                                                                          nullptr);
+
+                  mesh_remap_item_define(
+                      &map, int(i), hit_dist, 0, sources_num, indices, weights);
+                }
+              }
+              else {
+                /* No source for this dest vertex! */
+                BKE_mesh_remap_item_define_invalid(&map, int(i));
+              }
             }
-          }
-          else {
-            /* No source for this dest vertex! */
-            BKE_mesh_remap_item_define_invalid(r_map, i);
-          }
-        }
-      }
 
-      MEM_freeN(vcos);
-      MEM_freeN(indices);
-      MEM_freeN(weights);
+            MEM_freeN(vcos);
+            MEM_freeN(indices);
+            MEM_freeN(weights);
+          });
     }
     else {
       CLOG_WARN(&LOG, "Unsupported mesh-to-mesh vertex mapping mode (%d)!", mode);
@@ -685,7 +730,6 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
   using namespace blender;
   const float full_weight = 1.0f;
   const float max_dist_sq = max_dist * max_dist;
-  int i;
 
   BLI_assert(mode & MREMAP_MODE_EDGE);
 
@@ -693,18 +737,21 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
 
   if (mode == MREMAP_MODE_TOPOLOGY) {
     BLI_assert(numedges_dst == me_src->edges_num);
-    for (i = 0; i < numedges_dst; i++) {
-      mesh_remap_item_define(r_map, i, FLT_MAX, 0, 1, &i, &full_weight);
-    }
+    mesh_remap_items_define_parallel(
+        r_map, numedges_dst, [&](MeshPairRemap &map, const IndexRange range) {
+          for (const int64_t i : range) {
+            const int index = int(i);
+            mesh_remap_item_define(&map, index, FLT_MAX, 0, 1, &index, &full_weight);
+          }
+        });
   }
   else {
     BVHTreeFromMesh treedata = {nullptr};
-    BVHTreeNearest nearest = {0};
-    BVHTreeRayHit rayhit = {0};
-    float hit_dist;
-    float tmp_co[3], tmp_no[3];
 
     if (mode == MREMAP_MODE_EDGE_VERT_NEAREST) {
+      BVHTreeNearest nearest = {0};
+      float hit_dist;
+      float tmp_co[3];
       const int num_verts_src = me_src->verts_num;
       const blender::Span<blender::int2> edges_src = me_src->edges();
       const blender::Span<blender::float3> positions_src = me_src->vert_positions();
@@ -716,7 +763,7 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
       HitData *v_dst_to_src_map = static_cast<HitData *>(
           MEM_mallocN(sizeof(*v_dst_to_src_map) * size_t(numverts_dst), __func__));
 
-      for (i = 0; i < numverts_dst; i++) {
+      for (int i = 0; i < numverts_dst; i++) {
         v_dst_to_src_map[i].hit_dist = -1.0f;
       }
 
@@ -728,7 +775,7 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
       nearest.index = -1;
 
-      for (i = 0; i < numedges_dst; i++) {
+      for (int i = 0; i < numedges_dst; i++) {
         const blender::int2 &e_dst = edges_dst[i];
         float best_totdist = FLT_MAX;
         int best_eidx_src = -1;
@@ -829,28 +876,37 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
     }
     else if (mode == MREMAP_MODE_EDGE_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
 
-      for (i = 0; i < numedges_dst; i++) {
-        interp_v3_v3v3(tmp_co,
-                       vert_positions_dst[edges_dst[i][0]],
-                       vert_positions_dst[edges_dst[i][1]],
-                       0.5f);
+      mesh_remap_items_define_parallel(
+          r_map, numedges_dst, [&](MeshPairRemap &map, const IndexRange range) {
+            BVHTreeNearest nearest = {0};
+            nearest.index = -1;
+            float hit_dist;
+            float tmp_co[3];
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+            for (const int64_t i : range) {
+              interp_v3_v3v3(tmp_co,
+                             vert_positions_dst[edges_dst[i][0]],
+                             vert_positions_dst[edges_dst[i][1]],
+                             0.5f);
 
-        if (mesh_remap_bvhtree_query_nearest(&treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
-        {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
-        }
-        else {
-          /* No source for this dest edge! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
+              /* Convert the vertex to tree coordinates, if needed. */
+              if (space_transform) {
+                BLI_space_transform_apply(space_transform, tmp_co);
+              }
+
+              if (mesh_remap_bvhtree_query_nearest(
+                      &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
+              {
+                mesh_remap_item_define(
+                    &map, int(i), hit_dist, 0, 1, &nearest.index, &full_weight);
+              }
+              else {
+                /* No source for this dest edge! */
+                BKE_mesh_remap_item_define_invalid(&map, int(i));
+              }
+            }
+          });
     }
     else if (mode == MREMAP_MODE_EDGE_POLY_NEAREST) {
       const blender::Span<blender::int2> edges_src = me_src->edges();
@@ -861,51 +917,60 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
 
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_CORNER_TRIS, 2);
 
-      for (i = 0; i < numedges_dst; i++) {
-        interp_v3_v3v3(tmp_co,
-                       vert_positions_dst[edges_dst[i][0]],
-                       vert_positions_dst[edges_dst[i][1]],
-                       0.5f);
+      mesh_remap_items_define_parallel(
+          r_map, numedges_dst, [&](MeshPairRemap &map, const IndexRange range) {
+            BVHTreeNearest nearest = {0};
+            nearest.index = -1;
+            float hit_dist;
+            float tmp_co[3];
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+            for (const int64_t i : range) {
+              interp_v3_v3v3(tmp_co,
+                             vert_positions_dst[edges_dst[i][0]],
+                             vert_positions_dst[edges_dst[i][1]],
+                             0.5f);
+
+              /* Convert the vertex to tree coordinates, if needed. */
+              if (space_transform) {
+                BLI_space_transform_apply(space_transform, tmp_co);
+              }
 
-        if (mesh_remap_bvhtree_query_nearest(&treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
-        {
-          const int face_index = tri_faces[nearest.index];
-          const blender::IndexRange face_src = faces_src[face_index];
-          const int *corner_edge_src = &corner_edges_src[face_src.start()];
-          int nloops = int(face_src.size());
-          float best_dist_sq = FLT_MAX;
-          int best_eidx_src = -1;
-
-          for (; nloops--; corner_edge_src++) {
-            const blender::int2 &edge_src = edges_src[*corner_edge_src];
-            const float *co1_src = positions_src[edge_src[0]];
-            const float *co2_src = positions_src[edge_src[1]];
-            float co_src[3];
-            float dist_sq;
-
-            interp_v3_v3v3(co_src, co1_src, co2_src, 0.5f);
-            dist_sq = len_squared_v3v3(tmp_co, co_src);
-            if (dist_sq < best_dist_sq) {
-              best_dist_sq = dist_sq;
-              best_eidx_src = *corner_edge_src;
+              if (mesh_remap_bvhtree_query_nearest(
+                      &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
+              {
+                const int face_index = tri_faces[nearest.index];
+                const blender::IndexRange face_src = faces_src[face_index];
+                float best_dist_sq = FLT_MAX;
+                int best_eidx_src = -1;
+
+                for (const int edge_src_index : corner_edges_src.slice(face_src)) {
+                  const blender::int2 &edge_src = edges_src[edge_src_index];
+                  float co_src[3];
+
+                  interp_v3_v3v3(
+                      co_src, positions_src[edge_src[0]], positions_src[edge_src[1]], 0.5f);
+                  const float dist_sq = len_squared_v3v3(tmp_co, co_src);
+                  if (dist_sq < best_dist_sq) {
+                    best_dist_sq = dist_sq;
+                    best_eidx_src = edge_src_index;
+                  }
+                }
+                if (best_eidx_src >= 0) {
+                  mesh_remap_item_define(
+                      &map, int(i), hit_dist, 0, 1, &best_eidx_src, &full_weight);
+                }
+              }
+              else {
+                /* No source for this dest edge! */
+                BKE_mesh_remap_item_define_invalid(&map, int(i));
+              }
             }
-          }
-          if (best_eidx_src >= 0) {
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &best_eidx_src, &full_weight);
-          }
-        }
-        else {
-          /* No source for this dest edge! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
+          });
     }
     else if (mode == MREMAP_MODE_EDGE_EDGEINTERP_VNORPROJ) {
+      BVHTreeRayHit rayhit = {0};
+      float hit_dist;
+      float tmp_co[3], tmp_no[3];
       const int num_rays_min = 5, num_rays_max = 100;
       const int numedges_src = me_src->edges_num;
 
@@ -920,7 +985,7 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
 
       const blender::Span<blender::float3> vert_normals_dst = me_dst->vert_normals();
 
-      for (i = 0; i < numedges_dst; i++) {
+      for (int i = 0; i < numedges_dst; i++) {
         /* For each dst edge, we sample some rays from it (interpolated from its vertices)
          * and use their hits to interpolate from source edges. */
         const blender::int2 &edge = edges_dst[i];
@@ -2045,7 +2110,6 @@ void BKE_mesh_remap_calc_faces_from_mesh(const int mode,
   const float full_weight = 1.0f;
   const float max_dist_sq = max_dist * max_dist;
   blender::Span<blender::float3> face_normals_dst;
-  blender::float3 tmp_co, tmp_no;
 
   BLI_assert(mode & MREMAP_MODE_POLY);
 
@@ -2057,73 +2121,90 @@ void BKE_mesh_remap_calc_faces_from_mesh(const int mode,
 
   if (mode == MREMAP_MODE_TOPOLOGY) {
     BLI_assert(faces_dst.size() == me_src->faces_num);
-    for (const int64_t i : faces_dst.index_range()) {
-      const int index = int(i);
-      mesh_remap_item_define(r_map, int(i), FLT_MAX, 0, 1, &index, &full_weight);
-    }
+    mesh_remap_items_define_parallel(
+        r_map, int(faces_dst.size()), [&](MeshPairRemap &map, const blender::IndexRange range) {
+          for (const int64_t i : range) {
+            const int index = int(i);
+            mesh_remap_item_define(&map, index, FLT_MAX, 0, 1, &index, &full_weight);
+          }
+        });
   }
   else {
     BVHTreeFromMesh treedata = {nullptr};
-    BVHTreeNearest nearest = {0};
-    BVHTreeRayHit rayhit = {0};
-    float hit_dist;
     const blender::Span<int> tri_faces = me_src->corner_tri_faces();
+    const blender::Span<blender::float3> positions_dst(
+        reinterpret_cast<const blender::float3 *>(vert_positions_dst), numverts_dst);
 
     BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_CORNER_TRIS, 2);
 
     if (mode == MREMAP_MODE_POLY_NEAREST) {
-      nearest.index = -1;
+      mesh_remap_items_define_parallel(
+          r_map, int(faces_dst.size()), [&](MeshPairRemap &map, const blender::IndexRange range) {
+            BVHTreeNearest nearest = {0};
+            nearest.index = -1;
+            float hit_dist;
 
-      for (const int64_t i : faces_dst.index_range()) {
-        const blender::IndexRange face = faces_dst[i];
-        tmp_co = blender::bke::mesh::face_center_calc(
-            {reinterpret_cast<const blender::float3 *>(vert_positions_dst), numverts_dst},
-            {&corner_verts_dst[face.start()], face.size()});
+            for (const int64_t i : range) {
+              const blender::IndexRange face = faces_dst[i];
+              blender::float3 tmp_co = blender::bke::mesh::face_center_calc(
+                  positions_dst, {&corner_verts_dst[face.start()], face.size()});
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+              /* Convert the vertex to tree coordinates, if needed. */
+              if (space_transform) {
+                BLI_space_transform_apply(space_transform, tmp_co);
+              }
 
-        if (mesh_remap_bvhtree_query_nearest(&treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
-        {
-          const int face_index = tri_faces[nearest.index];
-          mesh_remap_item_define(r_map, int(i), hit_dist, 0, 1, &face_index, &full_weight);
-        }
-        else {
-          /* No source for this dest face! */
-          BKE_mesh_remap_item_define_invalid(r_map, int(i));
-        }
-      }
+              if (mesh_remap_bvhtree_query_nearest(
+                      &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
+              {
+                const int face_index = tri_faces[nearest.index];
+                mesh_remap_item_define(
+                    &map, int(i), hit_dist, 0, 1, &face_index, &full_weight);
+              }
+              else {
+                /* No source for this dest face! */
+                BKE_mesh_remap_item_define_invalid(&map, int(i));
+              }
+            }
+          });
     }
     else if (mode == MREMAP_MODE_POLY_NOR) {
-      for (const int64_t i : faces_dst.index_range()) {
-        const blender::IndexRange face = faces_dst[i];
+      mesh_remap_items_define_parallel(
+          r_map, int(faces_dst.size()), [&](MeshPairRemap &map, const blender::IndexRange range) {
+            BVHTreeRayHit rayhit = {0};
+            float hit_dist;
 
-        tmp_co = blender::bke::mesh::face_center_calc(
-            {reinterpret_cast<const blender::float3 *>(vert_positions_dst), numverts_dst},
-            {&corner_verts_dst[face.start()], face.size()});
-        copy_v3_v3(tmp_no, face_normals_dst[i]);
+            for (const int64_t i : range) {
+              const blender::IndexRange face = faces_dst[i];
+              blender::float3 tmp_co = blender::bke::mesh::face_center_calc(
+                  positions_dst, {&corner_verts_dst[face.start()], face.size()});
+              blender::float3 tmp_no = face_normals_dst[i];
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-          BLI_space_transform_apply_normal(space_transform, tmp_no);
-        }
+              /* Convert the vertex to tree coordinates, if needed. */
+              if (space_transform) {
+                BLI_space_transform_apply(space_transform, tmp_co);
+                BLI_space_transform_apply_normal(space_transform, tmp_no);
+              }
 
-        if (mesh_remap_bvhtree_query_raycast(
-                &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist))
-        {
-          const int face_index = tri_faces[rayhit.index];
-          mesh_remap_item_define(r_map, int(i), hit_dist, 0, 1, &face_index, &full_weight);
-        }
-        else {
-          /* No source for this dest face! */
-          BKE_mesh_remap_item_define_invalid(r_map, int(i));
-        }
-      }
+              if (mesh_remap_bvhtree_query_raycast(
+                      &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist))
+              {
+                const int face_index = tri_faces[rayhit.index];
+                mesh_remap_item_define(
+                    &map, int(i), hit_dist, 0, 1, &face_index, &full_weight);
+              }
+              else {
+                /* No source for this dest face! */
+                BKE_mesh_remap_item_define_invalid(&map, int(i));
+              }
+            }
+          });
     }
     else if (mode == MREMAP_MODE_POLY_POLYINTERP_PNORPROJ) {
+      BVHTreeRayHit rayhit = {0};
+      float hit_dist;
+      blender::float3 tmp_co, tmp_no;
+
       /* We cast our rays randomly, with a pseudo-even distribution
        * (since we spread across tessellated triangles,
        * with additional weighting based on each triangle's relative area). */
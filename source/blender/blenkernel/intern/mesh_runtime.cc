@@ -9,6 +9,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array_utils.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_math_geom.h"
 #include "BLI_task.hh"
 
@@ -293,6 +294,7 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
   mesh->runtime->vert_normals_cache.tag_dirty();
   mesh->runtime->face_normals_cache.tag_dirty();
   mesh->runtime->corner_normals_cache.tag_dirty();
+  mesh->runtime->corner_normal_fans_cache.tag_dirty();
   mesh->runtime->loose_edges_cache.tag_dirty();
   mesh->runtime->loose_verts_cache.tag_dirty();
   mesh->runtime->verts_no_face_cache.tag_dirty();
@@ -309,6 +311,7 @@ void Mesh::tag_edges_split()
   /* Triangulation didn't change because vertex positions and loop vertex indices didn't change. */
   free_bvh_cache(*this->runtime);
   this->runtime->vert_normals_cache.tag_dirty();
+  this->runtime->corner_normal_fans_cache.tag_dirty();
   this->runtime->subdiv_ccg.reset();
   this->runtime->vert_to_face_offset_cache.tag_dirty();
   this->runtime->vert_to_face_map_cache.tag_dirty();
@@ -336,6 +339,7 @@ void Mesh::tag_edges_split()
 void Mesh::tag_sharpness_changed()
 {
   this->runtime->corner_normals_cache.tag_dirty();
+  this->runtime->corner_normal_fans_cache.tag_dirty();
 }
 
 void Mesh::tag_custom_normals_changed()
@@ -348,6 +352,7 @@ void Mesh::tag_face_winding_changed()
   this->runtime->vert_normals_cache.tag_dirty();
   this->runtime->face_normals_cache.tag_dirty();
   this->runtime->corner_normals_cache.tag_dirty();
+  this->runtime->corner_normal_fans_cache.tag_dirty();
   this->runtime->vert_to_corner_map_cache.tag_dirty();
   this->runtime->shrinkwrap_boundary_cache.tag_dirty();
 }
@@ -361,6 +366,64 @@ void Mesh::tag_positions_changed()
   this->tag_positions_changed_no_normals();
 }
 
+void Mesh::tag_positions_changed(const blender::IndexMask &changed_verts)
+{
+  using namespace blender;
+  using namespace blender::bke;
+  if (changed_verts.is_empty()) {
+    return;
+  }
+  MeshRuntime &runtime = *this->runtime;
+  /* The vertex normals and the triangulation of n-gons depend on the face normals, so partial
+   * updates are only possible when they are cached. They are only worth it when most of the mesh
+   * is unchanged. */
+  if (!runtime.face_normals_cache.is_cached() || changed_verts.size() > this->verts_num / 4) {
+    this->tag_positions_changed();
+    return;
+  }
+
+  const Span<float3> positions = this->vert_positions();
+  const OffsetIndices faces = this->faces();
+  const Span<int> corner_verts = this->corner_verts();
+  const GroupedSpan<int> vert_to_face_map = this->vert_to_face_map();
+
+  /* Faces using a moved vertex have new normals, which change the normals of all their vertices.
+   * Loose vertices are included as well, their normal depends on their position. */
+  Array<bool> faces_changed(this->faces_num, false);
+  Array<bool> verts_changed(this->verts_num, false);
+  changed_verts.foreach_index([&](const int vert) {
+    verts_changed[vert] = true;
+    faces_changed.as_mutable_span().fill_indices(vert_to_face_map[vert], true);
+  });
+  IndexMaskMemory memory;
+  const IndexMask changed_faces = IndexMask::from_bools(faces_changed, memory);
+  changed_faces.foreach_index([&](const int face) {
+    verts_changed.as_mutable_span().fill_indices(corner_verts.slice(faces[face]), true);
+  });
+  const IndexMask normal_verts = IndexMask::from_bools(verts_changed, memory);
+
+  runtime.face_normals_cache.update([&](Vector<float3> &r_data) {
+    mesh::normals_calc_faces(positions, faces, corner_verts, changed_faces, r_data);
+  });
+  const Span<float3> face_normals = runtime.face_normals_cache.data();
+  if (runtime.vert_normals_cache.is_cached()) {
+    runtime.vert_normals_cache.update([&](Vector<float3> &r_data) {
+      mesh::normals_calc_verts(
+          positions, faces, corner_verts, vert_to_face_map, face_normals, normal_verts, r_data);
+    });
+  }
+  if (runtime.corner_tris_cache.is_cached()) {
+    runtime.corner_tris_cache.update([&](Array<int3> &r_data) {
+      mesh::corner_tris_calc_with_normals(
+          positions, faces, corner_verts, face_normals, changed_faces, r_data);
+    });
+  }
+  runtime.corner_normals_cache.tag_dirty();
+  runtime.shrinkwrap_boundary_cache.tag_dirty();
+  free_bvh_cache(runtime);
+  runtime.bounds_cache.tag_dirty();
+}
+
 void Mesh::tag_positions_changed_no_normals()
 {
   free_bvh_cache(*this->runtime);
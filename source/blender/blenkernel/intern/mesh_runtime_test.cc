@@ -0,0 +1,132 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "CLG_log.h"
+
+#include "DNA_mesh_types.h"
+
+#include "BLI_index_mask.hh"
+#include "BLI_math_vector_types.hh"
+
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+
+namespace blender::bke::tests {
+
+class MeshRuntimeTest : public testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+};
+
+/** A strip of quads with two rows of vertices at varying heights, so that the faces differ. */
+static Mesh *create_quad_strip(const int quads_num)
+{
+  const int columns_num = quads_num + 1;
+  Mesh *mesh = BKE_mesh_new_nomain(
+      columns_num * 2, columns_num + quads_num * 2, quads_num, quads_num * 4);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  for (const int i : IndexRange(columns_num)) {
+    positions[i] = float3(i, 0.0f, 0.1f * i);
+    positions[columns_num + i] = float3(i, 1.0f, 0.2f * (i % 3));
+  }
+  MutableSpan<int2> edges = mesh->edges_for_write();
+  for (const int i : IndexRange(columns_num)) {
+    edges[i] = int2(i, columns_num + i);
+  }
+  for (const int i : IndexRange(quads_num)) {
+    edges[columns_num + i * 2] = int2(i, i + 1);
+    edges[columns_num + i * 2 + 1] = int2(columns_num + i, columns_num + i + 1);
+  }
+  MutableSpan<int> face_offsets = mesh->face_offsets_for_write();
+  for (const int i : face_offsets.index_range()) {
+    face_offsets[i] = i * 4;
+  }
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  for (const int i : IndexRange(quads_num)) {
+    corner_verts[i * 4 + 0] = i;
+    corner_verts[i * 4 + 1] = i + 1;
+    corner_verts[i * 4 + 2] = columns_num + i + 1;
+    corner_verts[i * 4 + 3] = columns_num + i;
+  }
+  return mesh;
+}
+
+static void expect_near(const Span<float3> a, const Span<float3> b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  for (const int i : a.index_range()) {
+    EXPECT_V3_NEAR(a[i], b[i], 1e-6f);
+  }
+}
+
+TEST_F(MeshRuntimeTest, TagPositionsChangedMasked)
+{
+  Mesh *mesh = create_quad_strip(10);
+  const Array<float3> old_face_normals(mesh->face_normals());
+  const Array<float3> old_vert_normals(mesh->vert_normals());
+  mesh->corner_tris();
+  mesh->bounds_min_max();
+
+  const int moved_vert = 3;
+  mesh->vert_positions_for_write()[moved_vert].z = 5.0f;
+  IndexMaskMemory memory;
+  mesh->tag_positions_changed(IndexMask::from_indices<int>({moved_vert}, memory));
+
+  /* The caches are updated in place, instead of being recomputed on the next access. */
+  EXPECT_TRUE(mesh->runtime->face_normals_cache.is_cached());
+  EXPECT_TRUE(mesh->runtime->vert_normals_cache.is_cached());
+  EXPECT_TRUE(mesh->runtime->corner_tris_cache.is_cached());
+  EXPECT_FALSE(mesh->runtime->bounds_cache.is_cached());
+
+  /* Compare with the caches computed from scratch. */
+  Mesh *mesh_ref = BKE_mesh_copy_for_eval(mesh);
+  mesh_ref->tag_positions_changed();
+  expect_near(mesh->face_normals(), mesh_ref->face_normals());
+  expect_near(mesh->vert_normals(), mesh_ref->vert_normals());
+  EXPECT_EQ(mesh->corner_tris(), mesh_ref->corner_tris());
+  EXPECT_EQ(mesh->bounds_min_max()->max.z, 5.0f);
+
+  /* Only the normals around the moved vertex changed. */
+  const GroupedSpan<int> vert_to_face_map = mesh->vert_to_face_map();
+  for (const int face : mesh->faces().index_range()) {
+    const bool uses_moved_vert = vert_to_face_map[moved_vert].contains(face);
+    EXPECT_EQ(mesh->face_normals()[face] != old_face_normals[face], uses_moved_vert);
+  }
+  EXPECT_EQ(mesh->vert_normals()[0], old_vert_normals[0]);
+  EXPECT_EQ(mesh->vert_normals()[10], old_vert_normals[10]);
+
+  BKE_id_free(nullptr, mesh_ref);
+  BKE_id_free(nullptr, mesh);
+}
+
+TEST_F(MeshRuntimeTest, TagPositionsChangedMaskedLarge)
+{
+  Mesh *mesh = create_quad_strip(2);
+  mesh->face_normals();
+  mesh->vert_normals();
+
+  /* With many changed vertices, the caches are recomputed on the next access instead. */
+  mesh->vert_positions_for_write()[0].z = 5.0f;
+  mesh->vert_positions_for_write()[1].z = 5.0f;
+  IndexMaskMemory memory;
+  mesh->tag_positions_changed(IndexMask::from_indices<int>({0, 1}, memory));
+  EXPECT_FALSE(mesh->runtime->face_normals_cache.is_cached());
+  EXPECT_FALSE(mesh->runtime->vert_normals_cache.is_cached());
+
+  BKE_id_free(nullptr, mesh);
+}
+
+}  // namespace blender::bke::tests
@@ -13,6 +13,7 @@
 
 #include "BLI_array_utils.hh"
 #include "BLI_enumerable_thread_specific.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
@@ -165,13 +166,14 @@ static void corner_tris_calc_impl(const Span<float3> positions,
                                   const OffsetIndices<int> faces,
                                   const Span<int> corner_verts,
                                   const Span<float3> face_normals,
+                                  const IndexMask &face_mask,
                                   MutableSpan<int3> corner_tris)
 {
   threading::EnumerableThreadSpecific<LocalData> all_local_data;
   if (face_normals.is_empty()) {
-    threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    face_mask.foreach_segment(GrainSize(1024), [&](const IndexMaskSegment segment) {
       LocalData &local_data = all_local_data.local();
-      for (const int64_t i : range) {
+      for (const int64_t i : segment) {
         const int face_start = int(faces[i].start());
         const int face_size = int(faces[i].size());
         const int tris_start = poly_to_tri_count(int(i), face_start);
@@ -185,9 +187,9 @@ static void corner_tris_calc_impl(const Span<float3> positions,
     });
   }
   else {
-    threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    face_mask.foreach_segment(GrainSize(1024), [&](const IndexMaskSegment segment) {
       LocalData &local_data = all_local_data.local();
-      for (const int64_t i : range) {
+      for (const int64_t i : segment) {
         const int face_start = int(faces[i].start());
         const int face_size = int(faces[i].size());
         const int tris_start = poly_to_tri_count(int(i), face_start);
@@ -208,7 +210,7 @@ void corner_tris_calc(const Span<float3> vert_positions,
                       const Span<int> corner_verts,
                       MutableSpan<int3> corner_tris)
 {
-  corner_tris_calc_impl(vert_positions, faces, corner_verts, {}, corner_tris);
+  corner_tris_calc_impl(vert_positions, faces, corner_verts, {}, faces.index_range(), corner_tris);
 }
 
 void corner_tris_calc_face_indices(const OffsetIndices<int> faces, MutableSpan<int> tri_faces)
@@ -230,7 +232,18 @@ void corner_tris_calc_with_normals(const Span<float3> vert_positions,
                                    MutableSpan<int3> corner_tris)
 {
   BLI_assert(!face_normals.is_empty() || faces.is_empty());
-  corner_tris_calc_impl(vert_positions, faces, corner_verts, face_normals, corner_tris);
+  corner_tris_calc_impl(
+      vert_positions, faces, corner_verts, face_normals, faces.index_range(), corner_tris);
+}
+
+void corner_tris_calc_with_normals(const Span<float3> vert_positions,
+                                   const OffsetIndices<int> faces,
+                                   const Span<int> corner_verts,
+                                   const Span<float3> face_normals,
+                                   const IndexMask &face_mask,
+                                   MutableSpan<int3> corner_tris)
+{
+  corner_tris_calc_impl(vert_positions, faces, corner_verts, face_normals, face_mask, corner_tris);
 }
 
 /** \} */
@@ -37,6 +37,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
+#include "BLI_profile.hh"
 #include "BLI_rand.hh"
 #include "BLI_session_uid.h"
 #include "BLI_string.h"
@@ -906,6 +907,7 @@ static void ensure_non_lazy_normals(Mesh *mesh)
 Mesh *BKE_modifier_modify_mesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mesh)
 {
   const ModifierTypeInfo *mti = BKE_modifier_get_info(ModifierType(md->type));
+  PROFILE_SCOPE_DETAIL(mti->name, md->name);
 
   if (mesh->runtime->wrapper_type == ME_WRAPPER_TYPE_BMESH) {
     if ((mti->flags & eModifierTypeFlag_AcceptsBMesh) == 0) {
@@ -922,6 +924,7 @@ void BKE_modifier_deform_verts(ModifierData *md,
                                blender::MutableSpan<blender::float3> positions)
 {
   const ModifierTypeInfo *mti = BKE_modifier_get_info(ModifierType(md->type));
+  PROFILE_SCOPE_DETAIL(mti->name, md->name);
   mti->deform_verts(md, ctx, mesh, positions);
   if (mesh) {
     mesh->tag_positions_changed();
@@ -935,6 +938,7 @@ void BKE_modifier_deform_vertsEM(ModifierData *md,
                                  blender::MutableSpan<blender::float3> positions)
 {
   const ModifierTypeInfo *mti = BKE_modifier_get_info(ModifierType(md->type));
+  PROFILE_SCOPE_DETAIL(mti->name, md->name);
   if (mesh && mti->depends_on_normals && mti->depends_on_normals(md)) {
     ensure_non_lazy_normals(mesh);
   }
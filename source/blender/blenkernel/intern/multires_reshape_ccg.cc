@@ -23,9 +23,10 @@ bool multires_reshape_assign_final_coords_from_ccg(const MultiresReshapeContext
   const int reshape_grid_size = reshape_context->reshape.grid_size;
   const float reshape_grid_size_1_inv = 1.0f / (float(reshape_grid_size) - 1.0f);
 
-  int num_grids = subdiv_ccg->grids.size();
+  const CCGKey key = BKE_subdiv_ccg_key_top_level(*subdiv_ccg);
+  int num_grids = subdiv_ccg->grids_num;
   for (int grid_index = 0; grid_index < num_grids; ++grid_index) {
-    CCGElem *ccg_grid = subdiv_ccg->grids[grid_index];
+    const blender::IndexRange ccg_grid = CCG_grid_range(key, grid_index);
     for (int y = 0; y < reshape_grid_size; ++y) {
       const float v = float(y) * reshape_grid_size_1_inv;
       for (int x = 0; x < reshape_grid_size; ++x) {
@@ -40,9 +41,8 @@ bool multires_reshape_assign_final_coords_from_ccg(const MultiresReshapeContext
             reshape_context, &grid_coord);
 
         BLI_assert(grid_element.displacement != nullptr);
-        memcpy(grid_element.displacement,
-               CCG_grid_elem_co(&reshape_level_key, ccg_grid, x, y),
-               sizeof(float[3]));
+        const int ccg_element = ccg_grid[CCG_grid_xy_to_index(reshape_level_key.grid_size, x, y)];
+        memcpy(grid_element.displacement, &subdiv_ccg->positions[ccg_element], sizeof(float[3]));
 
         /* NOTE: The sculpt mode might have SubdivCCG's data out of sync from what is stored in
          * the original object. This happens in the following scenario:
@@ -67,7 +67,7 @@ bool multires_reshape_assign_final_coords_from_ccg(const MultiresReshapeContext
          * after a Memfile one to never be undone (see #83806). This might be the root cause of
          * this inconsistency. */
         if (reshape_level_key.has_mask && grid_element.mask != nullptr) {
-          *grid_element.mask = *CCG_grid_elem_mask(&reshape_level_key, ccg_grid, x, y);
+          *grid_element.mask = subdiv_ccg->masks[ccg_element];
         }
       }
     }
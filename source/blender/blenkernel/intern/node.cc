@@ -4241,7 +4241,18 @@ void ntreeUpdateAllNew(Main *main)
 
 void ntreeUpdateAllUsers(Main *main, ID *id)
 {
-  if (id == nullptr) {
+  ntreeUpdateAllUsers(main, blender::Span<ID *>(&id, 1));
+}
+
+void ntreeUpdateAllUsers(Main *main, const blender::Span<ID *> ids)
+{
+  blender::Set<const ID *> ids_set;
+  for (const ID *id : ids) {
+    if (id != nullptr) {
+      ids_set.add(id);
+    }
+  }
+  if (ids_set.is_empty()) {
     return;
   }
 
@@ -4250,7 +4261,7 @@ void ntreeUpdateAllUsers(Main *main, ID *id)
   /* Update all users of ngroup, to add/remove sockets as needed. */
   FOREACH_NODETREE_BEGIN (main, ntree, owner_id) {
     for (bNode *node : ntree->all_nodes()) {
-      if (node->id == id) {
+      if (node->id != nullptr && ids_set.contains(node->id)) {
         BKE_ntree_update_tag_node_property(ntree, node);
         need_update = true;
       }
@@ -3845,26 +3845,26 @@ bool BKE_object_minmax_dupli(Depsgraph *depsgraph,
     return ok;
   }
 
-  ListBase *lb = object_duplilist(depsgraph, scene, ob);
-  LISTBASE_FOREACH (DupliObject *, dob, lb) {
-    if (((use_hidden == false) && (dob->no_draw != 0)) || dob->ob_data == nullptr) {
+  bke::DupliList *duplis = object_duplilist(depsgraph, scene, ob);
+  for (const DupliObject &dob : *duplis) {
+    if (((use_hidden == false) && (dob.no_draw != 0)) || dob.ob_data == nullptr) {
       /* pass */
     }
     else {
-      Object temp_ob = blender::dna::shallow_copy(*dob->ob);
-      blender::bke::ObjectRuntime runtime = *dob->ob->runtime;
+      Object temp_ob = blender::dna::shallow_copy(*dob.ob);
+      blender::bke::ObjectRuntime runtime = *dob.ob->runtime;
       temp_ob.runtime = &runtime;
 
       /* Do not modify the original bounding-box. */
       temp_ob.runtime->bounds_eval.reset();
-      BKE_object_replace_data_on_shallow_copy(&temp_ob, dob->ob_data);
+      BKE_object_replace_data_on_shallow_copy(&temp_ob, dob.ob_data);
       if (const std::optional<Bounds<float3>> bounds = BKE_object_boundbox_get(&temp_ob)) {
         BoundBox bb;
         BKE_boundbox_init_from_minmax(&bb, bounds->min, bounds->max);
         int i;
         for (i = 0; i < 8; i++) {
           float3 vec;
-          mul_v3_m4v3(vec, dob->mat, bb.vec[i]);
+          mul_v3_m4v3(vec, dob.mat, bb.vec[i]);
           minmax_v3v3_v3(r_min, r_max, vec);
         }
 
@@ -3872,7 +3872,7 @@ bool BKE_object_minmax_dupli(Depsgraph *depsgraph,
       }
     }
   }
-  free_object_duplilist(lb); /* does restore */
+  free_object_duplilist(duplis); /* does restore */
 
   return ok;
 }
@@ -17,6 +17,7 @@
 #include "BLI_string_utf8.h"
 
 #include "BLI_array.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
@@ -90,6 +91,8 @@ struct DupliContext {
   Scene *scene;
   /** Root parent object at the scene level. */
   Object *root_object;
+  /** Hash of the root object name, used for the random ID of every dupli. */
+  uint root_object_hash;
   /** Immediate parent object in the context. */
   Object *object;
   float space_mat[4][4];
@@ -125,8 +128,8 @@ struct DupliContext {
 
   const struct DupliGenerator *gen;
 
-  /** Result containers. */
-  ListBase *duplilist; /* Legacy doubly-linked list. */
+  /** Result container. */
+  blender::bke::DupliList *duplilist;
 };
 
 struct DupliGenerator {
@@ -153,6 +156,7 @@ static void init_context(DupliContext *r_ctx,
   r_ctx->collection = nullptr;
 
   r_ctx->root_object = ob;
+  r_ctx->root_object_hash = BLI_hash_int(BLI_hash_string(ob->id.name + 2));
   r_ctx->object = ob;
   r_ctx->obedit = OBEDIT_FROM_OBACT(ob);
   r_ctx->instance_stack = &instance_stack;
@@ -217,31 +221,25 @@ static bool copy_dupli_context(DupliContext *r_ctx,
 }
 
 /**
- * Generate a dupli instance.
+ * Fill a zero initialized dupli.
  *
  * \param mat: is transform of the object relative to current context (including
  * #Object.object_to_world).
+ * \param object_name_hash: #BLI_hash_string of the object name, passed in so that it can be
+ * computed once when many duplis instance the same object.
  */
-static DupliObject *make_dupli(const DupliContext *ctx,
-                               Object *ob,
-                               const ID *object_data,
-                               const float mat[4][4],
-                               int index,
-                               const GeometrySet *geometry = nullptr,
-                               int64_t instance_index = 0)
+static void init_dupli(const DupliContext *ctx,
+                       DupliObject *dob,
+                       Object *ob,
+                       const ID *object_data,
+                       const float mat[4][4],
+                       int index,
+                       const GeometrySet *geometry,
+                       int64_t instance_index,
+                       const uint object_name_hash)
 {
-  DupliObject *dob;
   int i;
 
-  /* Add a #DupliObject instance to the result container. */
-  if (ctx->duplilist) {
-    dob = MEM_cnew<DupliObject>("dupli object");
-    BLI_addtail(ctx->duplilist, dob);
-  }
-  else {
-    return nullptr;
-  }
-
   dob->ob = ob;
   dob->ob_data = const_cast<ID *>(object_data);
   mul_m4_m4m4(dob->mat, (float(*)[4])ctx->space_mat, mat);
@@ -289,7 +287,7 @@ static DupliObject *make_dupli(const DupliContext *ctx,
   /* Random number per instance.
    * The root object in the scene, persistent ID up to the instance object, and the instance object
    * name together result in a unique random number. */
-  dob->random_id = BLI_hash_string(dob->ob->id.name + 2);
+  dob->random_id = object_name_hash;
 
   if (dob->persistent_id[0] != INT_MAX) {
     for (i = 0; i < MAX_DUPLI_RECUR; i++) {
@@ -301,9 +299,38 @@ static DupliObject *make_dupli(const DupliContext *ctx,
   }
 
   if (ctx->root_object != ob) {
-    dob->random_id ^= BLI_hash_int(BLI_hash_string(ctx->root_object->id.name + 2));
+    dob->random_id ^= ctx->root_object_hash;
   }
+}
 
+/**
+ * Generate a dupli instance.
+ *
+ * \param mat: is transform of the object relative to current context (including
+ * #Object.object_to_world).
+ */
+static DupliObject *make_dupli(const DupliContext *ctx,
+                               Object *ob,
+                               const ID *object_data,
+                               const float mat[4][4],
+                               int index,
+                               const GeometrySet *geometry = nullptr,
+                               int64_t instance_index = 0)
+{
+  /* Add a #DupliObject instance to the result container. */
+  if (ctx->duplilist == nullptr) {
+    return nullptr;
+  }
+  DupliObject *dob = &ctx->duplilist->append();
+  init_dupli(ctx,
+             dob,
+             ob,
+             object_data,
+             mat,
+             index,
+             geometry,
+             instance_index,
+             BLI_hash_string(ob->id.name + 2));
   return dob;
 }
 
@@ -877,6 +904,90 @@ static const DupliGenerator gen_dupli_verts_font = {
 /** \name Instances Geometry Component Implementation
  * \{ */
 
+/**
+ * Whether instancing the object creates a single dupli without any nested duplis.
+ */
+static bool instance_object_has_no_duplis(const DupliContext *ctx, Object &object)
+{
+  /* Let #make_recursive_duplis report the recursion issues. */
+  if (ctx->level + 1 >= MAX_DUPLI_RECUR - 1 || ctx->instance_stack->contains(&object)) {
+    return false;
+  }
+  DupliContext object_ctx = *ctx;
+  object_ctx.object = &object;
+  object_ctx.level = ctx->level + 1;
+  return get_dupli_generator(&object_ctx) == nullptr;
+}
+
+/**
+ * Create the duplis for all instances in parallel, which is possible when every instance
+ * references an object without nested duplis. That is the common case for scattering millions of
+ * instances, which would spend most time in the recursive code path otherwise.
+ *
+ * \return False when some instances have to be processed with the recursive code path.
+ */
+static bool make_duplis_instances_parallel(const DupliContext *ctx,
+                                           const GeometrySet &geometry_set,
+                                           const Instances &instances,
+                                           const float parent_transform[4][4])
+{
+  using namespace blender;
+  if (ctx->duplilist == nullptr || instances.instances_num() < 4096) {
+    return false;
+  }
+
+  Span<InstanceReference> references = instances.references();
+  Array<uint> object_name_hashes(references.size());
+  for (const int i : references.index_range()) {
+    const InstanceReference &reference = references[i];
+    if (reference.type() == InstanceReference::Type::None) {
+      continue;
+    }
+    if (reference.type() != InstanceReference::Type::Object ||
+        !instance_object_has_no_duplis(ctx, reference.object()))
+    {
+      return false;
+    }
+    object_name_hashes[i] = BLI_hash_string(reference.object().id.name + 2);
+  }
+
+  Span<float4x4> instance_offset_matrices = instances.transforms();
+  Span<int> reference_handles = instances.reference_handles();
+  Span<int> almost_unique_ids = instances.almost_unique_ids();
+
+  IndexMaskMemory memory;
+  const IndexMask object_instances = IndexMask::from_predicate(
+      instance_offset_matrices.index_range(), GrainSize(4096), memory, [&](const int64_t i) {
+        return references[reference_handles[i]].type() == InstanceReference::Type::Object;
+      });
+
+  bke::DupliList &duplilist = *ctx->duplilist;
+  const IndexRange dupli_range = duplilist.append_uninitialized(object_instances.size());
+  const bool is_preview_base = ctx->preview_base_geometry == &geometry_set;
+  object_instances.foreach_index(GrainSize(1024), [&](const int64_t i, const int64_t pos) {
+    const int handle = reference_handles[i];
+    Object &object = references[handle].object();
+    float matrix[4][4];
+    mul_m4_m4m4(matrix, parent_transform, instance_offset_matrices[i].ptr());
+
+    DupliObject &dob = duplilist[dupli_range[pos]];
+    dob = {};
+    init_dupli(ctx,
+               &dob,
+               &object,
+               static_cast<ID *>(object.data),
+               matrix,
+               almost_unique_ids[i],
+               &geometry_set,
+               i,
+               object_name_hashes[handle]);
+    if (is_preview_base) {
+      dob.preview_instance_index = int(i);
+    }
+  });
+  return true;
+}
+
 static void make_duplis_geometry_set_impl(const DupliContext *ctx,
                                           const GeometrySet &geometry_set,
                                           const float parent_transform[4][4],
@@ -938,6 +1049,10 @@ static void make_duplis_geometry_set_impl(const DupliContext *ctx,
     instances_ctx = &new_instances_ctx;
   }
 
+  if (make_duplis_instances_parallel(instances_ctx, geometry_set, *instances, parent_transform)) {
+    return;
+  }
+
   Span<float4x4> instance_offset_matrices = instances->transforms();
   Span<int> reference_handles = instances->reference_handles();
   Span<int> almost_unique_ids = instances->almost_unique_ids();
@@ -1761,9 +1876,9 @@ static const DupliGenerator *get_dupli_generator(const DupliContext *ctx)
 /** \name Dupli-Container Implementation
  * \{ */
 
-ListBase *object_duplilist(Depsgraph *depsgraph, Scene *sce, Object *ob)
+blender::bke::DupliList *object_duplilist(Depsgraph *depsgraph, Scene *sce, Object *ob)
 {
-  ListBase *duplilist = MEM_cnew<ListBase>("duplilist");
+  blender::bke::DupliList *duplilist = MEM_new<blender::bke::DupliList>(__func__);
   DupliContext ctx;
   Vector<Object *> instance_stack;
   Vector<short> dupli_gen_type_stack({0});
@@ -1777,12 +1892,12 @@ ListBase *object_duplilist(Depsgraph *depsgraph, Scene *sce, Object *ob)
   return duplilist;
 }
 
-ListBase *object_duplilist_preview(Depsgraph *depsgraph,
-                                   Scene *sce,
-                                   Object *ob_eval,
-                                   const ViewerPath *viewer_path)
+blender::bke::DupliList *object_duplilist_preview(Depsgraph *depsgraph,
+                                                 Scene *sce,
+                                                 Object *ob_eval,
+                                                 const ViewerPath *viewer_path)
 {
-  ListBase *duplilist = MEM_cnew<ListBase>("duplilist");
+  blender::bke::DupliList *duplilist = MEM_new<blender::bke::DupliList>(__func__);
   DupliContext ctx;
   Vector<Object *> instance_stack;
   Vector<short> dupli_gen_type_stack({0});
@@ -1814,10 +1929,9 @@ ListBase *object_duplilist_preview(Depsgraph *depsgraph,
   return duplilist;
 }
 
-void free_object_duplilist(ListBase *lb)
+void free_object_duplilist(blender::bke::DupliList *duplilist)
 {
-  BLI_freelistN(lb);
-  MEM_freeN(lb);
+  MEM_delete(duplilist);
 }
 
 /** \} */
@@ -0,0 +1,61 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BKE_duplilist.hh"
+
+namespace blender::bke::tests {
+
+TEST(duplilist, Append)
+{
+  DupliList duplis;
+  EXPECT_TRUE(duplis.is_empty());
+
+  Vector<DupliObject *> pointers;
+  for (const int i : IndexRange(1000)) {
+    DupliObject &dob = duplis.append();
+    EXPECT_EQ(dob.random_id, 0u);
+    dob.random_id = uint(i);
+    pointers.append(&dob);
+  }
+  EXPECT_EQ(duplis.size(), 1000);
+
+  /* Existing duplis are never moved. */
+  for (const int i : IndexRange(1000)) {
+    EXPECT_EQ(&duplis[i], pointers[i]);
+    EXPECT_EQ(duplis[i].random_id, uint(i));
+  }
+}
+
+TEST(duplilist, AppendUninitialized)
+{
+  DupliList duplis;
+  duplis.append().random_id = 7;
+  const IndexRange range = duplis.append_uninitialized(5000);
+  EXPECT_EQ(range, IndexRange(1, 5000));
+  for (const int64_t i : range) {
+    duplis[i] = {};
+    duplis[i].random_id = uint(i * 3);
+  }
+  duplis.append().random_id = 9;
+  EXPECT_EQ(duplis.size(), 5002);
+
+  int64_t index = 0;
+  for (const DupliObject &dob : duplis) {
+    if (index == 0) {
+      EXPECT_EQ(dob.random_id, 7u);
+    }
+    else if (index == 5001) {
+      EXPECT_EQ(dob.random_id, 9u);
+    }
+    else {
+      EXPECT_EQ(dob.random_id, uint(index * 3));
+    }
+    index++;
+  }
+  EXPECT_EQ(index, 5002);
+}
+
+}  // namespace blender::bke::tests
@@ -23,6 +23,7 @@
 #include "BLI_path_util.h"
 #include "BLI_rand.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_image.h"
@@ -363,10 +364,9 @@ void BKE_ocean_eval_xz_catrom(Ocean *oc, OceanResult *ocr, float x, float z)
   BKE_ocean_eval_uv_catrom(oc, ocr, x / oc->_Lx, z / oc->_Lz);
 }
 
-void BKE_ocean_eval_ij(Ocean *oc, OceanResult *ocr, int i, int j)
+/** Same as #BKE_ocean_eval_ij, the caller is responsible for locking the ocean for reading. */
+static void ocean_eval_ij_nolock(Ocean *oc, OceanResult *ocr, int i, int j)
 {
-  BLI_rw_mutex_lock(&oc->oceanmutex, THREAD_LOCK_READ);
-
   i = abs(i) % oc->_M;
   j = abs(j) % oc->_N;
 
@@ -393,7 +393,12 @@ void BKE_ocean_eval_ij(Ocean *oc, OceanResult *ocr, int i, int j)
     compute_eigenstuff(
         ocr, oc->_Jxx[i * oc->_N + j], oc->_Jzz[i * oc->_N + j], oc->_Jxz[i * oc->_N + j]);
   }
+}
 
+void BKE_ocean_eval_ij(Ocean *oc, OceanResult *ocr, int i, int j)
+{
+  BLI_rw_mutex_lock(&oc->oceanmutex, THREAD_LOCK_READ);
+  ocean_eval_ij_nolock(oc, ocr, i, j);
   BLI_rw_mutex_unlock(&oc->oceanmutex);
 }
 
@@ -422,10 +427,11 @@ static void ocean_compute_htilda(void *__restrict userdata,
     fftw_complex exp_param2;
     fftw_complex conj_param;
 
+    /* `exp(-i * omega * t)` is the conjugate of `exp(i * omega * t)`,
+     * only evaluate the dispersion relation and the trigonometric functions once. */
     init_complex(exp_param1, 0.0, omega(o->_k[i * (1 + o->_N / 2) + j], o->_depth) * t);
-    init_complex(exp_param2, 0.0, -omega(o->_k[i * (1 + o->_N / 2) + j], o->_depth) * t);
     exp_complex(exp_param1, exp_param1);
-    exp_complex(exp_param2, exp_param2);
+    conj_complex(exp_param2, exp_param1);
     conj_complex(conj_param, o->_h0_minus[i * o->_N + j]);
 
     mul_complex_c(exp_param1, o->_h0[i * o->_N + j], exp_param1);
@@ -1383,13 +1389,10 @@ void BKE_ocean_bake(Ocean *o,
                     void (*update_cb)(void *, float progress, int *cancel),
                     void *update_cb_data)
 {
-  /* NOTE(@ideasman42): some of these values remain uninitialized unless certain options
-   * are enabled, take care that #BKE_ocean_eval_ij() initializes a member before use. */
-  OceanResult ocr;
-
+  using namespace blender;
   ImageFormatData imf = {0};
 
-  int f, i = 0, x, y, cancel = 0;
+  int f, i = 0, cancel = 0;
   float progress;
 
   ImBuf *ibuf_foam, *ibuf_disp, *ibuf_normal, *ibuf_spray, *ibuf_spray_inverse;
@@ -1429,72 +1432,80 @@ void BKE_ocean_bake(Ocean *o,
 
     BKE_ocean_simulate(o, och->time[i], och->wave_scale, och->chop_amount);
 
-    /* add new foam */
-    for (y = 0; y < res_y; y++) {
-      for (x = 0; x < res_x; x++) {
+    /* add new foam, every pixel only depends on the simulation and its own previous foam value */
+    BLI_rw_mutex_lock(&o->oceanmutex, THREAD_LOCK_READ);
+    threading::parallel_for(IndexRange(res_y), 16, [&](const IndexRange range) {
+      /* NOTE(@ideasman42): some of these values remain uninitialized unless certain options
+       * are enabled, take care that #BKE_ocean_eval_ij() initializes a member before use. */
+      OceanResult ocr;
+      for (const int y : range) {
+        for (int x = 0; x < res_x; x++) {
+          ocean_eval_ij_nolock(o, &ocr, x, y);
 
-        BKE_ocean_eval_ij(o, &ocr, x, y);
+          /* add to the image */
+          rgb_to_rgba_unit_alpha(&ibuf_disp->float_buffer.data[4 * (res_x * y + x)], ocr.disp);
 
-        /* add to the image */
-        rgb_to_rgba_unit_alpha(&ibuf_disp->float_buffer.data[4 * (res_x * y + x)], ocr.disp);
+          if (o->_do_jacobian) {
+            /* TODO(@ideasman42): cleanup unused code. */
 
-        if (o->_do_jacobian) {
-          /* TODO(@ideasman42): cleanup unused code. */
+            float /* r, */ /* UNUSED */ pr = 0.0f, foam_result;
+            float neg_disp, neg_eplus;
 
-          float /* r, */ /* UNUSED */ pr = 0.0f, foam_result;
-          float neg_disp, neg_eplus;
+            ocr.foam = BKE_ocean_jminus_to_foam(ocr.Jminus, och->foam_coverage);
 
-          ocr.foam = BKE_ocean_jminus_to_foam(ocr.Jminus, och->foam_coverage);
+            /* accumulate previous value for this cell */
+            if (i > 0) {
+              pr = prev_foam[res_x * y + x];
+            }
 
-          /* accumulate previous value for this cell */
-          if (i > 0) {
-            pr = prev_foam[res_x * y + x];
-          }
-
-          // r = BLI_rng_get_float(rng); /* UNUSED */ /* randomly reduce foam */
+            // r = BLI_rng_get_float(rng); /* UNUSED */ /* randomly reduce foam */
 
-          // pr = pr * och->foam_fade; /* overall fade */
+            // pr = pr * och->foam_fade; /* overall fade */
 
-          /* Remember ocean coord system is Y up!
-           * break up the foam where height (Y) is low (wave valley),
-           * and X and Z displacement is greatest. */
+            /* Remember ocean coord system is Y up!
+             * break up the foam where height (Y) is low (wave valley),
+             * and X and Z displacement is greatest. */
 
-          neg_disp = ocr.disp[1] < 0.0f ? 1.0f + ocr.disp[1] : 1.0f;
-          neg_disp = neg_disp < 0.0f ? 0.0f : neg_disp;
+            neg_disp = ocr.disp[1] < 0.0f ? 1.0f + ocr.disp[1] : 1.0f;
+            neg_disp = neg_disp < 0.0f ? 0.0f : neg_disp;
 
-          /* foam, 'ocr.Eplus' only initialized with do_jacobian */
-          neg_eplus = ocr.Eplus[2] < 0.0f ? 1.0f + ocr.Eplus[2] : 1.0f;
-          neg_eplus = neg_eplus < 0.0f ? 0.0f : neg_eplus;
+            /* foam, 'ocr.Eplus' only initialized with do_jacobian */
+            neg_eplus = ocr.Eplus[2] < 0.0f ? 1.0f + ocr.Eplus[2] : 1.0f;
+            neg_eplus = neg_eplus < 0.0f ? 0.0f : neg_eplus;
 
-          if (pr < 1.0f) {
-            pr *= pr;
-          }
+            if (pr < 1.0f) {
+              pr *= pr;
+            }
 
-          pr *= och->foam_fade * (0.75f + neg_eplus * 0.25f);
+            pr *= och->foam_fade * (0.75f + neg_eplus * 0.25f);
 
-          /* A full clamping should not be needed! */
-          foam_result = min_ff(pr + ocr.foam, 1.0f);
+            /* A full clamping should not be needed! */
+            foam_result = min_ff(pr + ocr.foam, 1.0f);
 
-          prev_foam[res_x * y + x] = foam_result;
+            prev_foam[res_x * y + x] = foam_result;
 
-          // foam_result = min_ff(foam_result, 1.0f);
+            // foam_result = min_ff(foam_result, 1.0f);
 
-          value_to_rgba_unit_alpha(&ibuf_foam->float_buffer.data[4 * (res_x * y + x)],
-                                   foam_result);
+            value_to_rgba_unit_alpha(&ibuf_foam->float_buffer.data[4 * (res_x * y + x)],
+                                     foam_result);
 
-          /* spray map baking */
-          if (o->_do_spray) {
-            rgb_to_rgba_unit_alpha(&ibuf_spray->float_buffer.data[4 * (res_x * y + x)], ocr.Eplus);
-            rgb_to_rgba_unit_alpha(&ibuf_spray_inverse->float_buffer.data[4 * (res_x * y + x)],
-                                   ocr.Eminus);
+            /* spray map baking */
+            if (o->_do_spray) {
+              rgb_to_rgba_unit_alpha(&ibuf_spray->float_buffer.data[4 * (res_x * y + x)],
+                                     ocr.Eplus);
+              rgb_to_rgba_unit_alpha(&ibuf_spray_inverse->float_buffer.data[4 * (res_x * y + x)],
+                                     ocr.Eminus);
+            }
           }
-        }
 
-        if (o->_do_normals) {
-          rgb_to_rgba_unit_alpha(&ibuf_normal->float_buffer.data[4 * (res_x * y + x)], ocr.normal);
+          if (o->_do_normals) {
+            rgb_to_rgba_unit_alpha(&ibuf_normal->float_buffer.data[4 * (res_x * y + x)],
+                                   ocr.normal);
+          }
         }
       }
-    }
+    });
+    BLI_rw_mutex_unlock(&o->oceanmutex);
 
     /* write the images */
     cache_filepath(filepath, och->bakepath, och->relbase, f, CACHE_TYPE_DISPLACE);
@@ -2252,7 +2252,7 @@ int BKE_sculptsession_vertex_count(const SculptSession *ss)
     return ss->bm->totvert;
   }
   if (ss->subdiv_ccg) {
-    return ss->subdiv_ccg->grids.size() * BKE_subdiv_ccg_key_top_level(*ss->subdiv_ccg).grid_area;
+    return ss->subdiv_ccg->grids_num * BKE_subdiv_ccg_key_top_level(*ss->subdiv_ccg).grid_area;
   }
   return ss->totvert;
 }
@@ -43,6 +43,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_rand.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -2673,6 +2674,85 @@ void psys_find_parents(ParticleSimulationData *sim, const bool use_render_params
   BLI_kdtree_3d_free(tree);
 }
 
+/**
+ * Compute the data that only depends on the parent particle once per parent, instead of once for
+ * every child interpolated from it. Hair systems usually have many children per parent.
+ */
+static void psys_thread_context_init_parents(ParticleThreadContext *ctx)
+{
+  using namespace blender;
+  Object *ob = ctx->sim.ob;
+  ParticleSystemModifierData *psmd = ctx->sim.psmd;
+  ParticleSystem *psys = ctx->sim.psys;
+  ParticleSettings *part = psys->part;
+  const int totpart = psys->totpart;
+
+  if (totpart == 0) {
+    return;
+  }
+
+  ctx->parent_hairmats = static_cast<float(*)[4][4]>(
+      MEM_malloc_arrayN(totpart, sizeof(float[4][4]), __func__));
+  ctx->parent_modifier_orcos = static_cast<float(*)[3]>(
+      MEM_malloc_arrayN(totpart, sizeof(float[3]), __func__));
+  if (!ctx->between) {
+    ctx->parent_orcos = static_cast<float(*)[3]>(
+        MEM_malloc_arrayN(totpart, sizeof(float[3]), __func__));
+  }
+
+  threading::parallel_for(IndexRange(totpart), 256, [&](const IndexRange range) {
+    for (const int p : range) {
+      ParticleData *pa = &psys->particles[p];
+      float co[3];
+
+      psys_mat_hair_to_global(ob, psmd->mesh_final, part->from, pa, ctx->parent_hairmats[p]);
+
+      psys_particle_on_emitter(psmd,
+                               part->from,
+                               pa->num,
+                               pa->num_dmcache,
+                               pa->fuv,
+                               pa->foffset,
+                               co,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               ctx->parent_modifier_orcos[p]);
+
+      if (ctx->parent_orcos) {
+        /*
+         * NOTE: Should in theory be the same as:
+         * cpa_num = psys_particle_dm_face_lookup(
+         *        ctx->sim.psmd->dm_final,
+         *        ctx->sim.psmd->dm_deformed,
+         *        pa->num, pa->fuv,
+         *        nullptr);
+         */
+        int cpa_num = ELEM(pa->num_dmcache, DMCACHE_ISCHILD, DMCACHE_NOTFOUND) ?
+                          pa->num :
+                          pa->num_dmcache;
+
+        /* XXX hack to avoid messed up particle num and subsequent crash (#40733) */
+        if (cpa_num > psmd->mesh_final->totface_legacy) {
+          cpa_num = 0;
+        }
+
+        psys_particle_on_emitter(psmd,
+                                 part->from,
+                                 cpa_num,
+                                 DMCACHE_ISCHILD,
+                                 pa->fuv,
+                                 pa->foffset,
+                                 co,
+                                 nullptr,
+                                 nullptr,
+                                 nullptr,
+                                 ctx->parent_orcos[p]);
+      }
+    }
+  });
+}
+
 static bool psys_thread_context_init_path(ParticleThreadContext *ctx,
                                           ParticleSimulationData *sim,
                                           Scene *scene,
@@ -2777,6 +2857,8 @@ static bool psys_thread_context_init_path(ParticleThreadContext *ctx,
     ctx->twistcurve = nullptr;
   }
 
+  psys_thread_context_init_parents(ctx);
+
   return true;
 }
 
@@ -2816,7 +2898,6 @@ static void psys_thread_create_path(ParticleTask *task,
   }
 
   if (ctx->between) {
-    ParticleData *pa = psys->particles + cpa->pa[0];
     int w, needupdate;
     float foffset, wsum = 0.0f;
     float co[3];
@@ -2927,11 +3008,10 @@ static void psys_thread_create_path(ParticleTask *task,
       sub_v3_v3v3(off1[w], co, key[w]->co);
     }
 
-    psys_mat_hair_to_global(ob, ctx->sim.psmd->mesh_final, psys->part->from, pa, hairmat);
+    copy_m4_m4(hairmat, ctx->parent_hairmats[cpa->pa[0]]);
   }
   else {
     ParticleData *pa = psys->particles + cpa->parent;
-    float co[3];
     if (ctx->editupdate) {
       if (!(edit->points[cpa->parent].flag & PEP_EDIT_RECALC)) {
         return;
@@ -2943,17 +3023,9 @@ static void psys_thread_create_path(ParticleTask *task,
     /* get the parent path */
     key[0] = pcache[cpa->parent];
 
-    /* get the original coordinates (orco) for texture usage */
+    /* get the original coordinates (orco) for texture usage, see
+     * #psys_thread_context_init_parents */
     cpa_from = part->from;
-
-    /*
-     * NOTE: Should in theory be the same as:
-     * cpa_num = psys_particle_dm_face_lookup(
-     *        ctx->sim.psmd->dm_final,
-     *        ctx->sim.psmd->dm_deformed,
-     *        pa->num, pa->fuv,
-     *        nullptr);
-     */
     cpa_num = ELEM(pa->num_dmcache, DMCACHE_ISCHILD, DMCACHE_NOTFOUND) ? pa->num : pa->num_dmcache;
 
     /* XXX hack to avoid messed up particle num and subsequent crash (#40733) */
@@ -2962,19 +3034,8 @@ static void psys_thread_create_path(ParticleTask *task,
     }
     cpa_fuv = pa->fuv;
 
-    psys_particle_on_emitter(ctx->sim.psmd,
-                             cpa_from,
-                             cpa_num,
-                             DMCACHE_ISCHILD,
-                             cpa_fuv,
-                             pa->foffset,
-                             co,
-                             nullptr,
-                             nullptr,
-                             nullptr,
-                             orco);
-
-    psys_mat_hair_to_global(ob, ctx->sim.psmd->mesh_final, psys->part->from, pa, hairmat);
+    copy_v3_v3(orco, ctx->parent_orcos[cpa->parent]);
+    copy_m4_m4(hairmat, ctx->parent_hairmats[cpa->parent]);
   }
 
   child_keys->segments = ctx->segments;
@@ -3103,17 +3164,24 @@ static void psys_thread_create_path(ParticleTask *task,
       ListBase modifiers;
       BLI_listbase_clear(&modifiers);
 
-      psys_particle_on_emitter(ctx->sim.psmd,
-                               part->from,
-                               pa->num,
-                               pa->num_dmcache,
-                               pa->fuv,
-                               pa->foffset,
-                               par_co,
-                               nullptr,
-                               nullptr,
-                               nullptr,
-                               par_orco);
+      const int64_t pa_index = pa - psys->particles;
+      if (pa_index < psys->totpart) {
+        copy_v3_v3(par_orco, ctx->parent_modifier_orcos[pa_index]);
+      }
+      else {
+        /* With virtual parents `cpa->parent` is a child index, which is not cached. */
+        psys_particle_on_emitter(ctx->sim.psmd,
+                                 part->from,
+                                 pa->num,
+                                 pa->num_dmcache,
+                                 pa->fuv,
+                                 pa->foffset,
+                                 par_co,
+                                 nullptr,
+                                 nullptr,
+                                 nullptr,
+                                 par_orco);
+      }
 
       psys_apply_child_modifiers(
           ctx, &modifiers, cpa, &ptex, orco, hairmat, child_keys, par, par_orco);
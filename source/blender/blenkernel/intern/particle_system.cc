@@ -516,6 +516,15 @@ void psys_thread_context_free(ParticleThreadContext *ctx)
   if (ctx->vg_twist) {
     MEM_freeN(ctx->vg_twist);
   }
+  if (ctx->parent_hairmats) {
+    MEM_freeN(ctx->parent_hairmats);
+  }
+  if (ctx->parent_orcos) {
+    MEM_freeN(ctx->parent_orcos);
+  }
+  if (ctx->parent_modifier_orcos) {
+    MEM_freeN(ctx->parent_modifier_orcos);
+  }
 
   psys_sim_data_free(&ctx->sim);
 
@@ -98,12 +98,12 @@ void update_node_bounds_mesh(const Span<float3> positions, PBVHNode &node)
   node.vb = bounds;
 }
 
-void update_node_bounds_grids(const CCGKey &key, const Span<CCGElem *> grids, PBVHNode &node)
+void update_node_bounds_grids(const CCGKey &key, const Span<float3> positions, PBVHNode &node)
 {
   Bounds<float3> bounds = negative_bounds();
   for (const int grid : node.prim_indices) {
-    for (const int i : IndexRange(key.grid_area)) {
-      math::min_max(float3(CCG_elem_offset_co(&key, grids[grid], i)), bounds.min, bounds.max);
+    for (const float3 &position : positions.slice(CCG_grid_range(key, grid))) {
+      math::min_max(position, bounds.min, bounds.max);
     }
   }
   node.vb = bounds;
@@ -130,7 +130,7 @@ static void update_node_vb(PBVH &pbvh, PBVHNode *node)
         update_node_bounds_mesh(pbvh.vert_positions, *node);
         break;
       case PBVH_GRIDS:
-        update_node_bounds_grids(pbvh.gridkey, pbvh.subdiv_ccg->grids, *node);
+        update_node_bounds_grids(pbvh.gridkey, pbvh.subdiv_ccg->positions, *node);
         break;
       case PBVH_BMESH:
         update_node_bounds_bmesh(*node);
@@ -801,7 +801,8 @@ std::unique_ptr<PBVH> build_grids(const CCGKey *key, Mesh *mesh, SubdivCCG *subd
     max_grids = max_ii(max_grids, faces[i].size());
   }
 
-  const Span<CCGElem *> grids = subdiv_ccg->grids;
+  const int grids_num = subdiv_ccg->grids_num;
+  const Span<float3> positions = subdiv_ccg->positions;
 
   /* Ensure leaf limit is at least 4 so there's room
    * to split at original face boundaries.
@@ -813,18 +814,16 @@ std::unique_ptr<PBVH> build_grids(const CCGKey *key, Mesh *mesh, SubdivCCG *subd
   pbvh->mesh = mesh;
 
   /* For each grid, store the AABB and the AABB centroid */
-  Array<Bounds<float3>> prim_bounds(grids.size());
+  Array<Bounds<float3>> prim_bounds(grids_num);
   const Bounds<float3> cb = threading::parallel_reduce(
-      grids.index_range(),
+      IndexRange(grids_num),
       1024,
       negative_bounds(),
       [&](const IndexRange range, const Bounds<float3> &init) {
         Bounds<float3> current = init;
         for (const int i : range) {
-          CCGElem *grid = grids[i];
           prim_bounds[i] = negative_bounds();
-          for (const int j : IndexRange(key->grid_area)) {
-            const float3 position = float3(CCG_elem_offset_co(key, grid, j));
+          for (const float3 &position : positions.slice(CCG_grid_range(*key, i))) {
             math::min_max(position, prim_bounds[i].min, prim_bounds[i].max);
           }
           const float3 center = math::midpoint(prim_bounds[i].min, prim_bounds[i].max);
@@ -834,12 +833,12 @@ std::unique_ptr<PBVH> build_grids(const CCGKey *key, Mesh *mesh, SubdivCCG *subd
       },
       [](const Bounds<float3> &a, const Bounds<float3> &b) { return bounds::merge(a, b); });
 
-  if (!grids.is_empty()) {
+  if (grids_num > 0) {
     const AttributeAccessor attributes = mesh->attributes();
     const VArraySpan material_index = *attributes.lookup<int>("material_index", AttrDomain::Face);
     const VArraySpan sharp_face = *attributes.lookup<bool>("sharp_face", AttrDomain::Face);
     pbvh_build(
-        *pbvh, {}, {}, {}, {}, material_index, sharp_face, {}, &cb, prim_bounds, grids.size());
+        *pbvh, {}, {}, {}, {}, material_index, sharp_face, {}, &cb, prim_bounds, grids_num);
   }
 
 #ifdef VALIDATE_UNIQUE_NODE_FACES
@@ -1407,15 +1406,13 @@ static void update_mask_mesh(const Mesh &mesh, const Span<PBVHNode *> nodes)
   });
 }
 
-void node_update_mask_grids(const CCGKey &key, const Span<CCGElem *> grids, PBVHNode &node)
+void node_update_mask_grids(const CCGKey &key, const Span<float> masks, PBVHNode &node)
 {
   BLI_assert(key.has_mask);
   bool fully_masked = true;
   bool fully_unmasked = true;
   for (const int grid : node.prim_indices) {
-    CCGElem *elem = grids[grid];
-    for (const int i : IndexRange(key.grid_area)) {
-      const float mask = *CCG_elem_offset_mask(&key, elem, i);
+    for (const float mask : masks.slice(CCG_grid_range(key, grid))) {
       fully_masked &= mask == 1.0f;
       fully_unmasked &= mask <= 0.0f;
     }
@@ -1439,7 +1436,7 @@ static void update_mask_grids(const SubdivCCG &subdiv_ccg, const Span<PBVHNode *
 
   threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
     for (PBVHNode *node : nodes.slice(range)) {
-      node_update_mask_grids(key, subdiv_ccg.grids, *node);
+      node_update_mask_grids(key, subdiv_ccg.masks, *node);
     }
   });
 }
@@ -1676,13 +1673,13 @@ const CCGKey *BKE_pbvh_get_grid_key(const PBVH &pbvh)
 int BKE_pbvh_get_grid_num_verts(const PBVH &pbvh)
 {
   BLI_assert(pbvh.header.type == PBVH_GRIDS);
-  return pbvh.subdiv_ccg->grids.size() * pbvh.gridkey.grid_area;
+  return pbvh.subdiv_ccg->grids_num * pbvh.gridkey.grid_area;
 }
 
 int BKE_pbvh_get_grid_num_faces(const PBVH &pbvh)
 {
   BLI_assert(pbvh.header.type == PBVH_GRIDS);
-  return pbvh.subdiv_ccg->grids.size() * (pbvh.gridkey.grid_size - 1) *
+  return pbvh.subdiv_ccg->grids_num * (pbvh.gridkey.grid_size - 1) *
          (pbvh.gridkey.grid_size - 1);
 }
 
@@ -2115,14 +2112,11 @@ static bool pbvh_grids_node_raycast(PBVH &pbvh,
   float nearest_vertex_co[3] = {0.0};
   const CCGKey *gridkey = &pbvh.gridkey;
   const BitGroupVector<> &grid_hidden = pbvh.subdiv_ccg->grid_hidden;
-  const Span<CCGElem *> grids = pbvh.subdiv_ccg->grids;
+  const Span<float3> positions = pbvh.subdiv_ccg->positions;
 
   for (int i = 0; i < totgrid; i++) {
     const int grid_index = node->prim_indices[i];
-    CCGElem *grid = grids[grid_index];
-    if (!grid) {
-      continue;
-    }
+    const Span<float3> grid_positions = positions.slice(CCG_grid_range(*gridkey, grid_index));
 
     for (int y = 0; y < gridsize - 1; y++) {
       for (int x = 0; x < gridsize - 1; x++) {
@@ -2141,10 +2135,10 @@ static bool pbvh_grids_node_raycast(PBVH &pbvh,
           co[3] = origco[y * gridsize + x];
         }
         else {
-          co[0] = CCG_grid_elem_co(gridkey, grid, x, y + 1);
-          co[1] = CCG_grid_elem_co(gridkey, grid, x + 1, y + 1);
-          co[2] = CCG_grid_elem_co(gridkey, grid, x + 1, y);
-          co[3] = CCG_grid_elem_co(gridkey, grid, x, y);
+          co[0] = grid_positions[CCG_grid_xy_to_index(gridsize, x, y + 1)];
+          co[1] = grid_positions[CCG_grid_xy_to_index(gridsize, x + 1, y + 1)];
+          co[2] = grid_positions[CCG_grid_xy_to_index(gridsize, x + 1, y)];
+          co[3] = grid_positions[CCG_grid_xy_to_index(gridsize, x, y)];
         }
 
         if (ray_face_intersection_quad(
@@ -2447,13 +2441,11 @@ static bool pbvh_grids_node_nearest_to_ray(PBVH &pbvh,
   const int gridsize = pbvh.gridkey.grid_size;
   bool hit = false;
   const BitGroupVector<> &grid_hidden = pbvh.subdiv_ccg->grid_hidden;
-  const Span<CCGElem *> grids = pbvh.subdiv_ccg->grids;
+  const Span<float3> positions = pbvh.subdiv_ccg->positions;
 
   for (int i = 0; i < totgrid; i++) {
-    CCGElem *grid = grids[node->prim_indices[i]];
-    if (!grid) {
-      continue;
-    }
+    const Span<float3> grid_positions = positions.slice(
+        CCG_grid_range(pbvh.gridkey, node->prim_indices[i]));
 
     for (int y = 0; y < gridsize - 1; y++) {
       for (int x = 0; x < gridsize - 1; x++) {
@@ -2477,10 +2469,10 @@ static bool pbvh_grids_node_nearest_to_ray(PBVH &pbvh,
         else {
           hit |= ray_face_nearest_quad(ray_start,
                                        ray_normal,
-                                       CCG_grid_elem_co(&pbvh.gridkey, grid, x, y),
-                                       CCG_grid_elem_co(&pbvh.gridkey, grid, x + 1, y),
-                                       CCG_grid_elem_co(&pbvh.gridkey, grid, x + 1, y + 1),
-                                       CCG_grid_elem_co(&pbvh.gridkey, grid, x, y + 1),
+                                       grid_positions[y * gridsize + x],
+                                       grid_positions[y * gridsize + x + 1],
+                                       grid_positions[(y + 1) * gridsize + x + 1],
+                                       grid_positions[(y + 1) * gridsize + x],
                                        depth,
                                        dist_sq);
         }
@@ -2637,7 +2629,6 @@ static blender::draw::pbvh::PBVH_GPU_Args pbvh_draw_args_init(const Mesh &mesh,
       args.mesh = pbvh.mesh;
       args.grid_indices = node.prim_indices;
       args.subdiv_ccg = pbvh.subdiv_ccg;
-      args.grids = pbvh.subdiv_ccg->grids;
       args.vert_normals = pbvh.vert_normals;
       break;
     case PBVH_BMESH:
@@ -2915,7 +2906,6 @@ void BKE_pbvh_node_color_buffer_free(PBVH &pbvh)
 
 void pbvh_vertex_iter_init(PBVH &pbvh, PBVHNode *node, PBVHVertexIter *vi, int mode)
 {
-  vi->grid = nullptr;
   vi->no = nullptr;
   vi->fno = nullptr;
   vi->vert_positions = {};
@@ -2940,14 +2930,18 @@ void pbvh_vertex_iter_init(PBVH &pbvh, PBVHNode *node, PBVHVertexIter *vi, int m
 
   if (pbvh.header.type == PBVH_GRIDS) {
     vi->key = pbvh.gridkey;
-    vi->grids = pbvh.subdiv_ccg->grids.data();
+    vi->grid_positions = pbvh.subdiv_ccg->positions;
+    vi->grid_normals = pbvh.subdiv_ccg->normals;
+    vi->grid_masks = pbvh.subdiv_ccg->masks;
     vi->grid_indices = node->prim_indices.data();
     vi->totgrid = node->prim_indices.size();
     vi->gridsize = pbvh.gridkey.grid_size;
   }
   else {
     vi->key = {};
-    vi->grids = nullptr;
+    vi->grid_positions = {};
+    vi->grid_normals = {};
+    vi->grid_masks = {};
     vi->grid_indices = nullptr;
     vi->totgrid = 1;
     vi->gridsize = 0;
@@ -2974,7 +2968,7 @@ void pbvh_vertex_iter_init(PBVH &pbvh, PBVHNode *node, PBVHVertexIter *vi, int m
   }
 
   vi->gh.reset();
-  if (vi->grids && mode == PBVH_ITER_UNIQUE) {
+  if (!vi->grid_positions.is_empty() && mode == PBVH_ITER_UNIQUE) {
     vi->grid_hidden = pbvh.subdiv_ccg->grid_hidden.is_empty() ? nullptr :
                                                                 &pbvh.subdiv_ccg->grid_hidden;
   }
@@ -2040,7 +2040,7 @@ int BKE_scene_base_iter_next(
   /* init */
   if (val == 0) {
     iter->phase = F_START;
-    iter->dupob = nullptr;
+    iter->dupob_index = 0;
     iter->duplilist = nullptr;
     iter->dupli_refob = nullptr;
   }
@@ -2112,9 +2112,9 @@ int BKE_scene_base_iter_next(
             if ((*base)->object->instance_collection == nullptr) {
               iter->duplilist = object_duplilist(depsgraph, (*scene), (*base)->object);
 
-              iter->dupob = static_cast<DupliObject *>(iter->duplilist->first);
+              iter->dupob_index = 0;
 
-              if (!iter->dupob) {
+              if (iter->duplilist->is_empty()) {
                 free_object_duplilist(iter->duplilist);
                 iter->duplilist = nullptr;
               }
@@ -2123,9 +2123,10 @@ int BKE_scene_base_iter_next(
           }
         }
         /* handle dupli's */
-        if (iter->dupob) {
+        if (iter->duplilist && iter->dupob_index < iter->duplilist->size()) {
+          const DupliObject &dob = (*iter->duplilist)[iter->dupob_index];
           (*base)->flag_legacy |= OB_FROMDUPLI;
-          *ob = iter->dupob->ob;
+          *ob = dob.ob;
           iter->phase = F_DUPLI;
 
           if (iter->dupli_refob != *ob) {
@@ -2137,9 +2138,9 @@ int BKE_scene_base_iter_next(
             iter->dupli_refob = *ob;
             copy_m4_m4(iter->omat, iter->dupli_refob->object_to_world().ptr());
           }
-          copy_m4_m4((*ob)->runtime->object_to_world.ptr(), iter->dupob->mat);
+          copy_m4_m4((*ob)->runtime->object_to_world.ptr(), dob.mat);
 
-          iter->dupob = iter->dupob->next;
+          iter->dupob_index++;
         }
         else if (iter->phase == F_DUPLI) {
           iter->phase = F_SCENE;
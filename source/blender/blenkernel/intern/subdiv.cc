@@ -169,10 +169,20 @@ Subdiv *update_from_converter(Subdiv *subdiv,
 
 Subdiv *update_from_mesh(Subdiv *subdiv, const Settings *settings, const Mesh *mesh)
 {
+  /* Hashing the mesh data is much cheaper than creating the converter and comparing it with the
+   * topology refiner, and it can be done in parallel. Different hashes don't mean that the
+   * topology refiner can't be reused though, so then the full comparison is still done. */
+  const uint64_t topology_hash = converter_mesh_topology_hash(settings, mesh);
+  if (subdiv != nullptr && subdiv->topology_refiner != nullptr &&
+      subdiv->topology_hash == topology_hash && settings_equal(&subdiv->settings, settings))
+  {
+    return subdiv;
+  }
   OpenSubdiv_Converter converter;
   converter_init_for_mesh(&converter, settings, mesh);
   subdiv = update_from_converter(subdiv, settings, &converter);
   converter_free(&converter);
+  subdiv->topology_hash = topology_hash;
   return subdiv;
 }
 
@@ -56,63 +56,15 @@ void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG &subdiv_ccg,
 
 /** \} */
 
-/* -------------------------------------------------------------------- */
-/** \name Generally useful internal helpers
- * \{ */
-
-/* Number of floats in per-vertex elements. */
-static int num_element_float_get(const SubdivCCG &subdiv_ccg)
-{
-  /* We always have 3 floats for coordinate. */
-  int num_floats = 3;
-  if (subdiv_ccg.has_normal) {
-    num_floats += 3;
-  }
-  if (subdiv_ccg.has_mask) {
-    num_floats += 1;
-  }
-  return num_floats;
-}
-
-/* Per-vertex element size in bytes. */
-static int element_size_bytes_get(const SubdivCCG &subdiv_ccg)
-{
-  return sizeof(float) * num_element_float_get(subdiv_ccg);
-}
-
-/** \} */
-
 /* -------------------------------------------------------------------- */
 /** \name Internal helpers for CCG creation
  * \{ */
 
 static void subdiv_ccg_init_layers(SubdivCCG &subdiv_ccg, const SubdivToCCGSettings &settings)
 {
-  /* CCG always contains coordinates. Rest of layers are coming after them. */
-  int layer_offset = sizeof(float[3]);
-  /* Mask. */
-  if (settings.need_mask) {
-    subdiv_ccg.has_mask = true;
-    subdiv_ccg.mask_offset = layer_offset;
-    layer_offset += sizeof(float);
-  }
-  else {
-    subdiv_ccg.has_mask = false;
-    subdiv_ccg.mask_offset = -1;
-  }
-  /* Normals.
-   *
-   * NOTE: Keep them at the end, matching old CCGDM. Doesn't really matter
-   * here, but some other area might in theory depend memory layout. */
-  if (settings.need_normal) {
-    subdiv_ccg.has_normal = true;
-    subdiv_ccg.normal_offset = layer_offset;
-    layer_offset += sizeof(float[3]);
-  }
-  else {
-    subdiv_ccg.has_normal = false;
-    subdiv_ccg.normal_offset = -1;
-  }
+  /* CCG always contains coordinates, the other layers are optional. */
+  subdiv_ccg.has_mask = settings.need_mask;
+  subdiv_ccg.has_normal = settings.need_normal;
 }
 
 /* TODO(sergey): Make it more accessible function. */
@@ -131,18 +83,17 @@ static int topology_refiner_count_face_corners(const OpenSubdiv_TopologyRefiner
 static void subdiv_ccg_alloc_elements(SubdivCCG &subdiv_ccg, Subdiv &subdiv)
 {
   const OpenSubdiv_TopologyRefiner *topology_refiner = subdiv.topology_refiner;
-  const int64_t element_size = element_size_bytes_get(subdiv_ccg);
   /* Allocate memory for surface grids. */
   const int64_t num_grids = topology_refiner_count_face_corners(topology_refiner);
   const int64_t grid_size = grid_size_from_level(subdiv_ccg.level);
   const int64_t grid_area = grid_size * grid_size;
-  subdiv_ccg.grid_element_size = element_size;
-  subdiv_ccg.grids.reinitialize(num_grids);
-  subdiv_ccg.grids_storage.reinitialize(num_grids * grid_area * element_size);
-  const size_t grid_size_in_bytes = size_t(grid_area) * element_size;
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    const size_t grid_offset = grid_size_in_bytes * grid_index;
-    subdiv_ccg.grids[grid_index] = (CCGElem *)&subdiv_ccg.grids_storage[grid_offset];
+  subdiv_ccg.grids_num = num_grids;
+  subdiv_ccg.positions.reinitialize(num_grids * grid_area);
+  if (subdiv_ccg.has_normal) {
+    subdiv_ccg.normals.reinitialize(num_grids * grid_area);
+  }
+  if (subdiv_ccg.has_mask) {
+    subdiv_ccg.masks.reinitialize(num_grids * grid_area);
   }
   /* TODO(sergey): Allocate memory for loose elements. */
 }
@@ -158,21 +109,21 @@ static void subdiv_ccg_eval_grid_element_limit(Subdiv &subdiv,
                                                const int ptex_face_index,
                                                const float u,
                                                const float v,
-                                               uchar *element)
+                                               const int element)
 {
   if (subdiv.displacement_evaluator != nullptr) {
-    eval_final_point(&subdiv, ptex_face_index, u, v, (float *)element);
+    eval_final_point(&subdiv, ptex_face_index, u, v, subdiv_ccg.positions[element]);
   }
   else if (subdiv_ccg.has_normal) {
     eval_limit_point_and_normal(&subdiv,
                                 ptex_face_index,
                                 u,
                                 v,
-                                (float *)element,
-                                (float *)(element + subdiv_ccg.normal_offset));
+                                subdiv_ccg.positions[element],
+                                subdiv_ccg.normals[element]);
   }
   else {
-    eval_limit_point(&subdiv, ptex_face_index, u, v, (float *)element);
+    eval_limit_point(&subdiv, ptex_face_index, u, v, subdiv_ccg.positions[element]);
   }
 }
 
@@ -181,17 +132,16 @@ static void subdiv_ccg_eval_grid_element_mask(SubdivCCG &subdiv_ccg,
                                               const int ptex_face_index,
                                               const float u,
                                               const float v,
-                                              uchar *element)
+                                              const int element)
 {
   if (!subdiv_ccg.has_mask) {
     return;
   }
-  float *mask_value_ptr = (float *)(element + subdiv_ccg.mask_offset);
   if (mask_evaluator != nullptr) {
-    *mask_value_ptr = mask_evaluator->eval_mask(mask_evaluator, ptex_face_index, u, v);
+    subdiv_ccg.masks[element] = mask_evaluator->eval_mask(mask_evaluator, ptex_face_index, u, v);
   }
   else {
-    *mask_value_ptr = 0.0f;
+    subdiv_ccg.masks[element] = 0.0f;
   }
 }
 
@@ -201,7 +151,7 @@ static void subdiv_ccg_eval_grid_element(Subdiv &subdiv,
                                          const int ptex_face_index,
                                          const float u,
                                          const float v,
-                                         uchar *element)
+                                         const int element)
 {
   subdiv_ccg_eval_grid_element_limit(subdiv, subdiv_ccg, ptex_face_index, u, v, element);
   subdiv_ccg_eval_grid_element_mask(subdiv_ccg, mask_evaluator, ptex_face_index, u, v, element);
@@ -215,22 +165,21 @@ static void subdiv_ccg_eval_regular_grid(Subdiv &subdiv,
 {
   const int ptex_face_index = face_ptex_offset[face_index];
   const int grid_size = subdiv_ccg.grid_size;
+  const int grid_area = grid_size * grid_size;
   const float grid_size_1_inv = 1.0f / (grid_size - 1);
-  const int element_size = element_size_bytes_get(subdiv_ccg);
   const IndexRange face = subdiv_ccg.faces[face_index];
   for (int corner = 0; corner < face.size(); corner++) {
     const int grid_index = face.start() + corner;
-    uchar *grid = (uchar *)subdiv_ccg.grids[grid_index];
+    const int grid_start = grid_index * grid_area;
     for (int y = 0; y < grid_size; y++) {
       const float grid_v = y * grid_size_1_inv;
       for (int x = 0; x < grid_size; x++) {
         const float grid_u = x * grid_size_1_inv;
         float u, v;
         rotate_grid_to_quad(corner, grid_u, grid_v, &u, &v);
-        const size_t grid_element_index = size_t(y) * grid_size + x;
-        const size_t grid_element_offset = grid_element_index * element_size;
+        const int element = grid_start + CCG_grid_xy_to_index(grid_size, x, y);
         subdiv_ccg_eval_grid_element(
-            subdiv, subdiv_ccg, mask_evaluator, ptex_face_index, u, v, &grid[grid_element_offset]);
+            subdiv, subdiv_ccg, mask_evaluator, ptex_face_index, u, v, element);
       }
     }
   }
@@ -243,21 +192,20 @@ static void subdiv_ccg_eval_special_grid(Subdiv &subdiv,
                                          const int face_index)
 {
   const int grid_size = subdiv_ccg.grid_size;
+  const int grid_area = grid_size * grid_size;
   const float grid_size_1_inv = 1.0f / (grid_size - 1);
-  const int element_size = element_size_bytes_get(subdiv_ccg);
   const IndexRange face = subdiv_ccg.faces[face_index];
   for (int corner = 0; corner < face.size(); corner++) {
     const int grid_index = face.start() + corner;
     const int ptex_face_index = face_ptex_offset[face_index] + corner;
-    uchar *grid = (uchar *)subdiv_ccg.grids[grid_index];
+    const int grid_start = grid_index * grid_area;
     for (int y = 0; y < grid_size; y++) {
       const float u = 1.0f - (y * grid_size_1_inv);
       for (int x = 0; x < grid_size; x++) {
         const float v = 1.0f - (x * grid_size_1_inv);
-        const size_t grid_element_index = size_t(y) * grid_size + x;
-        const size_t grid_element_offset = grid_element_index * element_size;
+        const int element = grid_start + CCG_grid_xy_to_index(grid_size, x, y);
         subdiv_ccg_eval_grid_element(
-            subdiv, subdiv_ccg, mask_evaluator, ptex_face_index, u, v, &grid[grid_element_offset]);
+            subdiv, subdiv_ccg, mask_evaluator, ptex_face_index, u, v, element);
       }
     }
   }
@@ -305,13 +253,6 @@ static SubdivCCGCoord subdiv_ccg_coord(int grid_index, int x, int y)
   return coord;
 }
 
-static CCGElem *subdiv_ccg_coord_to_elem(const CCGKey &key,
-                                         const SubdivCCG &subdiv_ccg,
-                                         const SubdivCCGCoord &coord)
-{
-  return CCG_grid_elem(&key, subdiv_ccg.grids[coord.grid_index], coord.x, coord.y);
-}
-
 /* Returns storage where boundary elements are to be stored. */
 static SubdivCCGCoord *subdiv_ccg_adjacent_edge_add_face(SubdivCCG &subdiv_ccg,
                                                          SubdivCCGAdjacentEdge &adjacent_edge)
@@ -539,13 +480,14 @@ CCGKey BKE_subdiv_ccg_key(const SubdivCCG &subdiv_ccg, int level)
 #ifdef WITH_OPENSUBDIV
   CCGKey key;
   key.level = level;
-  key.elem_size = element_size_bytes_get(subdiv_ccg);
   key.grid_size = grid_size_from_level(level);
   key.grid_area = key.grid_size * key.grid_size;
-  key.grid_bytes = key.elem_size * key.grid_area;
 
-  key.normal_offset = subdiv_ccg.normal_offset;
-  key.mask_offset = subdiv_ccg.mask_offset;
+  /* The layers are stored in separate arrays, so there are no interleaved elements. */
+  key.elem_size = -1;
+  key.grid_bytes = -1;
+  key.normal_offset = -1;
+  key.mask_offset = -1;
 
   key.has_normals = subdiv_ccg.has_normal;
   key.has_mask = subdiv_ccg.has_mask;
@@ -581,62 +523,55 @@ static void subdiv_ccg_recalc_inner_face_normals(const SubdivCCG &subdiv_ccg,
 {
   const int grid_size = subdiv_ccg.grid_size;
   const int grid_size_1 = grid_size - 1;
-  CCGElem *grid = subdiv_ccg.grids[corner];
+  const Span<float3> positions = subdiv_ccg.positions.as_span().slice(
+      CCG_grid_range(key, corner));
   for (int y = 0; y < grid_size - 1; y++) {
     for (int x = 0; x < grid_size - 1; x++) {
-      CCGElem *grid_elements[4] = {
-          CCG_grid_elem(&key, grid, x, y + 1),
-          CCG_grid_elem(&key, grid, x + 1, y + 1),
-          CCG_grid_elem(&key, grid, x + 1, y),
-          CCG_grid_elem(&key, grid, x, y),
-      };
-      float *co[4] = {
-          CCG_elem_co(&key, grid_elements[0]),
-          CCG_elem_co(&key, grid_elements[1]),
-          CCG_elem_co(&key, grid_elements[2]),
-          CCG_elem_co(&key, grid_elements[3]),
-      };
       const int face_index = y * grid_size_1 + x;
-      float *face_normal = face_normals[face_index];
-      normal_quad_v3(face_normal, co[0], co[1], co[2], co[3]);
+      normal_quad_v3(face_normals[face_index],
+                     positions[CCG_grid_xy_to_index(grid_size, x, y + 1)],
+                     positions[CCG_grid_xy_to_index(grid_size, x + 1, y + 1)],
+                     positions[CCG_grid_xy_to_index(grid_size, x + 1, y)],
+                     positions[CCG_grid_xy_to_index(grid_size, x, y)]);
     }
   }
 }
 
 /* Average normals at every grid element, using adjacent faces normals. */
-static void subdiv_ccg_average_inner_face_normals(const SubdivCCG &subdiv_ccg,
+static void subdiv_ccg_average_inner_face_normals(SubdivCCG &subdiv_ccg,
                                                   const CCGKey &key,
                                                   const Span<float3> face_normals,
                                                   const int corner)
 {
   const int grid_size = subdiv_ccg.grid_size;
   const int grid_size_1 = grid_size - 1;
-  CCGElem *grid = subdiv_ccg.grids[corner];
+  MutableSpan<float3> normals = subdiv_ccg.normals.as_mutable_span().slice(
+      CCG_grid_range(key, corner));
   for (int y = 0; y < grid_size; y++) {
     for (int x = 0; x < grid_size; x++) {
-      float normal_acc[3] = {0.0f, 0.0f, 0.0f};
+      float3 normal_acc(0.0f);
       int counter = 0;
       /* Accumulate normals of all adjacent faces. */
       if (x < grid_size_1 && y < grid_size_1) {
-        add_v3_v3(normal_acc, face_normals[y * grid_size_1 + x]);
+        normal_acc += face_normals[y * grid_size_1 + x];
         counter++;
       }
       if (x >= 1) {
         if (y < grid_size_1) {
-          add_v3_v3(normal_acc, face_normals[y * grid_size_1 + (x - 1)]);
+          normal_acc += face_normals[y * grid_size_1 + (x - 1)];
           counter++;
         }
         if (y >= 1) {
-          add_v3_v3(normal_acc, face_normals[(y - 1) * grid_size_1 + (x - 1)]);
+          normal_acc += face_normals[(y - 1) * grid_size_1 + (x - 1)];
           counter++;
         }
       }
       if (y >= 1 && x < grid_size_1) {
-        add_v3_v3(normal_acc, face_normals[(y - 1) * grid_size_1 + x]);
+        normal_acc += face_normals[(y - 1) * grid_size_1 + x];
         counter++;
       }
       /* Normalize and store. */
-      mul_v3_v3fl(CCG_grid_elem_no(&key, grid, x, y), normal_acc, 1.0f / counter);
+      normals[CCG_grid_xy_to_index(grid_size, x, y)] = normal_acc / float(counter);
     }
   }
 }
@@ -709,78 +644,74 @@ void BKE_subdiv_ccg_update_normals(SubdivCCG &subdiv_ccg, const IndexMask &face_
 
 #ifdef WITH_OPENSUBDIV
 
-static void average_grid_element_value_v3(float a[3], float b[3])
+static void average_grid_element_value_v3(float3 &a, float3 &b)
 {
-  add_v3_v3(a, b);
-  mul_v3_fl(a, 0.5f);
-  copy_v3_v3(b, a);
+  a = (a + b) * 0.5f;
+  b = a;
 }
 
-static void average_grid_element(const SubdivCCG &subdiv_ccg,
-                                 const CCGKey &key,
-                                 CCGElem *grid_element_a,
-                                 CCGElem *grid_element_b)
+static void average_grid_element(SubdivCCG &subdiv_ccg,
+                                 const int grid_element_a,
+                                 const int grid_element_b)
 {
-  average_grid_element_value_v3(CCG_elem_co(&key, grid_element_a),
-                                CCG_elem_co(&key, grid_element_b));
+  average_grid_element_value_v3(subdiv_ccg.positions[grid_element_a],
+                                subdiv_ccg.positions[grid_element_b]);
   if (subdiv_ccg.has_normal) {
-    average_grid_element_value_v3(CCG_elem_no(&key, grid_element_a),
-                                  CCG_elem_no(&key, grid_element_b));
+    average_grid_element_value_v3(subdiv_ccg.normals[grid_element_a],
+                                  subdiv_ccg.normals[grid_element_b]);
   }
   if (subdiv_ccg.has_mask) {
-    float mask = (*CCG_elem_mask(&key, grid_element_a) + *CCG_elem_mask(&key, grid_element_b)) *
-                 0.5f;
-    *CCG_elem_mask(&key, grid_element_a) = mask;
-    *CCG_elem_mask(&key, grid_element_b) = mask;
+    const float mask = (subdiv_ccg.masks[grid_element_a] + subdiv_ccg.masks[grid_element_b]) *
+                       0.5f;
+    subdiv_ccg.masks[grid_element_a] = mask;
+    subdiv_ccg.masks[grid_element_b] = mask;
   }
 }
 
 /* Accumulator to hold data during averaging. */
 struct GridElementAccumulator {
-  float co[3];
-  float no[3];
+  float3 co;
+  float3 no;
   float mask;
 };
 
 static void element_accumulator_init(GridElementAccumulator &accumulator)
 {
-  zero_v3(accumulator.co);
-  zero_v3(accumulator.no);
+  accumulator.co = float3(0.0f);
+  accumulator.no = float3(0.0f);
   accumulator.mask = 0.0f;
 }
 
 static void element_accumulator_add(GridElementAccumulator &accumulator,
                                     const SubdivCCG &subdiv_ccg,
-                                    const CCGKey &key,
-                                    /*const*/ CCGElem &grid_element)
+                                    const int grid_element)
 {
-  add_v3_v3(accumulator.co, CCG_elem_co(&key, &grid_element));
+  accumulator.co += subdiv_ccg.positions[grid_element];
   if (subdiv_ccg.has_normal) {
-    add_v3_v3(accumulator.no, CCG_elem_no(&key, &grid_element));
+    accumulator.no += subdiv_ccg.normals[grid_element];
   }
   if (subdiv_ccg.has_mask) {
-    accumulator.mask += *CCG_elem_mask(&key, &grid_element);
+    accumulator.mask += subdiv_ccg.masks[grid_element];
   }
 }
 
 static void element_accumulator_mul_fl(GridElementAccumulator &accumulator, const float f)
 {
-  mul_v3_fl(accumulator.co, f);
-  mul_v3_fl(accumulator.no, f);
+  accumulator.co *= f;
+  accumulator.no *= f;
   accumulator.mask *= f;
 }
 
-static void element_accumulator_copy(const SubdivCCG &subdiv_ccg,
-                                     const CCGKey &key,
-                                     CCGElem &destination,
+static void element_accumulator_copy(SubdivCCG &subdiv_ccg,
+                                     const int destination,
                                      const GridElementAccumulator &accumulator)
 {
-  copy_v3_v3(CCG_elem_co(&key, &destination), accumulator.co);
+  subdiv_ccg.positions[destination] = accumulator.co;
   if (subdiv_ccg.has_normal) {
-    copy_v3_v3(CCG_elem_no(&key, &destination), accumulator.no);
+    subdiv_ccg.normals[destination] = accumulator.no;
   }
   if (subdiv_ccg.has_mask) {
-    *CCG_elem_mask(&key, &destination) = accumulator.mask;
+    subdiv_ccg.masks[destination] = accumulator.mask;
   }
 }
 
@@ -788,17 +719,16 @@ static void subdiv_ccg_average_inner_face_grids(SubdivCCG &subdiv_ccg,
                                                 const CCGKey &key,
                                                 const IndexRange face)
 {
-  const Span<CCGElem *> grids = subdiv_ccg.grids;
   const int num_face_grids = face.size();
   const int grid_size = subdiv_ccg.grid_size;
-  CCGElem *prev_grid = grids[face.start() + num_face_grids - 1];
+  IndexRange prev_grid = CCG_grid_range(key, face.start() + num_face_grids - 1);
   /* Average boundary between neighbor grid. */
   for (int corner = 0; corner < num_face_grids; corner++) {
-    CCGElem *grid = grids[face.start() + corner];
+    const IndexRange grid = CCG_grid_range(key, face.start() + corner);
     for (int i = 1; i < grid_size; i++) {
-      CCGElem *prev_grid_element = CCG_grid_elem(&key, prev_grid, i, 0);
-      CCGElem *grid_element = CCG_grid_elem(&key, grid, 0, i);
-      average_grid_element(subdiv_ccg, key, prev_grid_element, grid_element);
+      const int prev_grid_element = prev_grid[CCG_grid_xy_to_index(grid_size, i, 0)];
+      const int grid_element = grid[CCG_grid_xy_to_index(grid_size, 0, i)];
+      average_grid_element(subdiv_ccg, prev_grid_element, grid_element);
     }
     prev_grid = grid;
   }
@@ -807,15 +737,13 @@ static void subdiv_ccg_average_inner_face_grids(SubdivCCG &subdiv_ccg,
   GridElementAccumulator center_accumulator;
   element_accumulator_init(center_accumulator);
   for (int corner = 0; corner < num_face_grids; corner++) {
-    CCGElem *grid = grids[face.start() + corner];
-    CCGElem *grid_center_element = CCG_grid_elem(&key, grid, 0, 0);
-    element_accumulator_add(center_accumulator, subdiv_ccg, key, *grid_center_element);
+    const int grid_center_element = CCG_grid_range(key, face.start() + corner).first();
+    element_accumulator_add(center_accumulator, subdiv_ccg, grid_center_element);
   }
   element_accumulator_mul_fl(center_accumulator, 1.0f / num_face_grids);
   for (int corner = 0; corner < num_face_grids; corner++) {
-    CCGElem *grid = grids[face.start() + corner];
-    CCGElem *grid_center_element = CCG_grid_elem(&key, grid, 0, 0);
-    element_accumulator_copy(subdiv_ccg, key, *grid_center_element, center_accumulator);
+    const int grid_center_element = CCG_grid_range(key, face.start() + corner).first();
+    element_accumulator_copy(subdiv_ccg, grid_center_element, center_accumulator);
   }
 }
 
@@ -835,9 +763,8 @@ static void subdiv_ccg_average_grids_boundary(SubdivCCG &subdiv_ccg,
   }
   for (int face_index = 0; face_index < num_adjacent_faces; face_index++) {
     for (int i = 1; i < grid_size2 - 1; i++) {
-      CCGElem *grid_element = subdiv_ccg_coord_to_elem(
-          key, subdiv_ccg, adjacent_edge.boundary_coords[face_index][i]);
-      element_accumulator_add(accumulators[i], subdiv_ccg, key, *grid_element);
+      const int grid_element = CCG_elem_index(key, adjacent_edge.boundary_coords[face_index][i]);
+      element_accumulator_add(accumulators[i], subdiv_ccg, grid_element);
     }
   }
   for (int i = 1; i < grid_size2 - 1; i++) {
@@ -846,9 +773,8 @@ static void subdiv_ccg_average_grids_boundary(SubdivCCG &subdiv_ccg,
   /* Copy averaged value to all the other faces. */
   for (int face_index = 0; face_index < num_adjacent_faces; face_index++) {
     for (int i = 1; i < grid_size2 - 1; i++) {
-      CCGElem *grid_element = subdiv_ccg_coord_to_elem(
-          key, subdiv_ccg, adjacent_edge.boundary_coords[face_index][i]);
-      element_accumulator_copy(subdiv_ccg, key, *grid_element, accumulators[i]);
+      const int grid_element = CCG_elem_index(key, adjacent_edge.boundary_coords[face_index][i]);
+      element_accumulator_copy(subdiv_ccg, grid_element, accumulators[i]);
     }
   }
 }
@@ -873,16 +799,14 @@ static void subdiv_ccg_average_grids_corners(SubdivCCG &subdiv_ccg,
   GridElementAccumulator accumulator;
   element_accumulator_init(accumulator);
   for (int face_index = 0; face_index < num_adjacent_faces; face_index++) {
-    CCGElem *grid_element = subdiv_ccg_coord_to_elem(
-        key, subdiv_ccg, adjacent_vertex.corner_coords[face_index]);
-    element_accumulator_add(accumulator, subdiv_ccg, key, *grid_element);
+    const int grid_element = CCG_elem_index(key, adjacent_vertex.corner_coords[face_index]);
+    element_accumulator_add(accumulator, subdiv_ccg, grid_element);
   }
   element_accumulator_mul_fl(accumulator, 1.0f / num_adjacent_faces);
   /* Copy averaged value to all the other faces. */
   for (int face_index = 0; face_index < num_adjacent_faces; face_index++) {
-    CCGElem *grid_element = subdiv_ccg_coord_to_elem(
-        key, subdiv_ccg, adjacent_vertex.corner_coords[face_index]);
-    element_accumulator_copy(subdiv_ccg, key, *grid_element, accumulator);
+    const int grid_element = CCG_elem_index(key, adjacent_vertex.corner_coords[face_index]);
+    element_accumulator_copy(subdiv_ccg, grid_element, accumulator);
   }
 }
 
@@ -1003,7 +927,7 @@ void BKE_subdiv_ccg_topology_counters(const SubdivCCG &subdiv_ccg,
                                       int &r_num_faces,
                                       int &r_num_loops)
 {
-  const int num_grids = subdiv_ccg.grids.size();
+  const int num_grids = subdiv_ccg.grids_num;
   const int grid_size = subdiv_ccg.grid_size;
   const int grid_area = grid_size * grid_size;
   const int num_edges_per_grid = 2 * (grid_size * (grid_size - 1));
@@ -1026,7 +950,7 @@ void BKE_subdiv_ccg_print_coord(const char *message, const SubdivCCGCoord &coord
 
 bool BKE_subdiv_ccg_check_coord_valid(const SubdivCCG &subdiv_ccg, const SubdivCCGCoord &coord)
 {
-  if (coord.grid_index < 0 || coord.grid_index >= subdiv_ccg.grids.size()) {
+  if (coord.grid_index < 0 || coord.grid_index >= subdiv_ccg.grids_num) {
     return false;
   }
   const int grid_size = subdiv_ccg.grid_size;
@@ -1540,7 +1464,7 @@ void BKE_subdiv_ccg_neighbor_coords_get(const SubdivCCG &subdiv_ccg,
 {
 #ifdef WITH_OPENSUBDIV
   BLI_assert(coord.grid_index >= 0);
-  BLI_assert(coord.grid_index < subdiv_ccg.grids.size());
+  BLI_assert(coord.grid_index < subdiv_ccg.grids_num);
   BLI_assert(coord.x >= 0);
   BLI_assert(coord.x < subdiv_ccg.grid_size);
   BLI_assert(coord.y >= 0);
@@ -1660,7 +1584,7 @@ blender::BitGroupVector<> &BKE_subdiv_ccg_grid_hidden_ensure(SubdivCCG &subdiv_c
 {
   if (subdiv_ccg.grid_hidden.is_empty()) {
     const int grid_area = subdiv_ccg.grid_size * subdiv_ccg.grid_size;
-    subdiv_ccg.grid_hidden = blender::BitGroupVector<>(subdiv_ccg.grids.size(), grid_area, false);
+    subdiv_ccg.grid_hidden = blender::BitGroupVector<>(subdiv_ccg.grids_num, grid_area, false);
   }
   return subdiv_ccg.grid_hidden;
 }
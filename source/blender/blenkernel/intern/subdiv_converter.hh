@@ -25,6 +25,10 @@ void converter_init_for_mesh(OpenSubdiv_Converter *converter,
                              const Settings *settings,
                              const Mesh *mesh);
 
+/* Hash of all mesh data that is used by the converter created by #converter_init_for_mesh.
+ * Meshes with the same hash create the same topology refiner. Never returns zero. */
+uint64_t converter_mesh_topology_hash(const Settings *settings, const Mesh *mesh);
+
 /* NOTE: Frees converter data, but not converter itself. This means, that if
  * converter was allocated on heap, it is up to the user to free that memory. */
 void converter_free(OpenSubdiv_Converter *converter);
@@ -10,7 +10,14 @@
 
 #include <cstring>
 
+#include <xxhash.h>
+
+#include "BLI_array.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_math_base.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_customdata.hh"
@@ -310,39 +317,30 @@ static void initialize_manifold_index_array(const BitSpan not_used_map,
                                             int **r_indices_reverse,
                                             int *r_num_manifold_elements)
 {
-  int *indices = nullptr;
+  IndexMaskMemory memory;
+  const IndexMask manifold_elements = not_used_map.is_empty() ?
+                                          IndexMask(num_elements) :
+                                          IndexMask::from_bits(not_used_map, memory)
+                                              .complement(IndexRange(num_elements), memory);
   if (r_indices != nullptr) {
-    indices = static_cast<int *>(MEM_malloc_arrayN(num_elements, sizeof(int), "manifold indices"));
-  }
-  int *indices_reverse = nullptr;
-  if (r_indices_reverse != nullptr) {
-    indices_reverse = static_cast<int *>(
-        MEM_malloc_arrayN(num_elements, sizeof(int), "manifold indices reverse"));
-  }
-  int offset = 0;
-  for (int i = 0; i < num_elements; i++) {
-    if (not_used_map.is_empty() || !not_used_map[i]) {
-      if (indices != nullptr) {
-        indices[i] = i - offset;
-      }
-      if (indices_reverse != nullptr) {
-        indices_reverse[i - offset] = i;
-      }
+    int *indices = static_cast<int *>(
+        MEM_malloc_arrayN(num_elements, sizeof(int), "manifold indices"));
+    MutableSpan<int> indices_span(indices, num_elements);
+    if (manifold_elements.size() != num_elements) {
+      threading::parallel_for(indices_span.index_range(), 4096, [&](const IndexRange range) {
+        indices_span.slice(range).fill(-1);
+      });
     }
-    else {
-      if (indices != nullptr) {
-        indices[i] = -1;
-      }
-      offset++;
-    }
-  }
-  if (r_indices != nullptr) {
+    index_mask::build_reverse_map<int>(manifold_elements, indices_span);
     *r_indices = indices;
   }
   if (r_indices_reverse != nullptr) {
+    int *indices_reverse = static_cast<int *>(
+        MEM_malloc_arrayN(num_elements, sizeof(int), "manifold indices reverse"));
+    manifold_elements.to_indices(MutableSpan<int>(indices_reverse, manifold_elements.size()));
     *r_indices_reverse = indices_reverse;
   }
-  *r_num_manifold_elements = num_elements - offset;
+  *r_num_manifold_elements = int(manifold_elements.size());
 }
 
 static void initialize_manifold_indices(ConverterStorage *storage)
@@ -350,27 +348,33 @@ static void initialize_manifold_indices(ConverterStorage *storage)
   const Mesh *mesh = storage->mesh;
   const bke::LooseVertCache &loose_verts = mesh->verts_no_face();
   const bke::LooseEdgeCache &loose_edges = mesh->loose_edges();
-  initialize_manifold_index_array(loose_verts.is_loose_bits,
-                                  mesh->verts_num,
-                                  &storage->manifold_vertex_index,
-                                  &storage->manifold_vertex_index_reverse,
-                                  &storage->num_manifold_vertices);
-  initialize_manifold_index_array(loose_edges.is_loose_bits,
-                                  mesh->edges_num,
-                                  nullptr,
-                                  &storage->manifold_edge_index_reverse,
-                                  &storage->num_manifold_edges);
+  /* The index arrays are independent, so they are built in parallel. */
+  threading::parallel_invoke(
+      mesh->verts_num + mesh->edges_num > 4096,
+      [&]() {
+        initialize_manifold_index_array(loose_verts.is_loose_bits,
+                                        mesh->verts_num,
+                                        &storage->manifold_vertex_index,
+                                        &storage->manifold_vertex_index_reverse,
+                                        &storage->num_manifold_vertices);
+      },
+      [&]() {
+        initialize_manifold_index_array(loose_edges.is_loose_bits,
+                                        mesh->edges_num,
+                                        nullptr,
+                                        &storage->manifold_edge_index_reverse,
+                                        &storage->num_manifold_edges);
+      });
   /* Initialize infinite sharp mapping. */
   if (loose_edges.count > 0) {
     const Span<int2> edges = storage->edges;
     storage->infinite_sharp_vertices_map.resize(mesh->verts_num, false);
-    for (int edge_index = 0; edge_index < mesh->edges_num; edge_index++) {
-      if (loose_edges.is_loose_bits[edge_index]) {
-        const int2 edge = edges[edge_index];
-        storage->infinite_sharp_vertices_map[edge[0]].set();
-        storage->infinite_sharp_vertices_map[edge[1]].set();
-      }
-    }
+    IndexMaskMemory memory;
+    IndexMask::from_bits(loose_edges.is_loose_bits, memory).foreach_index([&](const int i) {
+      const int2 edge = edges[i];
+      storage->infinite_sharp_vertices_map[edge[0]].set();
+      storage->infinite_sharp_vertices_map[edge[1]].set();
+    });
   }
 }
 
@@ -396,6 +400,57 @@ static void init_user_data(OpenSubdiv_Converter *converter,
   converter->user_data = user_data;
 }
 
+/* Hash large arrays in chunks, so that they can be hashed in parallel. */
+static uint64_t hash_data(const void *data, const int64_t size)
+{
+  const int64_t chunk_size = 1 << 16;
+  const int64_t chunks_num = int64_t(divide_ceil_ul(uint64_t(size), chunk_size));
+  if (chunks_num <= 1) {
+    return XXH3_64bits(data, size_t(size));
+  }
+  Array<uint64_t> chunk_hashes(chunks_num);
+  threading::parallel_for(chunk_hashes.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      const IndexRange chunk_range = IndexRange(chunk * chunk_size, chunk_size)
+                                         .intersect(IndexRange(size));
+      chunk_hashes[chunk] = XXH3_64bits(static_cast<const char *>(data) + chunk_range.start(),
+                                        size_t(chunk_range.size()));
+    }
+  });
+  return XXH3_64bits(chunk_hashes.data(), size_t(chunk_hashes.as_span().size_in_bytes()));
+}
+
+template<typename T> static uint64_t hash_span(const Span<T> span)
+{
+  return hash_data(span.data(), span.size_in_bytes());
+}
+
+uint64_t converter_mesh_topology_hash(const Settings *settings, const Mesh *mesh)
+{
+  Vector<uint64_t, 16> hashes;
+  hashes.append(uint64_t(mesh->verts_num));
+  hashes.append(hash_span(mesh->edges()));
+  hashes.append(hash_span(mesh->face_offsets()));
+  hashes.append(hash_span(mesh->corner_verts()));
+  hashes.append(hash_span(mesh->corner_edges()));
+  if (settings->use_creases) {
+    const AttributeAccessor attributes = mesh->attributes();
+    const VArraySpan vert_creases = *attributes.lookup<float>("crease_vert", AttrDomain::Point);
+    const VArraySpan edge_creases = *attributes.lookup<float>("crease_edge", AttrDomain::Edge);
+    hashes.append(vert_creases.is_empty() ? 0 : hash_span<float>(vert_creases));
+    hashes.append(edge_creases.is_empty() ? 0 : hash_span<float>(edge_creases));
+  }
+  for (const int i : IndexRange(CustomData_number_of_layers(&mesh->corner_data, CD_PROP_FLOAT2)))
+  {
+    const float2 *uv_map = static_cast<const float2 *>(
+        CustomData_get_layer_n(&mesh->corner_data, CD_PROP_FLOAT2, i));
+    hashes.append(hash_span(Span(uv_map, mesh->corners_num)));
+  }
+  const uint64_t hash = XXH3_64bits(hashes.data(), size_t(hashes.as_span().size_in_bytes()));
+  /* Zero is used for an unknown topology. */
+  return hash == 0 ? 1 : hash;
+}
+
 void converter_init_for_mesh(OpenSubdiv_Converter *converter,
                              const Settings *settings,
                              const Mesh *mesh)
@@ -11,7 +11,10 @@
 #include "atomic_ops.h"
 
 #include "BLI_bitmap.h"
+#include "BLI_array.hh"
+#include "BLI_math_base.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #include "BKE_customdata.hh"
 #include "BKE_mesh.hh"
@@ -145,47 +148,62 @@ static void subdiv_foreach_tls_free(ForeachTaskContext *ctx, void *tls)
  * \{ */
 
 /* NOTE: Expects edge map to be zeroed. */
-static void subdiv_foreach_ctx_count(ForeachTaskContext *ctx)
+/* Number of vertices, edges and faces which are created inside of a coarse face. This does not
+ * include geometry created for coarse vertices and edges. */
+struct FaceSubdivCounts {
+  int vertices;
+  int edges;
+  int faces;
+};
+
+static FaceSubdivCounts face_subdiv_counts_get(const ForeachTaskContext *ctx,
+                                               const IndexRange coarse_face)
 {
-  /* Reset counters. */
-  ctx->num_subdiv_vertices = 0;
-  ctx->num_subdiv_edges = 0;
-  ctx->num_subdiv_loops = 0;
-  ctx->num_subdiv_faces = 0;
-  /* Static geometry counters. */
   const int resolution = ctx->settings->resolution;
   const int no_quad_patch_resolution = ((resolution >> 1) + 1);
   const int num_subdiv_vertices_per_coarse_edge = resolution - 2;
-  const int num_inner_vertices_per_quad = (resolution - 2) * (resolution - 2);
-  const int num_inner_vertices_per_noquad_patch = (no_quad_patch_resolution - 2) *
-                                                  (no_quad_patch_resolution - 2);
+  const int num_ptex_faces_per_face = num_ptex_faces_per_face_get(coarse_face);
+  FaceSubdivCounts counts;
+  if (num_ptex_faces_per_face == 1) {
+    counts.vertices = (resolution - 2) * (resolution - 2);
+    counts.edges = num_edges_per_ptex_face_get(resolution - 2) +
+                   4 * num_subdiv_vertices_per_coarse_edge;
+    counts.faces = num_faces_per_ptex_get(resolution);
+  }
+  else {
+    const int num_irregular_vertices_per_patch = (no_quad_patch_resolution - 2) *
+                                                 (no_quad_patch_resolution - 1);
+    counts.vertices = 1 + num_ptex_faces_per_face * num_irregular_vertices_per_patch;
+    counts.edges = num_ptex_faces_per_face *
+                   (num_inner_edges_per_ptex_face_get(no_quad_patch_resolution - 1) +
+                    (no_quad_patch_resolution - 2) + num_subdiv_vertices_per_coarse_edge);
+    if (no_quad_patch_resolution >= 3) {
+      counts.edges += coarse_face.size();
+    }
+    counts.faces = num_ptex_faces_per_face * num_faces_per_ptex_get(no_quad_patch_resolution);
+  }
+  return counts;
+}
+
+/* NOTE: Expects the per-face offsets to be initialized already. */
+static void subdiv_foreach_ctx_count(ForeachTaskContext *ctx)
+{
+  const int resolution = ctx->settings->resolution;
+  const int num_subdiv_vertices_per_coarse_edge = resolution - 2;
   const Mesh *coarse_mesh = ctx->coarse_mesh;
   ctx->num_subdiv_vertices = coarse_mesh->verts_num;
   ctx->num_subdiv_edges = coarse_mesh->edges_num * (num_subdiv_vertices_per_coarse_edge + 1);
-  /* Calculate extra vertices and edges created by non-loose geometry. */
-  for (int face_index = 0; face_index < coarse_mesh->faces_num; face_index++) {
-    const IndexRange coarse_face = ctx->coarse_faces[face_index];
-    const int num_ptex_faces_per_face = num_ptex_faces_per_face_get(coarse_face);
-    /* Inner vertices of face. */
-    if (num_ptex_faces_per_face == 1) {
-      ctx->num_subdiv_vertices += num_inner_vertices_per_quad;
-      ctx->num_subdiv_edges += num_edges_per_ptex_face_get(resolution - 2) +
-                               4 * num_subdiv_vertices_per_coarse_edge;
-      ctx->num_subdiv_faces += num_faces_per_ptex_get(resolution);
-    }
-    else {
-      ctx->num_subdiv_vertices += 1 + num_ptex_faces_per_face * (no_quad_patch_resolution - 2) +
-                                  num_ptex_faces_per_face * num_inner_vertices_per_noquad_patch;
-      ctx->num_subdiv_edges += num_ptex_faces_per_face *
-                               (num_inner_edges_per_ptex_face_get(no_quad_patch_resolution - 1) +
-                                (no_quad_patch_resolution - 2) +
-                                num_subdiv_vertices_per_coarse_edge);
-      if (no_quad_patch_resolution >= 3) {
-        ctx->num_subdiv_edges += coarse_face.size();
-      }
-      ctx->num_subdiv_faces += num_ptex_faces_per_face *
-                               num_faces_per_ptex_get(no_quad_patch_resolution);
-    }
+  ctx->num_subdiv_faces = 0;
+  /* Extra vertices and edges created by non-loose geometry are known from the offsets of the
+   * last face. */
+  if (coarse_mesh->faces_num > 0) {
+    const int last_face_index = coarse_mesh->faces_num - 1;
+    const FaceSubdivCounts last_face_counts = face_subdiv_counts_get(
+        ctx, ctx->coarse_faces[last_face_index]);
+    ctx->num_subdiv_vertices += ctx->subdiv_vertex_offset[last_face_index] +
+                                last_face_counts.vertices;
+    ctx->num_subdiv_edges += ctx->subdiv_edge_offset[last_face_index] + last_face_counts.edges;
+    ctx->num_subdiv_faces += ctx->subdiv_face_offset[last_face_index] + last_face_counts.faces;
   }
 
   /* Add vertices used by outer edges on subdivided faces and loose edges. */
@@ -198,11 +216,6 @@ static void subdiv_foreach_ctx_init_offsets(ForeachTaskContext *ctx)
 {
   const Mesh *coarse_mesh = ctx->coarse_mesh;
   const int resolution = ctx->settings->resolution;
-  const int resolution_2 = resolution - 2;
-  const int resolution_2_squared = resolution_2 * resolution_2;
-  const int no_quad_patch_resolution = ((resolution >> 1) + 1);
-  const int num_irregular_vertices_per_patch = (no_quad_patch_resolution - 2) *
-                                               (no_quad_patch_resolution - 1);
   const int num_subdiv_vertices_per_coarse_edge = resolution - 2;
   const int num_subdiv_edges_per_coarse_edge = resolution - 1;
   /* Constant offsets in arrays. */
@@ -213,33 +226,51 @@ static void subdiv_foreach_ctx_init_offsets(ForeachTaskContext *ctx)
   ctx->edge_boundary_offset = 0;
   ctx->edge_inner_offset = ctx->edge_boundary_offset +
                            coarse_mesh->edges_num * num_subdiv_edges_per_coarse_edge;
-  /* "Indexed" offsets. */
-  int vertex_offset = 0;
-  int edge_offset = 0;
-  int face_offset = 0;
-  for (int face_index = 0; face_index < coarse_mesh->faces_num; face_index++) {
-    const IndexRange coarse_face = ctx->coarse_faces[face_index];
-    const int num_ptex_faces_per_face = num_ptex_faces_per_face_get(coarse_face);
-    ctx->subdiv_vertex_offset[face_index] = vertex_offset;
-    ctx->subdiv_edge_offset[face_index] = edge_offset;
-    ctx->subdiv_face_offset[face_index] = face_offset;
-    if (num_ptex_faces_per_face == 1) {
-      vertex_offset += resolution_2_squared;
-      edge_offset += num_edges_per_ptex_face_get(resolution - 2) +
-                     4 * num_subdiv_vertices_per_coarse_edge;
-      face_offset += num_faces_per_ptex_get(resolution);
-    }
-    else {
-      vertex_offset += 1 + num_ptex_faces_per_face * num_irregular_vertices_per_patch;
-      edge_offset += num_ptex_faces_per_face *
-                     (num_inner_edges_per_ptex_face_get(no_quad_patch_resolution - 1) +
-                      (no_quad_patch_resolution - 2) + num_subdiv_vertices_per_coarse_edge);
-      if (no_quad_patch_resolution >= 3) {
-        edge_offset += coarse_face.size();
+  /* "Indexed" offsets, computed with a parallel prefix sum: first the geometry created by each
+   * chunk of faces is counted, then the offsets within the chunks are filled in. */
+  const int64_t chunk_size = 4096;
+  const int64_t chunks_num = int64_t(divide_ceil_ul(uint64_t(coarse_mesh->faces_num), chunk_size));
+  auto chunk_faces = [&](const int64_t chunk) {
+    return IndexRange(chunk * chunk_size, chunk_size)
+        .intersect(IndexRange(coarse_mesh->faces_num));
+  };
+  Array<FaceSubdivCounts> chunk_offsets(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      FaceSubdivCounts chunk_counts = {0, 0, 0};
+      for (const int face_index : chunk_faces(chunk)) {
+        const FaceSubdivCounts counts = face_subdiv_counts_get(ctx,
+                                                               ctx->coarse_faces[face_index]);
+        chunk_counts.vertices += counts.vertices;
+        chunk_counts.edges += counts.edges;
+        chunk_counts.faces += counts.faces;
       }
-      face_offset += num_ptex_faces_per_face * num_faces_per_ptex_get(no_quad_patch_resolution);
+      chunk_offsets[chunk] = chunk_counts;
     }
+  });
+  FaceSubdivCounts offset = {0, 0, 0};
+  for (FaceSubdivCounts &chunk_offset : chunk_offsets) {
+    const FaceSubdivCounts chunk_counts = chunk_offset;
+    chunk_offset = offset;
+    offset.vertices += chunk_counts.vertices;
+    offset.edges += chunk_counts.edges;
+    offset.faces += chunk_counts.faces;
   }
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      FaceSubdivCounts face_offset = chunk_offsets[chunk];
+      for (const int face_index : chunk_faces(chunk)) {
+        ctx->subdiv_vertex_offset[face_index] = face_offset.vertices;
+        ctx->subdiv_edge_offset[face_index] = face_offset.edges;
+        ctx->subdiv_face_offset[face_index] = face_offset.faces;
+        const FaceSubdivCounts counts = face_subdiv_counts_get(ctx,
+                                                               ctx->coarse_faces[face_index]);
+        face_offset.vertices += counts.vertices;
+        face_offset.edges += counts.edges;
+        face_offset.faces += counts.faces;
+      }
+    }
+  });
 }
 
 static void subdiv_foreach_ctx_init(Subdiv *subdiv, ForeachTaskContext *ctx)
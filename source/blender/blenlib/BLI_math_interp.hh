@@ -20,6 +20,7 @@
 #include "BLI_math_base.h"
 #include "BLI_math_base.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 namespace blender::math {
 
@@ -299,6 +300,88 @@ void interpolate_cubic_bspline_fl(
 void interpolate_cubic_mitchell_fl(
     const float *buffer, float *output, int width, int height, int components, float u, float v);
 
+/**
+ * Batched sampling.
+ *
+ * Sample a 4 channel image at each of the `uvs` coordinates and write the results into `dst`,
+ * which must be the same size as `uvs`. Texel indices and filter weights are computed for a block
+ * of samples at once, and texels are then fetched and blended with SIMD instructions where
+ * available. This is much faster than calling the single sample functions in a loop when
+ * sampling many coordinates, e.g. for a whole image scanline.
+ *
+ * Unlike the single sample functions, the way samples outside of the image are handled is
+ * specified separately for each axis with #InterpWrapMode.
+ */
+
+enum class InterpWrapMode {
+  /** Samples outside the image are clamped to texels at image edge. */
+  Extend,
+  /** Image is repeated, including proper wrapping of filter footprints crossing the edge. */
+  Repeat,
+  /** Samples outside the image are turned into transparent black. */
+  Border,
+};
+
+void interpolate_nearest_byte(const uchar *buffer,
+                              int width,
+                              int height,
+                              Span<float2> uvs,
+                              MutableSpan<uchar4> dst,
+                              InterpWrapMode wrap_u = InterpWrapMode::Extend,
+                              InterpWrapMode wrap_v = InterpWrapMode::Extend);
+void interpolate_nearest_fl(const float *buffer,
+                            int width,
+                            int height,
+                            Span<float2> uvs,
+                            MutableSpan<float4> dst,
+                            InterpWrapMode wrap_u = InterpWrapMode::Extend,
+                            InterpWrapMode wrap_v = InterpWrapMode::Extend);
+
+void interpolate_bilinear_byte(const uchar *buffer,
+                               int width,
+                               int height,
+                               Span<float2> uvs,
+                               MutableSpan<uchar4> dst,
+                               InterpWrapMode wrap_u = InterpWrapMode::Extend,
+                               InterpWrapMode wrap_v = InterpWrapMode::Extend);
+void interpolate_bilinear_fl(const float *buffer,
+                             int width,
+                             int height,
+                             Span<float2> uvs,
+                             MutableSpan<float4> dst,
+                             InterpWrapMode wrap_u = InterpWrapMode::Extend,
+                             InterpWrapMode wrap_v = InterpWrapMode::Extend);
+
+void interpolate_cubic_bspline_byte(const uchar *buffer,
+                                    int width,
+                                    int height,
+                                    Span<float2> uvs,
+                                    MutableSpan<uchar4> dst,
+                                    InterpWrapMode wrap_u = InterpWrapMode::Extend,
+                                    InterpWrapMode wrap_v = InterpWrapMode::Extend);
+void interpolate_cubic_bspline_fl(const float *buffer,
+                                  int width,
+                                  int height,
+                                  Span<float2> uvs,
+                                  MutableSpan<float4> dst,
+                                  InterpWrapMode wrap_u = InterpWrapMode::Extend,
+                                  InterpWrapMode wrap_v = InterpWrapMode::Extend);
+
+void interpolate_cubic_mitchell_byte(const uchar *buffer,
+                                     int width,
+                                     int height,
+                                     Span<float2> uvs,
+                                     MutableSpan<uchar4> dst,
+                                     InterpWrapMode wrap_u = InterpWrapMode::Extend,
+                                     InterpWrapMode wrap_v = InterpWrapMode::Extend);
+void interpolate_cubic_mitchell_fl(const float *buffer,
+                                   int width,
+                                   int height,
+                                   Span<float2> uvs,
+                                   MutableSpan<float4> dst,
+                                   InterpWrapMode wrap_u = InterpWrapMode::Extend,
+                                   InterpWrapMode wrap_v = InterpWrapMode::Extend);
+
 }  // namespace blender::math
 
 #define EWA_MAXIDX 255
@@ -0,0 +1,113 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A tracing profiler that records nested time zones per thread. Unlike #SCOPED_TIMER, zones are
+ * not printed but stored in a per-thread ring buffer, so they can be left in the code and only
+ * cost a relaxed atomic load when profiling is disabled. The recorded zones can be exported in
+ * the Chrome trace event format, which can be viewed in `chrome://tracing` or Perfetto.
+ *
+ * Example:
+ * \code{.cc}
+ * void evaluate(const ModifierData &md)
+ * {
+ *   PROFILE_SCOPE_DETAIL("modifier", md.name);
+ *   ...
+ * }
+ * \endcode
+ */
+
+#include <atomic>
+#include <iosfwd>
+
+#include "BLI_string_ref.hh"
+#include "BLI_timeit.hh"
+
+namespace blender::profile {
+
+namespace detail {
+extern std::atomic<bool> enabled;
+}
+
+/** True when zones are being recorded. */
+inline bool is_enabled()
+{
+  return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/** Start or stop recording zones. Zones that were recorded before are kept. */
+void set_enabled(bool enabled);
+
+/** Remove all recorded zones. */
+void clear();
+
+/**
+ * Record a zone. Only the pointer of \a name is stored, so it has to be a static string.
+ * The optional \a detail is copied and may be truncated. This is called by #ScopedZone, it's only
+ * useful when the start and end of a zone are not in the same scope.
+ */
+void record_zone(const char *name,
+                 const char *detail,
+                 timeit::TimePoint start,
+                 timeit::TimePoint end);
+
+/**
+ * Write all recorded zones in the Chrome trace event format.
+ * When a thread recorded more zones than fit into its ring buffer, only the most recent ones are
+ * written.
+ */
+void write_chrome_trace(std::ostream &stream);
+/** \return False when the file could not be written. */
+bool write_chrome_trace(StringRefNull filepath);
+
+class ScopedZone {
+ private:
+  /** Null when profiling was disabled when the zone started. */
+  const char *name_ = nullptr;
+  const char *detail_ = nullptr;
+  timeit::TimePoint start_;
+
+ public:
+  ScopedZone(const char *name, const char *detail = nullptr)
+  {
+    if (is_enabled()) {
+      name_ = name;
+      detail_ = detail;
+      start_ = timeit::Clock::now();
+    }
+  }
+
+  ~ScopedZone()
+  {
+    if (name_) {
+      record_zone(name_, detail_, start_, timeit::Clock::now());
+    }
+  }
+
+  ScopedZone(const ScopedZone &other) = delete;
+  ScopedZone &operator=(const ScopedZone &other) = delete;
+};
+
+}  // namespace blender::profile
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+/** Record the runtime of the current scope under the given static name. */
+#define PROFILE_SCOPE(name) \
+  blender::profile::ScopedZone PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+
+/**
+ * Same as #PROFILE_SCOPE, with an additional string that is shown with the zone (e.g. the name of
+ * a modifier). The detail string has to stay valid until the end of the scope.
+ */
+#define PROFILE_SCOPE_DETAIL(name, detail) \
+  blender::profile::ScopedZone PROFILE_CONCAT(profile_scope_, __LINE__)(name, detail)
+
+/** Record the runtime of the current function. */
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
@@ -13,6 +13,7 @@
 #include "BLI_math_base.hh"
 #include "BLI_math_interp.hh"
 #include "BLI_math_vector.h"
+#include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_simd.hh"
 
@@ -613,6 +614,296 @@ void interpolate_cubic_mitchell_fl(
       buffer, output, width, height, components, u, v);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Batched Sampling
+ *
+ * Samples are processed in blocks: first texel indices and filter weights are computed for all
+ * samples of a block in simple loops that the compiler can vectorize, then texels are fetched
+ * and blended. Weights along each axis are computed once per sample and shared by all the
+ * filter taps.
+ * \{ */
+
+/** Number of samples for which texel indices and weights are computed at once. */
+static constexpr int64_t interp_batch_size = 64;
+
+/**
+ * Texel indices and filter weights along one axis, for a filter with #Taps samples.
+ * In border mode samples outside of the image get zero weight and a valid index, so that
+ * blending does not have to special case them.
+ */
+template<int Taps> struct InterpAxisTaps {
+  int index[size_t(Taps)];
+  float weight[size_t(Taps)];
+};
+
+template<int Taps, eCubicFilter filter>
+BLI_INLINE void interp_axis_taps(const float coord,
+                                 const int size,
+                                 const InterpWrapMode mode,
+                                 InterpAxisTaps<Taps> &r_taps)
+{
+  const float coord_floor = floorf(coord);
+  const float frac = coord - coord_floor;
+  /* Cubic filters start one texel before `floor(coord)`. */
+  const int first = int(coord_floor) - (Taps == 4 ? 1 : 0);
+
+  if constexpr (Taps == 1) {
+    r_taps.weight[0] = 1.0f;
+  }
+  else if constexpr (Taps == 2) {
+    r_taps.weight[0] = 1.0f - frac;
+    r_taps.weight[1] = frac;
+  }
+  else {
+    const float4 w = cubic_filter_coefficients<filter>(frac);
+    r_taps.weight[0] = w[0];
+    r_taps.weight[1] = w[1];
+    r_taps.weight[2] = w[2];
+    r_taps.weight[3] = w[3];
+  }
+
+  for (int i = 0; i < Taps; i++) {
+    int index = first + i;
+    switch (mode) {
+      case InterpWrapMode::Extend:
+        index = math::clamp(index, 0, size - 1);
+        break;
+      case InterpWrapMode::Repeat:
+        index %= size;
+        if (index < 0) {
+          index += size;
+        }
+        break;
+      case InterpWrapMode::Border:
+        if (index < 0 || index >= size) {
+          r_taps.weight[i] = 0.0f;
+          index = math::clamp(index, 0, size - 1);
+        }
+        break;
+    }
+    r_taps.index[i] = index;
+  }
+}
+
+/** Blend `Taps * Taps` texels of a 4 channel float image. */
+template<int Taps>
+BLI_INLINE float4 interp_blend_fl(const float *buffer,
+                                  const int64_t width,
+                                  const InterpAxisTaps<Taps> &tx,
+                                  const InterpAxisTaps<Taps> &ty)
+{
+#if BLI_HAVE_SSE2
+  __m128 out = _mm_setzero_ps();
+  for (int n = 0; n < Taps; n++) {
+    const float *row = buffer + width * ty.index[n] * 4;
+    __m128 row_out = _mm_setzero_ps();
+    for (int m = 0; m < Taps; m++) {
+      const __m128 texel = _mm_loadu_ps(row + tx.index[m] * 4);
+      row_out = _mm_add_ps(row_out, _mm_mul_ps(texel, _mm_set1_ps(tx.weight[m])));
+    }
+    out = _mm_add_ps(out, _mm_mul_ps(row_out, _mm_set1_ps(ty.weight[n])));
+  }
+  float4 res;
+  _mm_storeu_ps(res, out);
+  return res;
+#else
+  float4 out(0.0f);
+  for (int n = 0; n < Taps; n++) {
+    const float *row = buffer + width * ty.index[n] * 4;
+    float4 row_out(0.0f);
+    for (int m = 0; m < Taps; m++) {
+      row_out += float4(row + tx.index[m] * 4) * tx.weight[m];
+    }
+    out += row_out * ty.weight[n];
+  }
+  return out;
+#endif
+}
+
+/** Blend `Taps * Taps` texels of a 4 channel byte image, with rounding to nearest. */
+template<int Taps>
+BLI_INLINE uchar4 interp_blend_byte(const uchar *buffer,
+                                    const int64_t width,
+                                    const InterpAxisTaps<Taps> &tx,
+                                    const InterpAxisTaps<Taps> &ty)
+{
+  uchar4 res;
+#if BLI_HAVE_SSE2
+  __m128 out = _mm_setzero_ps();
+  for (int n = 0; n < Taps; n++) {
+    const int *row = reinterpret_cast<const int *>(buffer) + width * ty.index[n];
+    __m128 row_out = _mm_setzero_ps();
+    for (int m = 0; m < Taps; m++) {
+      /* Load 4 bytes and expand into 4-lane SIMD. */
+      __m128i texel_i = _mm_cvtsi32_si128(row[tx.index[m]]);
+      texel_i = _mm_unpacklo_epi8(texel_i, _mm_setzero_si128());
+      texel_i = _mm_unpacklo_epi16(texel_i, _mm_setzero_si128());
+      row_out = _mm_add_ps(row_out,
+                           _mm_mul_ps(_mm_cvtepi32_ps(texel_i), _mm_set1_ps(tx.weight[m])));
+    }
+    out = _mm_add_ps(out, _mm_mul_ps(row_out, _mm_set1_ps(ty.weight[n])));
+  }
+  /* Pack to 16 bit signed, then to 8 bit unsigned. This clamps out of range values too. */
+  out = _mm_add_ps(out, _mm_set1_ps(0.5f));
+  __m128i rgba32 = _mm_cvttps_epi32(out);
+  __m128i rgba16 = _mm_packs_epi32(rgba32, _mm_setzero_si128());
+  __m128i rgba8 = _mm_packus_epi16(rgba16, _mm_setzero_si128());
+  _mm_store_ss((float *)&res, _mm_castsi128_ps(rgba8));
+#else
+  float4 out(0.0f);
+  for (int n = 0; n < Taps; n++) {
+    const uchar *row = buffer + width * ty.index[n] * 4;
+    float4 row_out(0.0f);
+    for (int m = 0; m < Taps; m++) {
+      const uchar *texel = row + tx.index[m] * 4;
+      row_out += float4(texel[0], texel[1], texel[2], texel[3]) * tx.weight[m];
+    }
+    out += row_out * ty.weight[n];
+  }
+  for (int i = 0; i < 4; i++) {
+    res[i] = uchar(math::clamp(out[i] + 0.5f, 0.0f, 255.0f));
+  }
+#endif
+  return res;
+}
+
+template<typename T, int Taps, eCubicFilter filter = eCubicFilter::BSpline>
+static void interpolate_batch(const T *buffer,
+                              const int width,
+                              const int height,
+                              const Span<float2> uvs,
+                              MutableSpan<VecBase<T, 4>> dst,
+                              const InterpWrapMode wrap_u,
+                              const InterpWrapMode wrap_v)
+{
+  BLI_assert(buffer);
+  BLI_assert(uvs.size() == dst.size());
+
+  InterpAxisTaps<Taps> taps_u[interp_batch_size];
+  InterpAxisTaps<Taps> taps_v[interp_batch_size];
+
+  for (int64_t block_start = 0; block_start < uvs.size(); block_start += interp_batch_size) {
+    const int64_t block_size = math::min(interp_batch_size, uvs.size() - block_start);
+    const float2 *block_uvs = uvs.data() + block_start;
+    VecBase<T, 4> *block_dst = dst.data() + block_start;
+
+    for (int64_t i = 0; i < block_size; i++) {
+      interp_axis_taps<Taps, filter>(block_uvs[i].x, width, wrap_u, taps_u[i]);
+    }
+    for (int64_t i = 0; i < block_size; i++) {
+      interp_axis_taps<Taps, filter>(block_uvs[i].y, height, wrap_v, taps_v[i]);
+    }
+
+    for (int64_t i = 0; i < block_size; i++) {
+      if constexpr (std::is_same_v<T, float>) {
+        float4 res = interp_blend_fl<Taps>(buffer, width, taps_u[i], taps_v[i]);
+        /* Mitchell filter has negative lobes; prevent output from going out of range. */
+        if constexpr (Taps == 4 && filter == eCubicFilter::Mitchell) {
+          res = math::max(res, float4(0.0f));
+        }
+        block_dst[i] = res;
+      }
+      else {
+        block_dst[i] = interp_blend_byte<Taps>(buffer, width, taps_u[i], taps_v[i]);
+      }
+    }
+  }
+}
+
+void interpolate_nearest_byte(const uchar *buffer,
+                              int width,
+                              int height,
+                              Span<float2> uvs,
+                              MutableSpan<uchar4> dst,
+                              InterpWrapMode wrap_u,
+                              InterpWrapMode wrap_v)
+{
+  interpolate_batch<uchar, 1>(buffer, width, height, uvs, dst, wrap_u, wrap_v);
+}
+
+void interpolate_nearest_fl(const float *buffer,
+                            int width,
+                            int height,
+                            Span<float2> uvs,
+                            MutableSpan<float4> dst,
+                            InterpWrapMode wrap_u,
+                            InterpWrapMode wrap_v)
+{
+  interpolate_batch<float, 1>(buffer, width, height, uvs, dst, wrap_u, wrap_v);
+}
+
+void interpolate_bilinear_byte(const uchar *buffer,
+                               int width,
+                               int height,
+                               Span<float2> uvs,
+                               MutableSpan<uchar4> dst,
+                               InterpWrapMode wrap_u,
+                               InterpWrapMode wrap_v)
+{
+  interpolate_batch<uchar, 2>(buffer, width, height, uvs, dst, wrap_u, wrap_v);
+}
+
+void interpolate_bilinear_fl(const float *buffer,
+                             int width,
+                             int height,
+                             Span<float2> uvs,
+                             MutableSpan<float4> dst,
+                             InterpWrapMode wrap_u,
+                             InterpWrapMode wrap_v)
+{
+  interpolate_batch<float, 2>(buffer, width, height, uvs, dst, wrap_u, wrap_v);
+}
+
+void interpolate_cubic_bspline_byte(const uchar *buffer,
+                                    int width,
+                                    int height,
+                                    Span<float2> uvs,
+                                    MutableSpan<uchar4> dst,
+                                    InterpWrapMode wrap_u,
+                                    InterpWrapMode wrap_v)
+{
+  interpolate_batch<uchar, 4, eCubicFilter::BSpline>(
+      buffer, width, height, uvs, dst, wrap_u, wrap_v);
+}
+
+void interpolate_cubic_bspline_fl(const float *buffer,
+                                  int width,
+                                  int height,
+                                  Span<float2> uvs,
+                                  MutableSpan<float4> dst,
+                                  InterpWrapMode wrap_u,
+                                  InterpWrapMode wrap_v)
+{
+  interpolate_batch<float, 4, eCubicFilter::BSpline>(
+      buffer, width, height, uvs, dst, wrap_u, wrap_v);
+}
+
+void interpolate_cubic_mitchell_byte(const uchar *buffer,
+                                     int width,
+                                     int height,
+                                     Span<float2> uvs,
+                                     MutableSpan<uchar4> dst,
+                                     InterpWrapMode wrap_u,
+                                     InterpWrapMode wrap_v)
+{
+  interpolate_batch<uchar, 4, eCubicFilter::Mitchell>(
+      buffer, width, height, uvs, dst, wrap_u, wrap_v);
+}
+
+void interpolate_cubic_mitchell_fl(const float *buffer,
+                                   int width,
+                                   int height,
+                                   Span<float2> uvs,
+                                   MutableSpan<float4> dst,
+                                   InterpWrapMode wrap_u,
+                                   InterpWrapMode wrap_v)
+{
+  interpolate_batch<float, 4, eCubicFilter::Mitchell>(
+      buffer, width, height, uvs, dst, wrap_u, wrap_v);
+}
+
+/** \} */
+
 }  // namespace blender::math
 
 /**************************************************************************
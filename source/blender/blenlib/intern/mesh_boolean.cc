@@ -12,6 +12,7 @@
 #  include <atomic>
 #  include <fstream>
 #  include <iostream>
+#  include <optional>
 
 #  include "BLI_array.hh"
 #  include "BLI_assert.h"
@@ -30,6 +31,7 @@
 #  include "BLI_stack.hh"
 #  include "BLI_task.hh"
 #  include "BLI_vector.hh"
+#  include "BLI_vector_set.hh"
 
 #  include "BLI_mesh_boolean.hh"
 
@@ -870,6 +872,42 @@ static const Vert *find_flap_vert(const Face &tri, const Edge e, bool *r_rev)
   return flapv;
 }
 
+/**
+ * Index of the orient3d determinant when all input coordinates have index 1,
+ * see the description of the Burnikel et al. error bounds in mesh_intersect.cc.
+ */
+constexpr int index_orient3d = 11;
+
+/**
+ * Return the sign of #orient3d of the exact coordinates of a, b, c and d, computed from their
+ * double approximations. The answer is 0 if the double calculation cannot decide the sign,
+ * in which case the caller has to fall back to the exact calculation.
+ */
+static int filter_orient3d(const double3 &a, const double3 &b, const double3 &c, const double3 &d)
+{
+  const double3 ad = a - d;
+  const double3 bd = b - d;
+  const double3 cd = c - d;
+  const double det = ad.z * (bd.x * cd.y - cd.x * bd.y) + bd.z * (cd.x * ad.y - ad.x * cd.y) +
+                     cd.z * (ad.x * bd.y - bd.x * ad.y);
+  if (det == 0.0) {
+    return 0;
+  }
+  /* The supremum is the determinant using absolute values and only additions. */
+  const double3 abs_d = math::abs(d);
+  const double3 sad = math::abs(a) + abs_d;
+  const double3 sbd = math::abs(b) + abs_d;
+  const double3 scd = math::abs(c) + abs_d;
+  const double supremum = sad.z * (sbd.x * scd.y + scd.x * sbd.y) +
+                          sbd.z * (scd.x * sad.y + sad.x * scd.y) +
+                          scd.z * (sad.x * sbd.y + sbd.x * sad.y);
+  const double err_bound = supremum * index_orient3d * DBL_EPSILON;
+  if (fabs(det) > err_bound) {
+    return det > 0.0 ? 1 : -1;
+  }
+  return 0;
+}
+
 /**
  * Triangle \a tri and tri0 share edge e.
  * Classify \a tri with respect to tri0 as described in
@@ -890,9 +928,6 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
   if (dbg_level > 0) {
     std::cout << "classify  e = " << e << "\n";
   }
-  mpq3 a0 = tri0[0]->co_exact;
-  mpq3 a1 = tri0[1]->co_exact;
-  mpq3 a2 = tri0[2]->co_exact;
   bool rev;
   bool rev0;
   const Vert *flapv0 = find_flap_vert(tri0, e, &rev0);
@@ -904,9 +939,13 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
     std::cout << " rev = " << rev << " flapv = " << flapv << "\n";
   }
   BLI_assert(flapv != nullptr && flapv0 != nullptr);
-  const mpq3 flap = flapv->co_exact;
-  /* orient will be positive if flap is below oriented plane of a0,a1,a2. */
-  int orient = orient3d(a0, a1, a2, flap);
+  /* orient will be positive if flap is below oriented plane of tri0.
+   * Most triangles around an edge are not nearly co-planar, so first try to decide that with
+   * doubles and only use exact arithmetic when that is inconclusive. */
+  int orient = filter_orient3d(tri0[0]->co, tri0[1]->co, tri0[2]->co, flapv->co);
+  if (orient == 0) {
+    orient = orient3d(tri0[0]->co_exact, tri0[1]->co_exact, tri0[2]->co_exact, flapv->co_exact);
+  }
   int ans;
   if (orient > 0) {
     ans = rev0 ? 4 : 3;
@@ -1069,23 +1108,19 @@ static Array<int> sort_tris_around_edge(
  * This possibly makes new cells in \a cinfo, and sets up the
  * bipartite graph edges between cells and patches.
  * Will modify \a pinfo and \a cinfo and the patches and cells they contain.
+ * \a sorted_tris are the triangles around e, as sorted by #sort_tris_around_edge.
  */
 static void find_cells_from_edge(const IMesh &tm,
-                                 const TriMeshTopology &tmtopo,
                                  PatchesInfo &pinfo,
                                  CellsInfo &cinfo,
-                                 const Edge e)
+                                 const Edge e,
+                                 const Span<int> sorted_tris)
 {
   const int dbg_level = 0;
   if (dbg_level > 0) {
     std::cout << "FIND_CELLS_FROM_EDGE " << e << "\n";
   }
-  const Vector<int> *edge_tris = tmtopo.edge_tris(e);
-  BLI_assert(edge_tris != nullptr);
-  Array<int> sorted_tris = sort_tris_around_edge(
-      tm, e, Span<int>(*edge_tris), (*edge_tris)[0], nullptr);
-
-  int n_edge_tris = edge_tris->size();
+  int n_edge_tris = sorted_tris.size();
   Array<int> edge_patches(n_edge_tris);
   for (int i = 0; i < n_edge_tris; ++i) {
     edge_patches[i] = pinfo.tri_patch(sorted_tris[i]);
@@ -1186,19 +1221,31 @@ static CellsInfo find_cells(const IMesh &tm, const TriMeshTopology &tmtopo, Patc
     std::cout << "\nFIND_CELLS\n";
   }
   CellsInfo cinfo;
-  /* For each unique edge shared between patch pairs, process it. */
-  Set<Edge> processed_edges;
+  /* Find the unique edges shared between patch pairs. */
+  VectorSet<Edge> patch_edges;
   for (const auto item : pinfo.patch_patch_edge_map().items()) {
     int p = item.key.first;
     int q = item.key.second;
     if (p < q) {
-      const Edge &e = item.value;
-      if (!processed_edges.contains(e)) {
-        processed_edges.add_new(e);
-        find_cells_from_edge(tm, tmtopo, pinfo, cinfo, e);
-      }
+      patch_edges.add(item.value);
     }
   }
+  /* Sorting the triangles around the edges only reads the mesh, and it is where most of the
+   * time is spent (it may need exact arithmetic), so do that in parallel. */
+  Array<Array<int>> edge_sorted_tris(patch_edges.size());
+  threading::parallel_for(patch_edges.index_range(), 256, [&](IndexRange range) {
+    for (int i : range) {
+      const Edge e = patch_edges[i];
+      const Vector<int> *edge_tris = tmtopo.edge_tris(e);
+      BLI_assert(edge_tris != nullptr);
+      edge_sorted_tris[i] = sort_tris_around_edge(tm, e, *edge_tris, (*edge_tris)[0], nullptr);
+    }
+  });
+  /* Building the cells depends on the order in which the edges are processed, so it stays
+   * serial to keep the result deterministic. */
+  for (int i : patch_edges.index_range()) {
+    find_cells_from_edge(tm, pinfo, cinfo, patch_edges[i], edge_sorted_tris[i]);
+  }
   /* Some patches may have no cells at this point. These are either:
    * (a) a closed manifold patch only incident on itself (sphere, torus, klein bottle, etc.).
    * (b) an open manifold patch only incident on itself (has non-manifold boundaries).
@@ -1409,11 +1456,21 @@ static int find_cell_for_point_near_edge(const mpq3 &p,
     std::cout << "FIND_CELL_FOR_POINT_NEAR_EDGE, p=" << p << " e=" << e << "\n";
   }
   const Vector<int> *etris = tmtopo.edge_tris(e);
-  const Vert *dummy_vert = arena->add_or_find_vert(p, NO_INDEX);
-  const Face *dummy_tri = arena->add_face({e.v0(), e.v1(), dummy_vert},
-                                          NO_INDEX,
-                                          {NO_INDEX, NO_INDEX, NO_INDEX},
-                                          {false, false, false});
+  /* The dummy vertex and triangle are not added to the arena, so that this can be called from
+   * multiple threads without the ids of later arena elements depending on the scheduling.
+   * An existing vertex at p is still used, because the sorting compares vertex pointers. */
+  const Vert *dummy_vert = arena->find_vert(p);
+  std::optional<Vert> local_vert;
+  if (dummy_vert == nullptr) {
+    local_vert.emplace(p, double3(p[0].get_d(), p[1].get_d(), p[2].get_d()), NO_INDEX, NO_INDEX);
+    dummy_vert = &*local_vert;
+  }
+  const Face dummy_face({e.v0(), e.v1(), dummy_vert},
+                        NO_INDEX,
+                        NO_INDEX,
+                        {NO_INDEX, NO_INDEX, NO_INDEX},
+                        {false, false, false});
+  const Face *dummy_tri = &dummy_face;
   BLI_assert(etris != nullptr);
   Array<int> edge_tris(etris->size() + 1);
   std::copy(etris->begin(), etris->end(), edge_tris.begin());
@@ -2092,10 +2149,14 @@ static void finish_patch_cell_graph(const IMesh &tm,
       std::cout << comp << ": " << components[comp] << "\n";
     }
   }
+  /* The components only read the cells and patches here, so they can be handled in parallel.
+   * The dummy vertices and triangles used for sorting are not added to the arena. */
   Array<int> ambient_cell(components.size());
-  for (int comp : components.index_range()) {
-    ambient_cell[comp] = find_ambient_cell(tm, &components[comp], tmtopo, pinfo, arena);
-  }
+  threading::parallel_for(components.index_range(), 1, [&](IndexRange range) {
+    for (int comp : range) {
+      ambient_cell[comp] = find_ambient_cell(tm, &components[comp], tmtopo, pinfo, arena);
+    }
+  });
   if (dbg_level > 0) {
     std::cout << "ambient cells:\n";
     for (int comp : ambient_cell.index_range()) {
@@ -2107,10 +2168,12 @@ static void finish_patch_cell_graph(const IMesh &tm,
   if (tot_components > 1) {
     Array<BoundingBox> comp_bb(tot_components);
     populate_comp_bbs(components, pinfo, tm, comp_bb);
-    for (int comp : components.index_range()) {
-      comp_cont[comp] = find_component_containers(
-          comp, components, ambient_cell, tm, pinfo, tmtopo, comp_bb, arena);
-    }
+    threading::parallel_for(components.index_range(), 1, [&](IndexRange range) {
+      for (int comp : range) {
+        comp_cont[comp] = find_component_containers(
+            comp, components, ambient_cell, tm, pinfo, tmtopo, comp_bb, arena);
+      }
+    });
     if (dbg_level > 0) {
       std::cout << "component containers:\n";
       for (int comp : comp_cont.index_range()) {
@@ -10,6 +10,7 @@
 #ifdef WITH_GMP
 
 #  include <algorithm>
+#  include <atomic>
 #  include <fstream>
 #  include <functional>
 #  include <iostream>
@@ -330,7 +331,8 @@ class IMeshArena::IMeshArenaImpl : NonCopyable, NonMovable {
 
   /* Use these to allocate ids when Verts and Faces are allocated. */
   int next_vert_id_ = 0;
-  int next_face_id_ = 0;
+  /* Faces are constructed outside of the lock. */
+  std::atomic<int> next_face_id_ = 0;
 
   /* Need a lock when multi-threading to protect allocation of new elements. */
 #  ifdef USE_SPINLOCK
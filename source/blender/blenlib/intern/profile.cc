@@ -0,0 +1,272 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+#include <fmt/format.h>
+
+#include "BLI_array.hh"
+#include "BLI_fileops.hh"
+#include "BLI_profile.hh"
+#include "BLI_sort.hh"
+#include "BLI_threads.h"
+#include "BLI_vector.hh"
+
+namespace blender::profile {
+
+namespace detail {
+std::atomic<bool> enabled = false;
+}
+
+/** Number of zones that are kept per thread, older zones are overwritten. */
+static constexpr int64_t zones_per_thread = 1 << 16;
+
+struct Zone {
+  const char *name;
+  /** Nanoseconds since #Profiler::epoch. */
+  int64_t start;
+  int64_t end;
+  int thread_id;
+  char detail[44];
+};
+
+/**
+ * Zones recorded by one thread. When a thread exits, its buffer is kept and may be used by the
+ * next new thread, so that zones of short-lived threads remain available for export.
+ */
+struct ThreadBuffer {
+  /** Only contended when exporting zones while recording. */
+  std::mutex mutex;
+  /** Ring buffer, allocated when the first zone is recorded. */
+  Array<Zone, 0> zones;
+  /** Total number of recorded zones, can be larger than the ring buffer size. */
+  int64_t zones_num = 0;
+  /** False when the thread using this buffer has exited. */
+  bool in_use = false;
+};
+
+struct Profiler {
+  /** Protects the vector below and #ThreadBuffer::in_use. */
+  std::mutex mutex;
+  Vector<std::unique_ptr<ThreadBuffer>> buffers;
+  int next_thread_id = 0;
+  int main_thread_id = -1;
+  timeit::TimePoint epoch = timeit::Clock::now();
+};
+
+static Profiler &get_profiler()
+{
+  static Profiler profiler;
+  return profiler;
+}
+
+namespace {
+
+struct ThreadLocalBuffer {
+  ThreadBuffer *buffer = nullptr;
+  int thread_id = -1;
+
+  ~ThreadLocalBuffer()
+  {
+    if (buffer) {
+      Profiler &profiler = get_profiler();
+      std::lock_guard lock{profiler.mutex};
+      buffer->in_use = false;
+    }
+  }
+};
+
+}  // namespace
+
+static ThreadLocalBuffer &get_thread_local_buffer()
+{
+  static thread_local ThreadLocalBuffer local;
+  if (UNLIKELY(local.buffer == nullptr)) {
+    Profiler &profiler = get_profiler();
+    std::lock_guard lock{profiler.mutex};
+    for (std::unique_ptr<ThreadBuffer> &buffer : profiler.buffers) {
+      if (!buffer->in_use) {
+        local.buffer = buffer.get();
+        break;
+      }
+    }
+    if (local.buffer == nullptr) {
+      profiler.buffers.append(std::make_unique<ThreadBuffer>());
+      local.buffer = profiler.buffers.last().get();
+    }
+    local.buffer->in_use = true;
+    local.thread_id = profiler.next_thread_id++;
+    if (BLI_thread_is_main()) {
+      profiler.main_thread_id = local.thread_id;
+    }
+  }
+  return local;
+}
+
+void set_enabled(const bool enabled)
+{
+  /* Make sure the epoch is set before the first zone starts. */
+  get_profiler();
+  detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void clear()
+{
+  Profiler &profiler = get_profiler();
+  std::lock_guard lock{profiler.mutex};
+  for (std::unique_ptr<ThreadBuffer> &buffer : profiler.buffers) {
+    std::lock_guard buffer_lock{buffer->mutex};
+    buffer->zones_num = 0;
+  }
+}
+
+/** Copy as much of the string as fits, without splitting a multi-byte UTF-8 character. */
+static void copy_truncated_utf8(const StringRef src, char *dst, const int64_t dst_size)
+{
+  int64_t len = std::min(src.size(), dst_size - 1);
+  if (len < src.size()) {
+    while (len > 0 && (uchar(src[len]) & 0xC0) == 0x80) {
+      len--;
+    }
+  }
+  src.substr(0, len).unsafe_copy(dst);
+}
+
+void record_zone(const char *name,
+                 const char *detail,
+                 const timeit::TimePoint start,
+                 const timeit::TimePoint end)
+{
+  const Profiler &profiler = get_profiler();
+  ThreadLocalBuffer &local = get_thread_local_buffer();
+  ThreadBuffer &buffer = *local.buffer;
+
+  std::lock_guard lock{buffer.mutex};
+  if (buffer.zones.is_empty()) {
+    buffer.zones.reinitialize(zones_per_thread);
+  }
+  Zone &zone = buffer.zones[buffer.zones_num % zones_per_thread];
+  buffer.zones_num++;
+
+  zone.name = name;
+  zone.start = timeit::Nanoseconds(start - profiler.epoch).count();
+  zone.end = timeit::Nanoseconds(end - profiler.epoch).count();
+  zone.thread_id = local.thread_id;
+  copy_truncated_utf8(detail ? detail : "", zone.detail, sizeof(zone.detail));
+}
+
+static void append_json_string(fmt::memory_buffer &buf, const StringRef str)
+{
+  buf.push_back('"');
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        buf.append(StringRef("\\\""));
+        break;
+      case '\\':
+        buf.append(StringRef("\\\\"));
+        break;
+      default:
+        if (uchar(c) < 0x20) {
+          fmt::format_to(fmt::appender(buf), FMT_STRING("\\u{:04x}"), int(c));
+        }
+        else {
+          buf.push_back(c);
+        }
+        break;
+    }
+  }
+  buf.push_back('"');
+}
+
+void write_chrome_trace(std::ostream &stream)
+{
+  Profiler &profiler = get_profiler();
+
+  Vector<Zone> zones;
+  int threads_num;
+  int main_thread_id;
+  {
+    std::lock_guard lock{profiler.mutex};
+    for (std::unique_ptr<ThreadBuffer> &buffer : profiler.buffers) {
+      std::lock_guard buffer_lock{buffer->mutex};
+      const int64_t num = std::min(buffer->zones_num, zones_per_thread);
+      for (const int64_t i : IndexRange(buffer->zones_num - num, num)) {
+        zones.append(buffer->zones[i % zones_per_thread]);
+      }
+    }
+    threads_num = profiler.next_thread_id;
+    main_thread_id = profiler.main_thread_id;
+  }
+  /* Not required by the format, but makes the output deterministic and easier to read. */
+  parallel_sort(zones.begin(), zones.end(), [](const Zone &a, const Zone &b) {
+    return std::tie(a.thread_id, a.start) < std::tie(b.thread_id, b.start);
+  });
+
+  fmt::memory_buffer buf;
+  buf.append(StringRef("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  bool is_first_event = true;
+  auto begin_event = [&]() {
+    buf.append(StringRef(is_first_event ? "\n{" : ",\n{"));
+    is_first_event = false;
+  };
+
+  for (const int thread_id : IndexRange(threads_num)) {
+    begin_event();
+    fmt::format_to(fmt::appender(buf),
+                   FMT_STRING("\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                              "\"args\":{{\"name\":"),
+                   thread_id);
+    if (thread_id == main_thread_id) {
+      append_json_string(buf, "Main");
+    }
+    else {
+      append_json_string(buf, fmt::format(FMT_STRING("Thread {}"), thread_id));
+    }
+    buf.append(StringRef("}}"));
+  }
+  for (const Zone &zone : zones) {
+    begin_event();
+    buf.append(StringRef("\"name\":"));
+    append_json_string(buf, zone.name);
+    /* Time stamps are in microseconds. */
+    fmt::format_to(fmt::appender(buf),
+                   FMT_STRING(",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}"),
+                   zone.thread_id,
+                   double(zone.start) / 1e3,
+                   double(zone.end - zone.start) / 1e3);
+    if (zone.detail[0] != '\0') {
+      buf.append(StringRef(",\"args\":{\"detail\":"));
+      append_json_string(buf, zone.detail);
+      buf.push_back('}');
+    }
+    buf.push_back('}');
+
+    /* Avoid building up the entire file in memory. */
+    if (buf.size() > 1024 * 1024) {
+      stream.write(buf.data(), std::streamsize(buf.size()));
+      buf.clear();
+    }
+  }
+  buf.append(StringRef("\n]}\n"));
+  stream.write(buf.data(), std::streamsize(buf.size()));
+}
+
+bool write_chrome_trace(const StringRefNull filepath)
+{
+  blender::fstream stream(filepath.c_str(), std::ios::out | std::ios::binary);
+  if (!stream.is_open()) {
+    return false;
+  }
+  write_chrome_trace(stream);
+  return stream.good();
+}
+
+}  // namespace blender::profile
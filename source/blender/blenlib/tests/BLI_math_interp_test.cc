@@ -4,6 +4,9 @@
 
 #include "testing/testing.h"
 
+#include <array>
+
+#include "BLI_array.hh"
 #include "BLI_color.hh"
 #include "BLI_math_interp.hh"
 
@@ -391,3 +394,178 @@ TEST(math_interp, CubicMitchellFloatPartiallyOutsideImage)
   res = interpolate_cubic_mitchell_fl(image_fl[0][0], image_width, image_height, 2.2f, -0.1f);
   EXPECT_V4_NEAR(exp3, res, float_tolerance);
 }
+
+static const std::array<float2, 11> batch_uvs = {{
+    {1.0f, 2.0f},
+    {0.5f, 1.0f},
+    {1.25f, 0.625f},
+    {1.4f, 0.1f},
+    {-0.5f, 2.0f},
+    {1.25f, 2.9f},
+    {2.2f, -0.1f},
+    {-1.5f, 0.0f},
+    {5.0f, 0.0f},
+    {0.0f, 500.0f},
+    {-7.3f, -3.7f},
+}};
+
+TEST(math_interp, BatchNearestMatchesSingle)
+{
+  Array<float4> res_fl(batch_uvs.size());
+  Array<uchar4> res_char(batch_uvs.size());
+  interpolate_nearest_fl(image_fl[0][0], image_width, image_height, batch_uvs, res_fl);
+  interpolate_nearest_byte(image_char[0][0], image_width, image_height, batch_uvs, res_char);
+  for (const int i : res_fl.index_range()) {
+    const float2 uv = batch_uvs[i];
+    EXPECT_EQ(res_fl[i],
+              interpolate_nearest_fl(image_fl[0][0], image_width, image_height, uv.x, uv.y));
+    EXPECT_EQ(res_char[i],
+              interpolate_nearest_byte(image_char[0][0], image_width, image_height, uv.x, uv.y));
+  }
+
+  interpolate_nearest_fl(image_fl[0][0],
+                         image_width,
+                         image_height,
+                         batch_uvs,
+                         res_fl,
+                         InterpWrapMode::Repeat,
+                         InterpWrapMode::Repeat);
+  for (const int i : res_fl.index_range()) {
+    const float2 uv = batch_uvs[i];
+    EXPECT_EQ(res_fl[i],
+              interpolate_nearest_wrap_fl(image_fl[0][0], image_width, image_height, uv.x, uv.y));
+  }
+}
+
+TEST(math_interp, BatchBilinearMatchesSingle)
+{
+  Array<float4> res_fl(batch_uvs.size());
+  Array<uchar4> res_char(batch_uvs.size());
+
+  interpolate_bilinear_fl(image_fl[0][0], image_width, image_height, batch_uvs, res_fl);
+  interpolate_bilinear_byte(image_char[0][0], image_width, image_height, batch_uvs, res_char);
+  for (const int i : res_fl.index_range()) {
+    const float2 uv = batch_uvs[i];
+    EXPECT_V4_NEAR(
+        res_fl[i],
+        interpolate_bilinear_fl(image_fl[0][0], image_width, image_height, uv.x, uv.y),
+        float_tolerance);
+    EXPECT_V4_NEAR(
+        int4(res_char[i]),
+        int4(interpolate_bilinear_byte(image_char[0][0], image_width, image_height, uv.x, uv.y)),
+        1);
+  }
+
+  interpolate_bilinear_fl(image_fl[0][0],
+                          image_width,
+                          image_height,
+                          batch_uvs,
+                          res_fl,
+                          InterpWrapMode::Border,
+                          InterpWrapMode::Border);
+  interpolate_bilinear_byte(image_char[0][0],
+                            image_width,
+                            image_height,
+                            batch_uvs,
+                            res_char,
+                            InterpWrapMode::Border,
+                            InterpWrapMode::Border);
+  for (const int i : res_fl.index_range()) {
+    const float2 uv = batch_uvs[i];
+    EXPECT_V4_NEAR(
+        res_fl[i],
+        interpolate_bilinear_border_fl(image_fl[0][0], image_width, image_height, uv.x, uv.y),
+        float_tolerance);
+    EXPECT_V4_NEAR(int4(res_char[i]),
+                   int4(interpolate_bilinear_border_byte(
+                       image_char[0][0], image_width, image_height, uv.x, uv.y)),
+                   1);
+  }
+
+  interpolate_bilinear_fl(image_fl[0][0],
+                          image_width,
+                          image_height,
+                          batch_uvs,
+                          res_fl,
+                          InterpWrapMode::Repeat,
+                          InterpWrapMode::Repeat);
+  for (const int i : res_fl.index_range()) {
+    const float2 uv = batch_uvs[i];
+    EXPECT_V4_NEAR(
+        res_fl[i],
+        interpolate_bilinear_wrap_fl(image_fl[0][0], image_width, image_height, uv.x, uv.y),
+        float_tolerance);
+  }
+}
+
+TEST(math_interp, BatchBilinearMixedWrapModes)
+{
+  const Array<float2> uvs = {{-0.5f, 1.0f}, {1.0f, -0.5f}};
+  Array<float4> res(uvs.size());
+  interpolate_bilinear_fl(image_fl[0][0],
+                          image_width,
+                          image_height,
+                          uvs,
+                          res,
+                          InterpWrapMode::Repeat,
+                          InterpWrapMode::Border);
+  /* Repeated along U: blend of the last and first texels of the row. */
+  EXPECT_V4_NEAR(res[0], float4(63.0f, 64.0f, 65.0f, 66.0f), float_tolerance);
+  /* Border along V: half of the first row texel blended with transparent black. */
+  EXPECT_V4_NEAR(res[1], float4(115.0f, 115.0f, 115.0f, 115.0f), float_tolerance);
+}
+
+TEST(math_interp, BatchCubicMatchesSingle)
+{
+  /* Only compare samples fully inside the image, the single sample cubic functions turn samples
+   * far outside of the image into transparent black instead of extending edge texels. */
+  const Array<float2> uvs = {
+      {1.0f, 2.0f}, {1.25f, 0.625f}, {1.4f, 0.1f}, {1.25f, 1.9f}, {0.2f, 0.9f}};
+  Array<float4> res_fl(uvs.size());
+  Array<uchar4> res_char(uvs.size());
+
+  interpolate_cubic_bspline_fl(image_fl[0][0], image_width, image_height, uvs, res_fl);
+  interpolate_cubic_bspline_byte(image_char[0][0], image_width, image_height, uvs, res_char);
+  for (const int i : res_fl.index_range()) {
+    const float2 uv = uvs[i];
+    EXPECT_V4_NEAR(
+        res_fl[i],
+        interpolate_cubic_bspline_fl(image_fl[0][0], image_width, image_height, uv.x, uv.y),
+        float_tolerance);
+    EXPECT_V4_NEAR(int4(res_char[i]),
+                   int4(interpolate_cubic_bspline_byte(
+                       image_char[0][0], image_width, image_height, uv.x, uv.y)),
+                   1);
+  }
+
+  interpolate_cubic_mitchell_fl(image_fl[0][0], image_width, image_height, uvs, res_fl);
+  interpolate_cubic_mitchell_byte(image_char[0][0], image_width, image_height, uvs, res_char);
+  for (const int i : res_fl.index_range()) {
+    const float2 uv = uvs[i];
+    EXPECT_V4_NEAR(
+        res_fl[i],
+        interpolate_cubic_mitchell_fl(image_fl[0][0], image_width, image_height, uv.x, uv.y),
+        float_tolerance);
+    EXPECT_V4_NEAR(int4(res_char[i]),
+                   int4(interpolate_cubic_mitchell_byte(
+                       image_char[0][0], image_width, image_height, uv.x, uv.y)),
+                   1);
+  }
+}
+
+TEST(math_interp, BatchLargerThanBlock)
+{
+  /* Exercise processing of multiple blocks, including a partial last one. */
+  Array<float2> uvs(150);
+  for (const int i : uvs.index_range()) {
+    uvs[i] = float2(float(i % 13) * 0.25f - 0.5f, float(i % 7) * 0.5f - 0.5f);
+  }
+  Array<float4> res(uvs.size());
+  interpolate_bilinear_fl(image_fl[0][0], image_width, image_height, uvs, res);
+  for (const int i : uvs.index_range()) {
+    EXPECT_V4_NEAR(
+        res[i],
+        interpolate_bilinear_fl(image_fl[0][0], image_width, image_height, uvs[i].x, uvs[i].y),
+        float_tolerance);
+  }
+}
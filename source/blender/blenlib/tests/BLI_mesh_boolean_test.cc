@@ -17,6 +17,10 @@
 #include "BLI_mesh_boolean.hh"
 #include "BLI_vector.hh"
 
+#ifdef WITH_TBB
+#  include <tbb/task_arena.h>
+#endif
+
 #ifdef WITH_GMP
 namespace blender::meshintersect::tests {
 
@@ -455,6 +459,55 @@ TEST(boolean_trimesh, TetBesideTetTrimesh)
   }
 }
 
+/* Union of many separate pairs of nested tetrahedra, printed with the ids of the output. */
+static std::string nested_tets_union_result()
+{
+  constexpr int pairs_num = 8;
+  std::ostringstream spec;
+  spec << 8 * pairs_num << " " << 8 * pairs_num << "\n";
+  for (int pair = 0; pair < pairs_num; pair++) {
+    const int x = 5 * pair;
+    spec << x << " 0 0\n" << x + 2 << " 0 0\n" << x + 1 << " 2 0\n" << x + 1 << " 1 2\n";
+    spec << x - 1 << " -3/4 -1/2\n" << x + 3 << " -3/4 -1/2\n";
+    spec << x + 1 << " 13/4 -1/2\n" << x + 1 << " 5/4 7/2\n";
+  }
+  for (int pair = 0; pair < pairs_num; pair++) {
+    const int v = 8 * pair;
+    spec << v << " " << v + 2 << " " << v + 1 << "\n";
+    spec << v << " " << v + 1 << " " << v + 3 << "\n";
+    spec << v + 1 << " " << v + 2 << " " << v + 3 << "\n";
+    spec << v + 2 << " " << v << " " << v + 3 << "\n";
+    spec << v + 4 << " " << v + 6 << " " << v + 5 << "\n";
+    spec << v + 4 << " " << v + 5 << " " << v + 7 << "\n";
+    spec << v + 5 << " " << v + 6 << " " << v + 7 << "\n";
+    spec << v + 6 << " " << v + 4 << " " << v + 7 << "\n";
+  }
+
+  IMeshBuilder mb(spec.str().c_str());
+  IMesh out = boolean_trimesh(
+      mb.imesh, BoolOpType::Union, 1, all_shape_zero, true, false, &mb.arena);
+  out.populate_vert();
+  EXPECT_EQ(out.vert_size(), 4 * pairs_num);
+  EXPECT_EQ(out.face_size(), 4 * pairs_num);
+  std::ostringstream result;
+  result << out << mb.arena.tot_allocated_verts() << " " << mb.arena.tot_allocated_faces();
+  return result.str();
+}
+
+TEST(boolean_trimesh, NestedComponentsDeterministic)
+{
+  /* The components are handled in parallel, which must not change the result. */
+  const std::string parallel_result = nested_tets_union_result();
+  std::string serial_result;
+#ifdef WITH_TBB
+  tbb::task_arena single_thread_arena(1);
+  single_thread_arena.execute([&]() { serial_result = nested_tets_union_result(); });
+#else
+  serial_result = nested_tets_union_result();
+#endif
+  EXPECT_EQ(parallel_result, serial_result);
+}
+
 TEST(boolean_trimesh, DegenerateTris)
 {
   const char *spec = R"(10 10
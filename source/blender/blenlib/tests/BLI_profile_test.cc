@@ -0,0 +1,95 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <sstream>
+
+#include "BLI_profile.hh"
+#include "BLI_task.hh"
+
+#include "BLI_strict_flags.h" /* Keep last. */
+
+namespace blender::profile::tests {
+
+static std::string get_chrome_trace()
+{
+  std::stringstream stream;
+  write_chrome_trace(stream);
+  return stream.str();
+}
+
+static int64_t count_occurrences(const StringRef str, const StringRef pattern)
+{
+  int64_t count = 0;
+  for (int64_t pos = str.find(pattern); pos != StringRef::not_found;
+       pos = str.find(pattern, pos + 1))
+  {
+    count++;
+  }
+  return count;
+}
+
+TEST(profile, Disabled)
+{
+  clear();
+  set_enabled(false);
+  {
+    PROFILE_SCOPE("test_disabled_zone");
+  }
+  EXPECT_EQ(get_chrome_trace().find("test_disabled_zone"), std::string::npos);
+}
+
+TEST(profile, NestedZones)
+{
+  clear();
+  set_enabled(true);
+  {
+    PROFILE_SCOPE("test_outer_zone");
+    {
+      PROFILE_SCOPE_DETAIL("test_inner_zone", "Detail \"quoted\"");
+    }
+    PROFILE_SCOPE("test_inner_zone");
+  }
+  set_enabled(false);
+
+  const std::string trace = get_chrome_trace();
+  EXPECT_EQ(count_occurrences(trace, "\"name\":\"test_outer_zone\""), 1);
+  EXPECT_EQ(count_occurrences(trace, "\"name\":\"test_inner_zone\""), 2);
+  EXPECT_NE(trace.find("{\"detail\":\"Detail \\\"quoted\\\"\"}"), std::string::npos);
+  EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+
+  clear();
+  EXPECT_EQ(get_chrome_trace().find("test_outer_zone"), std::string::npos);
+}
+
+TEST(profile, LongDetail)
+{
+  clear();
+  set_enabled(true);
+  {
+    /* Multi-byte characters must not be split when truncating. */
+    PROFILE_SCOPE_DETAIL("test_long_detail", "ääääääääääääääääääääääääääääääääääääääääääää");
+  }
+  set_enabled(false);
+  const std::string trace = get_chrome_trace();
+  EXPECT_NE(trace.find("\"detail\":\"äääääääääääääääääääää\""), std::string::npos);
+  clear();
+}
+
+TEST(profile, Threads)
+{
+  clear();
+  set_enabled(true);
+  threading::parallel_for(IndexRange(1000), 1, [](const IndexRange range) {
+    for ([[maybe_unused]] const int64_t i : range) {
+      PROFILE_SCOPE("test_thread_zone");
+    }
+  });
+  set_enabled(false);
+  EXPECT_EQ(count_occurrences(get_chrome_trace(), "\"name\":\"test_thread_zone\""), 1000);
+  clear();
+}
+
+}  // namespace blender::profile::tests
@@ -17,7 +17,8 @@
 
 #include "BLI_ghash.h"
 #include "BLI_linklist.h"
-#include "BLI_path_util.h" /* Only for assertions. */
+#include "BLI_path_util.h"
+#include "BLI_profile.hh"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
 
@@ -405,6 +406,7 @@ BlendFileData *BLO_read_from_file(const char *filepath,
 {
   BLI_assert(!BLI_path_is_rel(filepath));
   BLI_assert(BLI_path_is_abs_from_cwd(filepath));
+  PROFILE_SCOPE_DETAIL("Read Blend File", BLI_path_basename(filepath));
 
   BlendFileData *bfd = nullptr;
   FileData *fd;
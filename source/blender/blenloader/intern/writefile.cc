@@ -96,6 +96,7 @@
 #include "BLI_linklist.h"
 #include "BLI_math_base.h"
 #include "BLI_mempool.h"
+#include "BLI_profile.hh"
 #include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h" /* MEM_freeN */
@@ -1654,6 +1655,7 @@ bool BLO_write_file(Main *mainvar,
                     const BlendFileWriteParams *params,
                     ReportList *reports)
 {
+  PROFILE_SCOPE_DETAIL("Write Blend File", BLI_path_basename(filepath));
   RawWriteWrap raw_wrap;
 
   if (write_flags & G_FILE_COMPRESS) {
@@ -1666,6 +1668,7 @@ bool BLO_write_file(Main *mainvar,
 
 bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int write_flags)
 {
+  PROFILE_SCOPE("Write Undo Step");
   bool use_userdef = false;
 
   const bool err = write_file_handle(
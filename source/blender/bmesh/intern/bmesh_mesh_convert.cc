@@ -193,22 +193,26 @@ static Vector<MeshToBMeshLayerInfo> mesh_to_bm_copy_info_calc(const CustomData &
   return infos;
 }
 
-static void mesh_attributes_copy_to_bmesh_block(CustomData &data,
-                                                const Span<MeshToBMeshLayerInfo> copy_info,
-                                                const int mesh_index,
-                                                BMHeader &header)
+/**
+ * Copy the mesh attributes into the already allocated BMesh element blocks, which are indexed like
+ * the mesh elements (null for skipped elements). This is done one layer at a time, in parallel.
+ */
+static void mesh_attributes_copy_to_bmesh_blocks(const Span<MeshToBMeshLayerInfo> copy_info,
+                                                 const Span<void *> blocks)
 {
-  CustomData_bmesh_alloc_block(&data, &header.data);
-  for (const MeshToBMeshLayerInfo &info : copy_info) {
-    if (info.mesh_data) {
-      CustomData_data_copy_value(info.type,
-                                 POINTER_OFFSET(info.mesh_data, info.elem_size * mesh_index),
-                                 POINTER_OFFSET(header.data, info.bmesh_offset));
-    }
-    else {
-      CustomData_data_set_default_value(info.type, POINTER_OFFSET(header.data, info.bmesh_offset));
-    }
+  if (copy_info.is_empty()) {
+    return;
   }
+  blender::threading::parallel_for(blocks.index_range(), 2048, [&](const IndexRange range) {
+    for (const MeshToBMeshLayerInfo &info : copy_info) {
+      CustomData_bmesh_layer_copy_from_array(
+          info.type,
+          info.mesh_data ? POINTER_OFFSET(info.mesh_data, info.elem_size * range.start()) :
+                           nullptr,
+          blocks.slice(range),
+          info.bmesh_offset);
+    }
+  });
 }
 
 void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *params)
@@ -430,6 +434,7 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *
 
   const Span<float3> positions = mesh->vert_positions();
   Array<BMVert *> vtable(mesh->verts_num);
+  Array<void *> blocks(mesh->verts_num);
   for (const int i : positions.index_range()) {
     BMVert *v = vtable[i] = BM_vert_create(
         bm, keyco ? keyco[i] : positions[i], nullptr, BM_CREATE_SKIP_CD);
@@ -446,27 +451,36 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *
       copy_v3_v3(v->no, vert_normals[i]);
     }
 
-    mesh_attributes_copy_to_bmesh_block(bm->vdata, vert_info, i, v->head);
-
-    /* Set shape key original index. */
-    if (cd_shape_keyindex_offset != -1) {
-      BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
-    }
-
-    /* Set shape-key data. */
-    if (tot_shape_keys) {
-      float(*co_dst)[3] = (float(*)[3])BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
-      for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
-        copy_v3_v3(*co_dst, shape_key_table[j][i]);
-      }
-    }
+    CustomData_bmesh_alloc_block(&bm->vdata, &v->head.data);
+    blocks[i] = v->head.data;
   }
   if (is_new) {
     bm->elem_index_dirty &= ~BM_VERT; /* Added in order, clear dirty flag. */
   }
+  mesh_attributes_copy_to_bmesh_blocks(vert_info, blocks);
+  if (cd_shape_keyindex_offset != -1 || tot_shape_keys) {
+    threading::parallel_for(vtable.index_range(), 2048, [&](const IndexRange range) {
+      for (const int i : range) {
+        BMVert *v = vtable[i];
+        /* Set shape key original index. */
+        if (cd_shape_keyindex_offset != -1) {
+          BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
+        }
+
+        /* Set shape-key data. */
+        if (tot_shape_keys) {
+          float(*co_dst)[3] = (float(*)[3])BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
+          for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
+            copy_v3_v3(*co_dst, shape_key_table[j][i]);
+          }
+        }
+      }
+    });
+  }
 
   const Span<blender::int2> edges = mesh->edges();
   Array<BMEdge *> etable(mesh->edges_num);
+  blocks.reinitialize(mesh->edges_num);
   for (const int i : edges.index_range()) {
     BMEdge *e = etable[i] = BM_edge_create(
         bm, vtable[edges[i][0]], vtable[edges[i][1]], nullptr, BM_CREATE_SKIP_CD);
@@ -486,11 +500,13 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *
       BM_elem_flag_enable(e, BM_ELEM_SMOOTH);
     }
 
-    mesh_attributes_copy_to_bmesh_block(bm->edata, edge_info, i, e->head);
+    CustomData_bmesh_alloc_block(&bm->edata, &e->head.data);
+    blocks[i] = e->head.data;
   }
   if (is_new) {
     bm->elem_index_dirty &= ~BM_EDGE; /* Added in order, clear dirty flag. */
   }
+  mesh_attributes_copy_to_bmesh_blocks(edge_info, blocks);
 
   const blender::OffsetIndices faces = mesh->faces();
   const Span<int> corner_verts = mesh->corner_verts();
@@ -503,6 +519,11 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *
     ftable.reinitialize(mesh->faces_num);
   }
 
+  /* Blocks of skipped faces and their corners stay null. */
+  blocks.reinitialize(mesh->faces_num);
+  blocks.fill(nullptr);
+  Array<void *> loop_blocks(mesh->corners_num, nullptr);
+
   int totloops = 0;
   for (const int i : faces.index_range()) {
     const IndexRange face = faces[i];
@@ -548,11 +569,13 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *
       /* Don't use 'j' since we may have skipped some faces, hence some loops. */
       BM_elem_index_set(l_iter, totloops++); /* set_ok */
 
-      mesh_attributes_copy_to_bmesh_block(bm->ldata, loop_info, j, l_iter->head);
+      CustomData_bmesh_alloc_block(&bm->ldata, &l_iter->head.data);
+      loop_blocks[j] = l_iter->head.data;
       j++;
     } while ((l_iter = l_iter->next) != l_first);
 
-    mesh_attributes_copy_to_bmesh_block(bm->pdata, poly_info, i, f->head);
+    CustomData_bmesh_alloc_block(&bm->pdata, &f->head.data);
+    blocks[i] = f->head.data;
 
     if (params->calc_face_normal) {
       BM_face_normal_update(f);
@@ -561,6 +584,10 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *
   if (is_new) {
     bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP); /* Added in order, clear dirty flag. */
   }
+  threading::parallel_invoke(
+      blocks.size() > 1024,
+      [&]() { mesh_attributes_copy_to_bmesh_blocks(poly_info, blocks); },
+      [&]() { mesh_attributes_copy_to_bmesh_blocks(loop_info, loop_blocks); });
 
   /* -------------------------------------------------------------------- */
   /* MSelect clears the array elements (to avoid adding multiple times).
@@ -1240,14 +1267,27 @@ static void bm_face_loop_table_build(BMesh &bm,
   }
 }
 
-static void bmesh_block_copy_to_mesh_attributes(const Span<BMeshToMeshLayerInfo> copy_info,
-                                                const int mesh_index,
-                                                const void *block)
+/**
+ * Copy the attributes of a range of BMesh elements to the mesh, one layer at a time.
+ */
+template<typename T>
+static void bmesh_blocks_copy_to_mesh_attributes(const Span<BMeshToMeshLayerInfo> copy_info,
+                                                 const Span<const T *> bm_elems,
+                                                 const IndexRange range)
 {
+  if (copy_info.is_empty()) {
+    return;
+  }
+  Array<const void *, 1024> blocks(range.size());
+  for (const int i : range.index_range()) {
+    blocks[i] = bm_elems[range[i]]->head.data;
+  }
   for (const BMeshToMeshLayerInfo &info : copy_info) {
-    CustomData_data_copy_value(info.type,
-                               POINTER_OFFSET(block, info.bmesh_offset),
-                               POINTER_OFFSET(info.mesh_data, info.elem_size * mesh_index));
+    CustomData_bmesh_layer_copy_to_array(info.type,
+                                         blocks,
+                                         info.bmesh_offset,
+                                         POINTER_OFFSET(info.mesh_data,
+                                                        info.elem_size * range.start()));
   }
 }
 
@@ -1269,9 +1309,9 @@ static void bm_to_mesh_verts(const BMesh &bm,
     for (const int vert_i : range) {
       const BMVert &src_vert = *bm_verts[vert_i];
       copy_v3_v3(dst_vert_positions[vert_i], src_vert.co);
-      bmesh_block_copy_to_mesh_attributes(info, vert_i, src_vert.head.data);
       any_loose_vert_local = any_loose_vert_local || src_vert.e == nullptr;
     }
+    bmesh_blocks_copy_to_mesh_attributes(info.as_span(), bm_verts, range);
     if (any_loose_vert_local) {
       any_loose_vert.store(true, std::memory_order_relaxed);
     }
@@ -1312,9 +1352,9 @@ static void bm_to_mesh_edges(const BMesh &bm,
     for (const int edge_i : range) {
       const BMEdge &src_edge = *bm_edges[edge_i];
       dst_edges[edge_i] = int2(BM_elem_index_get(src_edge.v1), BM_elem_index_get(src_edge.v2));
-      bmesh_block_copy_to_mesh_attributes(info, edge_i, src_edge.head.data);
       any_loose_edge_local |= BM_edge_is_wire(&src_edge);
     }
+    bmesh_blocks_copy_to_mesh_attributes(info.as_span(), bm_edges, range);
     if (any_loose_edge_local) {
       any_loose_edge.store(true, std::memory_order_relaxed);
     }
@@ -1360,8 +1400,8 @@ static void bm_to_mesh_faces(const BMesh &bm,
     for (const int face_i : range) {
       const BMFace &src_face = *bm_faces[face_i];
       dst_face_offsets[face_i] = BM_elem_index_get(BM_FACE_FIRST_LOOP(&src_face));
-      bmesh_block_copy_to_mesh_attributes(info, face_i, src_face.head.data);
     }
+    bmesh_blocks_copy_to_mesh_attributes(info.as_span(), bm_faces, range);
     if (!select_poly.is_empty()) {
       for (const int face_i : range) {
         select_poly[face_i] = BM_elem_flag_test(bm_faces[face_i], BM_ELEM_SELECT);
@@ -1401,8 +1441,8 @@ static void bm_to_mesh_loops(const BMesh &bm, const Span<const BMLoop *> bm_loop
       const BMLoop &src_loop = *bm_loops[loop_i];
       dst_corner_verts[loop_i] = BM_elem_index_get(src_loop.v);
       dst_corner_edges[loop_i] = BM_elem_index_get(src_loop.e);
-      bmesh_block_copy_to_mesh_attributes(info, loop_i, src_loop.head.data);
     }
+    bmesh_blocks_copy_to_mesh_attributes(info.as_span(), bm_loops, range);
   });
 }
 
@@ -27,11 +27,13 @@ struct CustomData_MeshMasks;
 struct Depsgraph;
 struct DupliObject;
 struct ID;
-struct ListBase;
 struct PointerRNA;
 struct Scene;
 struct ViewLayer;
 struct ViewerPath;
+namespace blender::bke {
+class DupliList;
+}
 
 /* -------------------------------------------------------------------- */
 /** \name DEG input data
@@ -193,9 +195,9 @@ struct DEGObjectIterData {
   /* Object which created the dupli-list. */
   Object *dupli_parent;
   /* List of duplicated objects. */
-  ListBase *dupli_list;
-  /* Next duplicated object to step into. */
-  DupliObject *dupli_object_next;
+  blender::bke::DupliList *dupli_list;
+  /* Index of the next duplicated object to step into. */
+  int64_t dupli_object_next_index;
   /* Corresponds to current object: current iterator object is evaluated from
    * this duplicated object. */
   DupliObject *dupli_object_current;
@@ -21,6 +21,8 @@
 #include "BLI_utildefines.h"
 
 #include "BKE_action.h"
+#include "BKE_anim_data.hh"
+#include "BKE_animsys.h"
 #include "BKE_collection.hh"
 #include "BKE_lib_id.hh"
 
@@ -209,6 +211,11 @@ void deg_graph_build_finalize(Main *bmain, Depsgraph *graph)
       }
     }
     else {
+      /* The cached animation evaluation plan might point to data which got re-allocated as part
+       * of the relations update (pose channels, modifiers, ...). */
+      if (AnimData *adt = BKE_animdata_from_id(id_node->id_cow)) {
+        BKE_animsys_free_eval_plan(adt);
+      }
       if (id_type == ID_GR) {
         /* Collection content might have changed (children collection might have been added or
          * removed from the graph based on their inclusion and visibility flags). */
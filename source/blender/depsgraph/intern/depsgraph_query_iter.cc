@@ -115,11 +115,13 @@ bool deg_object_hide_original(eEvaluationMode eval_mode, Object *ob, DupliObject
   return false;
 }
 
-void deg_iterator_duplis_init(DEGObjectIterData *data, Object *object, ListBase *duplis)
+void deg_iterator_duplis_init(DEGObjectIterData *data,
+                              Object *object,
+                              blender::bke::DupliList *duplis)
 {
   data->dupli_parent = object;
   data->dupli_list = duplis;
-  data->dupli_object_next = static_cast<DupliObject *>(duplis->first);
+  data->dupli_object_next_index = 0;
 }
 
 /* Returns false when iterator is exhausted. */
@@ -129,11 +131,11 @@ bool deg_iterator_duplis_step(DEGObjectIterData *data)
     return false;
   }
 
-  while (data->dupli_object_next != nullptr) {
-    DupliObject *dob = data->dupli_object_next;
+  while (data->dupli_object_next_index < data->dupli_list->size()) {
+    DupliObject *dob = &(*data->dupli_list)[data->dupli_object_next_index];
     Object *obd = dob->ob;
 
-    data->dupli_object_next = data->dupli_object_next->next;
+    data->dupli_object_next_index++;
 
     if (dob->no_draw) {
       continue;
@@ -193,7 +195,7 @@ bool deg_iterator_duplis_step(DEGObjectIterData *data)
   free_object_duplilist(data->dupli_list);
   data->dupli_parent = nullptr;
   data->dupli_list = nullptr;
-  data->dupli_object_next = nullptr;
+  data->dupli_object_next_index = 0;
   data->dupli_object_current = nullptr;
   deg_invalidate_iterator_work_data(data);
   return false;
@@ -244,7 +246,7 @@ bool deg_iterator_objects_step(DEGObjectIterData *data)
 
     const bool use_preview = object_orig == data->object_orig_with_preview;
     if (use_preview) {
-      ListBase *preview_duplis = object_duplilist_preview(
+      blender::bke::DupliList *preview_duplis = object_duplilist_preview(
           data->graph, data->scene, object, data->settings->viewer_path);
       deg_iterator_duplis_init(data, object, preview_duplis);
       data->id_node_index++;
@@ -264,7 +266,7 @@ bool deg_iterator_objects_step(DEGObjectIterData *data)
       if ((data->flag & DEG_ITER_OBJECT_FLAG_DUPLI) &&
           ((object->transflag & OB_DUPLI) || object->runtime->geometry_set_eval != nullptr))
       {
-        ListBase *duplis = object_duplilist(data->graph, data->scene, object);
+        blender::bke::DupliList *duplis = object_duplilist(data->graph, data->scene, object);
         deg_iterator_duplis_init(data, object, duplis);
       }
     }
@@ -292,7 +294,7 @@ DEGObjectIterData &DEGObjectIterData::operator=(const DEGObjectIterData &other)
     this->next_object = other.next_object;
     this->dupli_parent = other.dupli_parent;
     this->dupli_list = other.dupli_list;
-    this->dupli_object_next = other.dupli_object_next;
+    this->dupli_object_next_index = other.dupli_object_next_index;
     this->dupli_object_current = other.dupli_object_current;
     this->temp_dupli_object = blender::dna::shallow_copy(other.temp_dupli_object);
     this->temp_dupli_object_runtime = other.temp_dupli_object_runtime;
@@ -351,7 +353,7 @@ void DEG_iterator_objects_begin(BLI_Iterator *iter, DEGObjectIterData *data)
   data->next_object = nullptr;
   data->dupli_parent = nullptr;
   data->dupli_list = nullptr;
-  data->dupli_object_next = nullptr;
+  data->dupli_object_next_index = 0;
   data->dupli_object_current = nullptr;
   data->scene = DEG_get_evaluated_scene(depsgraph);
   data->id_node_index = 0;
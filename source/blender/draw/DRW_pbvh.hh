@@ -82,7 +82,6 @@ struct PBVH_GPU_Args {
   SubdivCCG *subdiv_ccg;
   Span<int> grid_indices;
   CCGKey ccg_key;
-  Span<CCGElem *> grids;
 
   Span<int> prim_indices;
 
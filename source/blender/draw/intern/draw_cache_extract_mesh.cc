@@ -18,6 +18,7 @@
 
 #include "BLI_array.hh"
 #include "BLI_math_bits.h"
+#include "BLI_profile.hh"
 #include "BLI_task.h"
 #include "BLI_vector.hh"
 
@@ -430,6 +431,7 @@ BLI_INLINE void extract_task_range_run_iter(const MeshRenderData &mr,
 
 static void extract_task_range_run(void *__restrict taskdata)
 {
+  PROFILE_SCOPE("Mesh Extraction");
   ExtractTaskData *data = (ExtractTaskData *)taskdata;
   const eMRIterType iter_type = data->iter_type;
   const bool is_mesh = data->mr->extract_type != MR_EXTRACT_BMESH;
@@ -528,6 +530,7 @@ static void mesh_render_data_update_task_data_free(void *data)
 
 static void mesh_extract_render_data_node_exec(void *__restrict task_data)
 {
+  PROFILE_SCOPE("Mesh Render Data Update");
   MeshRenderDataUpdateTaskData *update_task_data = static_cast<MeshRenderDataUpdateTaskData *>(
       task_data);
   MeshRenderData &mr = *update_task_data->mr;
@@ -579,6 +582,7 @@ void mesh_buffer_cache_create_requested(TaskGraph *task_graph,
                                         const ToolSettings *ts,
                                         const bool use_hide)
 {
+  PROFILE_SCOPE_DETAIL("Mesh Extraction Setup", object->id.name + 2);
   /* For each mesh where batches needs to be updated a sub-graph will be added to the task_graph.
    * This sub-graph starts with an extract_render_data_node. This fills/converts the required
    * data from Mesh.
@@ -797,6 +801,7 @@ void mesh_buffer_cache_create_requested_subdiv(MeshBatchCache &cache,
                                                DRWSubdivCache &subdiv_cache,
                                                MeshRenderData &mr)
 {
+  PROFILE_SCOPE("Mesh Extraction Subdivision");
   /* Create an array containing all the extractors that needs to be executed. */
   ExtractorRunDatas extractors;
 
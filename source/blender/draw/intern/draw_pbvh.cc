@@ -486,7 +486,7 @@ struct PBVHBatches {
   void fill_vbo_grids_intern(
       PBVHVbo &vbo,
       const PBVH_GPU_Args &args,
-      FunctionRef<void(FunctionRef<void(int x, int y, int grid_index, CCGElem *elems[4], int i)>
+      FunctionRef<void(FunctionRef<void(int x, int y, int grid_index, const int elems[4], int i)>
                            func)> foreach_grids)
   {
     uint vert_per_grid = square_i(args.ccg_key.grid_size - 1) * 4;
@@ -503,14 +503,18 @@ struct PBVHBatches {
     GPUVertBufRaw access;
     GPU_vertbuf_attr_get_raw_data(vbo.vert_buf, 0, &access);
 
+    const SubdivCCG &subdiv_ccg = *args.subdiv_ccg;
+    const Span<float3> positions = subdiv_ccg.positions;
+    const Span<float3> normals = subdiv_ccg.normals;
+    const Span<float> masks = subdiv_ccg.masks;
+
     if (const CustomRequest *request_type = std::get_if<CustomRequest>(&vbo.request)) {
       switch (*request_type) {
         case CustomRequest::Position: {
-          foreach_grids([&](int /*x*/, int /*y*/, int /*grid_index*/, CCGElem *elems[4], int i) {
-            float *co = CCG_elem_co(&args.ccg_key, elems[i]);
-
-            *static_cast<float3 *>(GPU_vertbuf_raw_step(&access)) = co;
-          });
+          foreach_grids(
+              [&](int /*x*/, int /*y*/, int /*grid_index*/, const int elems[4], int i) {
+                *static_cast<float3 *>(GPU_vertbuf_raw_step(&access)) = positions[elems[i]];
+              });
           break;
         }
         case CustomRequest::Normal: {
@@ -519,21 +523,21 @@ struct PBVHBatches {
           const VArraySpan sharp_faces = *attributes.lookup<bool>("sharp_face",
                                                                   bke::AttrDomain::Face);
 
-          foreach_grids([&](int /*x*/, int /*y*/, int grid_index, CCGElem *elems[4], int /*i*/) {
+          foreach_grids([&](int /*x*/, int /*y*/, int grid_index, const int elems[4], int /*i*/) {
             float3 no(0.0f, 0.0f, 0.0f);
 
             const bool smooth = !(!sharp_faces.is_empty() &&
                                   sharp_faces[grid_to_face_map[grid_index]]);
 
             if (smooth) {
-              no = CCG_elem_no(&args.ccg_key, elems[0]);
+              no = normals[elems[0]];
             }
             else {
               normal_quad_v3(no,
-                             CCG_elem_co(&args.ccg_key, elems[3]),
-                             CCG_elem_co(&args.ccg_key, elems[2]),
-                             CCG_elem_co(&args.ccg_key, elems[1]),
-                             CCG_elem_co(&args.ccg_key, elems[0]));
+                             positions[elems[3]],
+                             positions[elems[2]],
+                             positions[elems[1]],
+                             positions[elems[0]]);
             }
 
             short sno[3];
@@ -546,11 +550,10 @@ struct PBVHBatches {
         }
         case CustomRequest::Mask: {
           if (args.ccg_key.has_mask) {
-            foreach_grids([&](int /*x*/, int /*y*/, int /*grid_index*/, CCGElem *elems[4], int i) {
-              float *mask = CCG_elem_mask(&args.ccg_key, elems[i]);
-
-              *static_cast<float *>(GPU_vertbuf_raw_step(&access)) = *mask;
-            });
+            foreach_grids(
+                [&](int /*x*/, int /*y*/, int /*grid_index*/, const int elems[4], int i) {
+                  *static_cast<float *>(GPU_vertbuf_raw_step(&access)) = masks[elems[i]];
+                });
           }
           else {
             MutableSpan(static_cast<float *>(GPU_vertbuf_get_data(vbo.vert_buf)),
@@ -566,7 +569,7 @@ struct PBVHBatches {
           {
             const VArraySpan<int> face_sets_span(face_sets);
             foreach_grids(
-                [&](int /*x*/, int /*y*/, int grid_index, CCGElem * /*elems*/[4], int /*i*/) {
+                [&](int /*x*/, int /*y*/, int grid_index, const int /*elems*/[4], int /*i*/) {
                   uchar face_set_color[4] = {UCHAR_MAX, UCHAR_MAX, UCHAR_MAX, UCHAR_MAX};
 
                   const int face_index = BKE_subdiv_ccg_grid_to_face_index(*args.subdiv_ccg,
@@ -585,7 +588,7 @@ struct PBVHBatches {
           else {
             const uchar white[4] = {UCHAR_MAX, UCHAR_MAX, UCHAR_MAX};
             foreach_grids(
-                [&](int /*x*/, int /*y*/, int /*grid_index*/, CCGElem * /*elems*/[4], int /*i*/) {
+                [&](int /*x*/, int /*y*/, int /*grid_index*/, const int /*elems*/[4], int /*i*/) {
                   *static_cast<uchar4 *>(GPU_vertbuf_raw_step(&access)) = white;
                 });
           }
@@ -615,19 +618,19 @@ struct PBVHBatches {
     uint totgrid = args.grid_indices.size();
 
     auto foreach_solid =
-        [&](FunctionRef<void(int x, int y, int grid_index, CCGElem *elems[4], int i)> func) {
+        [&](FunctionRef<void(int x, int y, int grid_index, const int elems[4], int i)> func) {
           for (int i = 0; i < totgrid; i++) {
             const int grid_index = args.grid_indices[i];
 
-            CCGElem *grid = args.grids[grid_index];
+            const int start = CCG_grid_range(args.ccg_key, grid_index).start();
 
             for (int y = 0; y < gridsize - 1; y++) {
               for (int x = 0; x < gridsize - 1; x++) {
-                CCGElem *elems[4] = {
-                    CCG_grid_elem(&args.ccg_key, grid, x, y),
-                    CCG_grid_elem(&args.ccg_key, grid, x + 1, y),
-                    CCG_grid_elem(&args.ccg_key, grid, x + 1, y + 1),
-                    CCG_grid_elem(&args.ccg_key, grid, x, y + 1),
+                const int elems[4] = {
+                    start + CCG_grid_xy_to_index(gridsize, x, y),
+                    start + CCG_grid_xy_to_index(gridsize, x + 1, y),
+                    start + CCG_grid_xy_to_index(gridsize, x + 1, y + 1),
+                    start + CCG_grid_xy_to_index(gridsize, x, y + 1),
                 };
 
                 func(x, y, grid_index, elems, 0);
@@ -640,22 +643,21 @@ struct PBVHBatches {
         };
 
     auto foreach_indexed =
-        [&](FunctionRef<void(int x, int y, int grid_index, CCGElem *elems[4], int i)> func) {
+        [&](FunctionRef<void(int x, int y, int grid_index, const int elems[4], int i)> func) {
           for (int i = 0; i < totgrid; i++) {
             const int grid_index = args.grid_indices[i];
 
-            CCGElem *grid = args.grids[grid_index];
+            const int start = CCG_grid_range(args.ccg_key, grid_index).start();
 
             for (int y = 0; y < gridsize; y++) {
               for (int x = 0; x < gridsize; x++) {
-                CCGElem *elems[4] = {
-                    CCG_grid_elem(&args.ccg_key, grid, x, y),
-                    CCG_grid_elem(&args.ccg_key, grid, min_ii(x + 1, gridsize - 1), y),
-                    CCG_grid_elem(&args.ccg_key,
-                                  grid,
-                                  min_ii(x + 1, gridsize - 1),
-                                  min_ii(y + 1, gridsize - 1)),
-                    CCG_grid_elem(&args.ccg_key, grid, x, min_ii(y + 1, gridsize - 1)),
+                const int next_x = min_ii(x + 1, gridsize - 1);
+                const int next_y = min_ii(y + 1, gridsize - 1);
+                const int elems[4] = {
+                    start + CCG_grid_xy_to_index(gridsize, x, y),
+                    start + CCG_grid_xy_to_index(gridsize, next_x, y),
+                    start + CCG_grid_xy_to_index(gridsize, next_x, next_y),
+                    start + CCG_grid_xy_to_index(gridsize, x, next_y),
                 };
 
                 func(x, y, grid_index, elems, 0);
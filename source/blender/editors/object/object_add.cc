@@ -2738,10 +2738,10 @@ static void make_object_duplilist_real(bContext *C,
     return;
   }
 
-  ListBase *lb_duplis = object_duplilist(depsgraph, scene, object_eval);
+  bke::DupliList *duplis = object_duplilist(depsgraph, scene, object_eval);
 
-  if (BLI_listbase_is_empty(lb_duplis)) {
-    free_object_duplilist(lb_duplis);
+  if (duplis->is_empty()) {
+    free_object_duplilist(duplis);
     return;
   }
 
@@ -2755,8 +2755,8 @@ static void make_object_duplilist_real(bContext *C,
     }
   }
 
-  LISTBASE_FOREACH (DupliObject *, dob, lb_duplis) {
-    Object *ob_src = DEG_get_original_object(dob->ob);
+  for (DupliObject &dob : *duplis) {
+    Object *ob_src = DEG_get_original_object(dob.ob);
     Object *ob_dst = static_cast<Object *>(ID_NEW_SET(ob_src, BKE_id_copy(bmain, &ob_src->id)));
     id_us_min(&ob_dst->id);
 
@@ -2791,31 +2791,31 @@ static void make_object_duplilist_real(bContext *C,
     id_us_min((ID *)ob_dst->instance_collection);
     ob_dst->instance_collection = nullptr;
 
-    copy_m4_m4(ob_dst->runtime->object_to_world.ptr(), dob->mat);
+    copy_m4_m4(ob_dst->runtime->object_to_world.ptr(), dob.mat);
     BKE_object_apply_mat4(ob_dst, ob_dst->object_to_world().ptr(), false, false);
 
-    BLI_ghash_insert(dupli_gh, dob, ob_dst);
+    BLI_ghash_insert(dupli_gh, &dob, ob_dst);
     if (parent_gh) {
       void **val;
       /* Due to nature of hash/comparison of this ghash, a lot of duplis may be considered as
        * 'the same', this avoids trying to insert same key several time and
        * raise asserts in debug builds... */
-      if (!BLI_ghash_ensure_p(parent_gh, dob, &val)) {
+      if (!BLI_ghash_ensure_p(parent_gh, &dob, &val)) {
         *val = ob_dst;
       }
 
       if (is_dupli_instancer && instancer_gh) {
         /* Same as above, we may have several 'hits'. */
-        if (!BLI_ghash_ensure_p(instancer_gh, dob, &val)) {
+        if (!BLI_ghash_ensure_p(instancer_gh, &dob, &val)) {
           *val = ob_dst;
         }
       }
     }
   }
 
-  LISTBASE_FOREACH (DupliObject *, dob, lb_duplis) {
-    Object *ob_src = dob->ob;
-    Object *ob_dst = static_cast<Object *>(BLI_ghash_lookup(dupli_gh, dob));
+  for (DupliObject &dob : *duplis) {
+    Object *ob_src = dob.ob;
+    Object *ob_dst = static_cast<Object *>(BLI_ghash_lookup(dupli_gh, &dob));
 
     /* Remap new object to itself, and clear again newid pointer of orig object. */
     BKE_libblock_relink_to_newid(bmain, &ob_dst->id, 0);
@@ -2833,14 +2833,14 @@ static void make_object_duplilist_real(bContext *C,
          * they won't be read, this is simply for a hash lookup. */
         DupliObject dob_key;
         dob_key.ob = ob_src_par;
-        dob_key.type = dob->type;
-        if (dob->type == OB_DUPLICOLLECTION) {
+        dob_key.type = dob.type;
+        if (dob.type == OB_DUPLICOLLECTION) {
           memcpy(&dob_key.persistent_id[1],
-                 &dob->persistent_id[1],
-                 sizeof(dob->persistent_id[1]) * (MAX_DUPLI_RECUR - 1));
+                 &dob.persistent_id[1],
+                 sizeof(dob.persistent_id[1]) * (MAX_DUPLI_RECUR - 1));
         }
         else {
-          dob_key.persistent_id[0] = dob->persistent_id[0];
+          dob_key.persistent_id[0] = dob.persistent_id[0];
         }
         ob_dst_par = static_cast<Object *>(BLI_ghash_lookup(parent_gh, &dob_key));
       }
@@ -2869,7 +2869,7 @@ static void make_object_duplilist_real(bContext *C,
          * ignoring the first item.
          * We only check on persistent_id here, since we have no idea what object it might be. */
         memcpy(&dob_key.persistent_id[0],
-               &dob->persistent_id[1],
+               &dob.persistent_id[1],
                sizeof(dob_key.persistent_id[0]) * (MAX_DUPLI_RECUR - 1));
         ob_dst_par = static_cast<Object *>(BLI_ghash_lookup(instancer_gh, &dob_key));
       }
@@ -2887,7 +2887,7 @@ static void make_object_duplilist_real(bContext *C,
     if (ob_dst->parent) {
       /* NOTE: this may be the parent of other objects, but it should
        * still work out ok */
-      BKE_object_apply_mat4(ob_dst, dob->mat, false, true);
+      BKE_object_apply_mat4(ob_dst, dob.mat, false, true);
 
       /* to set ob_dst->orig and in case there's any other discrepancies */
       DEG_id_tag_update(&ob_dst->id, ID_RECALC_TRANSFORM);
@@ -2909,7 +2909,7 @@ static void make_object_duplilist_real(bContext *C,
     BLI_ghash_free(instancer_gh, nullptr, nullptr);
   }
 
-  free_object_duplilist(lb_duplis);
+  free_object_duplilist(duplis);
 
   BKE_main_id_newptr_and_tag_clear(bmain);
 
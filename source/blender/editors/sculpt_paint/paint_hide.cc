@@ -480,7 +480,7 @@ static void partialvis_masked_update_grids(Depsgraph &depsgraph,
 
   const bool value = action_to_hide(action);
   const CCGKey key = *BKE_pbvh_get_grid_key(pbvh);
-  const Span<CCGElem *> grids = subdiv_ccg.grids;
+  const Span<float> masks = subdiv_ccg.masks;
   if (!key.has_mask) {
     grid_hide_update(depsgraph,
                      object,
@@ -490,13 +490,10 @@ static void partialvis_masked_update_grids(Depsgraph &depsgraph,
   else {
     grid_hide_update(
         depsgraph, object, nodes, [&](const int grid_index, MutableBoundedBitSpan hide) {
-          CCGElem *grid = grids[grid_index];
-          for (const int y : IndexRange(key.grid_size)) {
-            for (const int x : IndexRange(key.grid_size)) {
-              CCGElem *elem = CCG_grid_elem(&key, grid, x, y);
-              if (*CCG_elem_mask(&key, elem) > 0.5f) {
-                hide[y * key.grid_size + x].set(value);
-              }
+          const Span<float> grid_masks = masks.slice(CCG_grid_range(key, grid_index));
+          for (const int i : grid_masks.index_range()) {
+            if (grid_masks[i] > 0.5f) {
+              hide[i].set(value);
             }
           }
         });
@@ -772,17 +769,15 @@ static void partialvis_gesture_update_grids(Depsgraph &depsgraph,
 
   const bool value = action_to_hide(action);
   const CCGKey key = *BKE_pbvh_get_grid_key(pbvh);
-  const Span<CCGElem *> grids = subdiv_ccg->grids;
+  const Span<float3> positions = subdiv_ccg->positions;
+  const Span<float3> normals = subdiv_ccg->normals;
   grid_hide_update(
       depsgraph, *object, nodes, [&](const int grid_index, MutableBoundedBitSpan hide) {
-        CCGElem *grid = grids[grid_index];
-        for (const int y : IndexRange(key.grid_size)) {
-          for (const int x : IndexRange(key.grid_size)) {
-            CCGElem *elem = CCG_grid_elem(&key, grid, x, y);
-            if (gesture::is_affected(
-                    gesture_data, CCG_elem_co(&key, elem), CCG_elem_no(&key, elem))) {
-              hide[y * key.grid_size + x].set(value);
-            }
+        const IndexRange grid_range = CCG_grid_range(key, grid_index);
+        for (const int i : IndexRange(key.grid_area)) {
+          const int elem = grid_range[i];
+          if (gesture::is_affected(gesture_data, positions[elem], normals[elem])) {
+            hide[i].set(value);
           }
         }
       });
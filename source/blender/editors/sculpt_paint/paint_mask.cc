@@ -62,18 +62,10 @@ Array<float> duplicate_mask(const Object &object)
     case PBVH_GRIDS: {
       const SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
       const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-      const Span<CCGElem *> grids = subdiv_ccg.grids;
-
-      Array<float> result(grids.size() * key.grid_area);
-      int index = 0;
-      for (const int grid : grids.index_range()) {
-        CCGElem *elem = grids[grid];
-        for (const int i : IndexRange(key.grid_area)) {
-          result[index] = *CCG_elem_offset_mask(&key, elem, i);
-          index++;
-        }
+      if (!key.has_mask) {
+        return Array<float>(subdiv_ccg.grids_num * key.grid_area, 0.0f);
       }
-      return result;
+      return Array<float>(subdiv_ccg.masks.as_span());
     }
     case PBVH_BMESH: {
       BMesh &bm = *ss.bm;
@@ -279,19 +271,16 @@ static void fill_mask_grids(Main &bmain,
 
   const BitGroupVector<> &grid_hidden = subdiv_ccg.grid_hidden;
 
-  const Span<CCGElem *> grids = subdiv_ccg.grids;
+  const MutableSpan<float> masks = subdiv_ccg.masks;
   bool any_changed = false;
   threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
     for (PBVHNode *node : nodes.slice(range)) {
       const Span<int> grid_indices = bke::pbvh::node_grid_indices(*node);
       if (std::all_of(grid_indices.begin(), grid_indices.end(), [&](const int grid) {
-            CCGElem *elem = grids[grid];
-            for (const int i : IndexRange(key.grid_area)) {
-              if (*CCG_elem_offset_mask(&key, elem, i) != value) {
-                return false;
-              }
-            }
-            return true;
+            const Span<float> grid_masks = masks.slice(CCG_grid_range(key, grid));
+            return std::all_of(grid_masks.begin(), grid_masks.end(), [&](const float mask) {
+              return mask == value;
+            });
           }))
       {
         continue;
@@ -300,18 +289,13 @@ static void fill_mask_grids(Main &bmain,
 
       if (grid_hidden.is_empty()) {
         for (const int grid : grid_indices) {
-          CCGElem *elem = grids[grid];
-          for (const int i : IndexRange(key.grid_area)) {
-            *CCG_elem_offset_mask(&key, elem, i) = value;
-          }
+          masks.slice(CCG_grid_range(key, grid)).fill(value);
         }
       }
       else {
         for (const int grid : grid_indices) {
-          CCGElem *elem = grids[grid];
-          bits::foreach_0_index(grid_hidden[grid], [&](const int i) {
-            *CCG_elem_offset_mask(&key, elem, i) = value;
-          });
+          const MutableSpan<float> grid_masks = masks.slice(CCG_grid_range(key, grid));
+          bits::foreach_0_index(grid_hidden[grid], [&](const int i) { grid_masks[i] = value; });
         }
       }
       BKE_pbvh_node_mark_redraw(node);
@@ -417,7 +401,7 @@ static void invert_mask_grids(Main &bmain,
   const BitGroupVector<> &grid_hidden = subdiv_ccg.grid_hidden;
 
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> grids = subdiv_ccg.grids;
+  const MutableSpan<float> masks = subdiv_ccg.masks;
   threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
     for (PBVHNode *node : nodes.slice(range)) {
       undo::push_node(object, node, undo::Type::Mask);
@@ -425,22 +409,20 @@ static void invert_mask_grids(Main &bmain,
       const Span<int> grid_indices = bke::pbvh::node_grid_indices(*node);
       if (grid_hidden.is_empty()) {
         for (const int grid : grid_indices) {
-          CCGElem *elem = grids[grid];
-          for (const int i : IndexRange(key.grid_area)) {
-            *CCG_elem_offset_mask(&key, elem, i) = 1.0f - *CCG_elem_offset_mask(&key, elem, i);
+          for (float &mask : masks.slice(CCG_grid_range(key, grid))) {
+            mask = 1.0f - mask;
           }
         }
       }
       else {
         for (const int grid : grid_indices) {
-          CCGElem *elem = grids[grid];
-          bits::foreach_0_index(grid_hidden[grid], [&](const int i) {
-            *CCG_elem_offset_mask(&key, elem, i) = 1.0f - *CCG_elem_offset_mask(&key, elem, i);
-          });
+          const MutableSpan<float> grid_masks = masks.slice(CCG_grid_range(key, grid));
+          bits::foreach_0_index(grid_hidden[grid],
+                                [&](const int i) { grid_masks[i] = 1.0f - grid_masks[i]; });
         }
       }
       BKE_pbvh_node_mark_update_mask(node);
-      bke::pbvh::node_update_mask_grids(key, grids, *node);
+      bke::pbvh::node_update_mask_grids(key, masks, *node);
     }
   });
 
@@ -188,11 +188,7 @@ const float *SCULPT_vertex_co_get(const SculptSession *ss, PBVHVertRef vertex)
     case PBVH_BMESH:
       return ((BMVert *)vertex.i)->co;
     case PBVH_GRIDS: {
-      const CCGKey *key = BKE_pbvh_get_grid_key(*ss->pbvh);
-      const int grid_index = vertex.i / key->grid_area;
-      const int index_in_grid = vertex.i - grid_index * key->grid_area;
-      CCGElem *elem = ss->subdiv_ccg->grids[grid_index];
-      return CCG_elem_co(key, CCG_elem_offset(key, elem, index_in_grid));
+      return ss->subdiv_ccg->positions[vertex.i];
     }
   }
   return nullptr;
@@ -245,11 +241,7 @@ void SCULPT_vertex_normal_get(const SculptSession *ss, PBVHVertRef vertex, float
       break;
     }
     case PBVH_GRIDS: {
-      const CCGKey *key = BKE_pbvh_get_grid_key(*ss->pbvh);
-      const int grid_index = vertex.i / key->grid_area;
-      const int index_in_grid = vertex.i - grid_index * key->grid_area;
-      CCGElem *elem = ss->subdiv_ccg->grids[grid_index];
-      copy_v3_v3(no, CCG_elem_no(key, CCG_elem_offset(key, elem, index_in_grid)));
+      copy_v3_v3(no, ss->subdiv_ccg->normals[vertex.i]);
       break;
     }
   }
@@ -316,13 +308,10 @@ float SCULPT_mask_get_at_grids_vert_index(const SubdivCCG &subdiv_ccg,
                                           const CCGKey &key,
                                           const int vert_index)
 {
-  if (key.mask_offset == -1) {
+  if (!key.has_mask) {
     return 0.0f;
   }
-  const int grid_index = vert_index / key.grid_area;
-  const int index_in_grid = vert_index - grid_index * key.grid_area;
-  CCGElem *elem = subdiv_ccg.grids[grid_index];
-  return *CCG_elem_offset_mask(&key, elem, index_in_grid);
+  return subdiv_ccg.masks[vert_index];
 }
 
 PBVHVertRef SCULPT_active_vertex_get(SculptSession *ss)
@@ -762,7 +751,7 @@ static void sculpt_vertex_neighbors_get_grids(const SculptSession *ss,
 {
   /* TODO: optimize this. We could fill #SculptVertexNeighborIter directly,
    * maybe provide coordinate and mask pointers directly rather than converting
-   * back and forth between #CCGElem and global index. */
+   * back and forth between #SubdivCCGCoord and global index. */
   const CCGKey *key = BKE_pbvh_get_grid_key(*ss->pbvh);
   const int grid_index = vertex.i / key->grid_area;
   const int index_in_grid = vertex.i - grid_index * key->grid_area;
@@ -1340,16 +1329,16 @@ static void restore_mask(Object &object, const Span<PBVHNode *> nodes)
       SubdivCCG &subdiv_ccg = *ss->subdiv_ccg;
       const BitGroupVector<> grid_hidden = subdiv_ccg.grid_hidden;
       const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-      const Span<CCGElem *> grids = subdiv_ccg.grids;
+      const MutableSpan<float> masks = subdiv_ccg.masks;
       threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
         for (PBVHNode *node : nodes.slice(range)) {
           if (undo::Node *unode = undo::get_node(node, undo::Type::Mask)) {
             int index = 0;
             for (const int grid : unode->grids) {
-              CCGElem *elem = grids[grid];
+              const IndexRange grid_range = CCG_grid_range(key, grid);
               for (const int i : IndexRange(key.grid_area)) {
                 if (grid_hidden.is_empty() || !grid_hidden[grid][i]) {
-                  *CCG_elem_offset_mask(&key, elem, i) = unode->mask[index];
+                  masks[grid_range[i]] = unode->mask[index];
                 }
                 index++;
               }
@@ -1466,16 +1455,16 @@ static void restore_position(Object &object, const Span<PBVHNode *> nodes)
       SubdivCCG &subdiv_ccg = *ss->subdiv_ccg;
       const BitGroupVector<> grid_hidden = subdiv_ccg.grid_hidden;
       const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-      const Span<CCGElem *> grids = subdiv_ccg.grids;
+      const MutableSpan<float3> positions = subdiv_ccg.positions;
       threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
         for (PBVHNode *node : nodes.slice(range)) {
           if (undo::Node *unode = undo::get_node(node, undo::Type::Position)) {
             int index = 0;
             for (const int grid : unode->grids) {
-              CCGElem *elem = grids[grid];
+              const IndexRange grid_range = CCG_grid_range(key, grid);
               for (const int i : IndexRange(key.grid_area)) {
                 if (grid_hidden.is_empty() || !grid_hidden[grid][i]) {
-                  copy_v3_v3(CCG_elem_offset_co(&key, elem, i), unode->position[index]);
+                  positions[grid_range[i]] = unode->position[index];
                 }
                 index++;
               }
@@ -1186,18 +1186,8 @@ static void write_mask_data(SculptSession *ss, const Span<float> mask)
       break;
     }
     case PBVH_GRIDS: {
-      const SubdivCCG &subdiv_ccg = *ss->subdiv_ccg;
-      const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-      const Span<CCGElem *> grids = subdiv_ccg.grids;
-
-      int index = 0;
-      for (const int grid : grids.index_range()) {
-        CCGElem *elem = grids[grid];
-        for (const int i : IndexRange(key.grid_area)) {
-          *CCG_elem_offset_mask(&key, elem, i) = mask[index];
-          index++;
-        }
-      }
+      SubdivCCG &subdiv_ccg = *ss->subdiv_ccg;
+      subdiv_ccg.masks.as_mutable_span().copy_from(mask);
       break;
     }
   }
@@ -2067,14 +2057,9 @@ static bool any_nonzero_mask(const Object &object)
       if (!key.has_mask) {
         return false;
       }
-      return std::any_of(subdiv_ccg.grids.begin(), subdiv_ccg.grids.end(), [&](CCGElem *elem) {
-        for (const int i : IndexRange(key.grid_area)) {
-          if (*CCG_elem_offset_mask(&key, elem, i) > 0.0f) {
-            return true;
-          }
-        }
-        return false;
-      });
+      const Span<float> masks = subdiv_ccg.masks;
+      return std::any_of(
+          masks.begin(), masks.end(), [&](const float value) { return value > 0.0f; });
     }
     case PBVH_BMESH: {
       BMesh &bm = *ss.bm;
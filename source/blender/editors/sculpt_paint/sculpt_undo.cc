@@ -506,13 +506,12 @@ static bool restore_coords(bContext *C,
     const Span<int> grid_indices = unode.grids;
 
     MutableSpan<float3> position = unode.position;
-    MutableSpan<CCGElem *> grids = subdiv_ccg->grids;
+    MutableSpan<float3> positions = subdiv_ccg->positions;
 
     int index = 0;
     for (const int i : grid_indices.index_range()) {
-      CCGElem *grid = grids[grid_indices[i]];
-      for (const int j : IndexRange(key.grid_area)) {
-        swap_v3_v3(CCG_elem_offset_co(&key, grid, j), position[index]);
+      for (const int j : CCG_grid_range(key, grid_indices[i])) {
+        std::swap(positions[j], position[index]);
         index++;
       }
     }
@@ -643,13 +642,12 @@ static bool restore_mask(Object &object, Node &unode, MutableSpan<bool> modified
     const CCGKey key = BKE_subdiv_ccg_key_top_level(*subdiv_ccg);
 
     MutableSpan<float> mask = unode.mask;
-    MutableSpan<CCGElem *> grids = subdiv_ccg->grids;
+    MutableSpan<float> masks = subdiv_ccg->masks;
 
     int index = 0;
     for (const int grid : unode.grids) {
-      CCGElem *elem = grids[grid];
-      for (const int j : IndexRange(key.grid_area)) {
-        std::swap(*CCG_elem_offset_mask(&key, elem, j), mask[index]);
+      for (const int j : CCG_grid_range(key, grid)) {
+        std::swap(masks[j], mask[index]);
         index++;
       }
     }
@@ -952,7 +950,7 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, UndoSculpt &usculpt)
       }
     }
     else if (unode->mesh_grids_num && subdiv_ccg != nullptr) {
-      if ((subdiv_ccg->grids.size() != unode->mesh_grids_num) ||
+      if ((subdiv_ccg->grids_num != unode->mesh_grids_num) ||
           (subdiv_ccg->grid_size != unode->grid_size))
       {
         continue;
@@ -1193,7 +1191,7 @@ static Node *alloc_node(const Object &object, const PBVHNode *node, const Type t
 
   int verts_num;
   if (BKE_pbvh_type(*ss->pbvh) == PBVH_GRIDS) {
-    unode->mesh_grids_num = ss->subdiv_ccg->grids.size();
+    unode->mesh_grids_num = ss->subdiv_ccg->grids_num;
     unode->grid_size = ss->subdiv_ccg->grid_size;
 
     unode->grids = bke::pbvh::node_grid_indices(*node);
@@ -1306,25 +1304,17 @@ static void store_coords(const Object &object, Node *unode)
   if (!unode->grids.is_empty()) {
     const SubdivCCG &subdiv_ccg = *ss->subdiv_ccg;
     const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-    const Span<CCGElem *> grids = subdiv_ccg.grids;
-    {
-      int index = 0;
-      for (const int grid : unode->grids) {
-        CCGElem *elem = grids[grid];
-        for (const int i : IndexRange(key.grid_area)) {
-          unode->position[index] = float3(CCG_elem_offset_co(&key, elem, i));
-          index++;
-        }
-      }
+    const Span<int> grids = unode->grids;
+    for (const int i : grids.index_range()) {
+      unode->position.as_mutable_span()
+          .slice(i * key.grid_area, key.grid_area)
+          .copy_from(subdiv_ccg.positions.as_span().slice(CCG_grid_range(key, grids[i])));
     }
     if (key.has_normals) {
-      int index = 0;
-      for (const int grid : unode->grids) {
-        CCGElem *elem = grids[grid];
-        for (const int i : IndexRange(key.grid_area)) {
-          unode->normal[index] = float3(CCG_elem_offset_no(&key, elem, i));
-          index++;
-        }
+      for (const int i : grids.index_range()) {
+        unode->normal.as_mutable_span()
+            .slice(i * key.grid_area, key.grid_area)
+            .copy_from(subdiv_ccg.normals.as_span().slice(CCG_grid_range(key, grids[i])));
       }
     }
   }
@@ -1387,14 +1377,11 @@ static void store_mask(const Object &object, Node *unode)
     const SubdivCCG &subdiv_ccg = *ss->subdiv_ccg;
     const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
     if (key.has_mask) {
-      const Span<CCGElem *> grids = subdiv_ccg.grids;
-      int index = 0;
-      for (const int grid : unode->grids) {
-        CCGElem *elem = grids[grid];
-        for (const int i : IndexRange(key.grid_area)) {
-          unode->mask[index] = *CCG_elem_offset_mask(&key, elem, i);
-          index++;
-        }
+      const Span<int> grids = unode->grids;
+      for (const int i : grids.index_range()) {
+        unode->mask.as_mutable_span()
+            .slice(i * key.grid_area, key.grid_area)
+            .copy_from(subdiv_ccg.masks.as_span().slice(CCG_grid_range(key, grids[i])));
       }
     }
     else {
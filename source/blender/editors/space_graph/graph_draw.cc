@@ -11,6 +11,7 @@
 #include <cstdio>
 #include <cstring>
 
+#include "BLI_array.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
@@ -684,17 +685,9 @@ static void draw_fcurve_curve(bAnimContext *ac,
                           eval_start;
   const float eval_end = BKE_nla_tweakedit_remap(adt, etime, NLATIME_CONVERT_UNMAP);
 
-  immBegin(GPU_PRIM_LINE_STRIP, (total_samples + 1));
-
-  /* At each sampling interval, add a new vertex.
-   *
-   * Apply the unit correction factor to the calculated values so that the displayed values appear
-   * correctly in the viewport.
-   */
+  /* At each sampling interval, add a new vertex. */
+  blender::Array<float> eval_times(total_samples + 1);
   for (int i = 0; i < total_samples; i++) {
-    const float ctime = stime + i * samplefreq;
-    float eval_time = eval_start + i * eval_freq;
-
     /* Prevent drawing past bounds, due to floating point problems.
      * User-wise, prevent visual flickering.
      *
@@ -702,13 +695,8 @@ static void draw_fcurve_curve(bAnimContext *ac,
      * eval_start + total_samples * eval_freq > eval_end
      * due to floating point problems.
      */
-    if (eval_time > eval_end) {
-      eval_time = eval_end;
-    }
-
-    immVertex2f(pos, ctime, (evaluate_fcurve(&fcurve_for_draw, eval_time) + offset) * unitFac);
+    eval_times[i] = std::min(eval_start + i * eval_freq, eval_end);
   }
-
   /* Ensure we include end boundary point.
    * User-wise, prevent visual flickering.
    *
@@ -716,7 +704,21 @@ static void draw_fcurve_curve(bAnimContext *ac,
    * eval_start + total_samples * eval_freq < eval_end
    * due to floating point problems.
    */
-  immVertex2f(pos, etime, (evaluate_fcurve(&fcurve_for_draw, eval_end) + offset) * unitFac);
+  eval_times[total_samples] = eval_end;
+
+  /* Evaluate all samples at once, which is faster than evaluating them one by one. */
+  blender::Array<float> values(total_samples + 1);
+  evaluate_fcurve_batch(&fcurve_for_draw, eval_times, values);
+
+  /* Apply the unit correction factor to the calculated values so that the displayed values appear
+   * correctly in the viewport.
+   */
+  immBegin(GPU_PRIM_LINE_STRIP, (total_samples + 1));
+  for (int i = 0; i < total_samples; i++) {
+    const float ctime = stime + i * samplefreq;
+    immVertex2f(pos, ctime, (values[i] + offset) * unitFac);
+  }
+  immVertex2f(pos, etime, (values[total_samples] + offset) * unitFac);
 
   immEnd();
 }
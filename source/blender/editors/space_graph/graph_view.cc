@@ -10,8 +10,11 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_rect.h"
+#include "BLI_vector.hh"
 
 #include "DNA_anim_types.h"
 #include "DNA_scene_types.h"
@@ -400,37 +403,40 @@ static void create_ghost_curves(bAnimContext *ac, int start, int end)
   ANIM_animdata_filter(
       ac, &anim_data, eAnimFilter_Flags(filter), ac->data, eAnimCont_Types(ac->datatype));
 
-  /* Loop through filtered data and add keys between selected keyframes on every frame. */
+  struct GhostCurveSource {
+    FCurve *fcu;
+    FCurve *gcu;
+    ChannelDriver *driver;
+    float unit_fac;
+    float offset;
+  };
+  /* Curves with the same NLA mapping are sampled at the same frames, so they are evaluated
+   * together. */
+  blender::Map<AnimData *, blender::Vector<GhostCurveSource>> sources_by_adt;
+  const int samples_num = end - start + 1;
+  const short mapping_flag = ANIM_get_normalization_flags(ac->sl);
+
   LISTBASE_FOREACH (bAnimListElem *, ale, &anim_data) {
     FCurve *fcu = (FCurve *)ale->key_data;
     FCurve *gcu = BKE_fcurve_create();
-    AnimData *adt = ANIM_nla_mapping_get(ac, ale);
-    ChannelDriver *driver = fcu->driver;
-    FPoint *fpt;
-    float unitFac, offset;
-    int cfra;
-    short mapping_flag = ANIM_get_normalization_flags(ac->sl);
+    GhostCurveSource source;
+    source.fcu = fcu;
+    source.gcu = gcu;
+    source.driver = fcu->driver;
 
     /* Disable driver so that it don't muck up the sampling process. */
     fcu->driver = nullptr;
 
     /* Calculate unit-mapping factor. */
-    unitFac = ANIM_unit_mapping_get_factor(ac->scene, ale->id, fcu, mapping_flag, &offset);
+    source.unit_fac = ANIM_unit_mapping_get_factor(
+        ac->scene, ale->id, fcu, mapping_flag, &source.offset);
 
     /* Create samples, but store them in a new curve
      * - we cannot use fcurve_store_samples() as that will only overwrite the original curve.
      */
-    gcu->fpt = fpt = static_cast<FPoint *>(
-        MEM_callocN(sizeof(FPoint) * (end - start + 1), "Ghost FPoint Samples"));
-    gcu->totvert = end - start + 1;
-
-    /* Use the sampling callback at 1-frame intervals from start to end frames. */
-    for (cfra = start; cfra <= end; cfra++, fpt++) {
-      float cfrae = BKE_nla_tweakedit_remap(adt, cfra, NLATIME_CONVERT_UNMAP);
-
-      fpt->vec[0] = cfrae;
-      fpt->vec[1] = (fcurve_samplingcb_evalcurve(fcu, nullptr, cfrae) + offset) * unitFac;
-    }
+    gcu->fpt = static_cast<FPoint *>(
+        MEM_callocN(sizeof(FPoint) * samples_num, "Ghost FPoint Samples"));
+    gcu->totvert = samples_num;
 
     /* Set color of ghost curve
      * - make the color slightly darker.
@@ -442,8 +448,38 @@ static void create_ghost_curves(bAnimContext *ac, int start, int end)
     /* Store new ghost curve. */
     BLI_addtail(&sipo->runtime.ghost_curves, gcu);
 
-    /* Restore driver. */
-    fcu->driver = driver;
+    sources_by_adt.lookup_or_add_default(ANIM_nla_mapping_get(ac, ale)).append(source);
+  }
+
+  for (const auto item : sources_by_adt.items()) {
+    AnimData *adt = item.key;
+    const blender::Span<GhostCurveSource> sources = item.value;
+
+    /* Sample the curves at 1-frame intervals from start to end frames. */
+    blender::Array<float> frames(samples_num);
+    for (int cfra = start; cfra <= end; cfra++) {
+      frames[cfra - start] = BKE_nla_tweakedit_remap(adt, cfra, NLATIME_CONVERT_UNMAP);
+    }
+    blender::Array<FCurve *> fcurves(sources.size());
+    for (const int i : sources.index_range()) {
+      fcurves[i] = sources[i].fcu;
+    }
+    blender::Array<float> values(sources.size() * samples_num);
+    evaluate_fcurves_batch(fcurves, frames, values);
+
+    for (const int i : sources.index_range()) {
+      const GhostCurveSource &source = sources[i];
+      const blender::Span<float> curve_values = values.as_span().slice(i * samples_num,
+                                                                       samples_num);
+      for (const int sample : frames.index_range()) {
+        source.gcu->fpt[sample].vec[0] = frames[sample];
+        source.gcu->fpt[sample].vec[1] = (curve_values[sample] + source.offset) *
+                                         source.unit_fac;
+      }
+
+      /* Restore driver. */
+      source.fcu->driver = source.driver;
+    }
   }
 
   /* Admin and redraws. */
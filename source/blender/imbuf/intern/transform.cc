@@ -9,6 +9,7 @@
 
 #include <type_traits>
 
+#include "BLI_array.hh"
 #include "BLI_math_color_blend.h"
 #include "BLI_math_interp.hh"
 #include "BLI_math_matrix.hh"
@@ -296,6 +297,30 @@ static void process_scanlines(const TransformContext &ctx, IndexRange y_range)
       }
     }
   }
+  else if constexpr (Filter == IMB_FILTER_BILINEAR && SrcChannels == 4 && !CropSource && !WrapUV)
+  {
+    /* One sample per pixel, with all pixels of a scanline sampled as one batch.
+     * Note: sample at pixel center for proper filtering. Bilinear interpolation uses `floor(uv)`
+     * and `floor(uv)+1` texels, so subtract 0.5 to map between pixel and texel spaces. */
+    float2 uv_start = ctx.start_uv + ctx.add_x * 0.5f + ctx.add_y * 0.5f - 0.5f;
+    Array<float2> uvs(ctx.dst_region_x_range.size());
+    for (int yi : y_range) {
+      T *output = init_pixel_pointer<T>(ctx.dst, ctx.dst_region_x_range.first(), yi);
+      float2 uv_row = uv_start + yi * ctx.add_y;
+      for (const int64_t i : uvs.index_range()) {
+        uvs[i] = uv_row + ctx.dst_region_x_range[i] * ctx.add_x;
+      }
+      MutableSpan<VecBase<T, 4>> dst(reinterpret_cast<VecBase<T, 4> *>(output), uvs.size());
+      if constexpr (std::is_same_v<T, float>) {
+        math::interpolate_bilinear_fl(
+            ctx.src->float_buffer.data, ctx.src->x, ctx.src->y, uvs, dst);
+      }
+      else {
+        math::interpolate_bilinear_byte(
+            ctx.src->byte_buffer.data, ctx.src->x, ctx.src->y, uvs, dst);
+      }
+    }
+  }
   else {
     /* One sample per pixel. Note: sample at pixel center for proper filtering. */
     float2 uv_start = ctx.start_uv + ctx.add_x * 0.5f + ctx.add_y * 0.5f;
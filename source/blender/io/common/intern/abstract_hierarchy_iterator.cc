@@ -286,27 +286,25 @@ void AbstractHierarchyIterator::export_graph_construct()
     }
 
     /* Export the duplicated objects instanced by this object. */
-    ListBase *lb = object_duplilist(depsgraph_, scene, object);
-    if (lb) {
-      DupliParentFinder dupli_parent_finder;
-
-      LISTBASE_FOREACH (DupliObject *, dupli_object, lb) {
-        PersistentID persistent_id(dupli_object);
-        if (!should_visit_dupli_object(dupli_object)) {
-          continue;
-        }
-        dupli_parent_finder.insert(dupli_object);
+    bke::DupliList *duplis = object_duplilist(depsgraph_, scene, object);
+    DupliParentFinder dupli_parent_finder;
+
+    for (DupliObject &dupli_object : *duplis) {
+      PersistentID persistent_id(&dupli_object);
+      if (!should_visit_dupli_object(&dupli_object)) {
+        continue;
       }
+      dupli_parent_finder.insert(&dupli_object);
+    }
 
-      LISTBASE_FOREACH (DupliObject *, dupli_object, lb) {
-        if (!should_visit_dupli_object(dupli_object)) {
-          continue;
-        }
-        visit_dupli_object(dupli_object, object, dupli_parent_finder);
+    for (DupliObject &dupli_object : *duplis) {
+      if (!should_visit_dupli_object(&dupli_object)) {
+        continue;
       }
+      visit_dupli_object(&dupli_object, object, dupli_parent_finder);
     }
 
-    free_object_duplilist(lb);
+    free_object_duplilist(duplis);
   }
   DEG_OBJECT_ITER_END;
 }
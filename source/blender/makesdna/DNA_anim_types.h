@@ -1157,6 +1157,8 @@ typedef struct AnimData {
 
   /** Runtime data, for depsgraph evaluation. */
   FCurve **driver_array;
+  /** Runtime data, resolved F-Curve targets of the active action (see `anim_sys.cc`). */
+  struct AnimDataEvalPlan *eval_plan;
 
   /**
    * Active Animation data-block. If this is set, `action` and NLA-related
@@ -22,6 +22,10 @@
 
 namespace blender {
 template<typename T> struct Bounds;
+namespace index_mask {
+class IndexMask;
+}  // namespace index_mask
+using index_mask::IndexMask;
 namespace offset_indices {
 template<typename T> struct GroupedSpan;
 template<typename T> class OffsetIndices;
@@ -397,6 +401,11 @@ typedef struct Mesh {
 
   /** Call after changing vertex positions to tag lazily calculated caches for recomputation. */
   void tag_positions_changed();
+  /**
+   * Call after changing the positions of some vertices. Cached normals and triangulation are
+   * updated for the faces using these vertices, instead of being recomputed from scratch.
+   */
+  void tag_positions_changed(const blender::IndexMask &changed_verts);
   /** Call after moving every mesh vertex by the same translation. */
   void tag_positions_changed_uniformly();
   /** Like #tag_positions_changed but doesn't tag normals; they must be updated separately. */
@@ -66,6 +66,25 @@ static void init_data(ModifierData *md)
   dtmd->flags = MOD_DATATRANSFER_OBSRC_TRANSFORM;
 }
 
+static DataTransferRemapCache *ensure_remap_cache(ModifierData *md)
+{
+  if (md->runtime == nullptr) {
+    md->runtime = BKE_data_transfer_remap_cache_new();
+  }
+  return static_cast<DataTransferRemapCache *>(md->runtime);
+}
+
+static void free_runtime_data(void *runtime_data)
+{
+  BKE_data_transfer_remap_cache_free(static_cast<DataTransferRemapCache *>(runtime_data));
+}
+
+static void free_data(ModifierData *md)
+{
+  free_runtime_data(md->runtime);
+  md->runtime = nullptr;
+}
+
 static void required_data_mask(ModifierData *md, CustomData_MeshMasks *r_cddata_masks)
 {
   DataTransferModifierData *dtmd = (DataTransferModifierData *)md;
@@ -183,6 +202,7 @@ static Mesh *modify_mesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh
                                   dtmd->mix_factor,
                                   dtmd->defgrp_name,
                                   invert_vgroup,
+                                  ensure_remap_cache(md),
                                   &reports))
   {
     result->runtime->is_original_bmesh = false;
@@ -493,14 +513,14 @@ ModifierTypeInfo modifierType_DataTransfer = {
 
     /*init_data*/ init_data,
     /*required_data_mask*/ required_data_mask,
-    /*free_data*/ nullptr,
+    /*free_data*/ free_data,
     /*is_disabled*/ is_disabled,
     /*update_depsgraph*/ update_depsgraph,
     /*depends_on_time*/ nullptr,
     /*depends_on_normals*/ nullptr,
     /*foreach_ID_link*/ foreach_ID_link,
     /*foreach_tex_link*/ nullptr,
-    /*free_runtime_data*/ nullptr,
+    /*free_runtime_data*/ free_runtime_data,
     /*panel_register*/ panel_register,
     /*blend_write*/ nullptr,
     /*blend_read*/ nullptr,
@@ -40,6 +40,26 @@ static void init_data(ModifierData *md)
   MEMCPY_STRUCT_AFTER(lmd, DNA_struct_default_get(LatticeModifierData), modifier);
 }
 
+static blender::bke::LatticeDeformBinding *ensure_binding(ModifierData *md)
+{
+  if (md->runtime == nullptr) {
+    md->runtime = blender::bke::lattice_deform_binding_new();
+  }
+  return static_cast<blender::bke::LatticeDeformBinding *>(md->runtime);
+}
+
+static void free_runtime_data(void *runtime_data)
+{
+  blender::bke::lattice_deform_binding_free(
+      static_cast<blender::bke::LatticeDeformBinding *>(runtime_data));
+}
+
+static void free_data(ModifierData *md)
+{
+  free_runtime_data(md->runtime);
+  md->runtime = nullptr;
+}
+
 static void required_data_mask(ModifierData *md, CustomData_MeshMasks *r_cddata_masks)
 {
   LatticeModifierData *lmd = (LatticeModifierData *)md;
@@ -102,7 +122,8 @@ static void deform_verts(ModifierData *md,
                                       lmd->flag,
                                       lmd->name,
                                       lmd->strength,
-                                      mesh);
+                                      mesh,
+                                      ensure_binding(md));
 }
 
 static void deform_verts_EM(ModifierData *md,
@@ -176,14 +197,14 @@ ModifierTypeInfo modifierType_Lattice = {
 
     /*init_data*/ init_data,
     /*required_data_mask*/ required_data_mask,
-    /*free_data*/ nullptr,
+    /*free_data*/ free_data,
     /*is_disabled*/ is_disabled,
     /*update_depsgraph*/ update_depsgraph,
     /*depends_on_time*/ nullptr,
     /*depends_on_normals*/ nullptr,
     /*foreach_ID_link*/ foreach_ID_link,
     /*foreach_tex_link*/ nullptr,
-    /*free_runtime_data*/ nullptr,
+    /*free_runtime_data*/ free_runtime_data,
     /*panel_register*/ panel_register,
     /*blend_write*/ nullptr,
     /*blend_read*/ nullptr,
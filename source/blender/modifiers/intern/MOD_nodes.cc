@@ -19,6 +19,7 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_multi_value_map.hh"
 #include "BLI_path_util.h"
+#include "BLI_profile.hh"
 #include "BLI_set.hh"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
@@ -1641,6 +1642,7 @@ static void modifyGeometry(ModifierData *md,
       BKE_modifier_get_original(ctx->object, &nmd->modifier));
 
   const bNodeTree &tree = *nmd->node_group;
+  PROFILE_SCOPE_DETAIL("Geometry Nodes", tree.id.name + 2);
   check_property_socket_sync(ctx->object, md);
 
   tree.ensure_topology_cache();
@@ -6,6 +6,7 @@
 
 #include "BKE_image.h"
 
+#include "BLI_math_interp.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_threads.h"
 
@@ -316,6 +317,58 @@ class ImageFieldsFunction : public mf::MultiFunction {
     }
   }
 
+  static std::optional<math::InterpWrapMode> batch_wrap_mode(const int8_t extension)
+  {
+    switch (extension) {
+      case SHD_IMAGE_EXTENSION_REPEAT:
+        return math::InterpWrapMode::Repeat;
+      case SHD_IMAGE_EXTENSION_EXTEND:
+        return math::InterpWrapMode::Extend;
+      case SHD_IMAGE_EXTENSION_CLIP:
+        return math::InterpWrapMode::Border;
+      default:
+        return std::nullopt;
+    }
+  }
+
+  /**
+   * Sample linear and cubic interpolation in batches using #BLI_math_interp.hh, which is much
+   * faster than the single sample lookups above when sampling many coordinates.
+   */
+  void sample_batched(const IndexMask &mask,
+                      const VArray<float3> &vectors,
+                      const math::InterpWrapMode wrap_mode,
+                      MutableSpan<float4> color_data) const
+  {
+    const ImBuf &ibuf = *image_buffer_;
+    const float2 size(ibuf.x, ibuf.y);
+
+    constexpr int64_t chunk_size = 1024;
+    Array<float2> uvs(std::min(mask.size(), chunk_size));
+    Array<float4> colors(uvs.size());
+    for (int64_t start = 0; start < mask.size(); start += chunk_size) {
+      const IndexMask chunk = mask.slice(start, std::min(chunk_size, mask.size() - start));
+      MutableSpan<float2> chunk_uvs = uvs.as_mutable_span().take_front(chunk.size());
+      MutableSpan<float4> chunk_colors = colors.as_mutable_span().take_front(chunk.size());
+
+      /* Interpolation functions use `floor(uv)` and `floor(uv)+1` texels, subtract 0.5 to map
+       * between pixel and texel spaces. */
+      chunk.foreach_index([&](const int64_t i, const int64_t pos) {
+        chunk_uvs[pos] = vectors[i].xy() * size - 0.5f;
+      });
+      if (interpolation_ == SHD_INTERP_LINEAR) {
+        math::interpolate_bilinear_fl(
+            ibuf.float_buffer.data, ibuf.x, ibuf.y, chunk_uvs, chunk_colors, wrap_mode, wrap_mode);
+      }
+      else {
+        math::interpolate_cubic_bspline_fl(
+            ibuf.float_buffer.data, ibuf.x, ibuf.y, chunk_uvs, chunk_colors, wrap_mode, wrap_mode);
+      }
+      chunk.foreach_index(
+          [&](const int64_t i, const int64_t pos) { color_data[i] = chunk_colors[pos]; });
+    }
+  }
+
   void call(const IndexMask &mask, mf::Params params, mf::Context /*context*/) const override
   {
     const VArray<float3> &vectors = params.readonly_single_input<float3>(0, "Vector");
@@ -326,26 +379,32 @@ class ImageFieldsFunction : public mf::MultiFunction {
     MutableSpan<float4> color_data{reinterpret_cast<float4 *>(r_color.data()), r_color.size()};
 
     /* Sample image texture. */
-    switch (interpolation_) {
-      case SHD_INTERP_LINEAR:
-        mask.foreach_index([&](const int64_t i) {
-          const float3 p = vectors[i];
-          color_data[i] = image_linear_texture_lookup(*image_buffer_, p.x, p.y, extension_);
-        });
-        break;
-      case SHD_INTERP_CLOSEST:
-        mask.foreach_index([&](const int64_t i) {
-          const float3 p = vectors[i];
-          color_data[i] = image_closest_texture_lookup(*image_buffer_, p.x, p.y, extension_);
-        });
-        break;
-      case SHD_INTERP_CUBIC:
-      case SHD_INTERP_SMART:
-        mask.foreach_index([&](const int64_t i) {
-          const float3 p = vectors[i];
-          color_data[i] = image_cubic_texture_lookup(*image_buffer_, p.x, p.y, extension_);
-        });
-        break;
+    const std::optional<math::InterpWrapMode> wrap_mode = batch_wrap_mode(extension_);
+    if (wrap_mode && interpolation_ != SHD_INTERP_CLOSEST) {
+      this->sample_batched(mask, vectors, *wrap_mode, color_data);
+    }
+    else {
+      switch (interpolation_) {
+        case SHD_INTERP_LINEAR:
+          mask.foreach_index([&](const int64_t i) {
+            const float3 p = vectors[i];
+            color_data[i] = image_linear_texture_lookup(*image_buffer_, p.x, p.y, extension_);
+          });
+          break;
+        case SHD_INTERP_CLOSEST:
+          mask.foreach_index([&](const int64_t i) {
+            const float3 p = vectors[i];
+            color_data[i] = image_closest_texture_lookup(*image_buffer_, p.x, p.y, extension_);
+          });
+          break;
+        case SHD_INTERP_CUBIC:
+        case SHD_INTERP_SMART:
+          mask.foreach_index([&](const int64_t i) {
+            const float3 p = vectors[i];
+            color_data[i] = image_cubic_texture_lookup(*image_buffer_, p.x, p.y, extension_);
+          });
+          break;
+      }
     }
 
     int alpha_mode = image_.alpha_mode;
@@ -34,6 +34,7 @@
 #include "BLI_hash_md5.hh"
 #include "BLI_lazy_threading.hh"
 #include "BLI_map.hh"
+#include "BLI_profile.hh"
 
 #include "DNA_ID.h"
 
@@ -327,6 +328,10 @@ class LazyFunctionForGeometryNode : public LazyFunction {
     geo_eval_log::TimePoint start_time = geo_eval_log::Clock::now();
     node_.typeinfo->geometry_node_execute(geo_params);
     geo_eval_log::TimePoint end_time = geo_eval_log::Clock::now();
+    if (profile::is_enabled()) {
+      /* Built-in node types are never freed, so the name can be referenced. */
+      profile::record_zone(node_.typeinfo->ui_name, node_.name, start_time, end_time);
+    }
 
     if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(*user_data))
     {
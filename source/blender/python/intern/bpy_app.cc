@@ -579,6 +579,31 @@ static PyObject *bpy_app_help_text(PyObject * /*self*/, PyObject *args, PyObject
   return result;
 }
 
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_memory_usage_by_name_doc,
+    ".. staticmethod:: memory_usage_by_name()\n"
+    "\n"
+    "   Return the memory that is currently in use, per allocation name.\n"
+    "   Unless Blender runs with ``--debug-memory``, only memory allocated after starting with\n"
+    "   ``--debug-memory-by-name`` is taken into account.\n"
+    "\n"
+    "   :return: Dictionary mapping allocation names to ``(bytes, blocks)`` tuples.\n"
+    "   :rtype: dict[str, tuple[int, int]]\n");
+static PyObject *bpy_app_memory_usage_by_name(PyObject * /*self*/)
+{
+  PyObject *result = PyDict_New();
+  MEM_foreach_memory_usage_by_name(
+      [](const char *name, size_t mem_in_use, size_t blocks_num, void *user_data) {
+        PyObject *item = PyTuple_New(2);
+        PyTuple_SET_ITEMS(item, PyLong_FromSize_t(mem_in_use), PyLong_FromSize_t(blocks_num));
+        PyDict_SetItemString(static_cast<PyObject *>(user_data), name, item);
+        Py_DECREF(item);
+      },
+      result);
+  return result;
+}
+
 #if (defined(__GNUC__) && !defined(__clang__))
 #  pragma GCC diagnostic push
 #  pragma GCC diagnostic ignored "-Wcast-function-type"
@@ -593,6 +618,10 @@ static PyMethodDef bpy_app_methods[] = {
      (PyCFunction)bpy_app_help_text,
      METH_VARARGS | METH_KEYWORDS | METH_STATIC,
      bpy_app_help_text_doc},
+    {"memory_usage_by_name",
+     (PyCFunction)bpy_app_memory_usage_by_name,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_memory_usage_by_name_doc},
     {nullptr, nullptr, 0, nullptr},
 };
 
@@ -17,10 +17,13 @@
 #  include "DNA_scene_types.h"
 #  include "DNA_texture_types.h"
 
+#  include "BLI_array.hh"
 #  include "BLI_math_geom.h"
 #  include "BLI_math_matrix.h"
 #  include "BLI_math_vector.h"
+#  include "BLI_task.hh"
 #  include "BLI_utildefines.h"
+#  include "BLI_vector_set.hh"
 
 #  include "BKE_cloth.hh"
 #  include "BKE_collision.h"
@@ -32,9 +35,11 @@
 #    pragma GCC diagnostic ignored "-Wtype-limits"
 #  endif
 
-#  ifdef _OPENMP
-#    define CLOTH_OPENMP_LIMIT 512
-#  endif
+/* Number of vertices handled by one task in the parallel long vector and big matrix routines. */
+#  define CLOTH_PARALLEL_GRAIN_SIZE 1024
+/* Fixed number of vertices summed per partial result in #dot_lfvector. The partial sums are
+ * added in order, so results don't depend on the number of threads. */
+#  define CLOTH_DOT_CHUNK_SIZE 4096
 
 // #define DEBUG_TIME
 
@@ -134,6 +139,16 @@ DO_INLINE void del_lfvector(float (*fLongVector)[3])
     // cloth_aligned_free(&MEMORY_BASE, fLongVector);
   }
 }
+/* Run `fn(start, end)` on ranges of the flattened float components of a long vector with
+ * `verts` elements, in parallel. The inner loops over plain float arrays are vectorized by the
+ * compiler. */
+template<typename Fn> static void parallel_lfvector_components(const uint verts, const Fn &fn)
+{
+  blender::threading::parallel_for(
+      blender::IndexRange(verts), CLOTH_PARALLEL_GRAIN_SIZE, [&](const blender::IndexRange range) {
+        fn(range.start() * 3, range.one_after_last() * 3);
+      });
+}
 /* copy long vector */
 DO_INLINE void cp_lfvector(float (*to)[3], float (*from)[3], uint verts)
 {
@@ -155,35 +170,54 @@ DO_INLINE void zero_lfvector(float (*to)[3], uint verts)
 /* Multiply long vector with scalar. */
 DO_INLINE void mul_lfvectorS(float (*to)[3], float (*fLongVector)[3], float scalar, uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    mul_fvector_S(to[i], fLongVector[i], scalar);
-  }
+  float *r = to[0];
+  const float *a = fLongVector[0];
+  parallel_lfvector_components(verts, [&](const int64_t start, const int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      r[i] = a[i] * scalar;
+    }
+  });
 }
 /* Multiply long vector with scalar.
  * `A -= B * float` */
 DO_INLINE void submul_lfvectorS(float (*to)[3], float (*fLongVector)[3], float scalar, uint verts)
 {
-  uint i = 0;
-  for (i = 0; i < verts; i++) {
-    VECSUBMUL(to[i], fLongVector[i], scalar);
-  }
+  float *r = to[0];
+  const float *a = fLongVector[0];
+  parallel_lfvector_components(verts, [&](const int64_t start, const int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      r[i] -= a[i] * scalar;
+    }
+  });
 }
 /* dot product for big vector */
 DO_INLINE float dot_lfvector(float (*fLongVectorA)[3], float (*fLongVectorB)[3], uint verts)
 {
-  long i = 0;
-  float temp = 0.0;
-  /* XXX brecht, disabled this for now (first schedule line was already disabled),
-   * due to non-commutative nature of floating point ops this makes the sim give
-   * different results each time you run it!
-   * schedule(guided, 2) */
-  // #pragma omp parallel for reduction(+: temp) if (verts > CLOTH_OPENMP_LIMIT)
-  for (i = 0; i < long(verts); i++) {
-    temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+  /* Partial sums over fixed chunks, added in order afterwards. A parallel reduction with dynamic
+   * splitting would make the result depend on the scheduling, due to the non-commutative nature
+   * of floating point ops, and give different simulation results each time. */
+  const int64_t chunks_num = (int64_t(verts) + CLOTH_DOT_CHUNK_SIZE - 1) / CLOTH_DOT_CHUNK_SIZE;
+  blender::Array<double> partial_sums(chunks_num);
+  blender::threading::parallel_for(
+      partial_sums.index_range(), 1, [&](const blender::IndexRange chunks) {
+        for (const int64_t chunk : chunks) {
+          const int64_t start = chunk * CLOTH_DOT_CHUNK_SIZE * 3;
+          const int64_t end = std::min<int64_t>(start + CLOTH_DOT_CHUNK_SIZE * 3,
+                                                int64_t(verts) * 3);
+          const float *a = fLongVectorA[0];
+          const float *b = fLongVectorB[0];
+          float sum = 0.0f;
+          for (int64_t i = start; i < end; i++) {
+            sum += a[i] * b[i];
+          }
+          partial_sums[chunk] = double(sum);
+        }
+      });
+  double temp = 0.0;
+  for (const double sum : partial_sums) {
+    temp += sum;
   }
-  return temp;
+  return float(temp);
 }
 /* `A = B + C` -> for big vector. */
 DO_INLINE void add_lfvector_lfvector(float (*to)[3],
@@ -191,21 +225,27 @@ DO_INLINE void add_lfvector_lfvector(float (*to)[3],
                                      float (*fLongVectorB)[3],
                                      uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    add_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
-  }
+  float *r = to[0];
+  const float *a = fLongVectorA[0];
+  const float *b = fLongVectorB[0];
+  parallel_lfvector_components(verts, [&](const int64_t start, const int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      r[i] = a[i] + b[i];
+    }
+  });
 }
 /* `A = B + C * float` -> for big vector. */
 DO_INLINE void add_lfvector_lfvectorS(
     float (*to)[3], float (*fLongVectorA)[3], float (*fLongVectorB)[3], float bS, uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
-  }
+  float *r = to[0];
+  const float *a = fLongVectorA[0];
+  const float *b = fLongVectorB[0];
+  parallel_lfvector_components(verts, [&](const int64_t start, const int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      r[i] = a[i] + b[i] * bS;
+    }
+  });
 }
 /* `A = B * float + C * float` -> for big vector */
 DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
@@ -215,20 +255,27 @@ DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
                                        float bS,
                                        uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDSS(to[i], fLongVectorA[i], aS, fLongVectorB[i], bS);
-  }
+  float *r = to[0];
+  const float *a = fLongVectorA[0];
+  const float *b = fLongVectorB[0];
+  parallel_lfvector_components(verts, [&](const int64_t start, const int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      r[i] = a[i] * aS + b[i] * bS;
+    }
+  });
 }
 /* `A = B - C * float` -> for big vector. */
 DO_INLINE void sub_lfvector_lfvectorS(
     float (*to)[3], float (*fLongVectorA)[3], float (*fLongVectorB)[3], float bS, uint verts)
 {
-  uint i = 0;
-  for (i = 0; i < verts; i++) {
-    VECSUBS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
-  }
+  float *r = to[0];
+  const float *a = fLongVectorA[0];
+  const float *b = fLongVectorB[0];
+  parallel_lfvector_components(verts, [&](const int64_t start, const int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      r[i] = a[i] - b[i] * bS;
+    }
+  });
 }
 /* `A = B - C` -> for big vector. */
 DO_INLINE void sub_lfvector_lfvector(float (*to)[3],
@@ -236,11 +283,14 @@ DO_INLINE void sub_lfvector_lfvector(float (*to)[3],
                                      float (*fLongVectorB)[3],
                                      uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    sub_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
-  }
+  float *r = to[0];
+  const float *a = fLongVectorA[0];
+  const float *b = fLongVectorB[0];
+  parallel_lfvector_components(verts, [&](const int64_t start, const int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      r[i] = a[i] - b[i];
+    }
+  });
 }
 ///////////////////////////
 // 3x3 matrix
@@ -582,49 +632,138 @@ DO_INLINE void initdiag_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
   }
 }
 
-/* SPARSE SYMMETRIC multiply big matrix with long vector. */
-/* STATUS: verified */
-DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
-{
-  uint vcount = from[0].vcount;
-  lfVector *temp = create_lfvector(vcount);
+/* Block compressed sparse row layout of a SPARSE SYMMETRIC big matrix. The big matrix only
+ * stores the diagonal and the lower triangle as a list of blocks, this lists all blocks
+ * contributing to each row, so that rows can be multiplied independently and in parallel. */
+struct bfmatrix_rows {
+  struct Entry {
+    /* Index of the block in the big matrix. */
+    int block;
+    /* Column of the block in this row. */
+    int col;
+    /* Upper triangle entry, the block is used transposed. */
+    bool transposed;
+  };
+  /* Start of the entries of every row, with one extra element for the end of the last row. */
+  blender::Array<int> offsets;
+  blender::Array<Entry> entries;
+  /* Row and column of every block the layout was built from. */
+  blender::Array<uint64_t> block_keys;
+};
 
-  zero_lfvector(to, vcount);
+BLI_INLINE uint64_t bfmatrix_block_key(const fmatrix3x3 &block)
+{
+  return (uint64_t(block.r) << 32) | uint64_t(block.c);
+}
 
-#  pragma omp parallel sections if (vcount > CLOTH_OPENMP_LIMIT)
-  {
-#  pragma omp section
-    {
-      for (uint i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
-        /* This is the lower triangle of the sparse matrix,
-         * therefore multiplication occurs with transposed sub-matrices. */
-        muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
+/* Build the row layout of the first `blocks_num` blocks of a big matrix. Entries of each row are
+ * in block order, which keeps the results of #mul_bfmatrix_lfvector deterministic.
+ * Springs are usually added in the same order every step, in which case the existing layout is
+ * kept. */
+static void build_bfmatrix_rows(bfmatrix_rows &rows,
+                                const fmatrix3x3 *matrix,
+                                const uint blocks_num)
+{
+  const uint vcount = matrix[0].vcount;
+  if (rows.block_keys.size() == blocks_num) {
+    bool layout_changed = false;
+    for (uint i = 0; i < blocks_num; i++) {
+      if (rows.block_keys[i] != bfmatrix_block_key(matrix[i])) {
+        layout_changed = true;
+        break;
       }
     }
-#  pragma omp section
-    {
-      for (uint i = 0; i < from[0].vcount + from[0].scount; i++) {
-        muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
-      }
+    if (!layout_changed) {
+      return;
     }
   }
-  add_lfvector_lfvector(to, to, temp, from[0].vcount);
+  rows.block_keys.reinitialize(blocks_num);
+  for (uint i = 0; i < blocks_num; i++) {
+    rows.block_keys[i] = bfmatrix_block_key(matrix[i]);
+  }
 
-  del_lfvector(temp);
+  rows.offsets.reinitialize(vcount + 1);
+  rows.offsets.fill(0);
+  for (uint i = 0; i < blocks_num; i++) {
+    rows.offsets[matrix[i].r]++;
+    if (i >= vcount) {
+      rows.offsets[matrix[i].c]++;
+    }
+  }
+  int offset = 0;
+  for (int &row_offset : rows.offsets) {
+    const int row_size = row_offset;
+    row_offset = offset;
+    offset += row_size;
+  }
+
+  rows.entries.reinitialize(offset);
+  blender::Array<int> fill(vcount, 0);
+  for (uint i = 0; i < blocks_num; i++) {
+    const uint r = matrix[i].r;
+    const uint c = matrix[i].c;
+    rows.entries[rows.offsets[r] + fill[r]++] = {int(i), int(c), false};
+    if (i >= vcount) {
+      /* This is the lower triangle of the sparse matrix,
+       * the upper triangle uses the transposed sub-matrices. */
+      rows.entries[rows.offsets[c] + fill[c]++] = {int(i), int(r), true};
+    }
+  }
 }
 
-/* SPARSE SYMMETRIC sub big matrix with big matrix. */
-/* A -= B * float + C * float --> for big matrix */
-/* VERIFIED */
-DO_INLINE void subadd_bfmatrixS_bfmatrixS(
-    fmatrix3x3 *to, fmatrix3x3 *from, float aS, fmatrix3x3 *matrix, float bS)
-{
-  uint i = 0;
+/* SPARSE SYMMETRIC multiply big matrix with long vector. */
+/* STATUS: verified */
+DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3],
+                                     const fmatrix3x3 *from,
+                                     const bfmatrix_rows &rows,
+                                     lfVector *fLongVector)
+{
+  const uint vcount = from[0].vcount;
+
+  blender::threading::parallel_for(
+      blender::IndexRange(vcount),
+      CLOTH_PARALLEL_GRAIN_SIZE,
+      [&](const blender::IndexRange range) {
+        for (const int64_t row : range) {
+          float sum[3] = {0.0f, 0.0f, 0.0f};
+          for (int i = rows.offsets[row]; i < rows.offsets[row + 1]; i++) {
+            const bfmatrix_rows::Entry &entry = rows.entries[i];
+            if (entry.transposed) {
+              muladd_fmatrixT_fvector(sum, from[entry.block].m, fLongVector[entry.col]);
+            }
+            else {
+              muladd_fmatrix_fvector(sum, from[entry.block].m, fLongVector[entry.col]);
+            }
+          }
+          copy_v3_v3(to[row], sum);
+        }
+      });
+}
 
-  /* process diagonal elements */
-  for (i = 0; i < matrix[0].vcount + matrix[0].scount; i++) {
-    subadd_fmatrixS_fmatrixS(to[i].m, from[i].m, aS, matrix[i].m, bS);
-  }
+/* SPARSE SYMMETRIC sub big matrix with big matrix. */
+/* A = M - B * float - C * float --> for big matrix with the same blocks */
+DO_INLINE void sub_bfmatrix_bfmatrixS_bfmatrixS(fmatrix3x3 *to,
+                                                const fmatrix3x3 *M,
+                                                const fmatrix3x3 *from,
+                                                float aS,
+                                                const fmatrix3x3 *matrix,
+                                                float bS,
+                                                uint blocks_num)
+{
+  blender::threading::parallel_for(
+      blender::IndexRange(blocks_num),
+      CLOTH_PARALLEL_GRAIN_SIZE,
+      [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          const float *m = M[i].m[0];
+          const float *a = from[i].m[0];
+          const float *b = matrix[i].m[0];
+          float *r = to[i].m[0];
+          for (int j = 0; j < 9; j++) {
+            r[j] = m[j] - (a[j] * aS + b[j] * bS);
+          }
+        }
+      });
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -652,11 +791,15 @@ struct Implicit_Data {
   lfVector *z;          /* target velocity in constrained directions */
   fmatrix3x3 *S;        /* filtering matrix for constraints */
   fmatrix3x3 *P, *Pinv; /* pre-conditioning matrix */
+
+  bfmatrix_rows rows; /* row layout of A and the force jacobians */
+  /* Vertices with constraints, all other blocks of S are identity. */
+  blender::VectorSet<int> constrained_verts;
 };
 
 Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
 {
-  Implicit_Data *id = (Implicit_Data *)MEM_callocN(sizeof(Implicit_Data), "implicit vecmat");
+  Implicit_Data *id = MEM_new<Implicit_Data>("implicit vecmat");
 
   /* process diagonal elements */
   id->tfm = create_bfmatrix(numverts, 0);
@@ -703,7 +846,7 @@ void SIM_mass_spring_solver_free(Implicit_Data *id)
   del_lfvector(id->dV);
   del_lfvector(id->z);
 
-  MEM_freeN(id);
+  MEM_delete(id);
 }
 
 /* ==== Transformation from/to root reference frames ==== */
@@ -740,90 +883,26 @@ BLI_INLINE void root_to_world_m3(Implicit_Data *data,
 
 /* ================================ */
 
-DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
-{
-  uint i = 0;
-
-  for (i = 0; i < S[0].vcount; i++) {
-    mul_m3_v3(S[i].m, V[S[i].r]);
-  }
-}
-
-/* this version of the CG algorithm does not work very well with partial constraints
- * (where S has non-zero elements). */
-#  if 0
-static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z, fmatrix3x3 *S)
+/* Only the constrained vertices are filtered, the blocks of all other vertices are identity. */
+DO_INLINE void filter(lfVector *V, fmatrix3x3 *S, const blender::Span<int> constrained_verts)
 {
-  /* Solves for unknown X in equation AX=B */
-  uint conjgrad_loopcount = 0, conjgrad_looplimit = 100;
-  float conjgrad_epsilon = 0.0001f /* , conjgrad_lasterror=0 */ /* UNUSED */;
-  lfVector *q, *d, *tmp, *r;
-  float s, starget, a, s_prev;
-  uint numverts = lA[0].vcount;
-  q = create_lfvector(numverts);
-  d = create_lfvector(numverts);
-  tmp = create_lfvector(numverts);
-  r = create_lfvector(numverts);
-
-  // zero_lfvector(ldV, CLOTHPARTICLES);
-  filter(ldV, S);
-
-  add_lfvector_lfvector(ldV, ldV, z, numverts);
-
-  // r = B - Mul(tmp, A, X);    /* just use B if X known to be zero. */
-  cp_lfvector(r, lB, numverts);
-  mul_bfmatrix_lfvector(tmp, lA, ldV);
-  sub_lfvector_lfvector(r, r, tmp, numverts);
-
-  filter(r, S);
-
-  cp_lfvector(d, r, numverts);
-
-  s = dot_lfvector(r, r, numverts);
-  starget = s * sqrtf(conjgrad_epsilon);
-
-  while (s > starget && conjgrad_loopcount < conjgrad_looplimit) {
-    // Mul(q, A, d); /* q = A*d; */
-    mul_bfmatrix_lfvector(q, lA, d);
-
-    filter(q, S);
-
-    a = s / dot_lfvector(d, q, numverts);
-
-    /* `X = X + d*a;` */
-    add_lfvector_lfvectorS(ldV, ldV, d, a, numverts);
-
-    /* `r = r - q*a;` */
-    sub_lfvector_lfvectorS(r, r, q, a, numverts);
-
-    s_prev = s;
-    s = dot_lfvector(r, r, numverts);
-
-    /* `d = r+d*(s/s_prev);` */
-    add_lfvector_lfvectorS(d, r, d, (s / s_prev), numverts);
-
-    filter(d, S);
-
-    conjgrad_loopcount++;
-  }
-  // conjgrad_lasterror = s; /* UNUSED */
-
-  del_lfvector(q);
-  del_lfvector(d);
-  del_lfvector(tmp);
-  del_lfvector(r);
-  // printf("W/O conjgrad_loopcount: %d\n", conjgrad_loopcount);
-
-  /* True means we reached desired accuracy in given time - ie stable. */
-  return conjgrad_loopcount < conjgrad_looplimit;
+  blender::threading::parallel_for(
+      constrained_verts.index_range(),
+      CLOTH_PARALLEL_GRAIN_SIZE,
+      [&](const blender::IndexRange range) {
+        for (const int i : constrained_verts.slice(range)) {
+          mul_m3_v3(S[i].m, V[S[i].r]);
+        }
+      });
 }
-#  endif
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const bfmatrix_rows &rows,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
+                       const blender::Span<int> constrained_verts,
                        ImplicitSolverResult *result)
 {
   /* Solves for unknown X in equation AX=B */
@@ -843,18 +922,18 @@ static int cg_filtered(lfVector *ldV,
 
   /* d0 = filter(B)^T * P * filter(B) */
   cp_lfvector(fB, lB, numverts);
-  filter(fB, S);
+  filter(fB, S, constrained_verts);
   bnorm2 = dot_lfvector(fB, fB, numverts);
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector(AdV, lA, rows, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
-  filter(r, S);
+  filter(r, S, constrained_verts);
 
   /* c = filter(P^-1 * r) */
   cp_lfvector(c, r, numverts);
-  filter(c, S);
+  filter(c, S, constrained_verts);
 
   /* delta = r^T * c */
   delta_new = dot_lfvector(r, c, numverts);
@@ -871,8 +950,8 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
-    filter(q, S);
+    mul_bfmatrix_lfvector(q, lA, rows, c);
+    filter(q, S, constrained_verts);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
 
@@ -886,7 +965,7 @@ static int cg_filtered(lfVector *ldV,
     delta_new = dot_lfvector(r, s, numverts);
 
     add_lfvector_lfvectorS(c, s, c, delta_new / delta_old, numverts);
-    filter(c, S);
+    filter(c, S, constrained_verts);
 
     conjgrad_loopcount++;
   }
@@ -914,224 +993,23 @@ static int cg_filtered(lfVector *ldV,
   return conjgrad_loopcount < conjgrad_looplimit;
 }
 
-#  if 0
-/* block diagonalizer */
-DO_INLINE void BuildPPinv(fmatrix3x3 *lA, fmatrix3x3 *P, fmatrix3x3 *Pinv)
-{
-  uint i = 0;
-
-  /* Take only the diagonal blocks of A */
-  // #pragma omp parallel for private(i) if (lA[0].vcount > CLOTH_OPENMP_LIMIT)
-  for (i = 0; i < lA[0].vcount; i++) {
-    /* block diagonalizer */
-    cp_fmatrix(P[i].m, lA[i].m);
-    inverse_fmatrix(Pinv[i].m, P[i].m);
-  }
-}
-
-#    if 0
-/* version 1.3 */
-static int cg_filtered_pre(lfVector *dv,
-                           fmatrix3x3 *lA,
-                           lfVector *lB,
-                           lfVector *z,
-                           fmatrix3x3 *S,
-                           fmatrix3x3 *P,
-                           fmatrix3x3 *Pinv)
-{
-  uint numverts = lA[0].vcount, iterations = 0, conjgrad_looplimit = 100;
-  float delta0 = 0, deltaNew = 0, deltaOld = 0, alpha = 0;
-  float conjgrad_epsilon = 0.0001; /* 0.2 is dt for steps=5 */
-  lfVector *r = create_lfvector(numverts);
-  lfVector *p = create_lfvector(numverts);
-  lfVector *s = create_lfvector(numverts);
-  lfVector *h = create_lfvector(numverts);
-
-  BuildPPinv(lA, P, Pinv);
-
-  filter(dv, S);
-  add_lfvector_lfvector(dv, dv, z, numverts);
-
-  mul_bfmatrix_lfvector(r, lA, dv);
-  sub_lfvector_lfvector(r, lB, r, numverts);
-  filter(r, S);
-
-  mul_prevfmatrix_lfvector(p, Pinv, r);
-  filter(p, S);
-
-  deltaNew = dot_lfvector(r, p, numverts);
-
-  delta0 = deltaNew * sqrt(conjgrad_epsilon);
-
-#      ifdef DEBUG_TIME
-  double start = BLI_time_now_seconds();
-#      endif
-
-  while ((deltaNew > delta0) && (iterations < conjgrad_looplimit)) {
-    iterations++;
-
-    mul_bfmatrix_lfvector(s, lA, p);
-    filter(s, S);
-
-    alpha = deltaNew / dot_lfvector(p, s, numverts);
-
-    add_lfvector_lfvectorS(dv, dv, p, alpha, numverts);
-
-    add_lfvector_lfvectorS(r, r, s, -alpha, numverts);
-
-    mul_prevfmatrix_lfvector(h, Pinv, r);
-    filter(h, S);
-
-    deltaOld = deltaNew;
-
-    deltaNew = dot_lfvector(r, h, numverts);
-
-    add_lfvector_lfvectorS(p, h, p, deltaNew / deltaOld, numverts);
-
-    filter(p, S);
-  }
-
-#      ifdef DEBUG_TIME
-  double end = BLI_time_now_seconds();
-  printf("cg_filtered_pre time: %f\n", float(end - start));
-#      endif
-
-  del_lfvector(h);
-  del_lfvector(s);
-  del_lfvector(p);
-  del_lfvector(r);
-
-  printf("iterations: %d\n", iterations);
-
-  return iterations < conjgrad_looplimit;
-}
-#    endif
-
-/* version 1.4 */
-static int cg_filtered_pre(lfVector *dv,
-                           fmatrix3x3 *lA,
-                           lfVector *lB,
-                           lfVector *z,
-                           fmatrix3x3 *S,
-                           fmatrix3x3 *P,
-                           fmatrix3x3 *Pinv,
-                           fmatrix3x3 *bigI)
-{
-  uint numverts = lA[0].vcount, iterations = 0, conjgrad_looplimit = 100;
-  float delta0 = 0, deltaNew = 0, deltaOld = 0, alpha = 0, tol = 0;
-  lfVector *r = create_lfvector(numverts);
-  lfVector *p = create_lfvector(numverts);
-  lfVector *s = create_lfvector(numverts);
-  lfVector *h = create_lfvector(numverts);
-  lfVector *bhat = create_lfvector(numverts);
-  lfVector *btemp = create_lfvector(numverts);
-
-  BuildPPinv(lA, P, Pinv);
-
-  initdiag_bfmatrix(bigI, I);
-  sub_bfmatrix_Smatrix(bigI, bigI, S);
-
-  /* x = Sx_0+(I-S)z */
-  filter(dv, S);
-  add_lfvector_lfvector(dv, dv, z, numverts);
-
-  /* b_hat = S(b-A(I-S)z) */
-  mul_bfmatrix_lfvector(r, lA, z);
-  mul_bfmatrix_lfvector(bhat, bigI, r);
-  sub_lfvector_lfvector(bhat, lB, bhat, numverts);
-
-  /* r = S(b-Ax) */
-  mul_bfmatrix_lfvector(r, lA, dv);
-  sub_lfvector_lfvector(r, lB, r, numverts);
-  filter(r, S);
-
-  /* p = SP^-1r */
-  mul_prevfmatrix_lfvector(p, Pinv, r);
-  filter(p, S);
-
-  /* delta0 = bhat^TP^-1bhat */
-  mul_prevfmatrix_lfvector(btemp, Pinv, bhat);
-  delta0 = dot_lfvector(bhat, btemp, numverts);
-
-  /* deltaNew = r^TP */
-  deltaNew = dot_lfvector(r, p, numverts);
-
-#    if 0
-  filter(dv, S);
-  add_lfvector_lfvector(dv, dv, z, numverts);
-
-  mul_bfmatrix_lfvector(r, lA, dv);
-  sub_lfvector_lfvector(r, lB, r, numverts);
-  filter(r, S);
-
-  mul_prevfmatrix_lfvector(p, Pinv, r);
-  filter(p, S);
-
-  deltaNew = dot_lfvector(r, p, numverts);
-
-  delta0 = deltaNew * sqrt(conjgrad_epsilon);
-#    endif
-
-#    ifdef DEBUG_TIME
-  double start = BLI_time_now_seconds();
-#    endif
-
-  tol = (0.01 * 0.2);
-
-  while ((deltaNew > delta0 * tol * tol) && (iterations < conjgrad_looplimit)) {
-    iterations++;
-
-    mul_bfmatrix_lfvector(s, lA, p);
-    filter(s, S);
-
-    alpha = deltaNew / dot_lfvector(p, s, numverts);
-
-    add_lfvector_lfvectorS(dv, dv, p, alpha, numverts);
-
-    add_lfvector_lfvectorS(r, r, s, -alpha, numverts);
-
-    mul_prevfmatrix_lfvector(h, Pinv, r);
-    filter(h, S);
-
-    deltaOld = deltaNew;
-
-    deltaNew = dot_lfvector(r, h, numverts);
-
-    add_lfvector_lfvectorS(p, h, p, deltaNew / deltaOld, numverts);
-
-    filter(p, S);
-  }
-
-#    ifdef DEBUG_TIME
-  double end = BLI_time_now_seconds();
-  printf("cg_filtered_pre time: %f\n", float(end - start));
-#    endif
-
-  del_lfvector(btemp);
-  del_lfvector(bhat);
-  del_lfvector(h);
-  del_lfvector(s);
-  del_lfvector(p);
-  del_lfvector(r);
-
-  // printf("iterations: %d\n", iterations);
-
-  return iterations < conjgrad_looplimit;
-}
-#  endif
-
 bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSolverResult *result)
 {
   uint numverts = data->dFdV[0].vcount;
 
+  /* Only the blocks of springs added since the forces were cleared are used. */
+  const uint blocks_num = numverts + uint(data->num_blocks);
+
   lfVector *dFdXmV = create_lfvector(numverts);
   zero_lfvector(data->dV, numverts);
 
-  cp_bfmatrix(data->A, data->M);
+  /* A and the force jacobians share the same blocks. */
+  build_bfmatrix_rows(data->rows, data->dFdX, blocks_num);
 
-  subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
+  sub_bfmatrix_bfmatrixS_bfmatrixS(
+      data->A, data->M, data->dFdV, dt, data->dFdX, (dt * dt), blocks_num);
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->rows, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1140,9 +1018,14 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
-
-  // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
+  cg_filtered(data->dV,
+              data->A,
+              data->rows,
+              data->B,
+              data->z,
+              data->S,
+              data->constrained_verts.as_span(),
+              result);
 
 #  ifdef DEBUG_TIME
   double end = BLI_time_now_seconds();
@@ -1276,11 +1159,13 @@ void SIM_mass_spring_clear_constraints(Implicit_Data *data)
     unit_m3(data->S[i].m);
     zero_v3(data->z[i]);
   }
+  data->constrained_verts.clear();
 }
 
 void SIM_mass_spring_add_constraint_ndof0(Implicit_Data *data, int index, const float dV[3])
 {
   zero_m3(data->S[index].m);
+  data->constrained_verts.add(index);
 
   world_to_root_v3(data, index, data->z[index], dV);
 }
@@ -1301,6 +1186,7 @@ void SIM_mass_spring_add_constraint_ndof1(
   /* XXX not sure but multiplication should work here */
   copy_m3_m3(data->S[index].m, m);
   //  mul_m3_m3m3(data->S[index].m, data->S[index].m, m);
+  data->constrained_verts.add(index);
 
   world_to_root_v3(data, index, u, dV);
   add_v3_v3(data->z[index], u);
@@ -1319,6 +1205,7 @@ void SIM_mass_spring_add_constraint_ndof2(Implicit_Data *data,
 
   copy_m3_m3(data->S[index].m, m);
   //  mul_m3_m3m3(data->S[index].m, data->S[index].m, m);
+  data->constrained_verts.add(index);
 
   world_to_root_v3(data, index, u, dV);
   add_v3_v3(data->z[index], u);
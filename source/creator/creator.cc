@@ -335,6 +335,10 @@ int main(int argc,
   {
     int i;
     for (i = 0; i < argc; i++) {
+      if (STREQ(argv[i], "--debug-memory-by-name")) {
+        /* Count from the first allocation on, so that all blocks are known by name. */
+        MEM_use_memory_usage_by_name(true);
+      }
       if (STR_ELEM(argv[i], "-d", "--debug", "--debug-memory", "--debug-all")) {
         printf("Switching to fully guarded memory allocator.\n");
         MEM_use_guarded_allocator();
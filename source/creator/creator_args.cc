@@ -25,6 +25,7 @@
 #  include "BLI_fileops.h"
 #  include "BLI_listbase.h"
 #  include "BLI_path_util.h"
+#  include "BLI_profile.hh"
 #  include "BLI_string.h"
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
@@ -35,6 +36,7 @@
 #  endif
 
 #  include "BKE_appdir.hh"
+#  include "BKE_blender.hh"
 #  include "BKE_blender_cli_command.hh"
 #  include "BKE_blender_version.h"
 #  include "BKE_blendfile.hh"
@@ -731,6 +733,8 @@ static void print_help(bArgs *ba, bool all)
     BLI_args_print_arg_doc(ba, "--debug-cycles");
   }
   BLI_args_print_arg_doc(ba, "--debug-memory");
+  BLI_args_print_arg_doc(ba, "--debug-memory-by-name");
+  BLI_args_print_arg_doc(ba, "--profile");
   BLI_args_print_arg_doc(ba, "--debug-jobs");
   BLI_args_print_arg_doc(ba, "--debug-python");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph");
@@ -1331,6 +1335,57 @@ static int arg_handle_debug_mode_memory_set(int /*argc*/, const char ** /*argv*/
   return 0;
 }
 
+static const char arg_handle_debug_mode_memory_by_name_set_doc[] =
+    "\n"
+    "\tCount the memory in use per allocation name, with low overhead.\n"
+    "\tThe statistics are printed by the memory statistics operator\n"
+    "\tand available from Python via 'bpy.app.memory_usage_by_name()'.";
+static int arg_handle_debug_mode_memory_by_name_set(int /*argc*/,
+                                                    const char ** /*argv*/,
+                                                    void * /*data*/)
+{
+  /* Already enabled in `main()` before the first allocation, see #MEM_use_memory_usage_by_name.
+   * Calling it again is harmless. */
+  MEM_use_memory_usage_by_name(true);
+  return 0;
+}
+
+static void profile_write_atexit(void *user_data)
+{
+  char *filepath = static_cast<char *>(user_data);
+  blender::profile::set_enabled(false);
+  if (blender::profile::write_chrome_trace(filepath)) {
+    printf("Profile written to '%s'\n", filepath);
+  }
+  else {
+    fprintf(stderr, "Error: could not write profile to '%s'\n", filepath);
+  }
+  MEM_freeN(filepath);
+}
+
+static const char arg_handle_profile_set_doc[] =
+    "<filepath>\n"
+    "\tRecord the time spent in dependency graph evaluation, modifiers, geometry nodes,\n"
+    "\tfile I/O and draw data extraction, per thread.\n"
+    "\tThe trace is written to <filepath> on exit, in the Chrome trace event format\n"
+    "\twhich can be viewed with 'chrome://tracing' or Perfetto.";
+static int arg_handle_profile_set(int argc, const char **argv, void * /*data*/)
+{
+  const char *arg_id = "--profile";
+  if (argc > 1) {
+    char filepath[FILE_MAX];
+    STRNCPY(filepath, argv[1]);
+    BLI_path_abs_from_cwd(filepath, sizeof(filepath));
+    if (!blender::profile::is_enabled()) {
+      BKE_blender_atexit_register(profile_write_atexit, BLI_strdup(filepath));
+      blender::profile::set_enabled(true);
+    }
+    return 1;
+  }
+  fprintf(stderr, "\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
 static const char arg_handle_debug_value_set_doc[] =
     "<value>\n"
     "\tSet debug value of <value> on startup.";
@@ -2617,6 +2672,12 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
     BLI_args_add(ba, nullptr, "--debug-cycles", CB(arg_handle_debug_mode_cycles), nullptr);
   }
   BLI_args_add(ba, nullptr, "--debug-memory", CB(arg_handle_debug_mode_memory_set), nullptr);
+  BLI_args_add(ba,
+               nullptr,
+               "--debug-memory-by-name",
+               CB(arg_handle_debug_mode_memory_by_name_set),
+               nullptr);
+  BLI_args_add(ba, nullptr, "--profile", CB(arg_handle_profile_set), nullptr);
 
   BLI_args_add(ba, nullptr, "--debug-value", CB(arg_handle_debug_value_set), nullptr);
   BLI_args_add(ba,